@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <drivers/flash.h>
+#include <init.h>
+#include <kernel.h>
+
+static K_THREAD_STACK_DEFINE(flash_async_stack,
+			     CONFIG_FLASH_ASYNC_WORKQUEUE_STACK_SIZE);
+struct k_work_q z_flash_async_workq;
+
+int z_flash_async_exec(const struct device *dev,
+		       const struct flash_async_op *op)
+{
+	const struct flash_driver_api *api = dev->api;
+	off_t offset = op->offset;
+	int rc = 0;
+
+	switch (op->type) {
+	case FLASH_ASYNC_OP_READ:
+		rc = api->read(dev, op->offset, op->data, op->len);
+		break;
+	case FLASH_ASYNC_OP_WRITE:
+		for (size_t i = 0; (rc == 0) && (i < op->buf_count); i++) {
+			rc = api->write(dev, offset, op->bufs[i].data,
+					op->bufs[i].len);
+			offset += op->bufs[i].len;
+		}
+		break;
+	case FLASH_ASYNC_OP_ERASE:
+		rc = api->erase(dev, op->offset, op->len);
+		break;
+	default:
+		rc = -EINVAL;
+		break;
+	}
+
+	return rc;
+}
+
+static void flash_async_work_handler(struct k_work *work)
+{
+	struct flash_async_op *op =
+		CONTAINER_OF(work, struct flash_async_op, work);
+	int rc;
+
+	rc = z_flash_async_exec(op->dev, op);
+	op->callback(op->dev, op, rc);
+}
+
+int z_flash_async_submit_generic(const struct device *dev,
+				 struct flash_async_op *op)
+{
+	int rc;
+
+	op->dev = dev;
+	k_work_init(&op->work, flash_async_work_handler);
+
+	rc = k_work_submit_to_queue(&z_flash_async_workq, &op->work);
+
+	return (rc < 0) ? rc : 0;
+}
+
+static int flash_async_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&z_flash_async_workq, flash_async_stack,
+			   K_THREAD_STACK_SIZEOF(flash_async_stack),
+			   CONFIG_FLASH_ASYNC_WORKQUEUE_PRIORITY, NULL);
+	k_thread_name_set(&z_flash_async_workq.thread, "flash_async");
+
+	return 0;
+}
+
+SYS_INIT(flash_async_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -172,9 +172,30 @@ static int flash_range_is_valid(const struct device *dev, off_t offset,
 	return 1;
 }
 
-static int flash_sim_read(const struct device *dev, const off_t offset,
-			  void *data,
-			  const size_t len)
+#ifdef CONFIG_FLASH_ASYNC
+/* Serializes accesses to the mock flash between synchronous operations and
+ * asynchronous ones, which are applied from the flash work queue.
+ */
+static K_MUTEX_DEFINE(flash_sim_lock);
+#endif
+
+static inline void flash_sim_lock_take(void)
+{
+#ifdef CONFIG_FLASH_ASYNC
+	(void)k_mutex_lock(&flash_sim_lock, K_FOREVER);
+#endif
+}
+
+static inline void flash_sim_lock_give(void)
+{
+#ifdef CONFIG_FLASH_ASYNC
+	(void)k_mutex_unlock(&flash_sim_lock);
+#endif
+}
+
+static int flash_sim_do_read(const struct device *dev, const off_t offset,
+			     void *data,
+			     const size_t len)
 {
 	ARG_UNUSED(dev);
 
@@ -194,17 +215,36 @@ static int flash_sim_read(const struct device *dev, const off_t offset,
 	memcpy(data, MOCK_FLASH(offset), len);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_read, len);
 
+	return 0;
+}
+
+static int flash_sim_read(const struct device *dev, const off_t offset,
+			  void *data,
+			  const size_t len)
+{
+	int rc;
+
+	flash_sim_lock_take();
+
+	rc = flash_sim_do_read(dev, offset, data, len);
+	if (rc != 0) {
+		flash_sim_lock_give();
+		return rc;
+	}
+
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
 	FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us,
 		   CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US);
 #endif
 
+	flash_sim_lock_give();
+
 	return 0;
 }
 
-static int flash_sim_write(const struct device *dev, const off_t offset,
-			   const void *data, const size_t len)
+static int flash_sim_do_write(const struct device *dev, const off_t offset,
+			      const void *data, const size_t len)
 {
 	uint8_t buf[FLASH_SIMULATOR_PROG_UNIT];
 	ARG_UNUSED(dev);
@@ -268,6 +308,22 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 
 	FLASH_SIM_STATS_INCN(flash_sim_stats, bytes_written, len);
 
+	return 0;
+}
+
+static int flash_sim_write(const struct device *dev, const off_t offset,
+			   const void *data, const size_t len)
+{
+	int rc;
+
+	flash_sim_lock_take();
+
+	rc = flash_sim_do_write(dev, offset, data, len);
+	if (rc != 0) {
+		flash_sim_lock_give();
+		return rc;
+	}
+
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
 	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
@@ -275,6 +331,8 @@ static int flash_sim_write(const struct device *dev, const off_t offset,
 		   CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US);
 #endif
 
+	flash_sim_lock_give();
+
 	return 0;
 }
 
@@ -288,8 +346,8 @@ static void unit_erase(const uint32_t unit)
 	       FLASH_SIMULATOR_ERASE_UNIT);
 }
 
-static int flash_sim_erase(const struct device *dev, const off_t offset,
-			   const size_t len)
+static int flash_sim_do_erase(const struct device *dev, const off_t offset,
+			      const size_t len)
 {
 	ARG_UNUSED(dev);
 
@@ -322,6 +380,22 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 		unit_erase(unit_start + i);
 	}
 
+	return 0;
+}
+
+static int flash_sim_erase(const struct device *dev, const off_t offset,
+			   const size_t len)
+{
+	int rc;
+
+	flash_sim_lock_take();
+
+	rc = flash_sim_do_erase(dev, offset, len);
+	if (rc != 0) {
+		flash_sim_lock_give();
+		return rc;
+	}
+
 #ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
 	/* wait before returning */
 	k_busy_wait(CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
@@ -329,9 +403,127 @@ static int flash_sim_erase(const struct device *dev, const off_t offset,
 		   CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US);
 #endif
 
+	flash_sim_lock_give();
+
+	return 0;
+}
+
+#ifdef CONFIG_FLASH_ASYNC
+/* Asynchronous operations are executed one at a time in submission order.
+ * Instead of busy waiting, the simulated duration of the operation at the
+ * head of the queue elapses on a timer, after which the operation is
+ * applied to the mock flash and its callback is invoked from the flash
+ * work queue.
+ */
+static sys_slist_t flash_sim_async_queue;
+static struct k_spinlock flash_sim_async_lock;
+static struct k_work_delayable flash_sim_async_work;
+
+static uint32_t flash_sim_async_time_us(const struct flash_async_op *op)
+{
+#ifdef CONFIG_FLASH_SIMULATOR_SIMULATE_TIMING
+	switch (op->type) {
+	case FLASH_ASYNC_OP_READ:
+		return CONFIG_FLASH_SIMULATOR_MIN_READ_TIME_US;
+	case FLASH_ASYNC_OP_WRITE:
+		return CONFIG_FLASH_SIMULATOR_MIN_WRITE_TIME_US * op->buf_count;
+	case FLASH_ASYNC_OP_ERASE:
+		return CONFIG_FLASH_SIMULATOR_MIN_ERASE_TIME_US;
+	default:
+		break;
+	}
+#endif
+
 	return 0;
 }
 
+static int flash_sim_async_exec(const struct flash_async_op *op)
+{
+	off_t offset = op->offset;
+	int rc = 0;
+
+	switch (op->type) {
+	case FLASH_ASYNC_OP_READ:
+		rc = flash_sim_do_read(op->dev, op->offset, op->data, op->len);
+		FLASH_SIM_STATS_INCN(flash_sim_stats, flash_read_time_us,
+				     flash_sim_async_time_us(op));
+		break;
+	case FLASH_ASYNC_OP_WRITE:
+		for (size_t i = 0; (rc == 0) && (i < op->buf_count); i++) {
+			rc = flash_sim_do_write(op->dev, offset,
+						op->bufs[i].data,
+						op->bufs[i].len);
+			offset += op->bufs[i].len;
+		}
+		FLASH_SIM_STATS_INCN(flash_sim_stats, flash_write_time_us,
+				     flash_sim_async_time_us(op));
+		break;
+	case FLASH_ASYNC_OP_ERASE:
+		rc = flash_sim_do_erase(op->dev, op->offset, op->len);
+		FLASH_SIM_STATS_INCN(flash_sim_stats, flash_erase_time_us,
+				     flash_sim_async_time_us(op));
+		break;
+	default:
+		rc = -EINVAL;
+		break;
+	}
+
+	return rc;
+}
+
+static void flash_sim_async_start(const struct flash_async_op *op)
+{
+	k_work_schedule_for_queue(&z_flash_async_workq, &flash_sim_async_work,
+				  K_USEC(flash_sim_async_time_us(op)));
+}
+
+static void flash_sim_async_handler(struct k_work *work)
+{
+	struct flash_async_op *op;
+	struct flash_async_op *next;
+	k_spinlock_key_t key;
+	int rc;
+
+	ARG_UNUSED(work);
+
+	key = k_spin_lock(&flash_sim_async_lock);
+	op = SYS_SLIST_PEEK_HEAD_CONTAINER(&flash_sim_async_queue, op, node);
+	k_spin_unlock(&flash_sim_async_lock, key);
+
+	flash_sim_lock_take();
+	rc = flash_sim_async_exec(op);
+	flash_sim_lock_give();
+
+	key = k_spin_lock(&flash_sim_async_lock);
+	(void)sys_slist_get(&flash_sim_async_queue);
+	next = SYS_SLIST_PEEK_HEAD_CONTAINER(&flash_sim_async_queue, next,
+					     node);
+	if (next != NULL) {
+		flash_sim_async_start(next);
+	}
+	k_spin_unlock(&flash_sim_async_lock, key);
+
+	op->callback(op->dev, op, rc);
+}
+
+static int flash_sim_submit(const struct device *dev,
+			    struct flash_async_op *op)
+{
+	k_spinlock_key_t key;
+
+	op->dev = dev;
+
+	key = k_spin_lock(&flash_sim_async_lock);
+	if (sys_slist_is_empty(&flash_sim_async_queue)) {
+		flash_sim_async_start(op);
+	}
+	sys_slist_append(&flash_sim_async_queue, &op->node);
+	k_spin_unlock(&flash_sim_async_lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 static const struct flash_pages_layout flash_sim_pages_layout = {
 	.pages_count = FLASH_SIMULATOR_PAGE_COUNT,
@@ -363,6 +555,9 @@ static const struct flash_driver_api flash_sim_api = {
 #ifdef CONFIG_FLASH_PAGE_LAYOUT
 	.page_layout = flash_sim_page_layout,
 #endif
+#ifdef CONFIG_FLASH_ASYNC
+	.submit = flash_sim_submit,
+#endif
 };
 
 #ifdef CONFIG_ARCH_POSIX
@@ -432,6 +627,9 @@ static int flash_init(const struct device *dev)
 	FLASH_SIM_STATS_INIT_AND_REG(flash_sim_stats, STATS_SIZE_32, "flash_sim_stats");
 	FLASH_SIM_STATS_INIT_AND_REG(flash_sim_thresholds, STATS_SIZE_32,
 			   "flash_sim_thresholds");
+#ifdef CONFIG_FLASH_ASYNC
+	k_work_init_delayable(&flash_sim_async_work, flash_sim_async_handler);
+#endif
 	return flash_mock_init(dev);
 }
 
@@ -440,6 +440,11 @@ struct device_state {
 	 * invoked.
 	 */
 	bool initialized : 1;
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	/** Indicates a device init thread claimed the device. */
+	bool init_claimed : 1;
+#endif
 };
 
 struct pm_device;
@@ -84,6 +84,9 @@ int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
  * start point is indicated by an offset value.
  *
  * The function is enabled via CONFIG_IMG_ENABLE_IMAGE_CHECK Kconfig options.
+ * With CONFIG_IMG_STREAM_HASH, an image that was just written through @p ctx
+ * is checked against the digest calculated while writing it, instead of
+ * being read back from flash.
  *
  * @param[in] ctx context.
  * @param[in] fic flash img check data.
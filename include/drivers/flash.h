@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <sys/types.h>
 #include <device.h>
+#include <kernel.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -57,6 +58,70 @@ struct flash_parameters {
 	uint8_t erase_value; /* Byte value of erased flash */
 };
 
+#if defined(CONFIG_FLASH_ASYNC)
+/** @brief Asynchronous flash operation types */
+enum flash_async_op_type {
+	FLASH_ASYNC_OP_READ,
+	FLASH_ASYNC_OP_WRITE,
+	FLASH_ASYNC_OP_ERASE,
+};
+
+/**
+ * @brief Scatter-gather descriptor of an asynchronous write
+ *
+ * The buffers of a write are programmed back to back starting at the
+ * offset of the operation. The length of each buffer must be a multiple
+ * of the write block size of the device.
+ */
+struct flash_async_buf {
+	const void *data;
+	size_t len;
+};
+
+struct flash_async_op;
+
+/**
+ * @brief Callback invoked when an asynchronous flash operation completes
+ *
+ * @param dev    Flash device the operation was submitted to.
+ * @param op     The completed operation; it may be resubmitted from here.
+ * @param result 0 on success, negative errno code on fail.
+ */
+typedef void (*flash_async_callback_t)(const struct device *dev,
+				       struct flash_async_op *op,
+				       int result);
+
+/**
+ * @brief Asynchronous flash operation
+ *
+ * The operation and all buffers it references must stay valid until its
+ * callback has been invoked.
+ */
+struct flash_async_op {
+	/** Type of the operation */
+	enum flash_async_op_type type;
+	/** Offset of the operation in the flash device */
+	off_t offset;
+	/** Destination buffer of a read */
+	void *data;
+	/** Number of bytes to read or erase */
+	size_t len;
+	/** Source buffers of a write */
+	const struct flash_async_buf *bufs;
+	/** Number of source buffers of a write */
+	size_t buf_count;
+	/** Completion callback */
+	flash_async_callback_t callback;
+	/** User data, not used by the driver */
+	void *user_data;
+
+	/* Private, used by the driver or the generic implementation */
+	sys_snode_t node;
+	const struct device *dev;
+	struct k_work work;
+};
+#endif /* CONFIG_FLASH_ASYNC */
+
 /**
  * @}
  */
@@ -124,6 +189,17 @@ typedef int (*flash_api_sfdp_read)(const struct device *dev, off_t offset,
 				   void *data, size_t len);
 typedef int (*flash_api_read_jedec_id)(const struct device *dev, uint8_t *id);
 
+#if defined(CONFIG_FLASH_ASYNC)
+/**
+ * @brief Flash asynchronous submit implementation handler type
+ *
+ * Drivers that do not provide this handler get their synchronous API
+ * called from the flash work queue.
+ */
+typedef int (*flash_api_submit)(const struct device *dev,
+				struct flash_async_op *op);
+#endif /* CONFIG_FLASH_ASYNC */
+
 __subsystem struct flash_driver_api {
 	flash_api_read read;
 	flash_api_write write;
@@ -136,6 +212,9 @@ __subsystem struct flash_driver_api {
 	flash_api_sfdp_read sfdp_read;
 	flash_api_read_jedec_id read_jedec_id;
 #endif /* CONFIG_FLASH_JESD216_API */
+#if defined(CONFIG_FLASH_ASYNC)
+	flash_api_submit submit;
+#endif /* CONFIG_FLASH_ASYNC */
 };
 
 /**
@@ -420,6 +499,78 @@ static inline const struct flash_parameters *z_impl_flash_get_parameters(const s
 	return api->get_parameters(dev);
 }
 
+#if defined(CONFIG_FLASH_ASYNC)
+/**
+ * @brief Work queue of the asynchronous flash operations.
+ *
+ * Drivers implementing asynchronous operations natively should complete
+ * them from this queue rather than the system work queue, on which flash
+ * users may be waiting for them.
+ */
+extern struct k_work_q z_flash_async_workq;
+
+/**
+ *  @brief  Execute an asynchronous flash operation through the
+ *          synchronous flash API.
+ *
+ *  Used by the generic asynchronous implementation, drivers should not
+ *  need to call it.
+ *
+ *  @param  dev             : flash device
+ *  @param  op              : operation to execute
+ *
+ *  @return  0 on success, negative errno code on fail.
+ */
+int z_flash_async_exec(const struct device *dev,
+		       const struct flash_async_op *op);
+
+/**
+ *  @brief  Queue an asynchronous flash operation on the flash work queue.
+ *
+ *  Generic implementation of flash_async_submit() for drivers that do
+ *  not implement asynchronous operations natively.
+ *
+ *  @param  dev             : flash device
+ *  @param  op              : operation to submit
+ *
+ *  @return  0 on success, negative errno code on fail.
+ */
+int z_flash_async_submit_generic(const struct device *dev,
+				 struct flash_async_op *op);
+
+/**
+ *  @brief  Submit an asynchronous flash operation.
+ *
+ *  The operation is described by @p op and completes by invoking its
+ *  callback, possibly from another thread. Operations submitted to the
+ *  same device complete in submission order. Drivers that do not
+ *  support asynchronous operations natively execute them with their
+ *  synchronous API on a dedicated work queue.
+ *
+ *  @param  dev             : flash device
+ *  @param  op              : operation to submit
+ *
+ *  @return  0 if the operation was queued, negative errno code on fail,
+ *           in which case the callback is not invoked.
+ */
+static inline int flash_async_submit(const struct device *dev,
+				     struct flash_async_op *op)
+{
+	const struct flash_driver_api *api =
+		(const struct flash_driver_api *)dev->api;
+
+	if (op->callback == NULL) {
+		return -EINVAL;
+	}
+
+	if (api->submit != NULL) {
+		return api->submit(dev, op);
+	}
+
+	return z_flash_async_submit_generic(dev, op);
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
 #ifdef __cplusplus
 }
 #endif
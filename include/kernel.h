@@ -2679,6 +2679,9 @@ struct k_mutex {
 	/** Original thread priority */
 	int owner_orig_prio;
 
+	/** Lock protecting the mutex state */
+	struct k_spinlock lock;
+
 	SYS_PORT_TRACING_TRACKING_FIELD(k_mutex)
 };
 
@@ -2777,6 +2780,7 @@ __syscall int k_mutex_unlock(struct k_mutex *mutex);
 
 struct k_condvar {
 	_wait_q_t wait_q;
+	struct k_spinlock lock;
 };
 
 #define Z_CONDVAR_INITIALIZER(obj)                                             \
@@ -2860,6 +2864,7 @@ struct k_sem {
 	_wait_q_t wait_q;
 	unsigned int count;
 	unsigned int limit;
+	struct k_spinlock lock;
 
 	_POLL_EVENT;
 
@@ -4292,6 +4297,8 @@ struct k_msgq {
 	char *write_ptr;
 	/** Number of used messages */
 	uint32_t used_msgs;
+	/** Number of messages claimed for reading in place */
+	uint32_t claimed_msgs;
 
 	_POLL_EVENT;
 
@@ -4315,6 +4322,7 @@ struct k_msgq {
 	.read_ptr = q_buffer, \
 	.write_ptr = q_buffer, \
 	.used_msgs = 0, \
+	.claimed_msgs = 0, \
 	_POLL_EVENT_OBJ_INIT(obj) \
 	}
 
@@ -4441,6 +4449,33 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages from @a data
+ * to message queue @a msgq with a single lock acquisition. Messages are
+ * handed directly to waiting receivers first, the rest are copied to the
+ * queue's ring buffer until it is full.
+ *
+ * If no message can be sent, the routine waits for up to @a timeout for
+ * room for the first one, like k_msgq_put().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages at @a data.
+ * @param timeout Non-negative waiting period to add the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages sent, at least one, on success.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+__syscall int k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Receive a message from a message queue.
  *
@@ -4460,9 +4495,38 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Messages are claimed by k_msgq_get_claim().
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue
+ * @a msgq in a "first in, first out" manner with a single lock
+ * acquisition. The room freed in the queue is refilled from threads
+ * waiting to send, and all of them are woken up with a single reschedule.
+ *
+ * If the queue is empty, the routine waits for up to @a timeout for one
+ * message, like k_msgq_get().
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold @a num_msgs messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message,
+ *                or one of the special values K_NO_WAIT and
+ *                K_FOREVER.
+ *
+ * @return Number of messages received, at least one, on success.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Messages are claimed by k_msgq_get_claim().
+ */
+__syscall int k_msgq_get_many(struct k_msgq *msgq, void *data,
+			      uint32_t num_msgs, k_timeout_t timeout);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4476,9 +4540,54 @@ __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
  *
  * @retval 0 Message read.
  * @retval -ENOMSG Returned when the queue has no message.
+ * @retval -EBUSY Messages are claimed by k_msgq_get_claim().
  */
 __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
 
+/**
+ * @brief Claim messages of a message queue to read them in place.
+ *
+ * This routine gives access to up to @a max_msgs of the oldest messages
+ * of message queue @a msgq directly in its ring buffer, as many as are
+ * contiguous. The messages stay in the queue until released with
+ * k_msgq_get_finish().
+ *
+ * A single claim can be outstanding at a time. While it is, other
+ * attempts to receive or peek return -EBUSY, so queues read in place
+ * should have a single consumer. Senders are not affected.
+ *
+ * A user mode caller must have read access to the queue's ring buffer.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Set to the address of the first claimed message.
+ * @param max_msgs Maximum number of messages to claim.
+ *
+ * @return Number of messages claimed, at least one, on success.
+ * @retval -ENOMSG Returned when the queue has no message.
+ * @retval -EBUSY Messages are already claimed.
+ */
+__syscall int k_msgq_get_claim(struct k_msgq *msgq, void **data,
+			       uint32_t max_msgs);
+
+/**
+ * @brief Release messages claimed from a message queue.
+ *
+ * This routine removes the first @a num_msgs messages claimed with
+ * k_msgq_get_claim() from message queue @a msgq and ends the claim. The
+ * remaining claimed messages, if any, stay at the head of the queue.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param num_msgs Number of messages to remove.
+ *
+ * @retval 0 Messages removed.
+ * @retval -EINVAL More messages than claimed, or no claim outstanding.
+ */
+__syscall int k_msgq_get_finish(struct k_msgq *msgq, uint32_t num_msgs);
+
 /**
  * @brief Purge a message queue.
  *
@@ -4708,6 +4817,8 @@ struct k_pipe {
 	size_t         bytes_used;      /**< # bytes used in buffer */
 	size_t         read_index;      /**< Where in buffer to read from */
 	size_t         write_index;     /**< Where in buffer to write */
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 	struct k_spinlock lock;		/**< Synchronization lock */
 
 	struct {
@@ -4732,6 +4843,8 @@ struct k_pipe {
 	.bytes_used = 0,                                            \
 	.read_index = 0,                                            \
 	.write_index = 0,                                           \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0,                                           \
 	.lock = {},                                                 \
 	.wait_q = {                                                 \
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
@@ -4823,6 +4936,7 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were written.
+ * @retval -EBUSY The pipe's buffer is claimed by k_pipe_put_claim().
  */
 __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_write, size_t *bytes_written,
@@ -4846,11 +4960,111 @@ __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were read.
+ * @retval -EBUSY The pipe's buffer is claimed by k_pipe_get_claim().
  */
 __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
 			 size_t min_xfer, k_timeout_t timeout);
 
+/**
+ * @brief Claim free space of a pipe's buffer to write data in place.
+ *
+ * This routine gives access to up to @a bytes_to_write bytes of
+ * contiguous free space of the buffer of @a pipe. The data written there
+ * is made available to readers with k_pipe_put_finish().
+ *
+ * A single write claim can be outstanding at a time. While it is,
+ * k_pipe_put() returns -EBUSY, so pipes written in place should have a
+ * single writer. Readers are not affected.
+ *
+ * If the buffer is full, the routine waits for up to @a timeout for
+ * readers to free some space.
+ *
+ * A user mode caller must have write access to the pipe's buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed space.
+ * @param bytes_to_write Maximum number of bytes to claim.
+ * @param bytes_claimed Address of area to hold the number of bytes claimed.
+ * @param timeout Waiting period to wait for free space,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least one byte was claimed.
+ * @retval -EIO Returned without waiting; the pipe's buffer is full or
+ *              the pipe has no buffer.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Space is already claimed.
+ */
+__syscall int k_pipe_put_claim(struct k_pipe *pipe, void **data,
+			       size_t bytes_to_write, size_t *bytes_claimed,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Commit data written in place to a pipe.
+ *
+ * This routine adds the first @a bytes_written bytes claimed with
+ * k_pipe_put_claim() to the data of @a pipe and ends the claim. Waiting
+ * readers whose request is completed by the commit are made ready
+ * together, with a single reschedule.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes_written Number of bytes written in the claimed space.
+ *
+ * @retval 0 Data committed.
+ * @retval -EINVAL More bytes than claimed, or no claim outstanding.
+ */
+__syscall int k_pipe_put_finish(struct k_pipe *pipe, size_t bytes_written);
+
+/**
+ * @brief Claim data of a pipe's buffer to read it in place.
+ *
+ * This routine gives access to up to @a bytes_to_read bytes of
+ * contiguous data of the buffer of @a pipe. The data stays in the pipe
+ * until released with k_pipe_get_finish(). Data of writers waiting for
+ * room in the buffer is only seen once it has been moved to the buffer.
+ *
+ * A single read claim can be outstanding at a time. While it is,
+ * k_pipe_get() returns -EBUSY, so pipes read in place should have a
+ * single reader. Writers are not affected.
+ *
+ * If the buffer is empty, the routine waits for up to @a timeout for
+ * writers to add data.
+ *
+ * A user mode caller must have read access to the pipe's buffer.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Set to the address of the claimed data.
+ * @param bytes_to_read Maximum number of bytes to claim.
+ * @param bytes_claimed Address of area to hold the number of bytes claimed.
+ * @param timeout Waiting period to wait for data,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least one byte was claimed.
+ * @retval -EIO Returned without waiting; the pipe's buffer is empty or
+ *              the pipe has no buffer.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Data is already claimed.
+ */
+__syscall int k_pipe_get_claim(struct k_pipe *pipe, void **data,
+			       size_t bytes_to_read, size_t *bytes_claimed,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Release data read in place from a pipe.
+ *
+ * This routine removes the first @a bytes_read bytes claimed with
+ * k_pipe_get_claim() from @a pipe and ends the claim. The room freed is
+ * refilled from waiting writers, and the writers whose request is
+ * completed are made ready together, with a single reschedule.
+ *
+ * @param pipe Address of the pipe.
+ * @param bytes_read Number of bytes to remove.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL More bytes than claimed, or no claim outstanding.
+ */
+__syscall int k_pipe_get_finish(struct k_pipe *pipe, size_t bytes_read);
+
 /**
  * @brief Query the number of bytes that may be read from @a pipe.
  *
@@ -4878,6 +5092,7 @@ __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
  * both all the data in the pipe's buffer and all the data waiting to go into
  * that pipe into a large temporary buffer and discarding the buffer. Any
  * writers that were previously pended become unpended.
+ * An outstanding read claim is ended.
  *
  * @param pipe Address of the pipe.
  */
@@ -4891,6 +5106,7 @@ __syscall void k_pipe_flush(struct k_pipe *pipe);
  * buffer) into a temporary buffer and then discarding that buffer. If there
  * were writers previously pending, then some may unpend as they try to fill
  * up the pipe's emptied buffer.
+ * An outstanding read claim is ended.
  *
  * @param pipe Address of the pipe.
  */
@@ -30,10 +30,26 @@ extern "C" {
 
 /** @cond INTERNAL_HIDDEN */
 
+struct net_eth_addr;
+
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+struct eth_bridge_fdb_entry {
+	sys_snode_t node;
+	struct net_if *iface;	/* NULL if the entry is unused */
+	int64_t last_seen;	/* Uptime in ms when last learned */
+	uint8_t addr[6];
+	bool is_static;
+};
+#endif
+
 struct eth_bridge {
 	struct k_mutex lock;
 	sys_slist_t interfaces;
 	sys_slist_t listeners;
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	struct eth_bridge_fdb_entry fdb[CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE];
+	sys_slist_t fdb_buckets[CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE];
+#endif
 };
 
 #define ETH_BRIDGE_INITIALIZER(obj) \
@@ -141,6 +157,73 @@ int eth_bridge_listener_add(struct eth_bridge *br, struct eth_bridge_listener *l
  */
 int eth_bridge_listener_remove(struct eth_bridge *br, struct eth_bridge_listener *l);
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB) || defined(__DOXYGEN__)
+/**
+ * @brief Add a static entry to the forwarding database of a bridge
+ *
+ * Unicast packets sent to @p addr are then only transmitted via @p iface.
+ * Static entries do not age out and are not replaced by learning. An
+ * existing entry for the same address is replaced.
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param addr MAC address of the entry
+ * @param iface Bridged interface the address is reachable through
+ *
+ * @return 0 if OK, -ENOMEM if the database is full of static entries,
+ *         negative error code otherwise.
+ */
+int eth_bridge_fdb_add(struct eth_bridge *br, const struct net_eth_addr *addr,
+		       struct net_if *iface);
+
+/**
+ * @brief Remove an entry from the forwarding database of a bridge
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param addr MAC address of the entry to remove
+ *
+ * @return 0 if OK, -ENOENT if there is no entry for the address.
+ */
+int eth_bridge_fdb_del(struct eth_bridge *br, const struct net_eth_addr *addr);
+
+/**
+ * @brief Remove all learned entries from the forwarding database
+ *
+ * Static entries are kept.
+ *
+ * @param br A pointer to an initialized bridge object
+ */
+void eth_bridge_fdb_flush(struct eth_bridge *br);
+
+/**
+ * @typedef eth_bridge_fdb_cb_t
+ * @brief Callback used while iterating over forwarding database entries
+ *
+ * @param br Pointer to bridge instance
+ * @param addr MAC address of the entry
+ * @param iface Interface the address is reachable through
+ * @param age Time in ms since the address was last seen, 0 for static entries
+ * @param is_static Whether the entry is static
+ * @param user_data User supplied data
+ */
+typedef void (*eth_bridge_fdb_cb_t)(struct eth_bridge *br,
+				    const struct net_eth_addr *addr,
+				    struct net_if *iface, uint32_t age,
+				    bool is_static, void *user_data);
+
+/**
+ * @brief Go through the entries in the forwarding database of a bridge
+ *
+ * Aged out entries are skipped. The bridge is locked while iterating, so
+ * the callback must not call other bridge functions.
+ *
+ * @param br A pointer to an initialized bridge object
+ * @param cb Callback to call for each entry
+ * @param user_data User supplied data
+ */
+void eth_bridge_fdb_foreach(struct eth_bridge *br, eth_bridge_fdb_cb_t cb,
+			    void *user_data);
+#endif /* CONFIG_NET_ETHERNET_BRIDGE_FDB */
+
 /**
  * @brief Get bridge index according to pointer
  *
@@ -312,6 +312,14 @@ __net_socket struct net_context {
 #endif
 #if defined(CONFIG_NET_CONTEXT_SNDTIMEO)
 		k_timeout_t sndtimeo;
+#endif
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+		/** Receive buffer size, 0 for the stack default */
+		uint16_t rcvbuf;
+#endif
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+		/** Send buffer size, 0 for no limit */
+		uint16_t sndbuf;
 #endif
 	} options;
 
@@ -1060,6 +1068,8 @@ enum net_context_option {
 	NET_OPT_SOCKS5		= 3,
 	NET_OPT_RCVTIMEO        = 4,
 	NET_OPT_SNDTIMEO        = 5,
+	NET_OPT_RCVBUF		= 6,
+	NET_OPT_SNDBUF		= 7,
 };
 
 /**
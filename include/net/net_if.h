@@ -193,6 +193,11 @@ enum net_if_flag {
 	/** Interface supports IPv6 */
 	NET_IF_IPV6,
 
+	/** Spread the traffic of this interface over the flow queues of
+	 * each traffic class, see CONFIG_NET_TC_FLOW_QUEUES.
+	 */
+	NET_IF_FLOW_HASH,
+
 /** @cond INTERNAL_HIDDEN */
 	/* Total number of flags - must be at the end of the enum */
 	NET_IF_NUM_FLAGS
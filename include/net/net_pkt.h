@@ -118,6 +118,25 @@ struct net_pkt {
 	uint64_t txtime;
 #endif /* CONFIG_NET_PKT_TXTIME */
 
+#if defined(CONFIG_NET_UDP_CHKSUM_COPY)
+	/* Ones' complement sum of the data appended to the packet,
+	 * accumulated while the data is copied into the packet.
+	 */
+	struct {
+		uint16_t start;	/* Offset of the summed data */
+		uint16_t len;	/* Length of the summed data */
+		uint16_t sum;	/* Partial checksum of the data */
+		uint8_t active : 1;
+	} chksum;
+#endif /* CONFIG_NET_UDP_CHKSUM_COPY */
+
+#if defined(CONFIG_NET_TCP_GSO)
+	/* Size of the segments the TCP payload is split into just before
+	 * the packet is passed to L2, 0 if the packet is sent as it is.
+	 */
+	uint16_t gso_size;
+#endif /* CONFIG_NET_TCP_GSO */
+
 	/** Reference counter */
 	atomic_t atomic_ref;
 
@@ -189,6 +208,13 @@ struct net_pkt {
 				 * defined(CONFIG_NET_ETHERNET_BRIDGE).
 				 */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	uint8_t ipv4_reassembled : 1; /* set to 1 if this packet was
+				       * reassembled from IPv4 fragments and
+				       * has no link layer header.
+				       */
+#endif
+
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
 		 * The value is shared between IPv6 and IPv4.
@@ -197,6 +223,11 @@ struct net_pkt {
 		uint8_t ipv4_ttl;
 	};
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	uint16_t ipv4_fragment_flags;	/* Fragment offset and MF (More Fragment) flag */
+	uint16_t ipv4_fragment_id;	/* Fragment id */
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 	union {
 #if defined(CONFIG_NET_IPV4)
 		uint8_t ipv4_opts_len; /* Length if IPv4 Header Options */
@@ -359,6 +390,33 @@ static inline void net_pkt_set_l2_bridged(struct net_pkt *pkt, bool is_l2_bridge
 	}
 }
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+static inline bool net_pkt_is_ipv4_reassembled(struct net_pkt *pkt)
+{
+	return !!(pkt->ipv4_reassembled);
+}
+
+static inline void net_pkt_set_ipv4_reassembled(struct net_pkt *pkt,
+						bool reassembled)
+{
+	pkt->ipv4_reassembled = reassembled;
+}
+#else
+static inline bool net_pkt_is_ipv4_reassembled(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return false;
+}
+
+static inline void net_pkt_set_ipv4_reassembled(struct net_pkt *pkt,
+						bool reassembled)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(reassembled);
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 	return pkt->ip_hdr_len;
@@ -714,6 +772,95 @@ static inline void net_pkt_set_ipv6_fragment_id(struct net_pkt *pkt,
 }
 #endif /* CONFIG_NET_IPV6_FRAGMENT */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
+{
+	return (pkt->ipv4_fragment_flags & NET_IPV4_FRAGH_OFFSET_MASK) * 8U;
+}
+
+static inline bool net_pkt_ipv4_fragment_more(struct net_pkt *pkt)
+{
+	return (pkt->ipv4_fragment_flags & NET_IPV4_MORE_FRAG_MASK) != 0;
+}
+
+static inline void net_pkt_set_ipv4_fragment_flags(struct net_pkt *pkt,
+						   uint16_t flags)
+{
+	pkt->ipv4_fragment_flags = flags;
+}
+
+static inline uint16_t net_pkt_ipv4_fragment_id(struct net_pkt *pkt)
+{
+	return pkt->ipv4_fragment_id;
+}
+
+static inline void net_pkt_set_ipv4_fragment_id(struct net_pkt *pkt,
+						uint16_t id)
+{
+	pkt->ipv4_fragment_id = id;
+}
+#else /* CONFIG_NET_IPV4_FRAGMENT */
+static inline uint16_t net_pkt_ipv4_fragment_offset(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline bool net_pkt_ipv4_fragment_more(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_ipv4_fragment_flags(struct net_pkt *pkt,
+						   uint16_t flags)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(flags);
+}
+
+static inline uint16_t net_pkt_ipv4_fragment_id(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_ipv4_fragment_id(struct net_pkt *pkt,
+						uint16_t id)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(id);
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
+#if defined(CONFIG_NET_TCP_GSO)
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	return pkt->gso_size;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	pkt->gso_size = size;
+}
+#else /* CONFIG_NET_TCP_GSO */
+static inline uint16_t net_pkt_gso_size(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return 0;
+}
+
+static inline void net_pkt_set_gso_size(struct net_pkt *pkt, uint16_t size)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(size);
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static inline uint8_t net_pkt_priority(struct net_pkt *pkt)
 {
 	return pkt->priority;
@@ -1907,6 +2054,24 @@ struct net_pkt *net_pkt_clone(struct net_pkt *pkt, k_timeout_t timeout);
 struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt,
 				      k_timeout_t timeout);
 
+/**
+ * @brief Clone the headers and a part of the payload of a pkt.
+ *
+ * @details The clone contains the first hdr_len bytes of pkt followed
+ *          by len bytes of pkt starting at hdr_len + offset.
+ *
+ * @param pkt Original pkt to be cloned
+ * @param hdr_len Length of the headers to copy
+ * @param offset Offset of the payload part after the headers
+ * @param len Length of the payload part
+ * @param timeout Timeout to wait for free buffer
+ *
+ * @return NULL if error, cloned packet otherwise.
+ */
+struct net_pkt *net_pkt_clone_slice(struct net_pkt *pkt, size_t hdr_len,
+				    size_t offset, size_t len,
+				    k_timeout_t timeout);
+
 /**
  * @brief Read some data from a net_pkt
  *
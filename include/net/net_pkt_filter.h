@@ -48,6 +48,9 @@ struct npf_test {
 struct npf_rule {
 	sys_snode_t node;
 	enum net_verdict result;	/**< result if all tests pass */
+#if defined(CONFIG_NET_PKT_FILTER_STATS)
+	uint32_t hits;			/**< packets given their verdict by this rule */
+#endif
 	uint32_t nb_tests;		/**< number of tests for this rule */
 	struct npf_test *tests[];	/**< pointers to @ref npf_test instances */
 };
@@ -57,10 +60,19 @@ extern struct npf_rule npf_default_ok;
 /** @brief Default rule list termination for rejecting a packet */
 extern struct npf_rule npf_default_drop;
 
+/** @cond INTERNAL_HIDDEN */
+
+struct npf_table;
+
+/** @endcond */
+
 /** @brief rule set for a given test location */
 struct npf_rule_list {
 	sys_slist_t rule_head;
 	struct k_spinlock lock;
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+	struct npf_table *table;	/* compiled form of rule_head */
+#endif
 };
 
 /** @brief  rule list applied to outgoing packets */
@@ -160,6 +172,12 @@ bool npf_remove_all_rules(struct npf_rule_list *rules);
  * the fate of the packet. If one condition is false then the next rule in
  * the list is evaluated.
  *
+ * With CONFIG_NET_PKT_FILTER_COMPILED, the parameters of the built-in
+ * conditions are captured when the rule list is modified, so a condition
+ * must not be changed while its rule is in a list. The contents of the
+ * Ethernet address arrays are the exception: they are still read for
+ * every packet.
+ *
  * @param _name Name for this rule.
  * @param _result Fate of the packet if all conditions are true, either
  *                <tt>NET_OK</tt> or <tt>NET_DROP</tt>.
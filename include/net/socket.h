@@ -873,8 +873,10 @@ struct ifreq {
 /** sockopt: Transmission of broadcast messages is supported (ignored, for compatibility) */
 #define SO_BROADCAST 6
 
-/** sockopt: Size of socket socket send buffer (ignored, for compatibility) */
+/** sockopt: Size of socket send buffer */
 #define SO_SNDBUF 7
+/** sockopt: Size of socket recv buffer */
+#define SO_RCVBUF 8
 
 /** sockopt: Enable sending keep-alive messages on connections (ignored, for compatibility) */
 #define SO_KEEPALIVE 9
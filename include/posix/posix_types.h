@@ -51,10 +51,12 @@ typedef struct k_sem sem_t;
 
 /* Mutex */
 typedef struct pthread_mutex {
-	pthread_t owner;
+	/* Owner thread, low bit set when other threads wait for it */
+	atomic_t owner;
 	uint16_t lock_count;
 	int type;
 	_wait_q_t wait_q;
+	struct k_spinlock lock;
 } pthread_mutex_t;
 
 typedef struct pthread_mutexattr {
@@ -64,6 +66,7 @@ typedef struct pthread_mutexattr {
 /* Condition variables */
 typedef struct pthread_cond {
 	_wait_q_t wait_q;
+	struct k_spinlock lock;
 } pthread_cond_t;
 
 typedef struct pthread_condattr {
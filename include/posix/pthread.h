@@ -88,6 +88,7 @@ static inline int pthread_cond_init(pthread_cond_t *cv,
 {
 	ARG_UNUSED(att);
 	z_waitq_init(&cv->wait_q);
+	cv->lock = (struct k_spinlock) {};
 	return 0;
 }
 
@@ -171,7 +172,7 @@ static inline int pthread_condattr_destroy(pthread_condattr_t *att)
 	{ \
 		.lock_count = 0, \
 		.wait_q = Z_WAIT_Q_INIT(&name.wait_q),	\
-		.owner = NULL, \
+		.owner = 0, \
 	}
 
 /*
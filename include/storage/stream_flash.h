@@ -22,6 +22,9 @@
 
 #include <stdbool.h>
 #include <drivers/flash.h>
+#ifdef CONFIG_STREAM_FLASH_HASH
+#include <tinycrypt/sha256.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,6 +65,16 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_ERASE_AHEAD
+	struct flash_async_op erase_op; /* Erase of the next page */
+	struct k_sem erase_done; /* Given when erase_op completes */
+	int erase_result; /* Result of erase_op */
+	bool erase_pending; /* erase_op has been submitted */
+#endif
+#ifdef CONFIG_STREAM_FLASH_HASH
+	struct tc_sha256_state_struct hash; /* SHA-256 of written data */
+	bool hash_valid; /* hash covers all bytes written */
+#endif
 };
 
 /**
@@ -128,6 +141,24 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
  */
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off);
 
+/**
+ * @brief Get the SHA-256 digest of the data written to flash.
+ *
+ * The digest covers the bytes counted by @ref stream_flash_bytes_written,
+ * so data still held in the write buffer is only included once it has been
+ * flushed. Getting the digest does not affect the stream, writing can
+ * continue afterwards.
+ *
+ * The function is enabled via CONFIG_STREAM_FLASH_HASH Kconfig option.
+ *
+ * @param ctx context
+ * @param hash buffer of TC_SHA256_DIGEST_SIZE bytes to store the digest in
+ *
+ * @return non-negative on success, -ENODATA if the progress was loaded
+ *         without a digest state, negative errno code on other failure
+ */
+int stream_flash_hash_get(struct stream_flash_ctx *ctx, uint8_t *hash);
+
 /**
  * @brief Load persistent stream write progress stored with key
  *        @p settings_key .
@@ -148,6 +179,9 @@ int stream_flash_progress_load(struct stream_flash_ctx *ctx,
 /**
  * @brief Save persistent stream write progress using key @p settings_key .
  *
+ * With CONFIG_STREAM_FLASH_HASH the state of the digest is stored along with
+ * the progress, so that it can be continued after loading the progress.
+ *
  * @param ctx context
  * @param settings_key key to use with the settings module for storing
  *                     the stream write progress
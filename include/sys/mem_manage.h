@@ -105,6 +105,14 @@ struct k_mem_paging_stats_t {
 		/** Number of dirty pages selected for eviction */
 		unsigned long			dirty;
 	} eviction;
+
+	struct {
+		/** Number of page faults that also paged in following pages */
+		unsigned long			cnt;
+
+		/** Number of pages paged in ahead of a page fault */
+		unsigned long			pages;
+	} readahead;
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 };
 
@@ -621,6 +629,31 @@ void k_mem_paging_backing_store_page_out(uintptr_t location);
  */
 void k_mem_paging_backing_store_page_in(uintptr_t location);
 
+/**
+ * Copy several data pages from the provided locations to page frames
+ *
+ * This is used instead of k_mem_paging_backing_store_page_in() when pages
+ * are read ahead of a page fault (see CONFIG_DEMAND_PAGING_READ_AHEAD), so
+ * that the backing store can retrieve them with a single request.
+ *
+ * Z_SCRATCH_PAGE is not mapped to any of the destination page frames
+ * beforehand. Implementations copying through it must map it to each
+ * destination in turn with arch_mem_scratch().
+ *
+ * A default implementation calling k_mem_paging_backing_store_page_in()
+ * for each page is provided.
+ *
+ * Calls to this and k_mem_paging_backing_store_page_out() will always be
+ * serialized, but interrupts may be enabled.
+ *
+ * @param locations Location tokens of the data pages
+ * @param frames Destination page frames
+ * @param count Number of data pages
+ */
+void k_mem_paging_backing_store_page_in_batch(const uintptr_t *locations,
+					      struct z_page_frame **frames,
+					      size_t count);
+
 /**
  * Update internal accounting after a page-in
  *
@@ -644,6 +677,34 @@ void k_mem_paging_backing_store_page_in(uintptr_t location);
 void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
 					      uintptr_t location);
 
+#ifdef CONFIG_BACKING_STORE_COMPRESSED
+/** Statistics of the compressed backing store */
+struct k_mem_paging_backing_store_compressed_stats {
+	/** Number of pages currently stored */
+	size_t pages;
+
+	/** Compressed size of the pages currently stored, in bytes */
+	size_t bytes;
+
+	/** Number of pages paged out */
+	unsigned long page_outs;
+
+	/** Number of pages paged out that were full of zeroes */
+	unsigned long zero_pages;
+
+	/** Number of pages paged out uncompressed, as they didn't compress */
+	unsigned long raw_pages;
+};
+
+/**
+ * Get the statistics of the compressed backing store
+ *
+ * @param[out] stats Statistics struct to be filled.
+ */
+void k_mem_paging_backing_store_compressed_stats_get(
+	struct k_mem_paging_backing_store_compressed_stats *stats);
+#endif /* CONFIG_BACKING_STORE_COMPRESSED */
+
 /**
  * Backing store initialization function.
  *
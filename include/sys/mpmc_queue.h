@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/** @file */
+
+#ifndef ZEPHYR_INCLUDE_SYS_MPMC_QUEUE_H_
+#define ZEPHYR_INCLUDE_SYS_MPMC_QUEUE_H_
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup mpmc_queue_apis Lock-free multi producer, multi consumer queue
+ * @ingroup datastructure_apis
+ *
+ * A bounded queue of fixed-size items that any number of producers and
+ * consumers can use at the same time, from any context and any CPU,
+ * without locking.
+ *
+ * Each slot holds a sequence number telling whether it is free or full for
+ * the current turn of the ring. Producers and consumers reserve a slot by
+ * advancing the enqueue or dequeue position with a compare-and-swap, then
+ * hand it over by updating its sequence number once done with the item.
+ * @{
+ */
+
+/** @cond INTERNAL_HIDDEN */
+struct mpmc_slot {
+	atomic_t seq;
+	uint8_t data[];
+};
+/** @endcond */
+
+/**
+ * @brief Size of the slot of an item, including its sequence number
+ *
+ * @param item_size Size of an item (in bytes).
+ */
+#define MPMC_QUEUE_SLOT_SIZE(item_size) \
+	ROUND_UP(sizeof(struct mpmc_slot) + (item_size), sizeof(atomic_t))
+
+/**
+ * @brief Size of the buffer of a queue
+ *
+ * @param item_size Size of an item (in bytes).
+ * @param capacity Number of items.
+ */
+#define MPMC_QUEUE_BUF_SIZE(item_size, capacity) \
+	(MPMC_QUEUE_SLOT_SIZE(item_size) * (capacity))
+
+/**
+ * @brief A lock-free multi producer, multi consumer queue
+ */
+struct mpmc_queue {
+	uint8_t *buffer;
+	size_t slot_size;
+	/** Number of slots minus one, the number being a power of two */
+	uint32_t mask;
+	/** Position of the next slot to fill */
+	atomic_t enqueue_pos;
+	/** Position of the next slot to empty */
+	atomic_t dequeue_pos;
+};
+
+/**
+ * @brief Initialize a queue.
+ *
+ * @param queue Address of the queue.
+ * @param buffer Storage of MPMC_QUEUE_BUF_SIZE(item_size, capacity) bytes,
+ *		 aligned on atomic_t.
+ * @param item_size Size of an item (in bytes).
+ * @param capacity Number of items, must be a power of two.
+ *
+ * @retval 0 on success.
+ * @retval -EINVAL if @a capacity is not a power of two.
+ */
+int mpmc_queue_init(struct mpmc_queue *queue, void *buffer, size_t item_size,
+		    uint32_t capacity);
+
+/**
+ * @brief Reserve a free slot to write an item in place.
+ *
+ * The item is made available to consumers with
+ * @ref mpmc_queue_put_finish. Producers finishing out of order delay the
+ * consumers of the later items until the earlier ones are finished.
+ *
+ * @param[in]  queue Address of the queue.
+ * @param[out] item Set to the item to write.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if the queue is full.
+ */
+int mpmc_queue_put_claim(struct mpmc_queue *queue, void **item);
+
+/**
+ * @brief Make an item written in place available to consumers.
+ *
+ * @param queue Address of the queue.
+ * @param item Item returned by @ref mpmc_queue_put_claim.
+ */
+void mpmc_queue_put_finish(struct mpmc_queue *queue, void *item);
+
+/**
+ * @brief Copy an item to the queue.
+ *
+ * @param queue Address of the queue.
+ * @param item Item to copy.
+ * @param item_size Size of the item, at most the queue item size.
+ *
+ * @retval 0 on success.
+ * @retval -ENOMEM if the queue is full.
+ */
+int mpmc_queue_put(struct mpmc_queue *queue, const void *item,
+		   size_t item_size);
+
+/**
+ * @brief Reserve the oldest item to read it in place.
+ *
+ * The slot is given back to producers with @ref mpmc_queue_get_finish.
+ *
+ * @param[in]  queue Address of the queue.
+ * @param[out] item Set to the item to read.
+ *
+ * @retval 0 on success.
+ * @retval -EAGAIN if the queue is empty.
+ */
+int mpmc_queue_get_claim(struct mpmc_queue *queue, void **item);
+
+/**
+ * @brief Give the slot of an item read in place back to producers.
+ *
+ * @param queue Address of the queue.
+ * @param item Item returned by @ref mpmc_queue_get_claim.
+ */
+void mpmc_queue_get_finish(struct mpmc_queue *queue, void *item);
+
+/**
+ * @brief Copy the oldest item out of the queue.
+ *
+ * @param queue Address of the queue.
+ * @param item Output buffer.
+ * @param item_size Size of the output buffer, at most the queue item size.
+ *
+ * @retval 0 on success.
+ * @retval -EAGAIN if the queue is empty.
+ */
+int mpmc_queue_get(struct mpmc_queue *queue, void *item, size_t item_size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_MPMC_QUEUE_H_ */
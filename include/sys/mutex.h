@@ -11,9 +11,11 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
- * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
+ * With CONFIG_SYS_MUTEX_FAST_PATH, uncontended sys_mutexes are locked and
+ * unlocked with simple atomic ops instead of syscalls, similar to Linux's
+ * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI: the mutex holds its owner thread, and
+ * the kernel is only entered to wait for the mutex or to hand it over to a
+ * waiter.
  */
 
 #ifdef __cplusplus
@@ -25,14 +27,25 @@ extern "C" {
 #include <zephyr/types.h>
 #include <sys_clock.h>
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+#include <kernel.h>
+#endif
+
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* With CONFIG_SYS_MUTEX_FAST_PATH, owner thread of the mutex or 0,
+	 * plus SYS_MUTEX_CONTENDED once threads wait for it in the kernel.
+	 * Unused otherwise.
 	 */
 	atomic_t val;
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	/* Lock count, only accessed by the owner */
+	uint32_t lock_count;
+#endif
 };
 
+/* The owner holds the kernel mutex and must unlock with a syscall */
+#define SYS_MUTEX_CONTENDED ((atomic_val_t)1)
+
 /**
  * @defgroup user_mutex_apis User mode mutex APIs
  * @ingroup kernel_apis
@@ -101,8 +114,37 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	atomic_val_t self = (atomic_val_t)k_current_get();
+	atomic_val_t owner;
+	int ret;
+
+	if (atomic_cas(&mutex->val, 0, self)) {
+		mutex->lock_count = 1U;
+		return 0;
+	}
+
+	owner = atomic_get(&mutex->val);
+
+	if ((owner & ~SYS_MUTEX_CONTENDED) == self) {
+		mutex->lock_count++;
+		return 0;
+	}
+
+	if (owner != 0 && K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EBUSY;
+	}
+
+	ret = z_sys_mutex_kernel_lock(mutex, timeout);
+	if (ret == 0) {
+		mutex->lock_count = 1U;
+	}
+
+	return ret;
+#else
+	/* Make the syscall unconditionally */
 	return z_sys_mutex_kernel_lock(mutex, timeout);
+#endif
 }
 
 /**
@@ -124,8 +166,33 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	atomic_val_t self = (atomic_val_t)k_current_get();
+	atomic_val_t owner = atomic_get(&mutex->val);
+
+	if (owner == 0) {
+		return -EINVAL;
+	}
+
+	if ((owner & ~SYS_MUTEX_CONTENDED) != self) {
+		return -EPERM;
+	}
+
+	if (mutex->lock_count > 1U) {
+		mutex->lock_count--;
+		return 0;
+	}
+
+	if (atomic_cas(&mutex->val, self, 0)) {
+		return 0;
+	}
+
+	/* Contended: the kernel hands the mutex over to a waiter */
 	return z_sys_mutex_kernel_unlock(mutex);
+#else
+	/* Make the syscall unconditionally */
+	return z_sys_mutex_kernel_unlock(mutex);
+#endif
 }
 
 #include <syscalls/mutex.h>
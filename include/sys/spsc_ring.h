@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+/** @file */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SPSC_RING_H_
+#define ZEPHYR_INCLUDE_SYS_SPSC_RING_H_
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup spsc_ring_apis Lock-free single producer, single consumer ring
+ * @ingroup datastructure_apis
+ *
+ * A byte ring buffer that one producer and one consumer can use at the same
+ * time, from any context and any CPU, without locking. The producer only
+ * writes the head index and the consumer only writes the tail index, each
+ * publishing its progress with a fully ordered atomic store once it is done
+ * with the data.
+ *
+ * Several producers, or several consumers, must still be serialized by the
+ * caller.
+ * @{
+ */
+
+/**
+ * @brief A lock-free single producer, single consumer ring buffer
+ */
+struct spsc_ring {
+	uint8_t *buffer;
+	/** Size of the buffer minus one, the size being a power of two */
+	uint32_t mask;
+	/** Number of bytes ever put, written by the producer only */
+	atomic_t head;
+	/** Number of bytes ever got, written by the consumer only */
+	atomic_t tail;
+};
+
+/**
+ * @brief Define and initialize a lock-free ring buffer.
+ *
+ * @param name Name of the ring buffer.
+ * @param size8 Size of ring buffer (in bytes), must be a power of two.
+ */
+#define SPSC_RING_DEFINE(name, size8) \
+	BUILD_ASSERT(IS_POWER_OF_TWO(size8), \
+		     "SPSC ring size must be a power of two"); \
+	static uint8_t __noinit _spsc_ring_data_##name[size8]; \
+	struct spsc_ring name = { \
+		.buffer = _spsc_ring_data_##name, \
+		.mask = (size8) - 1, \
+	}
+
+/**
+ * @brief Initialize a lock-free ring buffer.
+ *
+ * @param ring Address of ring buffer.
+ * @param size Ring buffer size (in bytes), must be a power of two.
+ * @param data Ring buffer data area (uint8_t data[size]).
+ */
+static inline void spsc_ring_init(struct spsc_ring *ring, uint32_t size,
+				  uint8_t *data)
+{
+	__ASSERT(IS_POWER_OF_TWO(size), "size %u not a power of two", size);
+
+	ring->buffer = data;
+	ring->mask = size - 1;
+	atomic_set(&ring->head, 0);
+	atomic_set(&ring->tail, 0);
+}
+
+/**
+ * @brief Return ring buffer capacity.
+ *
+ * @param ring Address of ring buffer.
+ *
+ * @return Ring buffer capacity (in bytes).
+ */
+static inline uint32_t spsc_ring_capacity_get(struct spsc_ring *ring)
+{
+	return ring->mask + 1;
+}
+
+/**
+ * @brief Determine used space in a ring buffer.
+ *
+ * The value may be stale by the time it is returned if the other side
+ * is active.
+ *
+ * @param ring Address of ring buffer.
+ *
+ * @return Number of bytes in the ring buffer.
+ */
+static inline uint32_t spsc_ring_size_get(struct spsc_ring *ring)
+{
+	return (uint32_t)atomic_get(&ring->head) -
+	       (uint32_t)atomic_get(&ring->tail);
+}
+
+/**
+ * @brief Determine free space in a ring buffer.
+ *
+ * The value may be stale by the time it is returned if the other side
+ * is active.
+ *
+ * @param ring Address of ring buffer.
+ *
+ * @return Ring buffer free space (in bytes).
+ */
+static inline uint32_t spsc_ring_space_get(struct spsc_ring *ring)
+{
+	return spsc_ring_capacity_get(ring) - spsc_ring_size_get(ring);
+}
+
+/**
+ * @brief Claim contiguous free space for writing, without copy.
+ *
+ * Once written, the data is published with @ref spsc_ring_put_finish.
+ * Claims are not cumulative: claiming again before finishing returns the
+ * same area. Producer only.
+ *
+ * @param[in]  ring Address of ring buffer.
+ * @param[out] data Set to the start of the claimed area.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Size of the claimed area, smaller than requested if there is not
+ *	   enough free space or the area would wrap.
+ */
+uint32_t spsc_ring_put_claim(struct spsc_ring *ring, uint8_t **data,
+			     uint32_t size);
+
+/**
+ * @brief Publish bytes written to a claimed area.
+ *
+ * Producer only.
+ *
+ * @param ring Address of ring buffer.
+ * @param size Number of bytes written, at most the claimed size.
+ */
+void spsc_ring_put_finish(struct spsc_ring *ring, uint32_t size);
+
+/**
+ * @brief Write data to a ring buffer.
+ *
+ * Producer only.
+ *
+ * @param ring Address of ring buffer.
+ * @param data Address of data.
+ * @param size Data size (in bytes).
+ *
+ * @return Number of bytes written, smaller than @a size if the ring buffer
+ *	   is too full.
+ */
+uint32_t spsc_ring_put(struct spsc_ring *ring, const uint8_t *data,
+		       uint32_t size);
+
+/**
+ * @brief Claim contiguous data for reading, without copy.
+ *
+ * Once read, the data is released with @ref spsc_ring_get_finish. Claims
+ * are not cumulative: claiming again before finishing returns the same
+ * area. Consumer only.
+ *
+ * @param[in]  ring Address of ring buffer.
+ * @param[out] data Set to the start of the claimed data.
+ * @param[in]  size Requested size (in bytes).
+ *
+ * @return Size of the claimed data, smaller than requested if there is not
+ *	   enough data or the data wraps.
+ */
+uint32_t spsc_ring_get_claim(struct spsc_ring *ring, uint8_t **data,
+			     uint32_t size);
+
+/**
+ * @brief Release bytes read from claimed data.
+ *
+ * Consumer only.
+ *
+ * @param ring Address of ring buffer.
+ * @param size Number of bytes read, at most the claimed size.
+ */
+void spsc_ring_get_finish(struct spsc_ring *ring, uint32_t size);
+
+/**
+ * @brief Read data from a ring buffer.
+ *
+ * Consumer only.
+ *
+ * @param ring Address of ring buffer.
+ * @param data Address of the output buffer.
+ * @param size Size of the output buffer (in bytes).
+ *
+ * @return Number of bytes read.
+ */
+uint32_t spsc_ring_get(struct spsc_ring *ring, uint8_t *data, uint32_t size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_SPSC_RING_H_ */
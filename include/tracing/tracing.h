@@ -1419,6 +1419,70 @@
  */
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
 
+/**
+ * @brief Trace Message Queue put many attempt entry
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue put many attempt blocking
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue put many attempt outcome
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
+
+/**
+ * @brief Trace Message Queue get many attempt entry
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue get many attempt blocking
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)
+
+/**
+ * @brief Trace Message Queue get many attempt outcome
+ * @param msgq Message Queue object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
+
+/**
+ * @brief Trace Message Queue get claim attempt entry
+ * @param msgq Message Queue object
+ */
+#define sys_port_trace_k_msgq_get_claim_enter(msgq)
+
+/**
+ * @brief Trace Message Queue get claim attempt outcome
+ * @param msgq Message Queue object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_get_claim_exit(msgq, ret)
+
+/**
+ * @brief Trace Message Queue get finish
+ * @param msgq Message Queue object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_msgq_get_finish(msgq, ret)
+
 /**
  * @brief Trace Message Queue peek
  * @param msgq Message Queue object
@@ -1633,6 +1697,64 @@
  */
 #define sys_port_trace_k_pipe_get_exit(pipe, timeout, ret)
 
+/**
+ * @brief Trace Pipe put claim attempt entry
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_put_claim_enter(pipe, timeout)
+
+/**
+ * @brief Trace Pipe put claim attempt blocking
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_put_claim_blocking(pipe, timeout)
+
+/**
+ * @brief Trace Pipe put claim attempt outcome
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_put_claim_exit(pipe, timeout, ret)
+
+/**
+ * @brief Trace Pipe put finish
+ * @param pipe Pipe object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_put_finish(pipe, ret)
+
+/**
+ * @brief Trace Pipe get claim attempt entry
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_get_claim_enter(pipe, timeout)
+
+/**
+ * @brief Trace Pipe get claim attempt blocking
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ */
+#define sys_port_trace_k_pipe_get_claim_blocking(pipe, timeout)
+
+/**
+ * @brief Trace Pipe get claim attempt outcome
+ * @param pipe Pipe object
+ * @param timeout Timeout period
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_get_claim_exit(pipe, timeout, ret)
+
+/**
+ * @brief Trace Pipe get finish
+ * @param pipe Pipe object
+ * @param ret Return value
+ */
+#define sys_port_trace_k_pipe_get_finish(pipe, ret)
+
 /**
  * @brief Trace Pipe block put enter
  * @param pipe Pipe object
@@ -11,11 +11,10 @@
 #include <wait_q.h>
 #include <syscall_handler.h>
 
-static struct k_spinlock lock;
-
 int z_impl_k_condvar_init(struct k_condvar *condvar)
 {
 	z_waitq_init(&condvar->wait_q);
+	condvar->lock = (struct k_spinlock) {};
 	z_object_init(condvar);
 
 	SYS_PORT_TRACING_OBJ_INIT(k_condvar, condvar, 0);
@@ -34,7 +33,7 @@ int z_vrfy_k_condvar_init(struct k_condvar *condvar)
 
 int z_impl_k_condvar_signal(struct k_condvar *condvar)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&condvar->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_condvar, signal, condvar);
 
@@ -45,9 +44,9 @@ int z_impl_k_condvar_signal(struct k_condvar *condvar)
 
 		arch_thread_return_value_set(thread, 0);
 		z_ready_thread(thread);
-		z_reschedule(&lock, key);
+		z_reschedule(&condvar->lock, key);
 	} else {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&condvar->lock, key);
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_condvar, signal, condvar, 0);
@@ -70,7 +69,7 @@ int z_impl_k_condvar_broadcast(struct k_condvar *condvar)
 	k_spinlock_key_t key;
 	int woken = 0;
 
-	key = k_spin_lock(&lock);
+	key = k_spin_lock(&condvar->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_condvar, broadcast, condvar);
 
@@ -84,7 +83,7 @@ int z_impl_k_condvar_broadcast(struct k_condvar *condvar)
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_condvar, broadcast, condvar, woken);
 
-	z_reschedule(&lock, key);
+	z_reschedule(&condvar->lock, key);
 
 	return woken;
 }
@@ -105,10 +104,10 @@ int z_impl_k_condvar_wait(struct k_condvar *condvar, struct k_mutex *mutex,
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_condvar, wait, condvar);
 
-	key = k_spin_lock(&lock);
+	key = k_spin_lock(&condvar->lock);
 	k_mutex_unlock(mutex);
 
-	ret = z_pend_curr(&lock, key, &condvar->wait_q, timeout);
+	ret = z_pend_curr(&condvar->lock, key, &condvar->wait_q, timeout);
 	k_mutex_lock(mutex, K_FOREVER);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_condvar, wait, condvar, ret);
@@ -41,6 +41,177 @@ void z_device_state_init(void)
 	}
 }
 
+/* Mark device initialized.  If initialization failed, record the error
+ * condition.
+ */
+static void device_init_done(const struct device *dev, int rc)
+{
+	if (rc != 0) {
+		if (rc < 0) {
+			rc = -rc;
+		}
+		if (rc > UINT8_MAX) {
+			rc = UINT8_MAX;
+		}
+		dev->state->init_res = rc;
+	}
+	dev->state->initialized = true;
+}
+
+static void run_init_entry(const struct init_entry *entry)
+{
+	const struct device *dev = entry->dev;
+	int rc = entry->init(dev);
+
+	if (dev != NULL) {
+		device_init_done(dev, rc);
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+#define INIT_THREADS CONFIG_DEVICE_INIT_PARALLEL_THREADS
+
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks, INIT_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[INIT_THREADS];
+
+/* Protects the batch below and the init_claimed and initialized device
+ * flags, and is signaled every time a device of the batch is initialized.
+ */
+static K_MUTEX_DEFINE(init_lock);
+static K_CONDVAR_DEFINE(init_cond);
+
+/* Batch of consecutive device init entries being run in parallel */
+static const struct init_entry *batch_start;
+static const struct init_entry *batch_end;
+static size_t batch_unclaimed;
+
+static bool in_batch(const struct device *dev)
+{
+	const struct init_entry *entry;
+
+	for (entry = batch_start; entry < batch_end; entry++) {
+		if (entry->dev == dev) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/* Devices required from earlier levels or batches are already initialized,
+ * only wait for the ones of the current batch.
+ */
+static bool requirements_met(const struct device *dev)
+{
+	const device_handle_t *handles;
+	size_t count;
+
+	handles = device_required_handles_get(dev, &count);
+
+	for (size_t i = 0; i < count; i++) {
+		const struct device *rdev = device_from_handle(handles[i]);
+
+		if ((rdev != NULL) && !rdev->state->initialized &&
+		    in_batch(rdev)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static const struct init_entry *claim_init_entry(void)
+{
+	const struct init_entry *entry;
+
+	for (entry = batch_start; entry < batch_end; entry++) {
+		struct device_state *state = entry->dev->state;
+
+		if (!state->init_claimed && requirements_met(entry->dev)) {
+			state->init_claimed = true;
+			batch_unclaimed--;
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void init_thread(void *p1, void *p2, void *p3)
+{
+	const struct init_entry *entry;
+	int rc;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_mutex_lock(&init_lock, K_FOREVER);
+
+	while (batch_unclaimed > 0) {
+		entry = claim_init_entry();
+		if (entry == NULL) {
+			/* Wait for a required device to be initialized */
+			k_condvar_wait(&init_cond, &init_lock, K_FOREVER);
+			continue;
+		}
+
+		k_mutex_unlock(&init_lock);
+		rc = entry->init(entry->dev);
+		k_mutex_lock(&init_lock, K_FOREVER);
+
+		/* Waiters check the initialized flags with the lock held */
+		device_init_done(entry->dev, rc);
+		k_condvar_broadcast(&init_cond);
+	}
+
+	k_mutex_unlock(&init_lock);
+}
+
+/* Run the device init entries [start, end) on the init threads and the
+ * current thread, and return once they have all completed.
+ */
+static void run_init_batch(const struct init_entry *start,
+			   const struct init_entry *end)
+{
+	int nb_threads = MIN(INIT_THREADS, (end - start) - 1);
+	int prio = k_thread_priority_get(k_current_get());
+	int i;
+
+	batch_start = start;
+	batch_end = end;
+	batch_unclaimed = end - start;
+
+	for (i = 0; i < nb_threads; i++) {
+		k_thread_create(&init_threads[i], init_stacks[i],
+				K_THREAD_STACK_SIZEOF(init_stacks[i]),
+				init_thread, NULL, NULL, NULL,
+				prio, 0, K_NO_WAIT);
+		k_thread_name_set(&init_threads[i], "device_init");
+	}
+
+	init_thread(NULL, NULL, NULL);
+
+	for (i = 0; i < nb_threads; i++) {
+		k_thread_join(&init_threads[i], K_FOREVER);
+	}
+}
+
+/* Number of consecutive device init entries starting at @p entry */
+static size_t device_run_length(const struct init_entry *entry,
+				const struct init_entry *end)
+{
+	const struct init_entry *last = entry;
+
+	while ((last < end) && (last->dev != NULL)) {
+		last++;
+	}
+
+	return last - entry;
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the init entry initialization functions at a given level
  *
@@ -50,6 +221,10 @@ void z_device_state_init(void)
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_DEVICE_INIT_PARALLEL, runs of consecutive device entries of
+ * the POST_KERNEL and APPLICATION levels are executed concurrently, in an
+ * order respecting the device dependencies.
+ *
  * @param level init level to run.
  */
 void z_sys_init_run_level(int32_t level)
@@ -68,24 +243,20 @@ void z_sys_init_run_level(int32_t level)
 	const struct init_entry *entry;
 
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
-		const struct device *dev = entry->dev;
-		int rc = entry->init(dev);
-
-		if (dev != NULL) {
-			/* Mark device initialized.  If initialization
-			 * failed, record the error condition.
-			 */
-			if (rc != 0) {
-				if (rc < 0) {
-					rc = -rc;
-				}
-				if (rc > UINT8_MAX) {
-					rc = UINT8_MAX;
-				}
-				dev->state->init_res = rc;
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+		if ((level == _SYS_INIT_LEVEL_POST_KERNEL) ||
+		    (level == _SYS_INIT_LEVEL_APPLICATION)) {
+			size_t count = device_run_length(entry,
+							 levels[level+1]);
+
+			if (count > 1) {
+				run_init_batch(entry, entry + count);
+				entry += count - 1;
+				continue;
 			}
-			dev->state->initialized = true;
 		}
+#endif
+		run_init_entry(entry);
 	}
 }
 
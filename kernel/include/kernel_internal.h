@@ -119,6 +119,17 @@ extern void z_thread_monitor_exit(struct k_thread *thread);
 	} while (false)
 #endif /* CONFIG_THREAD_MONITOR */
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+/* Contended paths of a sys_mutex whose state @a val names the owner
+ * thread, @a mutex being the kernel mutex backing it. See sys/mutex.h.
+ * Locking returns -EINVAL if the state is not a valid one or keeps
+ * changing under it.
+ */
+int z_mutex_lock_owned(struct k_mutex *mutex, atomic_t *val,
+		       k_timeout_t timeout);
+int z_mutex_unlock_owned(struct k_mutex *mutex, atomic_t *val);
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
+
 #ifdef CONFIG_USE_SWITCH
 /* This is a arch function traditionally, but when the switch-based
  * z_swap() is in use it's a simple inline provided by the kernel.
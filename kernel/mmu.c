@@ -1028,15 +1028,15 @@ static void virt_region_foreach(void *addr, size_t size,
  * with a call to k_mem_paging_backing_store_page_out() if it contains
  * a data page.
  *
+ * - If mapped, obtain backing store location and populate location parameter
  * - Map page frame to scratch area if requested. This always is true if we're
  *   doing a page fault, but is only set on manual evictions if the page is
  *   dirty.
- * - If mapped:
- *    - obtain backing store location and populate location parameter
- *    - Update page tables with location
+ * - If mapped, update page tables with location
  * - Mark page frame as busy
  *
- * Returns -ENOMEM if the backing store is full
+ * Returns -ENOMEM if the backing store is full, in which case nothing was
+ * done, not even remapping the scratch page.
  */
 static int page_frame_prepare_locked(struct z_page_frame *pf, bool *dirty_ptr,
 				     bool page_fault, uintptr_t *location_ptr)
@@ -1064,10 +1064,6 @@ static int page_frame_prepare_locked(struct z_page_frame *pf, bool *dirty_ptr,
 		dirty = dirty || !z_page_frame_is_backed(pf);
 	}
 
-	if (dirty || page_fault) {
-		arch_mem_scratch(phys);
-	}
-
 	if (z_page_frame_is_mapped(pf)) {
 		ret = k_mem_paging_backing_store_location_get(pf, location_ptr,
 							      page_fault);
@@ -1075,6 +1071,13 @@ static int page_frame_prepare_locked(struct z_page_frame *pf, bool *dirty_ptr,
 			LOG_ERR("out of backing store memory");
 			return -ENOMEM;
 		}
+	}
+
+	if (dirty || page_fault) {
+		arch_mem_scratch(phys);
+	}
+
+	if (z_page_frame_is_mapped(pf)) {
 		arch_mem_page_out(pf->addr, *location_ptr);
 	} else {
 		/* Shouldn't happen unless this function is mis-used */
@@ -1278,6 +1281,21 @@ static inline void paging_stats_eviction_inc(struct k_thread *faulting_thread,
 #endif /* CONFIG_DEMAND_PAGING_STATS */
 }
 
+static inline void paging_stats_readahead_inc(struct k_thread *faulting_thread,
+					      size_t pages)
+{
+#ifdef CONFIG_DEMAND_PAGING_STATS
+	paging_stats.readahead.cnt++;
+	paging_stats.readahead.pages += pages;
+#ifdef CONFIG_DEMAND_PAGING_THREAD_STATS
+	faulting_thread->paging_stats.readahead.cnt++;
+	faulting_thread->paging_stats.readahead.pages += pages;
+#else
+	ARG_UNUSED(faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_THREAD_STATS */
+#endif /* CONFIG_DEMAND_PAGING_STATS */
+}
+
 static inline struct z_page_frame *do_eviction_select(bool *dirty)
 {
 	struct z_page_frame *pf;
@@ -1312,6 +1330,137 @@ static inline struct z_page_frame *do_eviction_select(bool *dirty)
 	return pf;
 }
 
+__weak void k_mem_paging_backing_store_page_in_batch(const uintptr_t *locations,
+						     struct z_page_frame **frames,
+						     size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		arch_mem_scratch(z_page_frame_to_phys(frames[i]));
+		k_mem_paging_backing_store_page_in(locations[i]);
+	}
+}
+
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+#define CLUSTER_PAGES	(1 + CONFIG_DEMAND_PAGING_READ_AHEAD)
+
+/* Pages paged in by a single page fault, the faulting one first */
+struct page_cluster {
+	size_t count;
+	void *addr[CLUSTER_PAGES];
+	struct z_page_frame *pf[CLUSTER_PAGES];
+	uintptr_t page_in_location[CLUSTER_PAGES];
+	uintptr_t page_out_location[CLUSTER_PAGES];
+	bool dirty[CLUSTER_PAGES];
+};
+
+/* Add the paged out pages following the faulting one to the cluster,
+ * getting a page frame for each of them. Stops at the first page that is
+ * not paged out, or when the backing store can't take the page evicted to
+ * make room for it.
+ *
+ * The page frames of the cluster are marked busy so that they are not
+ * selected for eviction again while the cluster is being built.
+ *
+ * Called with interrupts locked.
+ */
+static void page_cluster_extend(struct page_cluster *cluster,
+				struct k_thread *faulting_thread)
+{
+	uint8_t *addr = cluster->addr[0];
+	struct z_page_frame *pf;
+	uintptr_t location;
+	bool dirty;
+	int ret;
+
+	cluster->pf[0]->flags |= Z_PAGE_FRAME_BUSY;
+
+	while (cluster->count < CLUSTER_PAGES) {
+		addr += CONFIG_MMU_PAGE_SIZE;
+		if (addr >= Z_VIRT_RAM_END ||
+		    arch_page_location_get(addr, &location) !=
+		    ARCH_PAGE_LOCATION_PAGED_OUT) {
+			break;
+		}
+
+		dirty = false;
+		pf = free_page_frame_list_get();
+		if (pf == NULL) {
+			pf = do_eviction_select(&dirty);
+			if (pf == NULL) {
+				break;
+			}
+		}
+
+		/* Not a page fault: keep the backing store location
+		 * reserved for page faults free.
+		 */
+		ret = page_frame_prepare_locked(pf, &dirty, false,
+						&cluster->page_out_location[
+							cluster->count]);
+		if (ret != 0) {
+			/* The backing store is full. Nothing was done to the
+			 * page frame, and the scratch page still maps the one
+			 * of the faulting page.
+			 */
+			break;
+		}
+
+		if (z_page_frame_is_mapped(pf)) {
+			paging_stats_eviction_inc(faulting_thread, dirty);
+		}
+
+		pf->flags |= Z_PAGE_FRAME_BUSY;
+		cluster->addr[cluster->count] = addr;
+		cluster->pf[cluster->count] = pf;
+		cluster->page_in_location[cluster->count] = location;
+		cluster->dirty[cluster->count] = dirty;
+		cluster->count++;
+	}
+
+	if (cluster->count > 1) {
+		paging_stats_readahead_inc(faulting_thread,
+					   cluster->count - 1);
+	}
+}
+
+/* Page out the dirty pages evicted for the read ahead pages, then page in
+ * the whole cluster. The page out of the page evicted for the faulting page
+ * was already done.
+ */
+static void page_cluster_transfer(struct page_cluster *cluster)
+{
+	for (size_t i = 1; i < cluster->count; i++) {
+		if (cluster->dirty[i]) {
+			arch_mem_scratch(z_page_frame_to_phys(cluster->pf[i]));
+			do_backing_store_page_out(
+				cluster->page_out_location[i]);
+		}
+	}
+
+	k_mem_paging_backing_store_page_in_batch(cluster->page_in_location,
+						 cluster->pf, cluster->count);
+}
+
+/* Map the read ahead pages of the cluster. Called with interrupts locked. */
+static void page_cluster_finish(struct page_cluster *cluster)
+{
+	struct z_page_frame *pf;
+
+	cluster->pf[0]->flags &= ~Z_PAGE_FRAME_BUSY;
+
+	for (size_t i = 1; i < cluster->count; i++) {
+		pf = cluster->pf[i];
+		pf->flags &= ~Z_PAGE_FRAME_BUSY;
+		pf->flags |= Z_PAGE_FRAME_MAPPED;
+		pf->addr = cluster->addr[i];
+
+		arch_mem_page_in(pf->addr, z_page_frame_to_phys(pf));
+		k_mem_paging_backing_store_page_finalize(
+			pf, cluster->page_in_location[i]);
+	}
+}
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+
 static bool do_page_fault(void *addr, bool pin)
 {
 	struct z_page_frame *pf;
@@ -1321,6 +1470,9 @@ static bool do_page_fault(void *addr, bool pin)
 	bool result;
 	bool dirty = false;
 	struct k_thread *faulting_thread = _current_cpu->current;
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	struct page_cluster cluster;
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
 
 	__ASSERT(page_frames_initialized, "page fault at %p happened too early",
 		 addr);
@@ -1406,6 +1558,15 @@ static bool do_page_fault(void *addr, bool pin)
 	ret = page_frame_prepare_locked(pf, &dirty, true, &page_out_location);
 	__ASSERT(ret == 0, "failed to prepare page frame");
 
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	cluster.count = 1;
+	cluster.addr[0] = UINT_TO_POINTER(POINTER_TO_UINT(addr)
+					  & ~(CONFIG_MMU_PAGE_SIZE - 1));
+	cluster.pf[0] = pf;
+	cluster.page_in_location[0] = page_in_location;
+	page_cluster_extend(&cluster, faulting_thread);
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	irq_unlock(key);
 	/* Interrupts are now unlocked if they were not locked when we entered
@@ -1413,15 +1574,38 @@ static bool do_page_fault(void *addr, bool pin)
 	 * locked.
 	 */
 #endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
-	if (dirty) {
-		do_backing_store_page_out(page_out_location);
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	if (cluster.count > 1) {
+		/* The scratch page was remapped while extending the
+		 * cluster
+		 */
+		if (dirty) {
+			arch_mem_scratch(z_page_frame_to_phys(pf));
+			do_backing_store_page_out(page_out_location);
+		}
+		page_cluster_transfer(&cluster);
+	} else
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+	{
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+		/* Don't rely on page_cluster_extend() leaving the scratch
+		 * page alone when it fails to add any page.
+		 */
+		arch_mem_scratch(z_page_frame_to_phys(pf));
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
+		if (dirty) {
+			do_backing_store_page_out(page_out_location);
+		}
+		do_backing_store_page_in(page_in_location);
 	}
-	do_backing_store_page_in(page_in_location);
 
 #ifdef CONFIG_DEMAND_PAGING_ALLOW_IRQ
 	key = irq_lock();
 	pf->flags &= ~Z_PAGE_FRAME_BUSY;
 #endif /* CONFIG_DEMAND_PAGING_ALLOW_IRQ */
+#if CONFIG_DEMAND_PAGING_READ_AHEAD > 0
+	page_cluster_finish(&cluster);
+#endif /* CONFIG_DEMAND_PAGING_READ_AHEAD > 0 */
 	if (pin) {
 		pf->flags |= Z_PAGE_FRAME_PINNED;
 	}
@@ -32,6 +32,68 @@ static inline void handle_poll_events(struct k_msgq *msgq, uint32_t state)
 }
 #endif /* CONFIG_POLL */
 
+static inline char *msgq_advance(struct k_msgq *msgq, char *ptr, size_t size)
+{
+	ptr += size;
+	if (ptr >= msgq->buffer_end) {
+		ptr -= msgq->buffer_end - msgq->buffer_start;
+	}
+
+	return ptr;
+}
+
+/* Copy messages to the ring buffer, in at most two chunks */
+static void msgq_write(struct k_msgq *msgq, const char *data,
+		       uint32_t num_msgs)
+{
+	size_t size = num_msgs * msgq->msg_size;
+	size_t chunk = MIN(size, (size_t)(msgq->buffer_end - msgq->write_ptr));
+
+	(void)memcpy(msgq->write_ptr, data, chunk);
+	if (chunk < size) {
+		(void)memcpy(msgq->buffer_start, data + chunk, size - chunk);
+	}
+	msgq->write_ptr = msgq_advance(msgq, msgq->write_ptr, size);
+	msgq->used_msgs += num_msgs;
+}
+
+/* Copy messages out of the ring buffer, in at most two chunks */
+static void msgq_read(struct k_msgq *msgq, char *data, uint32_t num_msgs)
+{
+	size_t size = num_msgs * msgq->msg_size;
+	size_t chunk = MIN(size, (size_t)(msgq->buffer_end - msgq->read_ptr));
+
+	(void)memcpy(data, msgq->read_ptr, chunk);
+	if (chunk < size) {
+		(void)memcpy(data + chunk, msgq->buffer_start, size - chunk);
+	}
+	msgq->read_ptr = msgq_advance(msgq, msgq->read_ptr, size);
+	msgq->used_msgs -= num_msgs;
+}
+
+/* Add the messages of threads waiting to send to the room freed by a
+ * receiver, and make these threads ready. Returns true if any was.
+ */
+static bool msgq_refill(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread;
+	bool woken = false;
+
+	while (msgq->used_msgs < msgq->max_msgs) {
+		pending_thread = z_unpend_first_thread(&msgq->wait_q);
+		if (pending_thread == NULL) {
+			break;
+		}
+
+		msgq_write(msgq, pending_thread->base.swap_data, 1U);
+		arch_thread_return_value_set(pending_thread, 0);
+		z_ready_thread(pending_thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
 void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 		 uint32_t max_msgs)
 {
@@ -42,6 +104,7 @@ void k_msgq_init(struct k_msgq *msgq, char *buffer, size_t msg_size,
 	msgq->read_ptr = buffer;
 	msgq->write_ptr = buffer;
 	msgq->used_msgs = 0;
+	msgq->claimed_msgs = 0;
 	msgq->flags = 0;
 	z_waitq_init(&msgq->wait_q);
 	msgq->lock = (struct k_spinlock) {};
@@ -185,6 +248,98 @@ static inline int z_vrfy_k_msgq_put(struct k_msgq *msgq, const void *data,
 #include <syscalls/k_msgq_put_mrsh.c>
 #endif
 
+int z_impl_k_msgq_put_many(struct k_msgq *msgq, const void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	struct k_thread *pending_thread;
+	const char *msg = data;
+	k_spinlock_key_t key;
+	bool woken = false;
+	uint32_t count = 0U;
+	uint32_t num;
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put_many, msgq, timeout);
+
+	if (num_msgs == 0U) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, 0);
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->used_msgs < msgq->max_msgs) {
+		/* give messages to waiting threads first */
+		while (count < num_msgs) {
+			pending_thread = z_unpend_first_thread(&msgq->wait_q);
+			if (pending_thread == NULL) {
+				break;
+			}
+
+			(void)memcpy(pending_thread->base.swap_data, msg,
+				     msgq->msg_size);
+			arch_thread_return_value_set(pending_thread, 0);
+			z_ready_thread(pending_thread);
+			woken = true;
+			msg += msgq->msg_size;
+			count++;
+		}
+
+		/* put the others in queue */
+		num = MIN(num_msgs - count, msgq->max_msgs - msgq->used_msgs);
+		if (num > 0U) {
+			msgq_write(msgq, msg, num);
+			count += num;
+#ifdef CONFIG_POLL
+			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+		}
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for message space to become available */
+		k_spin_unlock(&msgq->lock, key);
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout,
+					       -ENOMSG);
+		return -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, put_many, msgq,
+						   timeout);
+
+		/* wait for the first message to be sent, like k_msgq_put() */
+		_current->base.swap_data = (void *) data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = (result == 0) ? 1 : result;
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout,
+					       result);
+		return result;
+	}
+
+	if (woken) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put_many, msgq, timeout, count);
+
+	return count;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_many(struct k_msgq *msgq,
+					 const void *data, uint32_t num_msgs,
+					 k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_READ(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_put_many(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_put_many_mrsh.c>
+#endif
+
 void z_impl_k_msgq_get_attrs(struct k_msgq *msgq, struct k_msgq_attrs *attrs)
 {
 	attrs->msg_size = msgq->msg_size;
@@ -215,7 +370,10 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
 
-	if (msgq->used_msgs > 0U) {
+	if (msgq->claimed_msgs != 0U) {
+		/* messages are being read in place */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
 		msgq->read_ptr += msgq->msg_size;
@@ -281,6 +439,76 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+int z_impl_k_msgq_get_many(struct k_msgq *msgq, void *data,
+			   uint32_t num_msgs, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key;
+	uint32_t count;
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_many, msgq, timeout);
+
+	if (num_msgs == 0U) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, 0);
+		return 0;
+	}
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->claimed_msgs != 0U) {
+		/* messages are being read in place */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
+		count = MIN(num_msgs, msgq->used_msgs);
+		msgq_read(msgq, data, count);
+
+		/* handle all the threads waiting to write (if any) */
+		if (msgq_refill(msgq)) {
+			z_reschedule(&msgq->lock, key);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq,
+						       timeout, count);
+			return count;
+		}
+		result = count;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		/* don't wait for a message to become available */
+		result = -ENOMSG;
+	} else {
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get_many, msgq,
+						   timeout);
+
+		/* wait for the first message, like k_msgq_get() */
+		_current->base.swap_data = data;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+		result = (result == 0) ? 1 : result;
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout,
+					       result);
+		return result;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_many, msgq, timeout, result);
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_many(struct k_msgq *msgq, void *data,
+					 uint32_t num_msgs,
+					 k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(data, num_msgs, msgq->msg_size));
+
+	return z_impl_k_msgq_get_many(msgq, data, num_msgs, timeout);
+}
+#include <syscalls/k_msgq_get_many_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -288,7 +516,10 @@ int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 
 	key = k_spin_lock(&msgq->lock);
 
-	if (msgq->used_msgs > 0U) {
+	if (msgq->claimed_msgs != 0U) {
+		/* messages are being read in place */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
 		result = 0;
@@ -315,6 +546,92 @@ static inline int z_vrfy_k_msgq_peek(struct k_msgq *msgq, void *data)
 #include <syscalls/k_msgq_peek_mrsh.c>
 #endif
 
+int z_impl_k_msgq_get_claim(struct k_msgq *msgq, void **data,
+			    uint32_t max_msgs)
+{
+	k_spinlock_key_t key;
+	uint32_t contiguous;
+	int result;
+
+	key = k_spin_lock(&msgq->lock);
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get_claim, msgq);
+
+	if (msgq->claimed_msgs != 0U) {
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
+		contiguous = (msgq->buffer_end - msgq->read_ptr) /
+			     msgq->msg_size;
+		msgq->claimed_msgs = MIN(MIN(max_msgs, msgq->used_msgs),
+					 contiguous);
+		*data = msgq->read_ptr;
+		result = msgq->claimed_msgs;
+	} else {
+		result = -ENOMSG;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get_claim, msgq, result);
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_claim(struct k_msgq *msgq, void **data,
+					  uint32_t max_msgs)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	/* the messages are handed out in place */
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(msgq->buffer_start,
+				     msgq->buffer_end - msgq->buffer_start));
+
+	return z_impl_k_msgq_get_claim(msgq, data, max_msgs);
+}
+#include <syscalls/k_msgq_get_claim_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_finish(struct k_msgq *msgq, uint32_t num_msgs)
+{
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&msgq->lock);
+
+	if (msgq->claimed_msgs == 0U || num_msgs > msgq->claimed_msgs) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_msgq, get_finish, msgq, -EINVAL);
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->read_ptr = msgq_advance(msgq, msgq->read_ptr,
+				      num_msgs * msgq->msg_size);
+	msgq->used_msgs -= num_msgs;
+	msgq->claimed_msgs = 0U;
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_msgq, get_finish, msgq, 0);
+
+	/* handle all the threads waiting to write (if any) */
+	if (msgq_refill(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_finish(struct k_msgq *msgq,
+					   uint32_t num_msgs)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_get_finish(msgq, num_msgs);
+}
+#include <syscalls/k_msgq_get_finish_mrsh.c>
+#endif
+
 void z_impl_k_msgq_purge(struct k_msgq *msgq)
 {
 	k_spinlock_key_t key;
@@ -331,6 +648,7 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 	}
 
 	msgq->used_msgs = 0;
+	msgq->claimed_msgs = 0;
 	msgq->read_ptr = msgq->write_ptr;
 
 	z_reschedule(&msgq->lock, key);
@@ -36,20 +36,24 @@
 #include <syscall_handler.h>
 #include <tracing/tracing.h>
 #include <sys/check.h>
+#include <sys/mutex.h>
 #include <logging/log.h>
 LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
 
-/* We use a global spinlock here because some of the synchronization
- * is protecting things like owner thread priorities which aren't
- * "part of" a single k_mutex.  Should move those bits of the API
- * under the scheduler lock so we can break this up.
+/* Each mutex state is protected by its own spinlock.  Priority
+ * inheritance changes owner thread priorities, which aren't "part of"
+ * a single k_mutex, so those updates are serialized across all the
+ * mutexes by a global lock.  It is nested inside the mutex lock and
+ * only taken on the contended paths, or when releasing a mutex whose
+ * owner had its priority changed.
  */
-static struct k_spinlock lock;
+static struct k_spinlock prio_lock;
 
 int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
 	mutex->lock_count = 0U;
+	mutex->lock = (struct k_spinlock) {};
 
 	z_waitq_init(&mutex->wait_q);
 
@@ -92,18 +96,14 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
-int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+/* Lock @a mutex, called with its spinlock held through @a key */
+static int mutex_lock(struct k_mutex *mutex, k_spinlock_key_t key,
+		      k_timeout_t timeout)
 {
 	int new_prio;
-	k_spinlock_key_t key;
+	k_spinlock_key_t prio_key;
 	bool resched = false;
 
-	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
-
-	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
-
-	key = k_spin_lock(&lock);
-
 	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
 		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
@@ -117,7 +117,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 			_current, mutex, mutex->lock_count,
 			mutex->owner_orig_prio);
 
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&mutex->lock, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
 
@@ -125,7 +125,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	}
 
 	if (unlikely(K_TIMEOUT_EQ(timeout, K_NO_WAIT))) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&mutex->lock, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EBUSY);
 
@@ -134,6 +134,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
+	prio_key = k_spin_lock(&prio_lock);
+
 	new_prio = new_prio_for_inheritance(_current->base.prio,
 					    mutex->owner->base.prio);
 
@@ -143,7 +145,9 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		resched = adjust_owner_prio(mutex, new_prio);
 	}
 
-	int got_mutex = z_pend_curr(&lock, key, &mutex->wait_q, timeout);
+	k_spin_unlock(&prio_lock, prio_key);
+
+	int got_mutex = z_pend_curr(&mutex->lock, key, &mutex->wait_q, timeout);
 
 	LOG_DBG("on mutex %p got_mutex value: %d", mutex, got_mutex);
 
@@ -159,7 +163,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	LOG_DBG("%p timeout on mutex %p", _current, mutex);
 
-	key = k_spin_lock(&lock);
+	key = k_spin_lock(&mutex->lock);
+	prio_key = k_spin_lock(&prio_lock);
 
 	struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
 
@@ -171,10 +176,12 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	resched = adjust_owner_prio(mutex, new_prio) || resched;
 
+	k_spin_unlock(&prio_lock, prio_key);
+
 	if (resched) {
-		z_reschedule(&lock, key);
+		z_reschedule(&mutex->lock, key);
 	} else {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&mutex->lock, key);
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EAGAIN);
@@ -182,6 +189,15 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	return -EAGAIN;
 }
 
+int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+
+	return mutex_lock(mutex, k_spin_lock(&mutex->lock), timeout);
+}
+
 #ifdef CONFIG_USERSPACE
 static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 				      k_timeout_t timeout)
@@ -192,10 +208,58 @@ static inline int z_vrfy_k_mutex_lock(struct k_mutex *mutex,
 #include <syscalls/k_mutex_lock_mrsh.c>
 #endif
 
-int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+/*
+ * Release @a mutex, called with its spinlock held through @a key and the
+ * scheduler locked. @a val is the state of the sys_mutex backed by
+ * @a mutex if any, it is updated to match the new owner.
+ */
+static void mutex_release(struct k_mutex *mutex, k_spinlock_key_t key,
+			  atomic_t *val)
 {
 	struct k_thread *new_owner;
 
+	if (mutex->owner->base.prio != mutex->owner_orig_prio) {
+		k_spinlock_key_t prio_key = k_spin_lock(&prio_lock);
+
+		adjust_owner_prio(mutex, mutex->owner_orig_prio);
+		k_spin_unlock(&prio_lock, prio_key);
+	}
+
+	/* Get the new owner, if any */
+	new_owner = z_unpend_first_thread(&mutex->wait_q);
+
+	mutex->owner = new_owner;
+
+	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
+		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	if (val != NULL) {
+		atomic_set(val, (new_owner != NULL) ?
+			   ((atomic_val_t)new_owner | SYS_MUTEX_CONTENDED) : 0);
+	}
+#else
+	ARG_UNUSED(val);
+#endif
+
+	if (new_owner != NULL) {
+		/*
+		 * new owner is already of higher or equal prio than first
+		 * waiter since the wait queue is priority-based: no need to
+		 * ajust its priority
+		 */
+		mutex->owner_orig_prio = new_owner->base.prio;
+		arch_thread_return_value_set(new_owner, 0);
+		z_ready_thread(new_owner);
+		z_reschedule(&mutex->lock, key);
+	} else {
+		mutex->lock_count = 0U;
+		k_spin_unlock(&mutex->lock, key);
+	}
+}
+
+int z_impl_k_mutex_unlock(struct k_mutex *mutex)
+{
 	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, unlock, mutex);
@@ -235,33 +299,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		goto k_mutex_unlock_return;
 	}
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
-
-	adjust_owner_prio(mutex, mutex->owner_orig_prio);
-
-	/* Get the new owner, if any */
-	new_owner = z_unpend_first_thread(&mutex->wait_q);
-
-	mutex->owner = new_owner;
-
-	LOG_DBG("new owner of mutex %p: %p (prio: %d)",
-		mutex, new_owner, new_owner ? new_owner->base.prio : -1000);
-
-	if (new_owner != NULL) {
-		/*
-		 * new owner is already of higher or equal prio than first
-		 * waiter since the wait queue is priority-based: no need to
-		 * ajust its priority
-		 */
-		mutex->owner_orig_prio = new_owner->base.prio;
-		arch_thread_return_value_set(new_owner, 0);
-		z_ready_thread(new_owner);
-		z_reschedule(&lock, key);
-	} else {
-		mutex->lock_count = 0U;
-		k_spin_unlock(&lock, key);
-	}
-
+	mutex_release(mutex, k_spin_lock(&mutex->lock), NULL);
 
 k_mutex_unlock_return:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, unlock, mutex, 0);
@@ -279,3 +317,131 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 }
 #include <syscalls/k_mutex_unlock_mrsh.c>
 #endif
+
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+static bool is_thread(atomic_val_t owner)
+{
+	struct z_object *ko = z_object_find((void *)owner);
+
+	return (ko != NULL) && (ko->type == K_OBJ_THREAD) &&
+	       ((ko->flags & K_OBJ_FLAG_INITIALIZED) != 0U);
+}
+
+/* Attempts at updating the state of a sys_mutex before giving up. The
+ * state lives in user memory, where other threads can keep changing it
+ * behind our back: don't spin on it with the spinlock held.
+ */
+#define SYS_MUTEX_CAS_RETRIES 8
+
+int z_mutex_lock_owned(struct k_mutex *mutex, atomic_t *val,
+		       k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	atomic_val_t owner;
+	int retries;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, lock, mutex, timeout);
+
+	key = k_spin_lock(&mutex->lock);
+
+	for (retries = 0; ; retries++) {
+		if (retries == SYS_MUTEX_CAS_RETRIES) {
+			k_spin_unlock(&mutex->lock, key);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex,
+						       timeout, -EINVAL);
+			return -EINVAL;
+		}
+
+		owner = atomic_get(val);
+
+		if (owner == 0) {
+			if (atomic_cas(val, 0, (atomic_val_t)_current)) {
+				k_spin_unlock(&mutex->lock, key);
+				SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex,
+							       timeout, 0);
+				return 0;
+			}
+			continue;
+		}
+
+		if ((owner & SYS_MUTEX_CONTENDED) != 0) {
+			/* The owner already holds the kernel mutex */
+			break;
+		}
+
+		/* The state lives in user memory: only trust it to point
+		 * to a thread once checked against the kernel objects.
+		 */
+		if (!is_thread(owner)) {
+			k_spin_unlock(&mutex->lock, key);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex,
+						       timeout, -EINVAL);
+			return -EINVAL;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&mutex->lock, key);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex,
+						       timeout, -EBUSY);
+			return -EBUSY;
+		}
+
+		if (atomic_cas(val, owner, owner | SYS_MUTEX_CONTENDED)) {
+			/* Lock the kernel mutex on behalf of the thread that
+			 * took the sys_mutex without a system call, so that
+			 * the waiters boost its priority.
+			 */
+			mutex->owner = (struct k_thread *)owner;
+			mutex->lock_count = 1U;
+			mutex->owner_orig_prio = mutex->owner->base.prio;
+			break;
+		}
+	}
+
+	return mutex_lock(mutex, key, timeout);
+}
+
+int z_mutex_unlock_owned(struct k_mutex *mutex, atomic_t *val)
+{
+	k_spinlock_key_t key;
+	atomic_val_t owner;
+	int ret = 0;
+
+	__ASSERT(!arch_is_in_isr(), "mutexes cannot be used inside ISRs");
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mutex, unlock, mutex);
+
+	z_sched_lock();
+
+	key = k_spin_lock(&mutex->lock);
+	owner = atomic_get(val);
+
+	if (owner == 0) {
+		ret = -EINVAL;
+	} else if ((owner & ~SYS_MUTEX_CONTENDED) != (atomic_val_t)_current) {
+		ret = -EPERM;
+	} else if ((owner & SYS_MUTEX_CONTENDED) != 0) {
+		if (mutex->owner != _current) {
+			/* State corrupted from user mode */
+			ret = -EINVAL;
+		} else {
+			mutex_release(mutex, key, val);
+			goto out;
+		}
+	} else {
+		/* Not contended: only the owner changes the state */
+		atomic_set(val, 0);
+	}
+
+	k_spin_unlock(&mutex->lock, key);
+
+out:
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, unlock, mutex, ret);
+
+	k_sched_unlock();
+
+	return ret;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST_PATH */
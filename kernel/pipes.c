@@ -38,6 +38,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	pipe->bytes_used = 0;
 	pipe->read_index = 0;
 	pipe->write_index = 0;
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
 	pipe->lock = (struct k_spinlock){};
 	z_waitq_init(&pipe->wait_q.writers);
 	z_waitq_init(&pipe->wait_q.readers);
@@ -91,6 +93,7 @@ void z_impl_k_pipe_flush(struct k_pipe *pipe)
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	pipe->get_claimed = 0;
 	(void) pipe_get_internal(key, pipe, NULL, (size_t) -1, &bytes_read, 0,
 				 K_NO_WAIT);
 
@@ -115,6 +118,7 @@ void z_impl_k_pipe_buffer_flush(struct k_pipe *pipe)
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	pipe->get_claimed = 0;
 	if (pipe->buffer != NULL) {
 		(void) pipe_get_internal(key, pipe, NULL, pipe->size,
 					 &bytes_read, 0, K_NO_WAIT);
@@ -160,6 +164,8 @@ int k_pipe_cleanup(struct k_pipe *pipe)
 		pipe->bytes_used = 0;
 		pipe->read_index = 0;
 		pipe->write_index = 0;
+		pipe->put_claimed = 0;
+		pipe->get_claimed = 0;
 		pipe->flags &= ~K_PIPE_FLAG_ALLOC;
 	}
 
@@ -412,6 +418,16 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if (pipe->put_claimed != 0U) {
+		/* data would be added behind the space being written in place */
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -735,6 +751,17 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if (pipe->get_claimed != 0U) {
+		/* the data at the head of the pipe is being read in place */
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe,
+					       timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	int ret = pipe_get_internal(key, pipe, data, bytes_to_read, bytes_read,
 				    min_xfer, timeout);
 
@@ -758,6 +785,358 @@ int z_vrfy_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 #include <syscalls/k_pipe_get_mrsh.c>
 #endif
 
+/**
+ * @brief Wait for the other side of a pipe to transfer data
+ *
+ * The current thread is queued with an empty request, which any transfer
+ * from the other side of the pipe completes. It is thus made ready
+ * without any data being copied to or from it, and can retry its claim.
+ *
+ * @return 0 once woken up, -EAGAIN if the waiting period is over
+ */
+static int pipe_claim_wait(struct k_pipe *pipe, k_spinlock_key_t key,
+			   _wait_q_t *wait_q, k_timeout_t timeout, int64_t end)
+{
+	struct k_pipe_desc pipe_desc = { .buffer = NULL, .bytes_to_xfer = 0 };
+	int64_t now;
+
+	if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		now = sys_clock_tick_get();
+		if ((end - now) <= 0) {
+			k_spin_unlock(&pipe->lock, key);
+			return -EAGAIN;
+		}
+		timeout = K_TICKS(end - now);
+	}
+
+	_current->base.swap_data = &pipe_desc;
+	(void)z_pend_curr(&pipe->lock, key, wait_q, timeout);
+
+	return 0;
+}
+
+/**
+ * @brief Copy data from the pipe's circular buffer to waiting readers
+ *
+ * Readers whose request is complete are made ready, the first one that
+ * is not keeps waiting with the data copied so far.
+ *
+ * @return true if any reader was made ready
+ */
+static bool pipe_readers_fill(struct k_pipe *pipe)
+{
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	size_t              bytes_copied;
+	bool                woken = false;
+
+	while ((thread = z_waitq_head(&pipe->wait_q.readers)) != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0U) {
+			/* The pipe's buffer is empty */
+			break;
+		}
+
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
+/**
+ * @brief Copy data from waiting writers to the pipe's circular buffer
+ *
+ * Writers whose request is complete are made ready, the first one that
+ * is not keeps waiting with the data left to write.
+ *
+ * @return true if any writer was made ready
+ */
+static bool pipe_writers_drain(struct k_pipe *pipe)
+{
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	size_t              bytes_copied;
+	bool                woken = false;
+
+	while ((thread = z_waitq_head(&pipe->wait_q.writers)) != NULL) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0U) {
+			/* The pipe's buffer is full */
+			break;
+		}
+
+		z_unpend_thread(thread);
+		z_ready_thread(thread);
+		woken = true;
+	}
+
+	return woken;
+}
+
+int z_impl_k_pipe_put_claim(struct k_pipe *pipe, void **data,
+			    size_t bytes_to_write, size_t *bytes_claimed,
+			    k_timeout_t timeout)
+{
+	int64_t end = sys_clock_timeout_end_calc(timeout);
+	size_t num_bytes;
+	int ret;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, put_claim, pipe, timeout);
+
+	CHECKIF((bytes_to_write == 0U) || bytes_claimed == NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put_claim, pipe,
+					       timeout, -EINVAL);
+
+		return -EINVAL;
+	}
+
+	*bytes_claimed = 0;
+
+	for (;;) {
+		k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+		if (pipe->put_claimed != 0U) {
+			k_spin_unlock(&pipe->lock, key);
+			ret = -EBUSY;
+			break;
+		}
+
+		num_bytes = MIN(pipe->size - pipe->bytes_used,
+				pipe->size - pipe->write_index);
+		num_bytes = MIN(num_bytes, bytes_to_write);
+
+		if (num_bytes != 0U) {
+			pipe->put_claimed = num_bytes;
+			*data = pipe->buffer + pipe->write_index;
+			*bytes_claimed = num_bytes;
+			k_spin_unlock(&pipe->lock, key);
+			ret = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || pipe->buffer == NULL) {
+			k_spin_unlock(&pipe->lock, key);
+			ret = -EIO;
+			break;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_pipe, put_claim, pipe,
+						   timeout);
+
+		/* The pipe's buffer is full: wait for a reader */
+		ret = pipe_claim_wait(pipe, key, &pipe->wait_q.writers,
+				      timeout, end);
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put_claim, pipe, timeout, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_claim(struct k_pipe *pipe, void **data,
+			    size_t bytes_to_write, size_t *bytes_claimed,
+			    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(bytes_claimed, sizeof(*bytes_claimed)));
+	/* The caller writes directly to the pipe's buffer */
+	if (pipe->buffer != NULL) {
+		Z_OOPS(Z_SYSCALL_MEMORY_WRITE(pipe->buffer, pipe->size));
+	}
+
+	return z_impl_k_pipe_put_claim(pipe, data, bytes_to_write,
+				       bytes_claimed, timeout);
+}
+#include <syscalls/k_pipe_put_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_put_finish(struct k_pipe *pipe, size_t bytes_written)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->put_claimed == 0U) || (bytes_written > pipe->put_claimed)) {
+		k_spin_unlock(&pipe->lock, key);
+		SYS_PORT_TRACING_OBJ_FUNC(k_pipe, put_finish, pipe, -EINVAL);
+
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0;
+	pipe->bytes_used += bytes_written;
+	pipe->write_index += bytes_written;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Readers only wait on an empty buffer, so hand them the new data.
+	 * All the readers completed are rescheduled at once.
+	 */
+	if (pipe_readers_fill(pipe)) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_pipe, put_finish, pipe, 0);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_finish(struct k_pipe *pipe, size_t bytes_written)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_put_finish(pipe, bytes_written);
+}
+#include <syscalls/k_pipe_put_finish_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_claim(struct k_pipe *pipe, void **data,
+			    size_t bytes_to_read, size_t *bytes_claimed,
+			    k_timeout_t timeout)
+{
+	int64_t end = sys_clock_timeout_end_calc(timeout);
+	size_t num_bytes;
+	int ret;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_pipe, get_claim, pipe, timeout);
+
+	CHECKIF((bytes_to_read == 0U) || bytes_claimed == NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get_claim, pipe,
+					       timeout, -EINVAL);
+
+		return -EINVAL;
+	}
+
+	*bytes_claimed = 0;
+
+	for (;;) {
+		k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+		if (pipe->get_claimed != 0U) {
+			k_spin_unlock(&pipe->lock, key);
+			ret = -EBUSY;
+			break;
+		}
+
+		num_bytes = MIN(pipe->bytes_used,
+				pipe->size - pipe->read_index);
+		num_bytes = MIN(num_bytes, bytes_to_read);
+
+		if (num_bytes != 0U) {
+			pipe->get_claimed = num_bytes;
+			*data = pipe->buffer + pipe->read_index;
+			*bytes_claimed = num_bytes;
+			k_spin_unlock(&pipe->lock, key);
+			ret = 0;
+			break;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) || pipe->buffer == NULL) {
+			k_spin_unlock(&pipe->lock, key);
+			ret = -EIO;
+			break;
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_pipe, get_claim, pipe,
+						   timeout);
+
+		/* The pipe's buffer is empty: wait for a writer */
+		ret = pipe_claim_wait(pipe, key, &pipe->wait_q.readers,
+				      timeout, end);
+		if (ret != 0) {
+			break;
+		}
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get_claim, pipe, timeout, ret);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_claim(struct k_pipe *pipe, void **data,
+			    size_t bytes_to_read, size_t *bytes_claimed,
+			    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(bytes_claimed, sizeof(*bytes_claimed)));
+	/* The caller reads directly from the pipe's buffer */
+	if (pipe->buffer != NULL) {
+		Z_OOPS(Z_SYSCALL_MEMORY_READ(pipe->buffer, pipe->size));
+	}
+
+	return z_impl_k_pipe_get_claim(pipe, data, bytes_to_read,
+				       bytes_claimed, timeout);
+}
+#include <syscalls/k_pipe_get_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_finish(struct k_pipe *pipe, size_t bytes_read)
+{
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->get_claimed == 0U) || (bytes_read > pipe->get_claimed)) {
+		k_spin_unlock(&pipe->lock, key);
+		SYS_PORT_TRACING_OBJ_FUNC(k_pipe, get_finish, pipe, -EINVAL);
+
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0;
+	pipe->bytes_used -= bytes_read;
+	pipe->read_index += bytes_read;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/*
+	 * Writers only wait on a full buffer, so move their data to the
+	 * room freed. All the writers completed are rescheduled at once.
+	 */
+	if (pipe_writers_drain(pipe)) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC(k_pipe, get_finish, pipe, 0);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_finish(struct k_pipe *pipe, size_t bytes_read)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_get_finish(pipe, bytes_read);
+}
+#include <syscalls/k_pipe_get_finish_mrsh.c>
+#endif
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -29,15 +29,6 @@
 #include <tracing/tracing.h>
 #include <sys/check.h>
 
-/* We use a system-wide lock to synchronize semaphores, which has
- * unfortunate performance impact vs. using a per-object lock
- * (semaphores are *very* widely used).  But per-object locks require
- * significant extra RAM.  A properly spin-aware semaphore
- * implementation would spin on atomic access to the count variable,
- * and not a spinlock per se.  Useful optimization for the future...
- */
-static struct k_spinlock lock;
-
 int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 		      unsigned int limit)
 {
@@ -52,6 +43,7 @@ int z_impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 
 	sem->count = initial_count;
 	sem->limit = limit;
+	sem->lock = (struct k_spinlock) {};
 
 	SYS_PORT_TRACING_OBJ_FUNC(k_sem, init, sem, 0);
 
@@ -85,7 +77,7 @@ static inline void handle_poll_events(struct k_sem *sem)
 
 void z_impl_k_sem_give(struct k_sem *sem)
 {
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&sem->lock);
 	struct k_thread *thread;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, give, sem);
@@ -100,7 +92,7 @@ void z_impl_k_sem_give(struct k_sem *sem)
 		handle_poll_events(sem);
 	}
 
-	z_reschedule(&lock, key);
+	z_reschedule(&sem->lock, key);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, give, sem);
 }
@@ -121,26 +113,26 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 	__ASSERT(((arch_is_in_isr() == false) ||
 		  K_TIMEOUT_EQ(timeout, K_NO_WAIT)), "");
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&sem->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_sem, take, sem, timeout);
 
 	if (likely(sem->count > 0U)) {
 		sem->count--;
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&sem->lock, key);
 		ret = 0;
 		goto out;
 	}
 
 	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-		k_spin_unlock(&lock, key);
+		k_spin_unlock(&sem->lock, key);
 		ret = -EBUSY;
 		goto out;
 	}
 
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_sem, take, sem, timeout);
 
-	ret = z_pend_curr(&lock, key, &sem->wait_q, timeout);
+	ret = z_pend_curr(&sem->lock, key, &sem->wait_q, timeout);
 
 out:
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_sem, take, sem, timeout, ret);
@@ -151,7 +143,7 @@ out:
 void z_impl_k_sem_reset(struct k_sem *sem)
 {
 	struct k_thread *thread;
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	k_spinlock_key_t key = k_spin_lock(&sem->lock);
 
 	while (true) {
 		thread = z_unpend_first_thread(&sem->wait_q);
@@ -167,7 +159,7 @@ void z_impl_k_sem_reset(struct k_sem *sem)
 
 	handle_poll_events(sem);
 
-	z_reschedule(&lock, key);
+	z_reschedule(&sem->lock, key);
 }
 
 #ifdef CONFIG_USERSPACE
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/mpmc_queue.h>
+#include <string.h>
+
+/* Bounded queue with per-slot sequence numbers. For the slot of position
+ * pos, the sequence number is:
+ * - pos when the slot is free for the producer of that position,
+ * - pos + 1 when it holds the item for the consumer of that position,
+ * - pos + capacity once consumed, freeing it for the next turn.
+ *
+ * Positions and sequence numbers are free running and compared through
+ * their difference, so wrapping around is harmless.
+ */
+
+static inline struct mpmc_slot *slot_get(struct mpmc_queue *queue,
+					 uint32_t pos)
+{
+	return (struct mpmc_slot *)&queue->buffer[(pos & queue->mask) *
+						  queue->slot_size];
+}
+
+static inline struct mpmc_slot *item_to_slot(void *item)
+{
+	return CONTAINER_OF(item, struct mpmc_slot, data);
+}
+
+int mpmc_queue_init(struct mpmc_queue *queue, void *buffer, size_t item_size,
+		    uint32_t capacity)
+{
+	if (!IS_POWER_OF_TWO(capacity)) {
+		return -EINVAL;
+	}
+
+	queue->buffer = buffer;
+	queue->slot_size = MPMC_QUEUE_SLOT_SIZE(item_size);
+	queue->mask = capacity - 1;
+
+	for (uint32_t i = 0; i < capacity; i++) {
+		atomic_set(&slot_get(queue, i)->seq, i);
+	}
+
+	atomic_set(&queue->enqueue_pos, 0);
+	atomic_set(&queue->dequeue_pos, 0);
+
+	return 0;
+}
+
+/* Reserve the slot at the position for which the sequence number is
+ * pos + offset, advancing the position.
+ */
+static struct mpmc_slot *slot_claim(struct mpmc_queue *queue, atomic_t *pos_ptr,
+				    uint32_t offset)
+{
+	struct mpmc_slot *slot;
+	uint32_t pos, seq;
+	int32_t diff;
+
+	pos = (uint32_t)atomic_get(pos_ptr);
+
+	while (true) {
+		slot = slot_get(queue, pos);
+		seq = (uint32_t)atomic_get(&slot->seq);
+		diff = (int32_t)(seq - (pos + offset));
+
+		if (diff == 0) {
+			if (atomic_cas(pos_ptr, (atomic_val_t)pos,
+				       (atomic_val_t)(pos + 1))) {
+				return slot;
+			}
+		} else if (diff < 0) {
+			/* The slot hasn't been handed over for this turn */
+			return NULL;
+		}
+
+		/* Another producer or consumer took the position */
+		pos = (uint32_t)atomic_get(pos_ptr);
+	}
+}
+
+int mpmc_queue_put_claim(struct mpmc_queue *queue, void **item)
+{
+	struct mpmc_slot *slot = slot_claim(queue, &queue->enqueue_pos, 0);
+
+	if (slot == NULL) {
+		return -ENOMEM;
+	}
+
+	*item = slot->data;
+
+	return 0;
+}
+
+void mpmc_queue_put_finish(struct mpmc_queue *queue, void *item)
+{
+	struct mpmc_slot *slot = item_to_slot(item);
+
+	ARG_UNUSED(queue);
+
+	/* The sequence number is the claimed position, untouched since */
+	atomic_inc(&slot->seq);
+}
+
+int mpmc_queue_put(struct mpmc_queue *queue, const void *item,
+		   size_t item_size)
+{
+	void *dst;
+	int ret;
+
+	__ASSERT(item_size <= queue->slot_size - sizeof(struct mpmc_slot),
+		 "item too large");
+
+	ret = mpmc_queue_put_claim(queue, &dst);
+	if (ret == 0) {
+		memcpy(dst, item, item_size);
+		mpmc_queue_put_finish(queue, dst);
+	}
+
+	return ret;
+}
+
+int mpmc_queue_get_claim(struct mpmc_queue *queue, void **item)
+{
+	struct mpmc_slot *slot = slot_claim(queue, &queue->dequeue_pos, 1);
+
+	if (slot == NULL) {
+		return -EAGAIN;
+	}
+
+	*item = slot->data;
+
+	return 0;
+}
+
+void mpmc_queue_get_finish(struct mpmc_queue *queue, void *item)
+{
+	struct mpmc_slot *slot = item_to_slot(item);
+
+	/* The sequence number is the claimed position plus one */
+	atomic_add(&slot->seq, queue->mask);
+}
+
+int mpmc_queue_get(struct mpmc_queue *queue, void *item, size_t item_size)
+{
+	void *src;
+	int ret;
+
+	__ASSERT(item_size <= queue->slot_size - sizeof(struct mpmc_slot),
+		 "item too large");
+
+	ret = mpmc_queue_get_claim(queue, &src);
+	if (ret == 0) {
+		memcpy(item, src, item_size);
+		mpmc_queue_get_finish(queue, src);
+	}
+
+	return ret;
+}
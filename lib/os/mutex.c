@@ -8,6 +8,7 @@
 #include <sys/mutex.h>
 #include <syscall_handler.h>
 #include <kernel_structs.h>
+#include <kernel_internal.h>
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -23,9 +24,9 @@ static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 
 static bool check_sys_mutex_addr(struct sys_mutex *addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* sys_mutex memory is used to lookup the underlying k_mutex, and
+	 * holds the owner of fast mutexes: we don't want threads using
+	 * mutexes that are outside their memory domain
 	 */
 	return Z_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
@@ -38,7 +39,11 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	return z_mutex_lock_owned(kernel_mutex, &mutex->val, timeout);
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,11 +61,19 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST_PATH
+	if (kernel_mutex == NULL) {
+		return -EINVAL;
+	}
+
+	return z_mutex_unlock_owned(kernel_mutex, &mutex->val);
+#else
 	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
 		return -EINVAL;
 	}
 
 	return k_mutex_unlock(kernel_mutex);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
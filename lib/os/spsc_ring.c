@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sys/spsc_ring.h>
+#include <string.h>
+
+/* Each side reads its own index without ordering, as only it writes it.
+ * Reading the other index is ordered before the accesses to the data, and
+ * publishing the own index after them, through the fully ordered atomic
+ * load and store.
+ */
+
+uint32_t spsc_ring_put_claim(struct spsc_ring *ring, uint8_t **data,
+			     uint32_t size)
+{
+	uint32_t head = (uint32_t)ring->head;
+	uint32_t tail = (uint32_t)atomic_get(&ring->tail);
+	uint32_t offset = head & ring->mask;
+	uint32_t space = spsc_ring_capacity_get(ring) - (head - tail);
+
+	*data = &ring->buffer[offset];
+
+	return MIN(size, MIN(space, spsc_ring_capacity_get(ring) - offset));
+}
+
+void spsc_ring_put_finish(struct spsc_ring *ring, uint32_t size)
+{
+	atomic_set(&ring->head, (atomic_val_t)((uint32_t)ring->head + size));
+}
+
+uint32_t spsc_ring_put(struct spsc_ring *ring, const uint8_t *data,
+		       uint32_t size)
+{
+	uint32_t total = 0, len;
+	uint8_t *dst;
+
+	/* At most two chunks, before and after the wrap */
+	for (int i = 0; i < 2 && total < size; i++) {
+		len = spsc_ring_put_claim(ring, &dst, size - total);
+		if (len == 0) {
+			break;
+		}
+
+		memcpy(dst, data + total, len);
+		spsc_ring_put_finish(ring, len);
+		total += len;
+	}
+
+	return total;
+}
+
+uint32_t spsc_ring_get_claim(struct spsc_ring *ring, uint8_t **data,
+			     uint32_t size)
+{
+	uint32_t tail = (uint32_t)ring->tail;
+	uint32_t head = (uint32_t)atomic_get(&ring->head);
+	uint32_t offset = tail & ring->mask;
+
+	*data = &ring->buffer[offset];
+
+	return MIN(size, MIN(head - tail, spsc_ring_capacity_get(ring) - offset));
+}
+
+void spsc_ring_get_finish(struct spsc_ring *ring, uint32_t size)
+{
+	atomic_set(&ring->tail, (atomic_val_t)((uint32_t)ring->tail + size));
+}
+
+uint32_t spsc_ring_get(struct spsc_ring *ring, uint8_t *data, uint32_t size)
+{
+	uint32_t total = 0, len;
+	uint8_t *src;
+
+	for (int i = 0; i < 2 && total < size; i++) {
+		len = spsc_ring_get_claim(ring, &src, size - total);
+		if (len == 0) {
+			break;
+		}
+
+		memcpy(data + total, src, len);
+		spsc_ring_get_finish(ring, len);
+		total += len;
+	}
+
+	return total;
+}
@@ -9,7 +9,7 @@
 #include <ksched.h>
 #include <wait_q.h>
 
-extern struct k_spinlock z_pthread_spinlock;
+static struct k_spinlock z_pthread_spinlock;
 
 int pthread_barrier_wait(pthread_barrier_t *b)
 {
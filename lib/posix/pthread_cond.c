@@ -9,8 +9,6 @@
 #include <wait_q.h>
 #include <posix/pthread.h>
 
-extern struct k_spinlock z_pthread_spinlock;
-
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 
 static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
@@ -19,12 +17,13 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 	__ASSERT(mut->lock_count == 1U, "");
 
 	int ret;
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
+	k_spinlock_key_t key = k_spin_lock(&cv->lock);
 
-	mut->lock_count = 0U;
-	mut->owner = NULL;
-	_ready_one_thread(&mut->wait_q);
-	ret = z_sched_wait(&z_pthread_spinlock, key, &cv->wait_q, timeout, NULL);
+	/* Signals are sent with the condition variable lock held, so none
+	 * can be missed between the mutex release and the wait.
+	 */
+	pthread_mutex_unlock(mut);
+	ret = z_sched_wait(&cv->lock, key, &cv->wait_q, timeout, NULL);
 
 	/* FIXME: this extra lock (and the potential context switch it
 	 * can cause) could be optimized out.  At the point of the
@@ -41,13 +40,19 @@ static int cond_wait(pthread_cond_t *cv, pthread_mutex_t *mut,
 
 int pthread_cond_signal(pthread_cond_t *cv)
 {
+	k_spinlock_key_t key = k_spin_lock(&cv->lock);
+
 	z_sched_wake(&cv->wait_q, 0, NULL);
+	k_spin_unlock(&cv->lock, key);
 	return 0;
 }
 
 int pthread_cond_broadcast(pthread_cond_t *cv)
 {
+	k_spinlock_key_t key = k_spin_lock(&cv->lock);
+
 	z_sched_wake_all(&cv->wait_q, 0, NULL);
+	k_spin_unlock(&cv->lock, key);
 	return 0;
 }
 
@@ -9,12 +9,13 @@
 #include <wait_q.h>
 #include <posix/pthread.h>
 
-struct k_spinlock z_pthread_spinlock;
-
 int64_t timespec_to_timeoutms(const struct timespec *abstime);
 
 #define MUTEX_MAX_REC_LOCK 32767
 
+/* Set in the owner of a mutex when threads wait for it */
+#define MUTEX_WAITERS ((atomic_val_t)1)
+
 /*
  *  Default mutex attrs.
  */
@@ -22,38 +23,61 @@ static const pthread_mutexattr_t def_attr = {
 	.type = PTHREAD_MUTEX_DEFAULT,
 };
 
-static int acquire_mutex(pthread_mutex_t *m, k_timeout_t timeout)
+/* Lock a mutex already owned by the caller */
+static int relock_mutex(pthread_mutex_t *m)
 {
-	int rc = 0;
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
-
-	if (m->lock_count == 0U && m->owner == NULL) {
+	if (m->type == PTHREAD_MUTEX_RECURSIVE &&
+	    m->lock_count < MUTEX_MAX_REC_LOCK) {
 		m->lock_count++;
-		m->owner = pthread_self();
+		return 0;
+	} else if (m->type == PTHREAD_MUTEX_ERRORCHECK) {
+		return EDEADLK;
+	}
 
-		k_spin_unlock(&z_pthread_spinlock, key);
+	return EINVAL;
+}
+
+static int acquire_mutex(pthread_mutex_t *m, k_timeout_t timeout)
+{
+	atomic_val_t self = (atomic_val_t)pthread_self();
+	atomic_val_t owner;
+	k_spinlock_key_t key;
+	int rc;
+
+	/* Uncontended case: a single atomic operation */
+	if (atomic_cas(&m->owner, 0, self)) {
+		m->lock_count = 1U;
 		return 0;
-	} else if (m->owner == pthread_self()) {
-		if (m->type == PTHREAD_MUTEX_RECURSIVE &&
-		    m->lock_count < MUTEX_MAX_REC_LOCK) {
-			m->lock_count++;
-			rc = 0;
-		} else if (m->type == PTHREAD_MUTEX_ERRORCHECK) {
-			rc = EDEADLK;
-		} else {
-			rc = EINVAL;
-		}
+	}
 
-		k_spin_unlock(&z_pthread_spinlock, key);
-		return rc;
+	if ((atomic_get(&m->owner) & ~MUTEX_WAITERS) == self) {
+		return relock_mutex(m);
 	}
 
-	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
-		k_spin_unlock(&z_pthread_spinlock, key);
-		return EINVAL;
+	key = k_spin_lock(&m->lock);
+
+	while (true) {
+		owner = atomic_get(&m->owner);
+
+		if (owner == 0) {
+			if (atomic_cas(&m->owner, 0, self)) {
+				k_spin_unlock(&m->lock, key);
+				m->lock_count = 1U;
+				return 0;
+			}
+		} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&m->lock, key);
+			return EINVAL;
+		} else if ((owner & MUTEX_WAITERS) != 0 ||
+			   atomic_cas(&m->owner, owner, owner | MUTEX_WAITERS)) {
+			/* The owner can no longer release the mutex without
+			 * taking the lock, and handing it over to us.
+			 */
+			break;
+		}
 	}
 
-	rc = z_pend_curr(&z_pthread_spinlock, key, &m->wait_q, timeout);
+	rc = z_pend_curr(&m->lock, key, &m->wait_q, timeout);
 	if (rc != 0) {
 		rc = ETIMEDOUT;
 	}
@@ -94,8 +118,9 @@ int pthread_mutex_init(pthread_mutex_t *m,
 {
 	const pthread_mutexattr_t *mattr;
 
-	m->owner = NULL;
+	atomic_set(&m->owner, 0);
 	m->lock_count = 0U;
+	m->lock = (struct k_spinlock) {};
 
 	mattr = (attr == NULL) ? &def_attr : attr;
 
@@ -124,36 +149,41 @@ int pthread_mutex_lock(pthread_mutex_t *m)
  */
 int pthread_mutex_unlock(pthread_mutex_t *m)
 {
-	k_spinlock_key_t key = k_spin_lock(&z_pthread_spinlock);
-
+	atomic_val_t self = (atomic_val_t)pthread_self();
+	k_spinlock_key_t key;
 	k_tid_t thread;
 
-	if (m->owner != pthread_self()) {
-		k_spin_unlock(&z_pthread_spinlock, key);
+	if ((atomic_get(&m->owner) & ~MUTEX_WAITERS) != self) {
 		return EPERM;
 	}
 
 	if (m->lock_count == 0U) {
-		k_spin_unlock(&z_pthread_spinlock, key);
 		return EINVAL;
 	}
 
 	m->lock_count--;
 
-	if (m->lock_count == 0U) {
-		thread = z_unpend_first_thread(&m->wait_q);
-		if (thread) {
-			m->owner = (pthread_t)thread;
-			m->lock_count++;
-			arch_thread_return_value_set(thread, 0);
-			z_ready_thread(thread);
-			z_reschedule(&z_pthread_spinlock, key);
-			return 0;
-		}
-		m->owner = NULL;
+	if (m->lock_count > 0U || atomic_cas(&m->owner, self, 0)) {
+		return 0;
+	}
 
+	/* Threads wait for the mutex: hand it over to the first one */
+	key = k_spin_lock(&m->lock);
+
+	thread = z_unpend_first_thread(&m->wait_q);
+	if (thread) {
+		atomic_set(&m->owner, (atomic_val_t)thread |
+			   (z_waitq_head(&m->wait_q) ? MUTEX_WAITERS : 0));
+		m->lock_count = 1U;
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		z_reschedule(&m->lock, key);
+		return 0;
 	}
-	k_spin_unlock(&z_pthread_spinlock, key);
+
+	/* They all timed out */
+	atomic_set(&m->owner, 0);
+	k_spin_unlock(&m->lock, key);
 	return 0;
 }
 
@@ -827,7 +827,7 @@ struct find_type_data {
 };
 
 static uint8_t find_type_cb(const struct bt_gatt_attr *attr, uint16_t handle,
-			    void *user_data)
+			    uint16_t end_handle, void *user_data)
 {
 	struct find_type_data *data = user_data;
 	struct bt_att_chan *chan = data->chan;
@@ -837,20 +837,6 @@ static uint8_t find_type_cb(const struct bt_gatt_attr *attr, uint16_t handle,
 	struct net_buf *frag;
 	size_t len;
 
-	/* Skip secondary services */
-	if (!bt_uuid_cmp(attr->uuid, BT_UUID_GATT_SECONDARY)) {
-		goto skip;
-	}
-
-	/* Update group end_handle if not a primary service */
-	if (bt_uuid_cmp(attr->uuid, BT_UUID_GATT_PRIMARY)) {
-		if (data->group &&
-		    handle > sys_le16_to_cpu(data->group->end_handle)) {
-			data->group->end_handle = sys_cpu_to_le16(handle);
-		}
-		return BT_GATT_ITER_CONTINUE;
-	}
-
 	BT_DBG("handle 0x%04x", handle);
 
 	/* stop if there is no space left */
@@ -911,9 +897,8 @@ static uint8_t find_type_cb(const struct bt_gatt_attr *attr, uint16_t handle,
 	/* Fast forward to next item position */
 	data->group = net_buf_add(frag, sizeof(*data->group));
 	data->group->start_handle = sys_cpu_to_le16(handle);
-	data->group->end_handle = sys_cpu_to_le16(handle);
+	data->group->end_handle = sys_cpu_to_le16(end_handle);
 
-	/* continue to find the end_handle */
 	return BT_GATT_ITER_CONTINUE;
 
 skip:
@@ -943,7 +928,8 @@ static uint8_t att_find_type_rsp(struct bt_att_chan *chan, uint16_t start_handle
 	/* Pre-set error in case no service will be found */
 	data.err = BT_ATT_ERR_ATTRIBUTE_NOT_FOUND;
 
-	bt_gatt_foreach_attr(start_handle, end_handle, find_type_cb, &data);
+	bt_gatt_foreach_attr_group(start_handle, end_handle,
+				   BT_UUID_GATT_PRIMARY, find_type_cb, &data);
 
 	/* If error has not been cleared, no service has been found */
 	if (data.err) {
@@ -1103,11 +1089,6 @@ static uint8_t read_type_cb(const struct bt_gatt_attr *attr, uint16_t handle,
 	struct bt_conn *conn = chan->chan.chan.conn;
 	ssize_t read;
 
-	/* Skip if doesn't match */
-	if (bt_uuid_cmp(attr->uuid, data->uuid)) {
-		return BT_GATT_ITER_CONTINUE;
-	}
-
 	BT_DBG("handle 0x%04x", handle);
 
 	/*
@@ -1176,7 +1157,8 @@ static uint8_t att_read_type_rsp(struct bt_att_chan *chan, struct bt_uuid *uuid,
 	/* Pre-set error if no attr will be found in handle */
 	data.err = BT_ATT_ERR_ATTRIBUTE_NOT_FOUND;
 
-	bt_gatt_foreach_attr(start_handle, end_handle, read_type_cb, &data);
+	bt_gatt_foreach_attr_type(start_handle, end_handle, uuid, NULL, 0,
+				  read_type_cb, &data);
 
 	if (data.err) {
 		net_buf_unref(data.buf);
@@ -1509,28 +1491,12 @@ static bool attr_read_group_cb(struct net_buf *frag, ssize_t read,
 }
 
 static uint8_t read_group_cb(const struct bt_gatt_attr *attr, uint16_t handle,
-			     void *user_data)
+			     uint16_t end_handle, void *user_data)
 {
 	struct read_group_data *data = user_data;
 	struct bt_att_chan *chan = data->chan;
 	int read;
 
-	/* Update group end_handle if attribute is not a service */
-	if (bt_uuid_cmp(attr->uuid, BT_UUID_GATT_PRIMARY) &&
-	    bt_uuid_cmp(attr->uuid, BT_UUID_GATT_SECONDARY)) {
-		if (data->group &&
-		    handle > sys_le16_to_cpu(data->group->end_handle)) {
-			data->group->end_handle = sys_cpu_to_le16(handle);
-		}
-		return BT_GATT_ITER_CONTINUE;
-	}
-
-	/* If Group Type don't match skip */
-	if (bt_uuid_cmp(attr->uuid, data->uuid)) {
-		data->group = NULL;
-		return BT_GATT_ITER_CONTINUE;
-	}
-
 	BT_DBG("handle 0x%04x", handle);
 
 	/* Stop if there is no space left */
@@ -1544,7 +1510,7 @@ static uint8_t read_group_cb(const struct bt_gatt_attr *attr, uint16_t handle,
 
 	/* Initialize group handle range */
 	data->group->start_handle = sys_cpu_to_le16(handle);
-	data->group->end_handle = sys_cpu_to_le16(handle);
+	data->group->end_handle = sys_cpu_to_le16(end_handle);
 
 	/* Read attribute value and store in the buffer */
 	read = att_chan_read(chan, attr, data->buf, 0, attr_read_group_cb,
@@ -1582,7 +1548,8 @@ static uint8_t att_read_group_rsp(struct bt_att_chan *chan, struct bt_uuid *uuid
 	data.rsp->len = 0U;
 	data.group = NULL;
 
-	bt_gatt_foreach_attr(start_handle, end_handle, read_group_cb, &data);
+	bt_gatt_foreach_attr_group(start_handle, end_handle, data.uuid,
+				   read_group_cb, &data);
 
 	if (!data.rsp->len) {
 		net_buf_unref(data.buf);
@@ -77,6 +77,73 @@ NET_BUF_POOL_FIXED_DEFINE(frag_pool, CONFIG_BT_L2CAP_TX_FRAG_COUNT,
 
 #endif /* CONFIG_BT_L2CAP_TX_FRAG_COUNT > 0 */
 
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+/* Fragment views share the data of the buffer being fragmented. The HCI
+ * headers of a view are pushed into the bytes preceding the fragment, which
+ * belong to the previous fragment, so a new view (or the final fragment,
+ * which is the original buffer) may only be sent once the HCI driver has
+ * released the previous view. Each connection has at most one view in
+ * flight, gated by its frag_view_sem, so connections don't wait on each
+ * other.
+ */
+#if defined(CONFIG_BT_ISO)
+#define FRAG_VIEW_COUNT (CONFIG_BT_MAX_CONN + CONFIG_BT_ISO_MAX_CHAN)
+#else
+#define FRAG_VIEW_COUNT CONFIG_BT_MAX_CONN
+#endif /* CONFIG_BT_ISO */
+
+struct frag_view {
+	struct bt_conn *conn;
+	struct net_buf *parent;
+};
+
+static void frag_view_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_DEFINE(frag_view_pool, FRAG_VIEW_COUNT, 0,
+		    sizeof(struct tx_meta), frag_view_destroy);
+
+static struct frag_view frag_views[FRAG_VIEW_COUNT];
+
+static void frag_view_destroy(struct net_buf *buf)
+{
+	struct frag_view *view = &frag_views[net_buf_id(buf)];
+	struct bt_conn *conn = view->conn;
+	struct net_buf *parent = view->parent;
+
+	view->conn = NULL;
+	view->parent = NULL;
+	net_buf_destroy(buf);
+
+	net_buf_unref(parent);
+	k_sem_give(&conn->frag_view_sem);
+}
+
+/* Must be called with conn->frag_view_sem taken */
+static struct net_buf *frag_view_create(struct bt_conn *conn,
+					struct net_buf *buf)
+{
+	struct frag_view *view;
+	struct net_buf *frag;
+
+	frag = net_buf_alloc_with_data(&frag_view_pool, buf->__buf, buf->size,
+				       K_NO_WAIT);
+	if (!frag) {
+		BT_WARN("No fragment view available");
+		k_sem_give(&conn->frag_view_sem);
+		return NULL;
+	}
+
+	view = &frag_views[net_buf_id(frag)];
+	view->conn = conn;
+	view->parent = net_buf_ref(buf);
+
+	frag->len = 0U;
+	net_buf_reserve(frag, net_buf_headroom(buf));
+
+	return frag;
+}
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
+
 #if defined(CONFIG_BT_SMP) || defined(CONFIG_BT_BREDR)
 const struct bt_conn_auth_cb *bt_auth;
 #endif /* CONFIG_BT_SMP || CONFIG_BT_BREDR */
@@ -221,6 +288,9 @@ struct bt_conn *bt_conn_new(struct bt_conn *conns, size_t size)
 #if defined(CONFIG_BT_CONN_TX)
 	k_work_init(&conn->tx_complete_work, tx_complete_work);
 #endif /* CONFIG_BT_CONN_TX */
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+	k_sem_init(&conn->frag_view_sem, 1, 1);
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
 
 	return conn;
 }
@@ -569,6 +639,12 @@ static struct net_buf *create_frag(struct bt_conn *conn, struct net_buf *buf)
 	struct net_buf *frag;
 	uint16_t frag_len;
 
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+	frag = frag_view_create(conn, buf);
+	if (!frag) {
+		return NULL;
+	}
+#else
 	switch (conn->type) {
 #if defined(CONFIG_BT_ISO)
 	case BT_CONN_TYPE_ISO:
@@ -583,6 +659,7 @@ static struct net_buf *create_frag(struct bt_conn *conn, struct net_buf *buf)
 #endif /* CONFIG_BT_CONN */
 
 	}
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
 
 	if (conn->state != BT_CONN_CONNECTED) {
 		net_buf_unref(frag);
@@ -592,17 +669,75 @@ static struct net_buf *create_frag(struct bt_conn *conn, struct net_buf *buf)
 	/* Fragments never have a TX completion callback */
 	tx_data(frag)->tx = NULL;
 
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+	frag_len = MIN(conn_mtu(conn), buf->len);
+
+	net_buf_add(frag, frag_len);
+#else
 	frag_len = MIN(conn_mtu(conn), net_buf_tailroom(frag));
 
 	net_buf_add_mem(frag, buf->data, frag_len);
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
 	net_buf_pull(buf, frag_len);
 
 	return frag;
 }
 
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+static bool frag_view_acquire(struct bt_conn *conn, uint8_t flags)
+{
+	/* A PDU is only started once the previous one ended with its
+	 * original buffer, so the connection has no view left in flight.
+	 */
+	return !k_sem_take(&conn->frag_view_sem,
+			   flags == FRAG_START ? K_FOREVER : K_NO_WAIT);
+}
+
+/* Send the fragments of buf whose preceding view the HCI driver has
+ * released. If it still holds one, the rest of buf is parked in
+ * conn->frag_buf and resumed from bt_conn_process_tx() once the view is
+ * released, so the TX thread keeps serving the other connections.
+ */
+static bool send_frag_views(struct bt_conn *conn, struct net_buf *buf,
+			    uint8_t flags)
+{
+	struct net_buf *frag;
+
+	while (buf->len > conn_mtu(conn)) {
+		if (!frag_view_acquire(conn, flags)) {
+			conn->frag_buf = buf;
+			return true;
+		}
+
+		frag = create_frag(conn, buf);
+		if (!frag) {
+			return false;
+		}
+
+		if (!send_frag(conn, frag, flags, true)) {
+			return false;
+		}
+
+		flags = FRAG_CONT;
+	}
+
+	/* The header of the last fragment overwrites the previous view */
+	if (!frag_view_acquire(conn, flags)) {
+		conn->frag_buf = buf;
+		return true;
+	}
+
+	k_sem_give(&conn->frag_view_sem);
+
+	return send_frag(conn, buf, FRAG_END, false);
+}
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
+
 static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 {
+#if !defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
 	struct net_buf *frag;
+#endif /* !CONFIG_BT_L2CAP_TX_FRAG_VIEW */
 
 	BT_DBG("conn %p buf %p len %u", conn, buf, buf->len);
 
@@ -611,6 +746,9 @@ static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 		return send_frag(conn, buf, FRAG_SINGLE, false);
 	}
 
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+	return send_frag_views(conn, buf, FRAG_START);
+#else
 	/* Create & enqueue first fragment */
 	frag = create_frag(conn, buf);
 	if (!frag) {
@@ -637,6 +775,7 @@ static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 	}
 
 	return send_frag(conn, buf, FRAG_END, false);
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
 }
 
 static struct k_poll_signal conn_change =
@@ -646,6 +785,20 @@ static void conn_cleanup(struct bt_conn *conn)
 {
 	struct net_buf *buf;
 
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+	/* Drop the rest of a partially sent PDU */
+	if (conn->frag_buf) {
+		buf = conn->frag_buf;
+		conn->frag_buf = NULL;
+
+		if (tx_data(buf)->tx) {
+			tx_free(tx_data(buf)->tx);
+		}
+
+		net_buf_unref(buf);
+	}
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
+
 	/* Give back any allocated buffers */
 	while ((buf = net_buf_get(&conn->tx_queue, K_NO_WAIT))) {
 		if (tx_data(buf)->tx) {
@@ -680,6 +833,21 @@ static int conn_prepare_events(struct bt_conn *conn,
 		return -ENOTCONN;
 	}
 
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+	/* Resume the pending PDU before looking at the queue */
+	if (conn->frag_buf) {
+		BT_DBG("Adding conn %p fragment view to poll list", conn);
+
+		k_poll_event_init(&events[0],
+				K_POLL_TYPE_SEM_AVAILABLE,
+				K_POLL_MODE_NOTIFY_ONLY,
+				&conn->frag_view_sem);
+		events[0].tag = BT_EVENT_CONN_FRAG_VIEW;
+
+		return 0;
+	}
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
+
 	BT_DBG("Adding conn %p to poll list", conn);
 
 	k_poll_event_init(&events[0],
@@ -738,6 +906,20 @@ void bt_conn_process_tx(struct bt_conn *conn)
 		return;
 	}
 
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+	/* Continue the PDU that waited for its previous fragment view */
+	if (conn->frag_buf) {
+		buf = conn->frag_buf;
+		conn->frag_buf = NULL;
+
+		if (!send_frag_views(conn, buf, FRAG_CONT)) {
+			net_buf_unref(buf);
+		}
+
+		return;
+	}
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
+
 	/* Get next ACL packet for connection */
 	buf = net_buf_get(&conn->tx_queue, K_NO_WAIT);
 	BT_ASSERT(buf);
@@ -199,6 +199,13 @@ struct bt_conn {
 	struct k_work           tx_complete_work;
 #endif /* CONFIG_BT_CONN_TX */
 
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+	/* Rest of a PDU waiting for its previous fragment view */
+	struct net_buf		*frag_buf;
+	/* Available while the HCI driver holds no fragment view */
+	struct k_sem		frag_view_sem;
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
+
 	/* Queue for outgoing ACL data */
 	struct k_fifo		tx_queue;
 
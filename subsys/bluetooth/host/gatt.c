@@ -85,6 +85,169 @@ static sys_slist_t db;
 static atomic_t init;
 static atomic_t service_init;
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+struct attr_index_entry {
+	const struct bt_gatt_attr *attr;
+	uint16_t handle;
+	/* 16-bit UUID value, 0 if the UUID is of another type */
+	uint16_t uuid16;
+	/* Last handle of the group, only set for service declarations */
+	uint16_t group_end;
+};
+
+/* Handle sorted copy of the database, valid only if all attributes fit */
+struct attr_index {
+	struct attr_index_entry entries[CONFIG_BT_GATT_ATTR_INDEX_SIZE];
+	uint16_t count;
+	bool valid;
+};
+
+/* Rebuilds fill the inactive index and swap it in under attr_index_lock,
+ * which walks hold for as long as they use the active index.
+ */
+static struct attr_index attr_indexes[2];
+static struct attr_index *attr_index = &attr_indexes[0];
+static K_MUTEX_DEFINE(attr_index_lock);
+static K_MUTEX_DEFINE(attr_index_build_lock);
+
+static bool attr_index_is_service(const struct attr_index_entry *entry)
+{
+	return entry->uuid16 == BT_UUID_GATT_PRIMARY_VAL ||
+	       entry->uuid16 == BT_UUID_GATT_SECONDARY_VAL;
+}
+
+static bool attr_index_add(struct attr_index *index,
+			   const struct bt_gatt_attr *attr, uint16_t handle)
+{
+	struct attr_index_entry *entry;
+
+	if (index->count >= ARRAY_SIZE(index->entries)) {
+		return false;
+	}
+
+	entry = &index->entries[index->count++];
+	entry->attr = attr;
+	entry->handle = handle;
+	entry->group_end = 0U;
+
+	if (attr->uuid->type == BT_UUID_TYPE_16) {
+		entry->uuid16 = BT_UUID_16(attr->uuid)->val;
+	} else {
+		entry->uuid16 = 0U;
+	}
+
+	return true;
+}
+
+static bool attr_index_fill(struct attr_index *index)
+{
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	struct bt_gatt_service *svc;
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+	uint16_t handle = 1;
+	uint16_t group_end = 0U;
+
+	index->count = 0U;
+
+	STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
+		for (size_t i = 0; i < static_svc->attr_count; i++, handle++) {
+			if (!attr_index_add(index, &static_svc->attrs[i],
+					    handle)) {
+				return false;
+			}
+		}
+	}
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+	/* Services in db are kept in ascending handle order */
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		for (size_t i = 0; i < svc->attr_count; i++) {
+			if (!attr_index_add(index, &svc->attrs[i],
+					    svc->attrs[i].handle)) {
+				return false;
+			}
+		}
+	}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+
+	/* A group ends at the last attribute before the next service */
+	for (uint16_t i = index->count; i > 0U; i--) {
+		struct attr_index_entry *entry = &index->entries[i - 1U];
+
+		if (!group_end) {
+			group_end = entry->handle;
+		}
+
+		if (attr_index_is_service(entry)) {
+			entry->group_end = group_end;
+			group_end = 0U;
+		}
+	}
+
+	return true;
+}
+
+static void attr_index_rebuild(void)
+{
+	struct attr_index *shadow;
+
+	k_mutex_lock(&attr_index_build_lock, K_FOREVER);
+
+	/* attr_index only changes with attr_index_build_lock held */
+	shadow = attr_index == &attr_indexes[0] ? &attr_indexes[1] :
+						  &attr_indexes[0];
+
+	shadow->valid = attr_index_fill(shadow);
+	if (!shadow->valid) {
+		BT_WARN("Attribute index full, falling back to database walk");
+	}
+
+	k_mutex_lock(&attr_index_lock, K_FOREVER);
+	attr_index = shadow;
+	k_mutex_unlock(&attr_index_lock);
+
+	k_mutex_unlock(&attr_index_build_lock);
+}
+
+/* Lock and return the active index, NULL if it cannot be used */
+static const struct attr_index *attr_index_get(void)
+{
+	k_mutex_lock(&attr_index_lock, K_FOREVER);
+
+	if (!attr_index->valid) {
+		k_mutex_unlock(&attr_index_lock);
+		return NULL;
+	}
+
+	return attr_index;
+}
+
+static void attr_index_put(void)
+{
+	k_mutex_unlock(&attr_index_lock);
+}
+
+/* Return the position of the first indexed attribute with handle >= handle */
+static uint16_t attr_index_lower_bound(const struct attr_index *index,
+				       uint16_t handle)
+{
+	uint16_t lo = 0U;
+	uint16_t hi = index->count;
+
+	while (lo < hi) {
+		uint16_t mid = lo + (hi - lo) / 2U;
+
+		if (index->entries[mid].handle < handle) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static ssize_t read_name(struct bt_conn *conn, const struct bt_gatt_attr *attr,
 			 void *buf, uint16_t len, uint16_t offset)
 {
@@ -1120,6 +1283,10 @@ populate:
 
 	gatt_insert(svc, last_handle);
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	attr_index_rebuild();
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	return 0;
 }
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
@@ -1279,6 +1446,10 @@ static void bt_gatt_service_init(void)
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
 		last_static_handle += svc->attr_count;
 	}
+
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	attr_index_rebuild();
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
 }
 
 void bt_gatt_init(void)
@@ -1431,6 +1602,10 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	attr_index_rebuild();
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
@@ -1785,17 +1960,67 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static void foreach_attr_type_index(const struct attr_index *index,
+				    uint16_t start_handle, uint16_t end_handle,
+				    const struct bt_uuid *uuid,
+				    const void *attr_data, uint16_t num_matches,
+				    bt_gatt_attr_func_t func, void *user_data)
+{
+	uint16_t uuid16 = 0U;
+
+	if (uuid && uuid->type == BT_UUID_TYPE_16) {
+		uuid16 = BT_UUID_16(uuid)->val;
+	}
+
+	for (uint16_t i = attr_index_lower_bound(index, start_handle);
+	     i < index->count; i++) {
+		const struct attr_index_entry *entry = &index->entries[i];
+
+		if (entry->handle > end_handle) {
+			return;
+		}
+
+		/* Skip 16-bit UUID mismatches without a full UUID compare */
+		if (uuid16 && entry->uuid16 && uuid16 != entry->uuid16) {
+			continue;
+		}
+
+		if (gatt_foreach_iter(entry->attr, entry->handle,
+				      start_handle, end_handle, uuid,
+				      attr_data, &num_matches, func,
+				      user_data) == BT_GATT_ITER_STOP) {
+			return;
+		}
+	}
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
 			       bt_gatt_attr_func_t func, void *user_data)
 {
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	const struct attr_index *index;
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
 	size_t i;
 
 	if (!num_matches) {
 		num_matches = UINT16_MAX;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	index = attr_index_get();
+	if (index) {
+		foreach_attr_type_index(index, start_handle, end_handle, uuid,
+					attr_data, num_matches, func,
+					user_data);
+		attr_index_put();
+		return;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
@@ -1824,6 +2049,103 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 				num_matches, func, user_data);
 }
 
+struct foreach_group_data {
+	const struct bt_uuid *uuid;
+	const struct bt_gatt_attr *attr;
+	uint16_t handle;
+	uint16_t end_handle;
+	bt_gatt_group_func_t func;
+	void *user_data;
+};
+
+static uint8_t foreach_group_flush(struct foreach_group_data *data)
+{
+	const struct bt_gatt_attr *attr = data->attr;
+
+	if (!attr) {
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	data->attr = NULL;
+
+	return data->func(attr, data->handle, data->end_handle,
+			  data->user_data);
+}
+
+static uint8_t foreach_group_cb(const struct bt_gatt_attr *attr,
+				uint16_t handle, void *user_data)
+{
+	struct foreach_group_data *data = user_data;
+
+	/* Extend the pending group if attribute is not a service */
+	if (bt_uuid_cmp(attr->uuid, BT_UUID_GATT_PRIMARY) &&
+	    bt_uuid_cmp(attr->uuid, BT_UUID_GATT_SECONDARY)) {
+		data->end_handle = handle;
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	if (foreach_group_flush(data) == BT_GATT_ITER_STOP) {
+		data->func = NULL;
+		return BT_GATT_ITER_STOP;
+	}
+
+	if (!bt_uuid_cmp(attr->uuid, data->uuid)) {
+		data->attr = attr;
+		data->handle = handle;
+		data->end_handle = handle;
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+void bt_gatt_foreach_attr_group(uint16_t start_handle, uint16_t end_handle,
+				const struct bt_uuid *uuid,
+				bt_gatt_group_func_t func, void *user_data)
+{
+	struct foreach_group_data data = {
+		.uuid = uuid,
+		.func = func,
+		.user_data = user_data,
+	};
+
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	const struct attr_index *index = attr_index_get();
+
+	if (index) {
+		for (uint16_t i = attr_index_lower_bound(index, start_handle);
+		     i < index->count; i++) {
+			const struct attr_index_entry *entry =
+				&index->entries[i];
+
+			if (entry->handle > end_handle) {
+				break;
+			}
+
+			if (!attr_index_is_service(entry) ||
+			    bt_uuid_cmp(entry->attr->uuid, uuid)) {
+				continue;
+			}
+
+			if (func(entry->attr, entry->handle,
+				 MIN(entry->group_end, end_handle),
+				 user_data) == BT_GATT_ITER_STOP) {
+				break;
+			}
+		}
+
+		attr_index_put();
+		return;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
+	/* Groups are only reported once their end handle is known */
+	bt_gatt_foreach_attr(start_handle, end_handle, foreach_group_cb, &data);
+
+	if (data.func) {
+		(void)foreach_group_flush(&data);
+	}
+}
+
 static uint8_t find_next(const struct bt_gatt_attr *attr, uint16_t handle,
 			 void *user_data)
 {
@@ -34,6 +34,17 @@ int bt_gatt_store_ccc(uint8_t id, const bt_addr_le_t *addr);
 
 int bt_gatt_clear(uint8_t id, const bt_addr_le_t *addr);
 
+typedef uint8_t (*bt_gatt_group_func_t)(const struct bt_gatt_attr *attr,
+					uint16_t handle, uint16_t end_handle,
+					void *user_data);
+
+/* Iterate over the service declarations of type uuid within the handle
+ * range, passing the last handle of each group clipped to end_handle.
+ */
+void bt_gatt_foreach_attr_group(uint16_t start_handle, uint16_t end_handle,
+				const struct bt_uuid *uuid,
+				bt_gatt_group_func_t func, void *user_data);
+
 #if defined(CONFIG_BT_GATT_CLIENT)
 void bt_gatt_notification(struct bt_conn *conn, uint16_t handle,
 			  const void *data, uint16_t length);
@@ -2386,6 +2386,17 @@ static void process_events(struct k_poll_event *ev, int count)
 				}
 			}
 			break;
+#if defined(CONFIG_BT_L2CAP_TX_FRAG_VIEW)
+		case K_POLL_STATE_SEM_AVAILABLE:
+			if (ev->tag == BT_EVENT_CONN_FRAG_VIEW) {
+				struct bt_conn *conn;
+
+				conn = CONTAINER_OF(ev->sem, struct bt_conn,
+						    frag_view_sem);
+				bt_conn_process_tx(conn);
+			}
+			break;
+#endif /* CONFIG_BT_L2CAP_TX_FRAG_VIEW */
 		case K_POLL_STATE_NOT_READY:
 			break;
 		default:
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Compressed RAM-based backing store
+ */
+#include <mmu.h>
+#include <string.h>
+#include <kernel_arch_interface.h>
+#include <sys/mem_manage.h>
+#include <sys/util.h>
+#include <logging/log.h>
+
+#include "compressed_codec.h"
+
+LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
+
+/*
+ * Evicted pages are compressed with a small LZ77 codec in the style of LZ4,
+ * and stored in a pool of fixed-size chunks, a page using as many chunks as
+ * its compressed size needs. Pages full of zeroes use no chunk at all, and
+ * pages that don't compress well are stored as they are.
+ *
+ * The location token of a page is the index of its slot times the page
+ * size, as architectures store it in page table entries. A slot records
+ * the first chunk of the page and its stored size; the chunks of a page
+ * are chained through chunk_next[].
+ *
+ * As k_mem_paging_backing_store_page_out() can't fail, getting a location
+ * reserves enough chunks for an incompressible page. The reservation is
+ * turned into the chunks actually needed when the page is paged out.
+ *
+ * Like the RAM backing store, locations are freed as soon as pages are paged
+ * in, so Z_PAGE_FRAME_BACKED is never set.
+ */
+
+#define CHUNK_SIZE	CONFIG_BACKING_STORE_COMPRESSED_CHUNK_SIZE
+#define NUM_CHUNKS	(CONFIG_BACKING_STORE_COMPRESSED_SIZE / CHUNK_SIZE)
+#define PAGE_CHUNKS	(CONFIG_MMU_PAGE_SIZE / CHUNK_SIZE)
+#define NUM_SLOTS	CONFIG_BACKING_STORE_COMPRESSED_PAGES
+
+BUILD_ASSERT(CONFIG_MMU_PAGE_SIZE % CHUNK_SIZE == 0,
+	     "chunk size must divide the page size");
+BUILD_ASSERT(NUM_CHUNKS >= 2 * PAGE_CHUNKS,
+	     "backing store must hold at least two uncompressed pages");
+BUILD_ASSERT(NUM_CHUNKS < UINT16_MAX && NUM_SLOTS < UINT16_MAX,
+	     "chunk and slot indexes must fit 16 bits");
+
+#define NO_INDEX	UINT16_MAX
+
+/* Stored size of a slot that was reserved but not paged out yet */
+#define SLOT_RESERVED	UINT16_MAX
+
+struct slot {
+	/* First chunk of the page, or next free slot if the slot is free */
+	uint16_t first;
+	/* Stored size: 0 for a zero page, the page size if uncompressed */
+	uint16_t size;
+};
+
+static uint8_t chunks[NUM_CHUNKS][CHUNK_SIZE];
+static uint16_t chunk_next[NUM_CHUNKS];
+static uint16_t free_chunk;
+static size_t free_chunks;
+/* Free chunks promised to slots not paged out yet */
+static size_t reserved_chunks;
+
+static struct slot slots[NUM_SLOTS];
+static uint16_t free_slot;
+static size_t free_slots;
+
+static struct k_mem_paging_backing_store_compressed_stats stats;
+
+/* Compressed page, before it is split into chunks or after it is gathered
+ * from them. Page-ins and page-outs are serialized.
+ */
+static uint8_t buffer[CONFIG_MMU_PAGE_SIZE];
+
+static bool is_zero_page(const uint8_t *page)
+{
+	const uint32_t *word = (const uint32_t *)page;
+
+	for (size_t i = 0; i < CONFIG_MMU_PAGE_SIZE / sizeof(*word); i++) {
+		if (word[i] != 0U) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/*
+ * Space management
+ */
+
+static struct slot *location_to_slot(uintptr_t location)
+{
+	__ASSERT(location % CONFIG_MMU_PAGE_SIZE == 0,
+		 "unaligned location 0x%lx", location);
+	__ASSERT(location < NUM_SLOTS * CONFIG_MMU_PAGE_SIZE,
+		 "bad location 0x%lx, past bounds of backing store", location);
+
+	return &slots[location / CONFIG_MMU_PAGE_SIZE];
+}
+
+static inline size_t size_to_chunks(size_t size)
+{
+	return DIV_ROUND_UP(size, CHUNK_SIZE);
+}
+
+/* Copy data to newly allocated chunks, return the first one */
+static uint16_t chunks_store(const uint8_t *data, size_t size)
+{
+	uint16_t first = NO_INDEX, *prev = &first;
+	uint16_t chunk;
+	size_t len;
+
+	for (; size > 0; size -= len, data += len) {
+		len = MIN(size, CHUNK_SIZE);
+
+		chunk = free_chunk;
+		__ASSERT(chunk != NO_INDEX, "chunk count mismatch");
+		free_chunk = chunk_next[chunk];
+		free_chunks--;
+
+		memcpy(chunks[chunk], data, len);
+		*prev = chunk;
+		prev = &chunk_next[chunk];
+	}
+	*prev = NO_INDEX;
+
+	return first;
+}
+
+static void chunks_load(uint16_t chunk, uint8_t *data, size_t size)
+{
+	size_t len;
+
+	for (; size > 0; size -= len, data += len) {
+		len = MIN(size, CHUNK_SIZE);
+		memcpy(data, chunks[chunk], len);
+		chunk = chunk_next[chunk];
+	}
+}
+
+static void chunks_free(uint16_t chunk)
+{
+	uint16_t next;
+
+	while (chunk != NO_INDEX) {
+		next = chunk_next[chunk];
+		chunk_next[chunk] = free_chunk;
+		free_chunk = chunk;
+		free_chunks++;
+		chunk = next;
+	}
+}
+
+int k_mem_paging_backing_store_location_get(struct z_page_frame *pf,
+					    uintptr_t *location,
+					    bool page_fault)
+{
+	/* Keep room for one more page for page faults */
+	size_t pages = page_fault ? 1 : 2;
+	uint16_t index;
+
+	if (free_slots < pages ||
+	    free_chunks - reserved_chunks < pages * PAGE_CHUNKS) {
+		return -ENOMEM;
+	}
+
+	index = free_slot;
+	free_slot = slots[index].first;
+	free_slots--;
+
+	slots[index].first = NO_INDEX;
+	slots[index].size = SLOT_RESERVED;
+	reserved_chunks += PAGE_CHUNKS;
+
+	*location = index * CONFIG_MMU_PAGE_SIZE;
+
+	return 0;
+}
+
+void k_mem_paging_backing_store_location_free(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+
+	if (slot->size == SLOT_RESERVED) {
+		reserved_chunks -= PAGE_CHUNKS;
+	} else {
+		chunks_free(slot->first);
+		stats.pages--;
+		stats.bytes -= slot->size;
+	}
+
+	slot->first = free_slot;
+	free_slot = slot - slots;
+	free_slots++;
+}
+
+void k_mem_paging_backing_store_page_out(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+	const uint8_t *data = Z_SCRATCH_PAGE;
+	size_t size;
+	int key;
+
+	__ASSERT(slot->size == SLOT_RESERVED, "location 0x%lx in use",
+		 location);
+
+	if (is_zero_page(data)) {
+		size = 0;
+		stats.zero_pages++;
+	} else {
+		/* Only keep the compressed data if it saves a chunk */
+		size = compress_page(data, buffer,
+				     CONFIG_MMU_PAGE_SIZE - CHUNK_SIZE);
+		if (size == 0) {
+			size = CONFIG_MMU_PAGE_SIZE;
+			stats.raw_pages++;
+		} else {
+			data = buffer;
+		}
+	}
+
+	/* Location management runs with interrupts locked */
+	key = irq_lock();
+	reserved_chunks -= PAGE_CHUNKS;
+	slot->first = chunks_store(data, size);
+	slot->size = size;
+	stats.pages++;
+	stats.bytes += size;
+	stats.page_outs++;
+	irq_unlock(key);
+}
+
+void k_mem_paging_backing_store_page_in(uintptr_t location)
+{
+	struct slot *slot = location_to_slot(location);
+
+	__ASSERT(slot->size != SLOT_RESERVED, "location 0x%lx not paged out",
+		 location);
+
+	if (slot->size == 0) {
+		(void)memset(Z_SCRATCH_PAGE, 0, CONFIG_MMU_PAGE_SIZE);
+	} else if (slot->size == CONFIG_MMU_PAGE_SIZE) {
+		chunks_load(slot->first, Z_SCRATCH_PAGE, CONFIG_MMU_PAGE_SIZE);
+	} else {
+		chunks_load(slot->first, buffer, slot->size);
+		if (!decompress_page(buffer, slot->size, Z_SCRATCH_PAGE)) {
+			/* The contents of the page are lost */
+			LOG_ERR("corrupted page at location 0x%lx", location);
+			k_panic();
+		}
+	}
+}
+
+void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
+					      uintptr_t location)
+{
+	k_mem_paging_backing_store_location_free(location);
+}
+
+void k_mem_paging_backing_store_compressed_stats_get(
+	struct k_mem_paging_backing_store_compressed_stats *s)
+{
+	int key = irq_lock();
+
+	*s = stats;
+	irq_unlock(key);
+}
+
+void k_mem_paging_backing_store_init(void)
+{
+	size_t i;
+
+	for (i = 0; i < NUM_CHUNKS; i++) {
+		chunk_next[i] = i + 1 < NUM_CHUNKS ? i + 1 : NO_INDEX;
+	}
+	free_chunk = 0;
+	free_chunks = NUM_CHUNKS;
+	reserved_chunks = 0;
+
+	for (i = 0; i < NUM_SLOTS; i++) {
+		slots[i].first = i + 1 < NUM_SLOTS ? i + 1 : NO_INDEX;
+	}
+	free_slot = 0;
+	free_slots = NUM_SLOTS;
+}
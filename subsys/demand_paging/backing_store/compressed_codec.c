@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Page codec of the compressed RAM-based backing store
+ */
+#include <string.h>
+#include <toolchain.h>
+#include <sys/byteorder.h>
+#include <sys/util.h>
+
+#include "compressed_codec.h"
+
+/*
+ * A compressed page is a series of sequences, each made of:
+ * - a token byte, the number of literals in the upper 4 bits and the match
+ *   length minus MIN_MATCH in the lower 4 bits, a value of 15 meaning the
+ *   length continues in the following bytes, each adding up to 255
+ * - the literals
+ * - the match offset on 2 bytes, little endian, and the rest of the match
+ *   length if any
+ *
+ * The last sequence has literals only and ends the page.
+ */
+
+#define MIN_MATCH	4
+#define HASH_BITS	10
+#define NO_POS		UINT16_MAX
+
+/* Position in the page of the last occurrence of each hashed 4 bytes */
+static uint16_t hash_table[1 << HASH_BITS];
+
+static inline uint32_t read32(const uint8_t *p)
+{
+	return UNALIGNED_GET((const uint32_t *)p);
+}
+
+static inline uint32_t hash(uint32_t seq)
+{
+	return (seq * 2654435761U) >> (32 - HASH_BITS);
+}
+
+static inline size_t extra_size(size_t len)
+{
+	return len < 15 ? 0 : (len - 15) / 255 + 1;
+}
+
+static uint8_t *put_extra(uint8_t *op, size_t len)
+{
+	for (len -= 15; len >= 255; len -= 255) {
+		*op++ = 255;
+	}
+	*op++ = len;
+
+	return op;
+}
+
+/* Append a sequence, or return NULL if it doesn't fit before oend */
+static uint8_t *put_sequence(uint8_t *op, const uint8_t *oend,
+			     const uint8_t *literals, size_t lit_len,
+			     uint16_t offset, size_t match_len)
+{
+	size_t ml = match_len != 0 ? match_len - MIN_MATCH : 0;
+	size_t needed = 1 + extra_size(lit_len) + lit_len;
+
+	if (match_len != 0) {
+		needed += 2 + extra_size(ml);
+	}
+
+	if (needed > (size_t)(oend - op)) {
+		return NULL;
+	}
+
+	*op++ = (MIN(lit_len, 15) << 4) | MIN(ml, 15);
+	if (lit_len >= 15) {
+		op = put_extra(op, lit_len);
+	}
+
+	memcpy(op, literals, lit_len);
+	op += lit_len;
+
+	if (match_len != 0) {
+		sys_put_le16(offset, op);
+		op += 2;
+		if (ml >= 15) {
+			op = put_extra(op, ml);
+		}
+	}
+
+	return op;
+}
+
+size_t compress_page(const uint8_t *src, uint8_t *dst, size_t size)
+{
+	const uint8_t *end = src + CONFIG_MMU_PAGE_SIZE;
+	const uint8_t *ip = src, *anchor = src;
+	const uint8_t *oend = dst + size;
+	uint8_t *op = dst;
+	unsigned int misses = 0;
+
+	memset(hash_table, 0xff, sizeof(hash_table));
+
+	while (ip <= end - MIN_MATCH) {
+		uint32_t seq = read32(ip);
+		uint32_t h = hash(seq);
+		uint16_t ref = hash_table[h];
+		size_t len = MIN_MATCH;
+
+		hash_table[h] = ip - src;
+
+		if (ref == NO_POS || read32(src + ref) != seq) {
+			/* Skip faster through data that doesn't compress */
+			ip += 1 + (misses++ >> 5);
+			continue;
+		}
+
+		misses = 0;
+		while (ip + len < end && ip[len] == src[ref + len]) {
+			len++;
+		}
+
+		op = put_sequence(op, oend, anchor, ip - anchor,
+				  ip - (src + ref), len);
+		if (op == NULL) {
+			return 0;
+		}
+
+		ip += len;
+		anchor = ip;
+	}
+
+	op = put_sequence(op, oend, anchor, end - anchor, 0, 0);
+
+	return op == NULL ? 0 : op - dst;
+}
+
+static bool get_extra(const uint8_t **ip, const uint8_t *iend, size_t *len)
+{
+	uint8_t byte;
+
+	do {
+		if (*ip == iend) {
+			return false;
+		}
+		byte = *(*ip)++;
+		*len += byte;
+	} while (byte == 255);
+
+	return true;
+}
+
+bool decompress_page(const uint8_t *src, size_t size, uint8_t *dst)
+{
+	const uint8_t *ip = src, *iend = src + size;
+	uint8_t *op = dst, *oend = dst + CONFIG_MMU_PAGE_SIZE;
+
+	while (ip < iend) {
+		uint8_t token = *ip++;
+		size_t len = token >> 4;
+		uint16_t offset;
+
+		if (len == 15 && !get_extra(&ip, iend, &len)) {
+			return false;
+		}
+		if (len > (size_t)(iend - ip) || len > (size_t)(oend - op)) {
+			return false;
+		}
+
+		memcpy(op, ip, len);
+		op += len;
+		ip += len;
+
+		if (ip == iend) {
+			break;
+		}
+
+		if (iend - ip < 2) {
+			return false;
+		}
+		offset = sys_get_le16(ip);
+		ip += 2;
+
+		len = token & 0xf;
+		if (len == 15 && !get_extra(&ip, iend, &len)) {
+			return false;
+		}
+		len += MIN_MATCH;
+
+		if (offset == 0 || offset > op - dst ||
+		    len > (size_t)(oend - op)) {
+			return false;
+		}
+
+		/* Matches may overlap their own output */
+		for (; len > 0; len--, op++) {
+			*op = *(op - offset);
+		}
+	}
+
+	return op == oend;
+}
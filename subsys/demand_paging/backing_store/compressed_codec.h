@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DEMAND_PAGING_BACKING_STORE_COMPRESSED_CODEC_H_
+#define ZEPHYR_SUBSYS_DEMAND_PAGING_BACKING_STORE_COMPRESSED_CODEC_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Compress a page of CONFIG_MMU_PAGE_SIZE bytes
+ *
+ * Not reentrant, callers must serialize compressions.
+ *
+ * @param src Page to compress
+ * @param dst Buffer for the compressed data
+ * @param size Size of dst
+ *
+ * @return Size of the compressed data, or 0 if it would not fit in size
+ *         bytes, in which case the contents of dst are undefined
+ */
+size_t compress_page(const uint8_t *src, uint8_t *dst, size_t size);
+
+/**
+ * Decompress a page compressed by compress_page()
+ *
+ * @param src Compressed data
+ * @param size Size of the compressed data
+ * @param dst Buffer of CONFIG_MMU_PAGE_SIZE bytes for the page
+ *
+ * @return true if the data decoded to exactly one page, false if it is
+ *         corrupted
+ */
+bool decompress_page(const uint8_t *src, size_t size, uint8_t *dst);
+
+#endif /* ZEPHYR_SUBSYS_DEMAND_PAGING_BACKING_STORE_COMPRESSED_CODEC_H_ */
@@ -121,6 +121,17 @@ void k_mem_paging_backing_store_page_in(uintptr_t location)
 		     CONFIG_MMU_PAGE_SIZE);
 }
 
+void k_mem_paging_backing_store_page_in_batch(const uintptr_t *locations,
+					      struct z_page_frame **frames,
+					      size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		arch_mem_scratch(z_page_frame_to_phys(frames[i]));
+		(void)memcpy(Z_SCRATCH_PAGE, location_to_slab(locations[i]),
+			     CONFIG_MMU_PAGE_SIZE);
+	}
+}
+
 void k_mem_paging_backing_store_page_finalize(struct z_page_frame *pf,
 					      uintptr_t location)
 {
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Clock (second chance) eviction algorithm for demand paging
+ */
+#include <kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+/* Index of the next page frame the hand looks at. Eviction selection runs
+ * with interrupts locked, so no other locking is needed.
+ */
+static size_t hand;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf;
+	uintptr_t flags;
+	size_t i;
+
+	/* Accessed pages get their accessed state cleared the first time
+	 * the hand passes them, so two turns always find a page unless
+	 * every page is pinned.
+	 */
+	for (i = 0; i < 2 * Z_NUM_PAGE_FRAMES; i++) {
+		pf = &z_page_frames[hand];
+		hand = (hand + 1) % Z_NUM_PAGE_FRAMES;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, false);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			/* Second chance */
+			(void)arch_page_info_get(pf->addr, NULL, true);
+			continue;
+		}
+
+		*dirty_ptr = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+		return pf;
+	}
+
+	/* Shouldn't ever happen unless every page is pinned */
+	__ASSERT(false, "no page to evict");
+
+	return NULL;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Approximate Least Recently Used (LRU) eviction algorithm for demand paging
+ */
+#include <kernel.h>
+#include <mmu.h>
+#include <kernel_arch_interface.h>
+
+#define AGE_TOP BIT(CONFIG_EVICTION_LRU_AGE_BITS - 1)
+
+/* Aging counter of each page frame: the accessed state sampled by the
+ * last passes of the hand, the most recent one in the top bit.
+ */
+static uint8_t ages[Z_NUM_PAGE_FRAMES];
+
+/* Index of the next page frame the hand looks at. Eviction selection runs
+ * with interrupts locked, so no other locking is needed.
+ */
+static size_t hand;
+
+struct z_page_frame *k_mem_paging_eviction_select(bool *dirty_ptr)
+{
+	struct z_page_frame *pf, *last_pf = NULL;
+	unsigned int last_age = UINT_MAX;
+	bool last_dirty = false;
+	uintptr_t flags;
+	size_t i, idx;
+
+	/* Age the page frames as the hand passes them, and stop at the first
+	 * one that was not accessed for CONFIG_EVICTION_LRU_AGE_BITS passes.
+	 * Failing that, take the oldest one of the turn.
+	 */
+	for (i = 0; i < Z_NUM_PAGE_FRAMES; i++) {
+		idx = hand;
+		pf = &z_page_frames[idx];
+		hand = (hand + 1) % Z_NUM_PAGE_FRAMES;
+
+		if (!z_page_frame_is_evictable(pf)) {
+			continue;
+		}
+
+		flags = arch_page_info_get(pf->addr, NULL, false);
+
+		/* Implies a mismatch with page frame ontology and page
+		 * tables
+		 */
+		__ASSERT((flags & ARCH_DATA_PAGE_LOADED) != 0U,
+			 "non-present page, %s",
+			 ((flags & ARCH_DATA_PAGE_NOT_MAPPED) != 0U) ?
+			 "un-mapped" : "paged out");
+
+		ages[idx] >>= 1;
+		if ((flags & ARCH_DATA_PAGE_ACCESSED) != 0UL) {
+			ages[idx] |= AGE_TOP;
+			(void)arch_page_info_get(pf->addr, NULL, true);
+		}
+
+		if (ages[idx] < last_age) {
+			last_age = ages[idx];
+			last_pf = pf;
+			last_dirty = (flags & ARCH_DATA_PAGE_DIRTY) != 0UL;
+
+			if (last_age == 0U) {
+				break;
+			}
+		}
+	}
+
+	if (last_pf == NULL) {
+		/* Shouldn't ever happen unless every page is pinned */
+		__ASSERT(false, "no page to evict");
+
+		return NULL;
+	}
+
+	/* The frame will hold a new page, which starts its own history */
+	ages[last_pf - z_page_frames] = 0U;
+	*dirty_ptr = last_dirty;
+
+	return last_pf;
+}
+
+void k_mem_paging_eviction_init(void)
+{
+}
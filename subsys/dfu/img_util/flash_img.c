@@ -89,6 +89,47 @@ int flash_img_init(struct flash_img_context *ctx)
 	return flash_img_init_id(ctx, UPLOAD_FLASH_AREA_ID);
 }
 
+#if defined(CONFIG_IMG_STREAM_HASH)
+/* Compare against the digest calculated while writing, which applies only if
+ * the checked content is exactly what was written through ctx. Returns
+ * -ENOENT if the digest does not apply.
+ */
+static int flash_img_check_stream_hash(struct flash_img_context *ctx,
+				       const struct flash_img_check *fic,
+				       uint8_t area_id)
+{
+	const struct flash_area *fa;
+	uint8_t hash[TC_SHA256_DIGEST_SIZE];
+	bool applies;
+	int rc;
+
+	if (fic->match == NULL || fic->clen == 0 || ctx->stream.fdev == NULL) {
+		return -ENOENT;
+	}
+
+	rc = flash_area_open(area_id, &fa);
+	if (rc) {
+		return rc;
+	}
+
+	applies = ctx->stream.fdev == flash_area_get_device(fa) &&
+		  ctx->stream.offset == fa->fa_off &&
+		  stream_flash_bytes_written(&ctx->stream) == fic->clen;
+
+	flash_area_close(fa);
+
+	if (!applies || stream_flash_hash_get(&ctx->stream, hash) != 0) {
+		return -ENOENT;
+	}
+
+	if (memcmp(hash, fic->match, sizeof(hash))) {
+		return -EILSEQ;
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_IMG_ENABLE_IMAGE_CHECK)
 int flash_img_check(struct flash_img_context *ctx,
 		    const struct flash_img_check *fic,
@@ -101,6 +142,13 @@ int flash_img_check(struct flash_img_context *ctx,
 		return -EINVAL;
 	}
 
+#if defined(CONFIG_IMG_STREAM_HASH)
+	rc = flash_img_check_stream_hash(ctx, fic, area_id);
+	if (rc != -ENOENT) {
+		return rc;
+	}
+#endif
+
 	rc = flash_area_open(area_id,
 			     (const struct flash_area **)&(ctx->flash_area));
 	if (rc) {
@@ -78,15 +78,102 @@ static const struct fs_file_system_t *fs_type_get(int type)
 	return (ep != NULL) ? ep->fstp : NULL;
 }
 
+#ifdef CONFIG_FILE_SYSTEM_PATH_CACHE
+/* Cache of recently matched mount points, most recently used first.
+ * Only mount points with no other mount point nested beneath them are
+ * cached: for those, a path that starts with the mount point name
+ * followed by a separator cannot have a longer match, so a single
+ * prefix compare resolves it without measuring the path or walking
+ * the mount list.  Entries stay valid until a file system is mounted
+ * or unmounted.
+ */
+static struct fs_mount_t *mnt_cache[CONFIG_FILE_SYSTEM_PATH_CACHE_SIZE];
+
+/* Must be called with mutex held */
+static struct fs_mount_t *mnt_cache_find(const char *name)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(mnt_cache); ++i) {
+		struct fs_mount_t *mp = mnt_cache[i];
+		size_t len;
+
+		if (mp == NULL) {
+			break;
+		}
+
+		len = mp->mountp_len;
+		if ((strncmp(name, mp->mnt_point, len) != 0) ||
+		    ((name[len] != '/') && (name[len] != '\0'))) {
+			continue;
+		}
+
+		/* Move the hit to the front */
+		for (; i > 0; --i) {
+			mnt_cache[i] = mnt_cache[i - 1];
+		}
+		mnt_cache[0] = mp;
+
+		return mp;
+	}
+
+	return NULL;
+}
+
+/* Must be called with mutex held */
+static void mnt_cache_add(struct fs_mount_t *mp)
+{
+	size_t len = mp->mountp_len;
+	struct fs_mount_t *itr;
+	sys_dnode_t *node;
+	size_t i;
+
+	/* A root mount point has every other one nested beneath it */
+	if (len <= 1) {
+		return;
+	}
+
+	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
+		itr = CONTAINER_OF(node, struct fs_mount_t, node);
+
+		if ((itr->mountp_len > len) &&
+		    (itr->mnt_point[len] == '/') &&
+		    (strncmp(itr->mnt_point, mp->mnt_point, len) == 0)) {
+			return;
+		}
+	}
+
+	/* Insert in front, dropping the least recently used entry */
+	for (i = ARRAY_SIZE(mnt_cache) - 1; i > 0; --i) {
+		mnt_cache[i] = mnt_cache[i - 1];
+	}
+	mnt_cache[0] = mp;
+}
+
+/* Must be called with mutex held */
+static void mnt_cache_flush(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(mnt_cache); ++i) {
+		mnt_cache[i] = NULL;
+	}
+}
+#endif /* CONFIG_FILE_SYSTEM_PATH_CACHE */
+
 static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 			    const char *name, size_t *match_len)
 {
 	struct fs_mount_t *mnt_p = NULL, *itr;
 	size_t longest_match = 0;
-	size_t len, name_len = strlen(name);
+	size_t len, name_len;
 	sys_dnode_t *node;
 
 	k_mutex_lock(&mutex, K_FOREVER);
+#ifdef CONFIG_FILE_SYSTEM_PATH_CACHE
+	mnt_p = mnt_cache_find(name);
+	if (mnt_p != NULL) {
+		k_mutex_unlock(&mutex);
+		goto found;
+	}
+#endif /* CONFIG_FILE_SYSTEM_PATH_CACHE */
+	name_len = strlen(name);
 	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
 		itr = CONTAINER_OF(node, struct fs_mount_t, node);
 		len = itr->mountp_len;
@@ -114,12 +201,20 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 			longest_match = len;
 		}
 	}
+#ifdef CONFIG_FILE_SYSTEM_PATH_CACHE
+	if (mnt_p != NULL) {
+		mnt_cache_add(mnt_p);
+	}
+#endif /* CONFIG_FILE_SYSTEM_PATH_CACHE */
 	k_mutex_unlock(&mutex);
 
 	if (mnt_p == NULL) {
 		return -ENOENT;
 	}
 
+#ifdef CONFIG_FILE_SYSTEM_PATH_CACHE
+found:
+#endif /* CONFIG_FILE_SYSTEM_PATH_CACHE */
 	*mnt_pntp = mnt_p;
 	if (match_len)
 		*match_len = mnt_p->mountp_len;
@@ -709,6 +804,11 @@ int fs_mount(struct fs_mount_t *mp)
 	sys_dlist_append(&fs_mnt_list, &mp->node);
 	LOG_DBG("fs mounted at %s", log_strdup(mp->mnt_point));
 
+#ifdef CONFIG_FILE_SYSTEM_PATH_CACHE
+	/* The new mount point may be nested beneath a cached one */
+	mnt_cache_flush();
+#endif /* CONFIG_FILE_SYSTEM_PATH_CACHE */
+
 mount_err:
 	k_mutex_unlock(&mutex);
 	return rc;
@@ -749,6 +849,10 @@ int fs_unmount(struct fs_mount_t *mp)
 	sys_dlist_remove(&mp->node);
 	LOG_DBG("fs unmounted from %s", log_strdup(mp->mnt_point));
 
+#ifdef CONFIG_FILE_SYSTEM_PATH_CACHE
+	mnt_cache_flush();
+#endif /* CONFIG_FILE_SYSTEM_PATH_CACHE */
+
 unmount_err:
 	k_mutex_unlock(&mutex);
 	return rc;
@@ -317,6 +317,17 @@ enum net_verdict net_ipv4_input(struct net_pkt *pkt)
 
 	net_pkt_set_family(pkt, PF_INET);
 
+	if (net_ipv4_hdr_frag_flags(hdr) & (NET_IPV4_MORE_FRAG_MASK |
+					    NET_IPV4_FRAGH_OFFSET_MASK)) {
+		/* Fragmented packet */
+		if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT)) {
+			return net_ipv4_handle_fragment_hdr(pkt, hdr);
+		}
+
+		NET_DBG("DROP: fragmented packet");
+		goto drop;
+	}
+
 	NET_DBG("IPv4 packet received from %s to %s",
 		log_strdup(net_sprint_ipv4_addr(&hdr->src)),
 		log_strdup(net_sprint_ipv4_addr(&hdr->dst)));
@@ -204,4 +204,120 @@ static inline int net_ipv4_parse_hdr_options(struct net_pkt *pkt,
 }
 #endif
 
+/**
+ * @brief Get the fragment flags and offset of an IPv4 header.
+ *
+ * @param hdr IPv4 header
+ *
+ * @return Flags and fragment offset field in host byte order.
+ */
+static inline uint16_t net_ipv4_hdr_frag_flags(struct net_ipv4_hdr *hdr)
+{
+	return (hdr->offset[0] << 8) | hdr->offset[1];
+}
+
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+/** Store pending IPv4 fragment information that is needed for reassembly. */
+struct net_ipv4_reassembly {
+	/** IPv4 source address of the fragment */
+	struct in_addr src;
+
+	/** IPv4 destination address of the fragment */
+	struct in_addr dst;
+
+	/**
+	 * Timeout for cancelling the reassembly. The timer is used
+	 * also to detect if this reassembly slot is used or not.
+	 */
+	struct k_work_delayable timer;
+
+	/** Pointers to pending fragments */
+	struct net_pkt *pkt[CONFIG_NET_IPV4_FRAGMENT_MAX_PKT];
+
+	/** IPv4 fragment identification */
+	uint16_t id;
+
+	/** IPv4 protocol of the fragmented packet */
+	uint8_t protocol;
+};
+#else
+struct net_ipv4_reassembly;
+#endif
+
+/**
+ * @typedef net_ipv4_frag_cb_t
+ * @brief Callback used while iterating over pending IPv4 fragments.
+ *
+ * @param reass IPv4 fragment reassembly struct
+ * @param user_data A valid pointer on some user data or NULL
+ */
+typedef void (*net_ipv4_frag_cb_t)(struct net_ipv4_reassembly *reass,
+				   void *user_data);
+
+/**
+ * @brief Go through all the currently pending IPv4 fragments.
+ *
+ * @param cb Callback to call for each pending IPv4 fragment.
+ * @param user_data User specified data or NULL.
+ */
+void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data);
+
+/**
+ * @brief Handles IPv4 fragmented packets.
+ *
+ * @param pkt     Network head packet.
+ * @param hdr     The IPv4 header of the current packet
+ *
+ * @return Return verdict about the packet.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr);
+#else
+static inline enum net_verdict net_ipv4_handle_fragment_hdr(
+						struct net_pkt *pkt,
+						struct net_ipv4_hdr *hdr)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(hdr);
+
+	return NET_DROP;
+}
+#endif
+
+/**
+ * @brief Send an IPv4 packet in fragments.
+ *
+ * @param iface Network interface
+ * @param pkt Network packet
+ * @param pkt_len Length of the packet
+ * @param mtu MTU of the network interface
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+int net_ipv4_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
+				 uint16_t pkt_len, uint16_t mtu);
+#endif
+
+/**
+ * @brief Prepare packet for sending, this will split up a packet that is
+ * too large to fit into the MTU of the network interface into fragments.
+ *
+ * @param pkt Network packet
+ *
+ * @return NET_OK if the packet can be sent as is, NET_CONTINUE if it was
+ * sent in fragments, or NET_DROP if it cannot be sent.
+ */
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt);
+#else
+static inline enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+
+	return NET_OK;
+}
+#endif
+
 #endif /* __IPV4_H */
@@ -0,0 +1,663 @@
+/** @file
+ * @brief IPv4 Fragment related functions
+ */
+
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_ipv4, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <errno.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_stats.h>
+#include <net/net_context.h>
+#include <random/rand32.h>
+#include "net_private.h"
+#include "connection.h"
+#include "icmpv4.h"
+#include "udp_internal.h"
+#include "tcp_internal.h"
+#include "ipv4.h"
+#include "net_stats.h"
+
+#define IPV4_REASSEMBLY_TIMEOUT K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT)
+
+#define BUF_ALLOC_TIMEOUT K_MSEC(100)
+
+static void reassembly_timeout(struct k_work *work);
+static bool reassembly_init_done;
+
+static struct net_ipv4_reassembly
+reassembly[CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT];
+
+static struct net_ipv4_reassembly *reassembly_get(uint16_t id,
+						  struct in_addr *src,
+						  struct in_addr *dst,
+						  uint8_t protocol)
+{
+	int i, avail = -1;
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		if (k_work_delayable_remaining_get(&reassembly[i].timer) &&
+		    reassembly[i].id == id &&
+		    reassembly[i].protocol == protocol &&
+		    net_ipv4_addr_cmp(src, &reassembly[i].src) &&
+		    net_ipv4_addr_cmp(dst, &reassembly[i].dst)) {
+			return &reassembly[i];
+		}
+
+		if (k_work_delayable_remaining_get(&reassembly[i].timer)) {
+			continue;
+		}
+
+		if (avail < 0) {
+			avail = i;
+		}
+	}
+
+	if (avail < 0) {
+		return NULL;
+	}
+
+	k_work_reschedule(&reassembly[avail].timer, IPV4_REASSEMBLY_TIMEOUT);
+
+	net_ipaddr_copy(&reassembly[avail].src, src);
+	net_ipaddr_copy(&reassembly[avail].dst, dst);
+
+	reassembly[avail].id = id;
+	reassembly[avail].protocol = protocol;
+
+	return &reassembly[avail];
+}
+
+static bool reassembly_cancel(uint16_t id,
+			      struct in_addr *src,
+			      struct in_addr *dst)
+{
+	int i, j;
+
+	NET_DBG("Cancel 0x%x", id);
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		int32_t remaining;
+
+		if (reassembly[i].id != id ||
+		    !net_ipv4_addr_cmp(src, &reassembly[i].src) ||
+		    !net_ipv4_addr_cmp(dst, &reassembly[i].dst)) {
+			continue;
+		}
+
+		remaining = k_ticks_to_ms_ceil32(
+			k_work_delayable_remaining_get(&reassembly[i].timer));
+		k_work_cancel_delayable(&reassembly[i].timer);
+
+		NET_DBG("IPv4 reassembly id 0x%x remaining %d ms",
+			reassembly[i].id, remaining);
+
+		reassembly[i].id = 0U;
+
+		for (j = 0; j < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; j++) {
+			if (!reassembly[i].pkt[j]) {
+				continue;
+			}
+
+			NET_DBG("[%d] IPv4 reassembly pkt %p %zd bytes data",
+				j, reassembly[i].pkt[j],
+				net_pkt_get_len(reassembly[i].pkt[j]));
+
+			net_pkt_unref(reassembly[i].pkt[j]);
+			reassembly[i].pkt[j] = NULL;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+static void reassembly_info(char *str, struct net_ipv4_reassembly *reass)
+{
+	NET_DBG("%s id 0x%x src %s dst %s remain %d ms", str, reass->id,
+		log_strdup(net_sprint_ipv4_addr(&reass->src)),
+		log_strdup(net_sprint_ipv4_addr(&reass->dst)),
+		k_ticks_to_ms_ceil32(
+			k_work_delayable_remaining_get(&reass->timer)));
+}
+
+static void reassembly_timeout(struct k_work *work)
+{
+	struct net_ipv4_reassembly *reass =
+		CONTAINER_OF(work, struct net_ipv4_reassembly, timer);
+
+	reassembly_info("Reassembly cancelled", reass);
+
+	/* Send a ICMPv4 Time Exceeded only if we received the first
+	 * fragment (RFC 792)
+	 */
+	if (reass->pkt[0] && net_pkt_ipv4_fragment_offset(reass->pkt[0]) == 0) {
+		net_icmpv4_send_error(reass->pkt[0], NET_ICMPV4_TIME_EXCEEDED,
+				NET_ICMPV4_TIME_EXCEEDED_FRAGMENT_REASSEMBLY_TIME);
+	}
+
+	reassembly_cancel(reass->id, &reass->src, &reass->dst);
+}
+
+static void reassemble_packet(struct net_ipv4_reassembly *reass)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *ipv4_hdr;
+	struct net_pkt *pkt;
+	struct net_buf *last;
+	uint16_t flags;
+	int i;
+
+	k_work_cancel_delayable(&reass->timer);
+
+	NET_ASSERT(reass->pkt[0]);
+
+	last = net_buf_frag_last(reass->pkt[0]->buffer);
+
+	/* We start from 2nd packet which is then appended to
+	 * the first one.
+	 */
+	for (i = 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		int removed_len;
+
+		pkt = reass->pkt[i];
+		if (!pkt) {
+			break;
+		}
+
+		net_pkt_cursor_init(pkt);
+
+		/* Get rid of IPv4 header which is at the beginning of the
+		 * fragment.
+		 */
+		removed_len = net_pkt_ip_hdr_len(pkt) +
+			      net_pkt_ipv4_opts_len(pkt);
+
+		NET_DBG("Removing %d bytes from start of pkt %p",
+			removed_len, pkt->buffer);
+
+		if (net_pkt_pull(pkt, removed_len)) {
+			NET_ERR("Failed to pull headers");
+			reassembly_cancel(reass->id, &reass->src, &reass->dst);
+			return;
+		}
+
+		/* Attach the data to previous pkt */
+		last->frags = pkt->buffer;
+		last = net_buf_frag_last(pkt->buffer);
+
+		pkt->buffer = NULL;
+		reass->pkt[i] = NULL;
+
+		net_pkt_unref(pkt);
+	}
+
+	pkt = reass->pkt[0];
+	reass->pkt[0] = NULL;
+
+	/* Update the header of the first fragment to describe the whole
+	 * packet, only the Don't Fragment flag is kept.
+	 */
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!ipv4_hdr) {
+		goto error;
+	}
+
+	flags = net_ipv4_hdr_frag_flags(ipv4_hdr) &
+		NET_IPV4_DO_NOT_FRAG_MASK;
+
+	ipv4_hdr->offset[0] = flags >> 8;
+	ipv4_hdr->offset[1] = flags;
+	ipv4_hdr->len = htons(net_pkt_get_len(pkt));
+	ipv4_hdr->chksum = 0U;
+	ipv4_hdr->chksum = net_calc_chksum_ipv4(pkt);
+
+	net_pkt_set_data(pkt, &ipv4_access);
+
+	net_pkt_set_ipv4_fragment_flags(pkt, 0U);
+	net_pkt_set_ipv4_reassembled(pkt, true);
+
+	NET_DBG("New pkt %p IPv4 len is %zd bytes", pkt,
+		net_pkt_get_len(pkt));
+
+	/* We need to use the queue when feeding the packet back into the
+	 * IP stack as we might run out of stack if we call processing_data()
+	 * directly. As the packet does not contain link layer header, we
+	 * MUST NOT pass it to L2 so there will be a special check for that
+	 * in process_data() when handling the packet.
+	 */
+	if (net_recv_data(net_pkt_iface(pkt), pkt) >= 0) {
+		return;
+	}
+error:
+	net_pkt_unref(pkt);
+}
+
+void net_ipv4_frag_foreach(net_ipv4_frag_cb_t cb, void *user_data)
+{
+	int i;
+
+	for (i = 0; reassembly_init_done &&
+		     i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+		if (!k_work_delayable_remaining_get(&reassembly[i].timer)) {
+			continue;
+		}
+
+		cb(&reassembly[i], user_data);
+	}
+}
+
+static inline size_t fragment_payload_len(struct net_pkt *pkt)
+{
+	return net_pkt_get_len(pkt) - net_pkt_ip_hdr_len(pkt) -
+	       net_pkt_ipv4_opts_len(pkt);
+}
+
+/* Verify that we have all the fragments received and in correct order.
+ * Return:
+ * - a negative value if the fragments are erroneous and must be dropped
+ * - zero if we are expecting more fragments
+ * - a positive value if we can proceed with the reassembly
+ */
+static int fragments_are_ready(struct net_ipv4_reassembly *reass)
+{
+	unsigned int expected_offset = 0;
+	bool more = true;
+	int i;
+
+	/* Fragments can arrive in any order, so we need to check that we
+	 * received the first fragment, that all intermediate fragments are
+	 * contiguous and that the More Fragments flag of the last one is 0.
+	 */
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		struct net_pkt *pkt = reass->pkt[i];
+		unsigned int offset;
+
+		if (!pkt) {
+			break;
+		}
+
+		offset = net_pkt_ipv4_fragment_offset(pkt);
+
+		if (offset < expected_offset) {
+			/* Overlapping or duplicated, drop it (RFC 5722
+			 * describes the same for IPv6).
+			 */
+			return -EBADMSG;
+		} else if (offset != expected_offset) {
+			/* Not contiguous, let's wait for fragments */
+			return 0;
+		}
+
+		expected_offset += fragment_payload_len(pkt);
+		more = net_pkt_ipv4_fragment_more(pkt);
+	}
+
+	if (more) {
+		return 0;
+	}
+
+	return 1;
+}
+
+static int shift_packets(struct net_ipv4_reassembly *reass, int pos)
+{
+	int i;
+
+	for (i = pos + 1; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		if (!reass->pkt[i]) {
+			NET_DBG("Moving [%d] %p (offset 0x%x) to [%d]",
+				pos, reass->pkt[pos],
+				net_pkt_ipv4_fragment_offset(reass->pkt[pos]),
+				pos + 1);
+
+			/* pkt[i] is free, so shift everything between
+			 * [pos] and [i - 1] by one element
+			 */
+			memmove(&reass->pkt[pos + 1], &reass->pkt[pos],
+				sizeof(void *) * (i - pos));
+
+			/* pkt[pos] is now free */
+			reass->pkt[pos] = NULL;
+
+			return 0;
+		}
+	}
+
+	/* We do not have free space left in the array */
+	return -ENOMEM;
+}
+
+enum net_verdict net_ipv4_handle_fragment_hdr(struct net_pkt *pkt,
+					      struct net_ipv4_hdr *hdr)
+{
+	struct net_ipv4_reassembly *reass = NULL;
+	uint16_t flag;
+	size_t payload_len;
+	bool found;
+	uint16_t id;
+	int ret;
+	int i;
+
+	if (!reassembly_init_done) {
+		/* Static initializing does not work here because of the array
+		 * so we must do it at runtime.
+		 */
+		for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_COUNT; i++) {
+			k_work_init_delayable(&reassembly[i].timer,
+					      reassembly_timeout);
+		}
+
+		reassembly_init_done = true;
+	}
+
+	flag = net_ipv4_hdr_frag_flags(hdr);
+	id = (hdr->id[0] << 8) | hdr->id[1];
+
+	net_pkt_set_ipv4_fragment_flags(pkt, flag);
+	net_pkt_set_ipv4_fragment_id(pkt, id);
+
+	/* Check the fragment before getting a reassembly slot, so that a
+	 * malformed fragment is simply dropped by the caller.
+	 */
+	payload_len = fragment_payload_len(pkt);
+
+	if (net_pkt_ipv4_fragment_more(pkt) && payload_len % 8) {
+		/* Fragment length is not multiple of 8, discard
+		 * the packet.
+		 */
+		NET_DBG("Fragment length %zd is not multiple of 8",
+			payload_len);
+		goto drop;
+	}
+
+	if (net_pkt_ipv4_fragment_offset(pkt) + payload_len >
+	    UINT16_MAX - net_pkt_ip_hdr_len(pkt) - net_pkt_ipv4_opts_len(pkt)) {
+		/* The reassembled packet would not fit in an IPv4 packet */
+		NET_DBG("Fragment offset %u too large",
+			net_pkt_ipv4_fragment_offset(pkt));
+		goto drop;
+	}
+
+	reass = reassembly_get(id, (struct in_addr *)hdr->src,
+			       (struct in_addr *)hdr->dst, hdr->proto);
+	if (!reass) {
+		NET_DBG("Cannot get reassembly slot, dropping pkt %p", pkt);
+		goto drop;
+	}
+
+	/* The fragments might come in wrong order so place them
+	 * in reassembly chain in correct order.
+	 */
+	for (i = 0, found = false; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		if (reass->pkt[i]) {
+			if (net_pkt_ipv4_fragment_offset(reass->pkt[i]) <
+			    net_pkt_ipv4_fragment_offset(pkt)) {
+				continue;
+			}
+
+			/* Make room for this fragment. If there is no room,
+			 * then it will discard the whole reassembly.
+			 */
+			if (shift_packets(reass, i)) {
+				break;
+			}
+		}
+
+		NET_DBG("Storing pkt %p to slot %d offset %d",
+			pkt, i, net_pkt_ipv4_fragment_offset(pkt));
+		reass->pkt[i] = pkt;
+		found = true;
+
+		break;
+	}
+
+	if (!found) {
+		/* We could not add this fragment into our saved fragment
+		 * list. We must discard the whole packet at this point.
+		 */
+		NET_DBG("No slots available for 0x%x", reass->id);
+		net_pkt_unref(pkt);
+		goto drop;
+	}
+
+	ret = fragments_are_ready(reass);
+	if (ret < 0) {
+		NET_DBG("Reassembled IPv4 verify failed, dropping id %u",
+			reass->id);
+
+		/* Let the caller release the already inserted pkt */
+		if (i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT) {
+			reass->pkt[i] = NULL;
+		}
+
+		net_pkt_unref(pkt);
+		goto drop;
+	} else if (ret == 0) {
+		reassembly_info("Reassembly nth pkt", reass);
+
+		NET_DBG("More fragments to be received");
+		goto accept;
+	}
+
+	reassembly_info("Reassembly last pkt", reass);
+
+	/* The last fragment received, reassemble the packet */
+	reassemble_packet(reass);
+
+accept:
+	return NET_OK;
+
+drop:
+	if (reass) {
+		if (reassembly_cancel(reass->id, &reass->src, &reass->dst)) {
+			return NET_OK;
+		}
+	}
+
+	return NET_DROP;
+}
+
+static int send_ipv4_fragment(struct net_pkt *pkt, uint16_t id,
+			      uint16_t fit_len, uint16_t frag_offset,
+			      bool final)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	uint16_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt);
+	struct net_ipv4_hdr *ipv4_hdr;
+	struct net_pkt *frag_pkt;
+	int ret = -ENOBUFS;
+	uint16_t flags;
+
+	frag_pkt = net_pkt_alloc_with_buffer(net_pkt_iface(pkt),
+					     fit_len + hdr_len - NET_IPV4H_LEN,
+					     AF_INET, 0, BUF_ALLOC_TIMEOUT);
+	if (!frag_pkt) {
+		return -ENOMEM;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	/* Every fragment carries a copy of the original header and options,
+	 * followed by its part of the payload.
+	 */
+	if (net_pkt_copy(frag_pkt, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, frag_offset) ||
+	    net_pkt_copy(frag_pkt, pkt, fit_len)) {
+		goto fail;
+	}
+
+	net_pkt_set_ip_hdr_len(frag_pkt, net_pkt_ip_hdr_len(pkt));
+	net_pkt_set_ipv4_opts_len(frag_pkt, net_pkt_ipv4_opts_len(pkt));
+	net_pkt_set_ipv4_ttl(frag_pkt, net_pkt_ipv4_ttl(pkt));
+	net_pkt_set_priority(frag_pkt, net_pkt_priority(pkt));
+
+	net_pkt_cursor_init(frag_pkt);
+	net_pkt_set_overwrite(frag_pkt, true);
+
+	ipv4_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(frag_pkt,
+							   &ipv4_access);
+	if (!ipv4_hdr) {
+		goto fail;
+	}
+
+	flags = frag_offset / 8U;
+	if (!final) {
+		flags |= NET_IPV4_MORE_FRAG_MASK;
+	}
+
+	ipv4_hdr->len = htons(hdr_len + fit_len);
+	ipv4_hdr->id[0] = id >> 8;
+	ipv4_hdr->id[1] = id;
+	ipv4_hdr->offset[0] = flags >> 8;
+	ipv4_hdr->offset[1] = flags;
+	ipv4_hdr->chksum = 0U;
+
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(frag_pkt))) {
+		ipv4_hdr->chksum = net_calc_chksum_ipv4(frag_pkt);
+	}
+
+	if (net_pkt_set_data(frag_pkt, &ipv4_access)) {
+		goto fail;
+	}
+
+	/* If everything has been ok so far, we can send the packet. */
+	ret = net_send_data(frag_pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	/* Let this packet to be sent and hopefully it will release
+	 * the memory that can be utilized for next sent IPv4 fragment.
+	 */
+	k_yield();
+
+	return 0;
+
+fail:
+	NET_DBG("Cannot send fragment (%d)", ret);
+	net_pkt_unref(frag_pkt);
+
+	return ret;
+}
+
+int net_ipv4_send_fragmented_pkt(struct net_if *iface, struct net_pkt *pkt,
+				 uint16_t pkt_len, uint16_t mtu)
+{
+	uint16_t hdr_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ipv4_opts_len(pkt);
+	uint16_t frag_offset;
+	size_t length;
+	uint16_t id;
+	int fit_len;
+	int ret;
+
+	ARG_UNUSED(iface);
+
+	/* Each fragment, except the last one, must carry a multiple of
+	 * 8 bytes of payload.
+	 */
+	fit_len = (mtu - hdr_len) & ~7;
+	if (fit_len <= 0) {
+		NET_DBG("No room for IPv4 payload MTU %d hdrs_len %d",
+			mtu, hdr_len);
+		return -EINVAL;
+	}
+
+	id = sys_rand32_get();
+	frag_offset = 0U;
+
+	length = pkt_len - hdr_len;
+	while (length) {
+		bool final = false;
+
+		if (fit_len >= length) {
+			final = true;
+			fit_len = length;
+		}
+
+		ret = send_ipv4_fragment(pkt, id, fit_len, frag_offset, final);
+		if (ret < 0) {
+			return ret;
+		}
+
+		length -= fit_len;
+		frag_offset += fit_len;
+	}
+
+	return 0;
+}
+
+enum net_verdict net_ipv4_prepare_for_send(struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_CONTIGUOUS_DEFINE(ipv4_access, struct net_ipv4_hdr);
+	struct net_ipv4_hdr *ip_hdr;
+	uint16_t mtu;
+	size_t pkt_len;
+	int ret;
+
+	NET_ASSERT(pkt && pkt->buffer);
+
+	mtu = net_if_get_mtu(net_pkt_iface(pkt));
+	pkt_len = net_pkt_get_len(pkt);
+
+	/* TCP packets to be segmented before L2 are never fragmented */
+	if (mtu == 0U || pkt_len <= mtu || net_pkt_gso_size(pkt)) {
+		return NET_OK;
+	}
+
+	net_pkt_cursor_init(pkt);
+
+	ip_hdr = (struct net_ipv4_hdr *)net_pkt_get_data(pkt, &ipv4_access);
+	if (!ip_hdr) {
+		return NET_DROP;
+	}
+
+	if (net_ipv4_hdr_frag_flags(ip_hdr) &
+	    NET_IPV4_DO_NOT_FRAG_MASK) {
+		NET_DBG("DROP: pkt %p len %zd larger than MTU %u and DF set",
+			pkt, pkt_len, mtu);
+		return NET_DROP;
+	}
+
+	ret = net_ipv4_send_fragmented_pkt(net_pkt_iface(pkt), pkt, pkt_len,
+					   mtu);
+	if (ret < 0) {
+		NET_DBG("Cannot fragment IPv4 pkt (%d)", ret);
+
+		if (ret == -ENOMEM) {
+			/* Try to send the packet if we could not allocate
+			 * enough network packets and hope the original large
+			 * packet can be sent ok.
+			 */
+			return NET_OK;
+		}
+	}
+
+	/* We "fake" the sending of the packet here so that
+	 * tcp.c:tcp_retry_expired() will increase the ref count when
+	 * re-sending the packet. This is crucial thing to do here and will
+	 * cause free memory access if not done.
+	 */
+	if (IS_ENABLED(CONFIG_NET_TCP)) {
+		net_pkt_set_sent(pkt, true);
+	}
+
+	/* We need to unref here because we simulate the packet sending. */
+	net_pkt_unref(pkt);
+
+	/* No need to continue with the sending as the packet is now split
+	 * and its fragments will be sent separately to network.
+	 */
+	return NET_CONTINUE;
+}
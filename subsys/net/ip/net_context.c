@@ -280,6 +280,9 @@ int net_context_get(sa_family_t family,
 #if defined(CONFIG_NET_CONTEXT_SNDTIMEO)
 		contexts[i].options.sndtimeo = K_FOREVER;
 #endif
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+		contexts[i].options.sndbuf = CONFIG_NET_CONTEXT_SNDBUF_DEFAULT;
+#endif
 
 		if (IS_ENABLED(CONFIG_NET_IPV6) ||
 		    IS_ENABLED(CONFIG_NET_IPV4)) {
@@ -851,8 +854,6 @@ static inline struct net_context *find_context(void *conn_handler)
 
 int net_context_listen(struct net_context *context, int backlog)
 {
-	ARG_UNUSED(backlog);
-
 	NET_ASSERT(PART_OF_ARRAY(contexts, context));
 
 	if (!net_context_is_used(context)) {
@@ -867,7 +868,7 @@ int net_context_listen(struct net_context *context, int backlog)
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	if (net_tcp_listen(context) >= 0) {
+	if (net_tcp_listen(context, backlog) >= 0) {
 		k_mutex_unlock(&context->lock);
 		return 0;
 	}
@@ -1245,6 +1246,38 @@ static int get_context_sndtimeo(struct net_context *context,
 #endif
 }
 
+static int get_context_rcvbuf(struct net_context *context,
+			      void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+	*((uint16_t *)value) = context->options.rcvbuf;
+
+	if (len) {
+		*len = sizeof(uint16_t);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int get_context_sndbuf(struct net_context *context,
+			      void *value, size_t *len)
+{
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	*((uint16_t *)value) = context->options.sndbuf;
+
+	if (len) {
+		*len = sizeof(uint16_t);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -1323,6 +1356,12 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
+#if defined(CONFIG_NET_UDP_CHKSUM_COPY)
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+		net_pkt_chksum_track(pkt);
+	}
+#endif
+
 	ret = context_write_data(pkt, buf, len, msg);
 	if (ret) {
 		return ret;
@@ -1621,6 +1660,18 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_SNDBUF) &&
+	    net_context_get_ip_proto(context) == IPPROTO_TCP) {
+		/* Do not take buffers that the connection cannot queue */
+		size_t space = net_tcp_send_buf_space(context);
+
+		if (space == 0) {
+			return -EAGAIN;
+		}
+
+		len = MIN(len, space);
+	}
+
 	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
 	if (!pkt) {
 		return -ENOBUFS;
@@ -2213,6 +2264,38 @@ static int set_context_sndtimeo(struct net_context *context,
 #endif
 }
 
+static int set_context_rcvbuf(struct net_context *context,
+			      const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+	if (len != sizeof(uint16_t)) {
+		return -EINVAL;
+	}
+
+	context->options.rcvbuf = *((uint16_t *)value);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
+static int set_context_sndbuf(struct net_context *context,
+			      const void *value, size_t len)
+{
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	if (len != sizeof(uint16_t)) {
+		return -EINVAL;
+	}
+
+	context->options.sndbuf = *((uint16_t *)value);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -2243,6 +2326,12 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_SNDTIMEO:
 		ret = set_context_sndtimeo(context, value, len);
 		break;
+	case NET_OPT_RCVBUF:
+		ret = set_context_rcvbuf(context, value, len);
+		break;
+	case NET_OPT_SNDBUF:
+		ret = set_context_sndbuf(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2280,6 +2369,12 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_SNDTIMEO:
 		ret = get_context_sndtimeo(context, value, len);
 		break;
+	case NET_OPT_RCVBUF:
+		ret = get_context_rcvbuf(context, value, len);
+		break;
+	case NET_OPT_SNDBUF:
+		ret = get_context_sndbuf(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
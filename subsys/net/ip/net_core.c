@@ -57,8 +57,8 @@ LOG_MODULE_REGISTER(net_core, CONFIG_NET_CORE_LOG_LEVEL);
 
 #include "net_stats.h"
 
-static inline enum net_verdict process_data(struct net_pkt *pkt,
-					    bool is_loopback)
+static inline enum net_verdict process_l2(struct net_pkt *pkt,
+					  bool is_loopback)
 {
 	int ret;
 	bool locally_routed = false;
@@ -78,6 +78,11 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	}
 #endif
 
+	/* Same for a reassembled IPv4 packet */
+	if (net_pkt_is_ipv4_reassembled(pkt)) {
+		locally_routed = true;
+	}
+
 	/* If there is no data, then drop the packet. */
 	if (!pkt->frags) {
 		NET_DBG("Corrupted packet (frags %p)", pkt->frags);
@@ -105,11 +110,12 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 		return ret;
 	}
 
-	ret = net_canbus_socket_input(pkt);
-	if (ret != NET_CONTINUE) {
-		return ret;
-	}
+	return net_canbus_socket_input(pkt);
+}
 
+static inline enum net_verdict process_l3(struct net_pkt *pkt,
+					  bool is_loopback)
+{
 	/* L2 has modified the buffer starting point, it is easier
 	 * to re-initialize the cursor rather than updating it.
 	 */
@@ -135,15 +141,38 @@ static inline enum net_verdict process_data(struct net_pkt *pkt,
 	return NET_DROP;
 }
 
-static void processing_data(struct net_pkt *pkt, bool is_loopback)
+static inline enum net_verdict process_data(struct net_pkt *pkt,
+					    bool is_loopback)
+{
+	enum net_verdict ret;
+
+	ret = process_l2(pkt, is_loopback);
+	if (ret != NET_CONTINUE) {
+		return ret;
+	}
+
+	return process_l3(pkt, is_loopback);
+}
+
+static void processing_data(struct net_pkt *pkt, bool is_loopback,
+			    bool l2_done)
 {
+	enum net_verdict ret;
+
 again:
-	switch (process_data(pkt, is_loopback)) {
+	if (l2_done) {
+		ret = process_l3(pkt, is_loopback);
+	} else {
+		ret = process_data(pkt, is_loopback);
+	}
+
+	switch (ret) {
 	case NET_CONTINUE:
 		if (IS_ENABLED(CONFIG_NET_L2_VIRTUAL)) {
 			/* If we have a tunneling packet, feed it back
 			 * to the stack in this case.
 			 */
+			l2_done = false;
 			goto again;
 		} else {
 			NET_DBG("Dropping pkt %p", pkt);
@@ -332,7 +361,7 @@ int net_send_data(struct net_pkt *pkt)
 		 * to RX processing.
 		 */
 		NET_DBG("Loopback pkt %p back to us", pkt);
-		processing_data(pkt, true);
+		processing_data(pkt, true, false);
 		return 0;
 	}
 
@@ -343,9 +372,21 @@ int net_send_data(struct net_pkt *pkt)
 	return 0;
 }
 
+static bool is_loopback_iface(struct net_if *iface)
+{
+	if (IS_ENABLED(CONFIG_NET_LOOPBACK)) {
+#ifdef CONFIG_NET_L2_DUMMY
+		if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
+			return true;
+		}
+#endif
+	}
+
+	return false;
+}
+
 static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 {
-	bool is_loopback = false;
 	size_t pkt_len;
 
 	pkt_len = net_pkt_get_len(pkt);
@@ -354,15 +395,7 @@ static void net_rx(struct net_if *iface, struct net_pkt *pkt)
 
 	net_stats_update_bytes_recv(iface, pkt_len);
 
-	if (IS_ENABLED(CONFIG_NET_LOOPBACK)) {
-#ifdef CONFIG_NET_L2_DUMMY
-		if (net_if_l2(iface) == &NET_L2_GET_NAME(DUMMY)) {
-			is_loopback = true;
-		}
-#endif
-	}
-
-	processing_data(pkt, is_loopback);
+	processing_data(pkt, is_loopback_iface(iface), false);
 
 	net_print_statistics();
 	net_pkt_print();
@@ -377,6 +410,50 @@ void net_process_rx_packet(struct net_pkt *pkt)
 	net_rx(net_pkt_iface(pkt), pkt);
 }
 
+#if defined(CONFIG_NET_TCP_GRO)
+struct net_pkt *net_process_rx_l2(struct net_pkt *pkt)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+	size_t pkt_len;
+
+	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
+
+	net_capture_pkt(iface, pkt);
+
+	pkt_len = net_pkt_get_len(pkt);
+
+	NET_DBG("Received pkt %p len %zu", pkt, pkt_len);
+
+	net_stats_update_bytes_recv(iface, pkt_len);
+
+	switch (process_l2(pkt, is_loopback_iface(iface))) {
+	case NET_CONTINUE:
+		return pkt;
+	case NET_OK:
+		NET_DBG("Consumed pkt %p", pkt);
+		break;
+	case NET_DROP:
+	default:
+		NET_DBG("Dropping pkt %p", pkt);
+		net_pkt_unref(pkt);
+		break;
+	}
+
+	net_print_statistics();
+	net_pkt_print();
+
+	return NULL;
+}
+
+void net_process_rx_l3(struct net_pkt *pkt)
+{
+	processing_data(pkt, is_loopback_iface(net_pkt_iface(pkt)), true);
+
+	net_print_statistics();
+	net_pkt_print();
+}
+#endif /* CONFIG_NET_TCP_GRO */
+
 static void net_queue_rx(struct net_if *iface, struct net_pkt *pkt)
 {
 	uint8_t prio = net_pkt_priority(pkt);
@@ -23,8 +23,10 @@ LOG_MODULE_REGISTER(net_if, CONFIG_NET_IF_LOG_LEVEL);
 #include <net/virtual.h>
 
 #include "net_private.h"
+#include "ipv4.h"
 #include "ipv6.h"
 #include "ipv4_autoconf_internal.h"
+#include "tcp_internal.h"
 
 #include "net_stats.h"
 
@@ -204,6 +206,36 @@ static void update_txtime_stats_detail(struct net_pkt *pkt,
 	}
 }
 
+#if defined(CONFIG_NET_TCP_GSO)
+static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt);
+
+static int net_if_tx_segment(struct net_pkt *pkt, void *user_data)
+{
+	net_if_tx(user_data, pkt);
+
+	return 0;
+}
+
+static bool net_if_tx_gso(struct net_if *iface, struct net_pkt *pkt)
+{
+	int ret;
+
+	net_pkt_set_queued(pkt, false);
+
+	ret = net_tcp_gso_segment(pkt, net_if_tx_segment, iface);
+	if (ret < 0) {
+		NET_DBG("Cannot segment pkt %p (%d)", pkt, ret);
+	}
+
+	/* The segments were sent instead of the original packet, release
+	 * it like the driver would do.
+	 */
+	net_pkt_unref(pkt);
+
+	return true;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
 static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 {
 	struct net_linkaddr ll_dst = {
@@ -221,6 +253,12 @@ static bool net_if_tx(struct net_if *iface, struct net_pkt *pkt)
 		return false;
 	}
 
+#if defined(CONFIG_NET_TCP_GSO)
+	if (net_pkt_gso_size(pkt)) {
+		return net_if_tx_gso(iface, pkt);
+	}
+#endif
+
 	create_time = net_pkt_create_time(pkt);
 
 	debug_check_packet(pkt);
@@ -482,6 +520,12 @@ enum net_verdict net_if_send_data(struct net_if *iface, struct net_pkt *pkt)
 		verdict = net_ipv6_prepare_for_send(pkt);
 	}
 
+	/* Split the packet if it does not fit into the MTU */
+	if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) &&
+	    net_pkt_family(pkt) == AF_INET) {
+		verdict = net_ipv4_prepare_for_send(pkt);
+	}
+
 done:
 	/*   NET_OK in which case packet has checked successfully. In this case
 	 *   the net_context callback is called after successful delivery in
@@ -961,6 +961,12 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 		max_len = 0;
 	}
 
+	if (IS_ENABLED(CONFIG_NET_TCP_GSO) && proto == IPPROTO_TCP &&
+	    (size > max_len)) {
+		/* Large TCP packets are segmented just before L2 */
+		max_len = size;
+	}
+
 	/* Family vs iface MTU */
 	if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
 		if (IS_ENABLED(CONFIG_NET_IPV6_FRAGMENT) && (size > max_len)) {
@@ -972,6 +978,13 @@ static size_t pkt_buffer_length(struct net_pkt *pkt,
 
 		max_len = MAX(max_len, NET_IPV6_MTU);
 	} else if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		if (IS_ENABLED(CONFIG_NET_IPV4_FRAGMENT) && (size > max_len)) {
+			/* We support larger packets if IPv4 fragmentation is
+			 * enabled.
+			 */
+			max_len = size;
+		}
+
 		max_len = MAX(max_len, NET_IPV4_MTU);
 	} else { /* family == AF_UNSPEC */
 #if defined (CONFIG_NET_L2_ETHERNET)
@@ -1579,6 +1592,71 @@ static void pkt_cursor_update(struct net_pkt *pkt,
 	}
 }
 
+#if defined(CONFIG_NET_UDP_CHKSUM_COPY)
+void net_pkt_chksum_track(struct net_pkt *pkt)
+{
+	pkt->chksum.start = net_pkt_get_len(pkt);
+	pkt->chksum.len = 0U;
+	pkt->chksum.sum = 0U;
+	pkt->chksum.active = 1U;
+}
+
+bool net_pkt_chksum_get(struct net_pkt *pkt, uint16_t *start, uint16_t *sum)
+{
+	if (!pkt->chksum.active) {
+		return false;
+	}
+
+	pkt->chksum.active = 0U;
+
+	if (pkt->chksum.start + pkt->chksum.len != net_pkt_get_len(pkt)) {
+		return false;
+	}
+
+	*start = pkt->chksum.start;
+	*sum = pkt->chksum.sum;
+
+	return true;
+}
+
+static inline bool pkt_chksum_appending(struct net_pkt *pkt)
+{
+	return pkt->chksum.active && !net_pkt_is_being_overwritten(pkt);
+}
+
+static void pkt_chksum_add(struct net_pkt *pkt, uint16_t sum, size_t len)
+{
+	if (pkt->chksum.len + len > UINT16_MAX) {
+		pkt->chksum.active = 0U;
+		return;
+	}
+
+	/* Data starting at an odd offset contributes byte swapped */
+	if (pkt->chksum.len & 1) {
+		sum = __bswap_16(sum);
+	}
+
+	pkt->chksum.sum += sum;
+	if (pkt->chksum.sum < sum) {
+		pkt->chksum.sum++;
+	}
+
+	pkt->chksum.len += len;
+}
+
+static void pkt_chksum_overwrite(struct net_pkt *pkt, size_t length)
+{
+	if (pkt->chksum.active &&
+	    net_pkt_get_current_offset(pkt) + length > pkt->chksum.start) {
+		pkt->chksum.active = 0U;
+	}
+}
+#else
+#define pkt_chksum_appending(...) false
+#define pkt_chksum_add(...)
+#define pkt_chksum_overwrite(...)
+#endif /* CONFIG_NET_UDP_CHKSUM_COPY */
+
 /* Internal function that does all operation (skip/read/write/memset) */
 static int net_pkt_cursor_operate(struct net_pkt *pkt,
 				  void *data, size_t length,
@@ -1587,6 +1665,13 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 	/* We use such variable to avoid lengthy lines */
 	struct net_pkt_cursor *c_op = &pkt->cursor;
 
+	/* Skipping is also accounted for, as it is used to commit data
+	 * modified in place through net_pkt_get_data().
+	 */
+	if (write && net_pkt_is_being_overwritten(pkt)) {
+		pkt_chksum_overwrite(pkt, length);
+	}
+
 	while (c_op->buf && length) {
 		size_t d_len, len;
 
@@ -1613,7 +1698,12 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 			len = d_len;
 		}
 
-		if (copy) {
+		if (copy && write && pkt_chksum_appending(pkt)) {
+			pkt_chksum_add(pkt,
+				       net_calc_chksum_copy(0, c_op->pos,
+							    data, len),
+				       len);
+		} else if (copy) {
 			memcpy(write ? c_op->pos : data,
 			       write ? data : c_op->pos,
 			       len);
@@ -1622,6 +1712,13 @@ static int net_pkt_cursor_operate(struct net_pkt *pkt,
 		}
 
 		if (write && !net_pkt_is_being_overwritten(pkt)) {
+			if (!copy && pkt_chksum_appending(pkt)) {
+				pkt_chksum_add(pkt,
+					       net_calc_chksum_buf(0, c_op->pos,
+								   len),
+					       len);
+			}
+
 			net_buf_add(c_op->buf, len);
 		}
 
@@ -1774,6 +1871,7 @@ static void clone_pkt_attributes(struct net_pkt *pkt, struct net_pkt *clone_pkt)
 	net_pkt_set_orig_iface(clone_pkt, net_pkt_orig_iface(pkt));
 	net_pkt_set_captured(clone_pkt, net_pkt_is_captured(pkt));
 	net_pkt_set_l2_bridged(clone_pkt, net_pkt_is_l2_bridged(pkt));
+	net_pkt_set_gso_size(clone_pkt, net_pkt_gso_size(pkt));
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) && net_pkt_family(pkt) == AF_INET) {
 		net_pkt_set_ipv4_ttl(clone_pkt, net_pkt_ipv4_ttl(pkt));
@@ -1903,6 +2001,59 @@ struct net_pkt *net_pkt_shallow_clone(struct net_pkt *pkt, k_timeout_t timeout)
 	return clone_pkt;
 }
 
+struct net_pkt *net_pkt_clone_slice(struct net_pkt *pkt, size_t hdr_len,
+				    size_t offset, size_t len,
+				    k_timeout_t timeout)
+{
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	struct net_pkt_cursor backup;
+	struct net_pkt *clone_pkt;
+
+#if NET_LOG_LEVEL >= LOG_LEVEL_DBG
+	clone_pkt = pkt_alloc_with_buffer(pkt->slab, net_pkt_iface(pkt),
+					  hdr_len + len, AF_UNSPEC, 0, timeout,
+					  __func__, __LINE__);
+#else
+	clone_pkt = pkt_alloc_with_buffer(pkt->slab, net_pkt_iface(pkt),
+					  hdr_len + len, AF_UNSPEC, 0, timeout);
+#endif
+	if (!clone_pkt) {
+		return NULL;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_copy(clone_pkt, pkt, hdr_len) ||
+	    net_pkt_skip(pkt, offset) ||
+	    net_pkt_copy(clone_pkt, pkt, len)) {
+		net_pkt_unref(clone_pkt);
+		clone_pkt = NULL;
+		goto out;
+	}
+
+	memcpy(&clone_pkt->lladdr_src, &pkt->lladdr_src,
+	       sizeof(clone_pkt->lladdr_src));
+	memcpy(&clone_pkt->lladdr_dst, &pkt->lladdr_dst,
+	       sizeof(clone_pkt->lladdr_dst));
+
+	clone_pkt_attributes(pkt, clone_pkt);
+
+	/* The slice is a packet of its own */
+	net_pkt_set_gso_size(clone_pkt, 0U);
+
+	net_pkt_cursor_init(clone_pkt);
+
+	NET_DBG("Cloned %zu bytes at %zu of %p to %p", len, offset, pkt,
+		clone_pkt);
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	return clone_pkt;
+}
+
 size_t net_pkt_remaining_data(struct net_pkt *pkt)
 {
 	struct net_buf *buf;
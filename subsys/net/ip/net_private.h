@@ -49,6 +49,14 @@ extern void net_if_stats_reset(struct net_if *iface);
 extern void net_if_stats_reset_all(void);
 extern void net_process_rx_packet(struct net_pkt *pkt);
 extern void net_process_tx_packet(struct net_pkt *pkt);
+#if defined(CONFIG_NET_TCP_GRO)
+/* Capture a received packet and run it through the L2. Returns the
+ * packet if it is to be passed to net_process_rx_l3(), NULL if the L2
+ * consumed or dropped it.
+ */
+extern struct net_pkt *net_process_rx_l2(struct net_pkt *pkt);
+extern void net_process_rx_l3(struct net_pkt *pkt);
+#endif
 
 #if defined(CONFIG_NET_NATIVE) || defined(CONFIG_NET_OFFLOAD)
 extern void net_context_init(void);
@@ -144,6 +152,55 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/**
+ * @brief Add the ones' complement sum of a buffer to a partial checksum
+ *
+ * @param sum Partial checksum, 0 to start a new one
+ * @param data Data to sum
+ * @param len Length of the data
+ *
+ * @return Partial checksum in host byte order, not complemented
+ */
+uint16_t net_calc_chksum_buf(uint16_t sum, const uint8_t *data, size_t len);
+
+/**
+ * @brief Copy a buffer and add its ones' complement sum to a partial
+ *        checksum in the same pass
+ *
+ * @param sum Partial checksum, 0 to start a new one
+ * @param dst Destination of the copy
+ * @param src Data to copy and sum
+ * @param len Length of the data
+ *
+ * @return Partial checksum in host byte order, not complemented
+ */
+uint16_t net_calc_chksum_copy(uint16_t sum, uint8_t *dst, const uint8_t *src,
+			      size_t len);
+
+#if defined(CONFIG_NET_UDP_CHKSUM_COPY)
+/**
+ * @brief Sum the data appended to the packet from now on while it is
+ *        copied into the packet
+ *
+ * @param pkt Network packet, its cursor must be at the end of the data
+ */
+void net_pkt_chksum_track(struct net_pkt *pkt);
+
+/**
+ * @brief Get the sum of the data appended since net_pkt_chksum_track()
+ *        and stop tracking
+ *
+ * @param pkt Network packet
+ * @param start Offset of the summed data in the packet
+ * @param sum Partial checksum of the data from start to the end of the
+ *        packet
+ *
+ * @return true if the sum is valid, false if the packet was modified in
+ *         a way that was not tracked
+ */
+bool net_pkt_chksum_get(struct net_pkt *pkt, uint16_t *start, uint16_t *sum);
+#endif /* CONFIG_NET_UDP_CHKSUM_COPY */
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -38,6 +38,7 @@ LOG_MODULE_REGISTER(net_shell, LOG_LEVEL_DBG);
 #include <sys/slist.h>
 #endif
 
+#include "ipv4.h"
 #include "ipv6.h"
 
 #if defined(CONFIG_NET_ARP)
@@ -1556,6 +1557,50 @@ static void tcp_sent_list_cb(struct tcp *conn, void *user_data)
 #endif /* CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG */
 #endif /* TCP */
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+static void ipv4_frag_cb(struct net_ipv4_reassembly *reass,
+			 void *user_data)
+{
+	struct net_shell_user_data *data = user_data;
+	const struct shell *shell = data->shell;
+	int *count = data->user_data;
+	char src[ADDR_LEN];
+	int i;
+
+	if (!*count) {
+		PR("\nIPv4 reassembly Id     Remain "
+		   "Src             \tDst\n");
+	}
+
+	snprintk(src, ADDR_LEN, "%s", net_sprint_ipv4_addr(&reass->src));
+
+	PR("%p      0x%04x  %5d %16s\t%16s\n", reass, reass->id,
+	   k_ticks_to_ms_ceil32(k_work_delayable_remaining_get(&reass->timer)),
+	   src, net_sprint_ipv4_addr(&reass->dst));
+
+	for (i = 0; i < CONFIG_NET_IPV4_FRAGMENT_MAX_PKT; i++) {
+		if (reass->pkt[i]) {
+			struct net_buf *frag = reass->pkt[i]->frags;
+
+			PR("[%d] pkt %p->", i, reass->pkt[i]);
+
+			while (frag) {
+				PR("%p", frag);
+
+				frag = frag->frags;
+				if (frag) {
+					PR("->");
+				}
+			}
+
+			PR("\n");
+		}
+	}
+
+	(*count)++;
+}
+#endif /* CONFIG_NET_IPV4_FRAGMENT */
+
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 static void ipv6_frag_cb(struct net_ipv6_reassembly *reass,
 			 void *user_data)
@@ -2066,6 +2111,14 @@ static int cmd_net_conn(const struct shell *shell, size_t argc, char *argv[])
 
 #endif
 
+#if defined(CONFIG_NET_IPV4_FRAGMENT)
+	count = 0;
+
+	net_ipv4_frag_foreach(ipv4_frag_cb, &user_data);
+
+	/* Do not print anything if no fragments are pending atm */
+#endif
+
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 	count = 0;
 
@@ -9,50 +9,290 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 
 #include <zephyr.h>
 #include <string.h>
+#include <random/rand32.h>
 
 #include <net/net_core.h>
 #include <net/net_pkt.h>
 #include <net/net_stats.h>
+#include <net/ethernet.h>
 
 #include "net_private.h"
 #include "net_stats.h"
 #include "net_tc_mapping.h"
+#include "tcp_internal.h"
+#include "ipv4.h"
 
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With several flow queues per traffic class, the name is "xx_q[y:z]" where
+ * z is the flow queue of the traffic class.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y:z]")
+
+/* Every traffic class has NET_TC_FLOW_QUEUES consecutive queues */
+#define TX_QUEUE_COUNT (NET_TC_TX_COUNT * NET_TC_FLOW_QUEUES)
+#define RX_QUEUE_COUNT (NET_TC_RX_COUNT * NET_TC_FLOW_QUEUES)
 
 /* Stacks for TX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, TX_QUEUE_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
-static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
+static struct net_traffic_class tx_classes[TX_QUEUE_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[RX_QUEUE_COUNT];
+#endif
+
+#if NET_TC_FLOW_QUEUES > 1
+static uint32_t flow_hash_seed;
+
+/* Mix one 32-bit word into the hash, as done by MurmurHash3 */
+static inline uint32_t flow_hash_add(uint32_t hash, uint32_t value)
+{
+	value *= 0xcc9e2d51U;
+	value = (value << 15) | (value >> 17);
+	value *= 0x1b873593U;
+
+	hash ^= value;
+	hash = (hash << 13) | (hash >> 19);
+
+	return hash * 5U + 0xe6546b64U;
+}
+
+static uint32_t flow_hash_add_addr(uint32_t hash, const uint8_t *addr,
+				   size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i += sizeof(uint32_t)) {
+		hash = flow_hash_add(hash,
+				     UNALIGNED_GET((const uint32_t *)&addr[i]));
+	}
+
+	return hash;
+}
+
+/* Skip the link layer header of received packets, and return the family
+ * of the IP header found at the cursor.
+ */
+static sa_family_t flow_l3_family(struct net_pkt *pkt, bool rx)
+{
+	struct net_pkt_cursor l3;
+	uint8_t vhl;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (rx && net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		struct net_eth_hdr hdr;
+		uint16_t type;
+
+		if (net_pkt_read(pkt, &hdr, sizeof(hdr))) {
+			return AF_UNSPEC;
+		}
+
+		type = ntohs(hdr.type);
+
+		if (type == NET_ETH_PTYPE_VLAN &&
+		    (net_pkt_skip(pkt, sizeof(uint16_t)) ||
+		     net_pkt_read_be16(pkt, &type))) {
+			return AF_UNSPEC;
+		}
+
+		if (type == NET_ETH_PTYPE_IP) {
+			return AF_INET;
+		}
+
+		if (type == NET_ETH_PTYPE_IPV6) {
+			return AF_INET6;
+		}
+
+		return AF_UNSPEC;
+	}
 #endif
 
+	/* Other received packets are only steered if they start with
+	 * the IP header.
+	 */
+	if (rx) {
+#if defined(CONFIG_NET_L2_DUMMY)
+		if (net_if_l2(net_pkt_iface(pkt)) != &NET_L2_GET_NAME(DUMMY)) {
+			return AF_UNSPEC;
+		}
+#else
+		return AF_UNSPEC;
+#endif
+	}
+
+	net_pkt_cursor_backup(pkt, &l3);
+
+	if (net_pkt_read_u8(pkt, &vhl)) {
+		return AF_UNSPEC;
+	}
+
+	net_pkt_cursor_restore(pkt, &l3);
+
+	switch (vhl >> 4) {
+	case 4:
+		return AF_INET;
+	case 6:
+		return AF_INET6;
+	default:
+		return AF_UNSPEC;
+	}
+}
+
+/* Hash the addresses, protocol and ports of a packet. Fragments of an IPv4
+ * datagram are all hashed without the ports so that they stay together.
+ */
+static uint32_t flow_hash(struct net_pkt *pkt, bool rx)
+{
+	bool overwrite = net_pkt_is_being_overwritten(pkt);
+	struct net_pkt_cursor backup;
+	union {
+		struct net_ipv4_hdr ipv4;
+		struct net_ipv6_hdr ipv6;
+	} hdr;
+	uint32_t hash = flow_hash_seed;
+	bool has_ports = false;
+	uint8_t proto = 0U;
+	uint16_t ports[2];
+	sa_family_t family;
+
+	net_pkt_cursor_backup(pkt, &backup);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_cursor_init(pkt);
+
+	family = flow_l3_family(pkt, rx);
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET &&
+	    !net_pkt_read(pkt, &hdr.ipv4, sizeof(hdr.ipv4))) {
+		proto = hdr.ipv4.proto;
+
+		hash = flow_hash_add_addr(hash, hdr.ipv4.src,
+					  sizeof(hdr.ipv4.src));
+		hash = flow_hash_add_addr(hash, hdr.ipv4.dst,
+					  sizeof(hdr.ipv4.dst));
+
+		has_ports = !(net_ipv4_hdr_frag_flags(&hdr.ipv4) &
+			      (NET_IPV4_MORE_FRAG_MASK |
+			       NET_IPV4_FRAGH_OFFSET_MASK)) &&
+			!net_pkt_skip(pkt, (hdr.ipv4.vhl & 0x0f) * 4U -
+				      sizeof(hdr.ipv4));
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6 &&
+		   !net_pkt_read(pkt, &hdr.ipv6, sizeof(hdr.ipv6))) {
+		/* Extension headers are not followed */
+		proto = hdr.ipv6.nexthdr;
+
+		hash = flow_hash_add_addr(hash, hdr.ipv6.src,
+					  sizeof(hdr.ipv6.src));
+		hash = flow_hash_add_addr(hash, hdr.ipv6.dst,
+					  sizeof(hdr.ipv6.dst));
+
+		has_ports = true;
+	}
+
+	if (has_ports && (proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    !net_pkt_read(pkt, ports, sizeof(ports))) {
+		hash = flow_hash_add(hash, UNALIGNED_GET((uint32_t *)ports));
+	}
+
+	hash = flow_hash_add(hash, proto);
+
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	/* Final avalanche so that all the bits select the queue */
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bU;
+	hash ^= hash >> 13;
+	hash *= 0xc2b2ae35U;
+	hash ^= hash >> 16;
+
+	return hash;
+}
+
+static void flow_hash_init(void)
+{
+	while (flow_hash_seed == 0U) {
+		flow_hash_seed = sys_rand32_get();
+	}
+}
+
+/* Select the queue of its traffic class a packet is submitted to */
+static uint8_t flow_queue(struct net_pkt *pkt, bool rx)
+{
+	struct net_if *iface = net_pkt_iface(pkt);
+
+	if (!iface || !net_if_flag_is_set(iface, NET_IF_FLOW_HASH)) {
+		return 0;
+	}
+
+	return ((uint64_t)flow_hash(pkt, rx) * NET_TC_FLOW_QUEUES) >> 32;
+}
+#else
+static inline void flow_hash_init(void) { }
+
+static inline uint8_t flow_queue(struct net_pkt *pkt, bool rx)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(rx);
+
+	return 0;
+}
+#endif /* NET_TC_FLOW_QUEUES > 1 */
+
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
 static void submit_to_queue(struct k_fifo *queue, struct net_pkt *pkt)
 {
 	k_fifo_put(queue, pkt);
 }
+
+/* Name a handler thread after its traffic class and flow queue */
+static void set_thread_name(k_tid_t tid, const char *dir, int queue)
+{
+	char name[MAX_NAME_LEN];
+
+	if (NET_TC_FLOW_QUEUES > 1) {
+		snprintk(name, sizeof(name), "%s_q[%d:%d]", dir,
+			 queue / NET_TC_FLOW_QUEUES,
+			 queue % NET_TC_FLOW_QUEUES);
+	} else {
+		snprintk(name, sizeof(name), "%s_q[%d]", dir, queue);
+	}
+
+	k_thread_name_set(tid, name);
+}
+
+/* Spread the flow queues of every traffic class over the CPUs */
+static void pin_thread(k_tid_t tid, int queue)
+{
+#if defined(CONFIG_SCHED_CPU_MASK)
+	if (NET_TC_FLOW_QUEUES > 1) {
+		k_thread_cpu_mask_clear(tid);
+		k_thread_cpu_mask_enable(tid, (queue % NET_TC_FLOW_QUEUES) %
+					 CONFIG_MP_NUM_CPUS);
+	}
+#else
+	ARG_UNUSED(tid);
+	ARG_UNUSED(queue);
+#endif
+}
 #endif
 
 bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_TX_COUNT > 0
+	int queue = tc * NET_TC_FLOW_QUEUES + flow_queue(pkt, false);
+
 	net_pkt_set_tx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&tx_classes[tc].fifo, pkt);
+	submit_to_queue(&tx_classes[queue].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -63,9 +303,11 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	int queue = tc * NET_TC_FLOW_QUEUES + flow_queue(pkt, true);
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[queue].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -237,6 +479,34 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #endif
 
 #if NET_TC_RX_COUNT > 0
+#if defined(CONFIG_NET_TCP_GRO)
+/* Every packet is captured and processed by the L2 on its own. Before
+ * going to L3, a TCP segment is merged with the segments of the same
+ * flow waiting behind it.
+ */
+static void tc_rx_process(struct k_fifo *fifo, struct net_pkt *pkt)
+{
+	struct net_pkt *next;
+
+	pkt = net_process_rx_l2(pkt);
+
+	while (pkt != NULL) {
+		pkt = net_tcp_gro_receive(fifo, pkt, &next);
+
+		net_process_rx_l3(pkt);
+
+		pkt = next;
+	}
+}
+#else
+static void tc_rx_process(struct k_fifo *fifo, struct net_pkt *pkt)
+{
+	ARG_UNUSED(fifo);
+
+	net_process_rx_packet(pkt);
+}
+#endif
+
 static void tc_rx_handler(struct k_fifo *fifo)
 {
 	struct net_pkt *pkt;
@@ -247,7 +517,7 @@ static void tc_rx_handler(struct k_fifo *fifo)
 			continue;
 		}
 
-		net_process_rx_packet(pkt);
+		tc_rx_process(fifo, pkt);
 	}
 }
 #endif
@@ -285,12 +555,14 @@ void net_tc_tx_init(void)
 	net_if_foreach(net_tc_tx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_TX_COUNT; i++) {
+	flow_hash_init();
+
+	for (i = 0; i < TX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = tx_tc2thread(i);
+		thread_priority = tx_tc2thread(i / NET_TC_FLOW_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -317,11 +589,10 @@ void net_tc_tx_init(void)
 			continue;
 		}
 
-		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
-			char name[MAX_NAME_LEN];
+		pin_thread(tid, i);
 
-			snprintk(name, sizeof(name), "tx_q[%d]", i);
-			k_thread_name_set(tid, name);
+		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
+			set_thread_name(tid, "tx", i);
 		}
 
 		k_thread_start(tid);
@@ -343,12 +614,14 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	flow_hash_init();
+
+	for (i = 0; i < RX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		thread_priority = rx_tc2thread(i / NET_TC_FLOW_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -375,11 +648,10 @@ void net_tc_rx_init(void)
 			continue;
 		}
 
-		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
-			char name[MAX_NAME_LEN];
+		pin_thread(tid, i);
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
-			k_thread_name_set(tid, name);
+		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
+			set_thread_name(tid, "rx", i);
 		}
 
 		k_thread_start(tid);
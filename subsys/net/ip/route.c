@@ -281,15 +281,228 @@ static inline void update_route_access(struct net_route_entry *route)
 	sys_slist_prepend(&routes, &route->node);
 }
 
-struct net_route_entry *net_route_lookup(struct net_if *iface,
-					 struct in6_addr *dst)
+#if defined(CONFIG_NET_ROUTE_TRIE)
+/* Path compressed binary trie of the route prefixes. A node holds the
+ * routes whose prefix is exactly the node prefix, and branches on the
+ * first bit after it. A node without routes is only kept while it has
+ * two children, so the trie never needs more than two nodes per route.
+ */
+struct route_trie_node {
+	struct route_trie_node *child[2];
+	struct net_route_entry *routes;
+	struct in6_addr prefix;
+	uint8_t prefix_len;
+	bool in_use;
+};
+
+static struct route_trie_node route_trie_nodes[CONFIG_NET_MAX_ROUTES * 2];
+static struct route_trie_node route_trie_root;
+
+static inline int trie_bit(const struct in6_addr *addr, uint8_t pos)
+{
+	return (addr->s6_addr[pos / 8] >> (7 - pos % 8)) & 1;
+}
+
+/* Number of leading bits that a and b have in common, up to max */
+static uint8_t trie_common_len(const struct in6_addr *a,
+			       const struct in6_addr *b, uint8_t max)
+{
+	uint8_t len = 0U;
+	int i;
+
+	for (i = 0; i < sizeof(a->s6_addr) && len < max; i++) {
+		uint8_t diff = a->s6_addr[i] ^ b->s6_addr[i];
+
+		if (diff == 0U) {
+			len += 8U;
+			continue;
+		}
+
+		len += __builtin_clz(diff) - (32 - 8);
+		break;
+	}
+
+	return MIN(len, max);
+}
+
+static struct route_trie_node *trie_node_alloc(const struct in6_addr *addr,
+					       uint8_t prefix_len)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(route_trie_nodes); i++) {
+		struct route_trie_node *node = &route_trie_nodes[i];
+
+		if (node->in_use) {
+			continue;
+		}
+
+		(void)memset(node, 0, sizeof(*node));
+		node->in_use = true;
+		net_ipaddr_copy(&node->prefix, addr);
+		node->prefix_len = prefix_len;
+
+		return node;
+	}
+
+	return NULL;
+}
+
+static int trie_free_count(void)
+{
+	int i, count = 0;
+
+	for (i = 0; i < ARRAY_SIZE(route_trie_nodes); i++) {
+		if (!route_trie_nodes[i].in_use) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+static int trie_insert(struct net_route_entry *route)
+{
+	struct route_trie_node *node = &route_trie_root;
+	const struct in6_addr *key = &route->addr;
+	uint8_t len = route->prefix_len;
+
+	/* An insert splits at most one node and adds one leaf, check that
+	 * both fit up front so a failure leaves the trie untouched.
+	 */
+	if (trie_free_count() < 2) {
+		return -ENOMEM;
+	}
+
+	while (node->prefix_len < len) {
+		int bit = trie_bit(key, node->prefix_len);
+		struct route_trie_node *child = node->child[bit];
+		struct route_trie_node *new;
+		uint8_t common;
+
+		if (child == NULL) {
+			new = trie_node_alloc(key, len);
+			if (new == NULL) {
+				return -ENOMEM;
+			}
+
+			node->child[bit] = new;
+			node = new;
+			break;
+		}
+
+		common = trie_common_len(key, &child->prefix,
+					 MIN(len, child->prefix_len));
+		if (common == child->prefix_len) {
+			node = child;
+			continue;
+		}
+
+		/* The prefix ends or diverges within the child prefix, so
+		 * insert a node for the common part above the child.
+		 */
+		new = trie_node_alloc(key, common);
+		if (new == NULL) {
+			return -ENOMEM;
+		}
+
+		new->child[trie_bit(&child->prefix, common)] = child;
+		node->child[bit] = new;
+		node = new;
+	}
+
+	route->trie_next = node->routes;
+	node->routes = route;
+
+	return 0;
+}
+
+static inline struct route_trie_node *
+trie_only_child(struct route_trie_node *node)
+{
+	return node->child[0] != NULL ? node->child[0] : node->child[1];
+}
+
+static void trie_remove(struct net_route_entry *route)
+{
+	struct route_trie_node *node = &route_trie_root;
+	struct route_trie_node *parent = NULL, *grandparent = NULL;
+	struct net_route_entry **prev;
+	int bit = 0, parent_bit = 0;
+
+	while (node != NULL && node->prefix_len < route->prefix_len) {
+		grandparent = parent;
+		parent_bit = bit;
+		parent = node;
+		bit = trie_bit(&route->addr, node->prefix_len);
+		node = node->child[bit];
+	}
+
+	if (node == NULL || node->prefix_len != route->prefix_len ||
+	    !net_ipv6_is_prefix(route->addr.s6_addr, node->prefix.s6_addr,
+				node->prefix_len)) {
+		return;
+	}
+
+	for (prev = &node->routes; *prev != NULL; prev = &(*prev)->trie_next) {
+		if (*prev == route) {
+			*prev = route->trie_next;
+			route->trie_next = NULL;
+			break;
+		}
+	}
+
+	if (node->routes != NULL || parent == NULL ||
+	    (node->child[0] != NULL && node->child[1] != NULL)) {
+		return;
+	}
+
+	parent->child[bit] = trie_only_child(node);
+	node->in_use = false;
+
+	/* The parent may now be left without routes and a single child */
+	if (grandparent != NULL && parent->routes == NULL &&
+	    (parent->child[0] == NULL || parent->child[1] == NULL)) {
+		grandparent->child[parent_bit] = trie_only_child(parent);
+		parent->in_use = false;
+	}
+}
+
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
+{
+	struct route_trie_node *node = &route_trie_root;
+	struct net_route_entry *found = NULL;
+
+	while (node != NULL &&
+	       net_ipv6_is_prefix(dst->s6_addr, node->prefix.s6_addr,
+				  node->prefix_len)) {
+		struct net_route_entry *route;
+
+		for (route = node->routes; route; route = route->trie_next) {
+			if (!iface || route->iface == iface) {
+				found = route;
+				break;
+			}
+		}
+
+		if (node->prefix_len == 128U) {
+			break;
+		}
+
+		node = node->child[trie_bit(dst, node->prefix_len)];
+	}
+
+	return found;
+}
+#else
+static struct net_route_entry *route_find(struct net_if *iface,
+					  struct in6_addr *dst)
 {
 	struct net_route_entry *route, *found = NULL;
 	uint8_t longest_match = 0U;
 	int i;
 
-	k_mutex_lock(&lock, K_FOREVER);
-
 	for (i = 0; i < CONFIG_NET_MAX_ROUTES && longest_match < 128; i++) {
 		struct net_nbr *nbr = get_nbr(i);
 
@@ -312,6 +525,18 @@ struct net_route_entry *net_route_lookup(struct net_if *iface,
 		}
 	}
 
+	return found;
+}
+#endif /* CONFIG_NET_ROUTE_TRIE */
+
+struct net_route_entry *net_route_lookup(struct net_if *iface,
+					 struct in6_addr *dst)
+{
+	struct net_route_entry *found;
+
+	k_mutex_lock(&lock, K_FOREVER);
+
+	found = route_find(iface, dst);
 	if (found) {
 		net_route_info("Found", found, dst);
 
@@ -460,6 +685,16 @@ struct net_route_entry *net_route_add(struct net_if *iface,
 	route->iface = iface;
 	route->preference = preference;
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	if (trie_insert(route) < 0) {
+		NET_ERR("Route trie node alloc failed!");
+		net_nbr_unref(tmp);
+		nbr_free(nbr);
+		route = NULL;
+		goto exit;
+	}
+#endif
+
 	net_route_update_lifetime(route, lifetime);
 
 	sys_slist_prepend(&routes, &route->node);
@@ -606,6 +841,10 @@ int net_route_del(struct net_route_entry *route)
 
 	sys_slist_find_and_remove(&routes, &route->node);
 
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	trie_remove(route);
+#endif
+
 	nbr = net_route_get_nbr(route);
 	if (!nbr) {
 		k_mutex_unlock(&lock);
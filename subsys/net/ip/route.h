@@ -68,6 +68,11 @@ struct net_route_entry {
 
 	/** Is the route valid forever */
 	uint8_t is_infinite : 1;
+
+#if defined(CONFIG_NET_ROUTE_TRIE)
+	/** Next route with the same prefix in the lookup trie. */
+	struct net_route_entry *trie_next;
+#endif
 };
 
 /* Route preference values, as defined in RFC 4191 */
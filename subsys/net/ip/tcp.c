@@ -31,6 +31,12 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #define FIN_TIMEOUT_MS MSEC_PER_SEC
 #define FIN_TIMEOUT K_MSEC(FIN_TIMEOUT_MS)
 
+#if defined(CONFIG_NET_TCP_GSO)
+#define GSO_MAX_SEGMENTS CONFIG_NET_TCP_GSO_MAX_SEGMENTS
+#else
+#define GSO_MAX_SEGMENTS 1
+#endif
+
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
 static int tcp_window =
@@ -51,6 +57,10 @@ static struct k_work_q tcp_work_q;
 static K_KERNEL_STACK_DEFINE(work_q_stack, CONFIG_NET_TCP_WORKQ_STACK_SIZE);
 
 static void tcp_in(struct tcp *conn, struct net_pkt *pkt);
+static void tcp_out(struct tcp *conn, uint8_t flags);
+#if defined(CONFIG_NET_TCP_SYN_QUEUE)
+static void tcp_syn_queue_purge(struct tcp *listener);
+#endif
 
 int (*tcp_send_cb)(struct net_pkt *pkt) = NULL;
 size_t (*tcp_recv_cb)(struct tcp *conn, struct net_pkt *pkt) = NULL;
@@ -355,6 +365,20 @@ static void tcp_send_queue_flush(struct tcp *conn)
 	}
 }
 
+/* A semaphore give only signals the first poll event waiting on it, so give
+ * it once per waiter to wake up every blocked sender and poller.
+ */
+static void tcp_tx_sem_wake(struct tcp *conn)
+{
+	k_sem_give(&conn->tx_sem);
+
+#if defined(CONFIG_POLL)
+	while (!sys_dlist_is_empty(&conn->tx_sem.poll_events)) {
+		k_sem_give(&conn->tx_sem);
+	}
+#endif
+}
+
 #if CONFIG_NET_TCP_LOG_LEVEL >= LOG_LEVEL_DBG
 #define tcp_conn_unref(conn)				\
 	tcp_conn_unref_debug(conn, __func__, __LINE__)
@@ -387,6 +411,10 @@ static int tcp_conn_unref(struct tcp *conn)
 		return ref_count;
 	}
 
+#if defined(CONFIG_NET_TCP_SYN_QUEUE)
+	tcp_syn_queue_purge(conn);
+#endif
+
 	k_mutex_lock(&tcp_lock, K_FOREVER);
 
 	/* If there is any pending data, pass that to application */
@@ -412,6 +440,11 @@ static int tcp_conn_unref(struct tcp *conn)
 
 	conn->context->tcp = NULL;
 
+	/* Blocked senders find the connection gone once they wake up, and
+	 * no poll event may stay linked to the freed semaphore.
+	 */
+	tcp_tx_sem_wake(conn);
+
 	net_context_unref(conn->context);
 
 	tcp_send_queue_flush(conn);
@@ -706,6 +739,30 @@ static size_t tcp_check_pending_data(struct tcp *conn, struct net_pkt *pkt,
 	return pending_len;
 }
 
+static int tcp_update_recv_wnd(struct tcp *conn, int32_t delta)
+{
+	int32_t new_win;
+	bool short_win;
+
+	new_win = conn->recv_win + delta;
+	if (new_win < 0 || new_win > UINT16_MAX) {
+		return -EINVAL;
+	}
+
+	short_win = conn->recv_win < conn_mss(conn);
+	conn->recv_win = new_win;
+
+	/* Tell the peer as soon as the window opens again, it would
+	 * otherwise wait for its retransmission timer.
+	 */
+	if (short_win && conn->recv_win >= conn_mss(conn) &&
+	    conn->state == TCP_ESTABLISHED) {
+		tcp_out(conn, ACK);
+	}
+
+	return 0;
+}
+
 static int tcp_data_get(struct tcp *conn, struct net_pkt *pkt, size_t *len)
 {
 	int ret = 0;
@@ -733,7 +790,7 @@ static int tcp_data_get(struct tcp *conn, struct net_pkt *pkt, size_t *len)
 
 		net_pkt_skip(up, net_pkt_get_len(up) - *len);
 
-		net_context_update_recv_wnd(conn->context, -*len);
+		tcp_update_recv_wnd(conn, -*len);
 
 		/* Do not pass data to application with TCP conn
 		 * locked as there could be an issue when the app tries
@@ -811,6 +868,42 @@ static int ip_header_add(struct tcp *conn, struct net_pkt *pkt)
 	return -EINVAL;
 }
 
+static uint16_t tcp_iface_mss(struct net_if *iface, sa_family_t family)
+{
+	if (family == AF_INET) {
+#if defined(CONFIG_NET_IPV4)
+		if (iface && net_if_get_mtu(iface) >= NET_IPV4TCPH_LEN) {
+			/* Detect MSS based on interface MTU minus "TCP,IP
+			 * header size"
+			 */
+			return net_if_get_mtu(iface) - NET_IPV4TCPH_LEN;
+		}
+#else
+		return 0;
+#endif /* CONFIG_NET_IPV4 */
+	}
+#if defined(CONFIG_NET_IPV6)
+	else if (family == AF_INET6) {
+		int mss = 0;
+
+		if (iface && net_if_get_mtu(iface) >= NET_IPV6TCPH_LEN) {
+			/* Detect MSS based on interface MTU minus "TCP,IP
+			 * header size"
+			 */
+			mss = net_if_get_mtu(iface) - NET_IPV6TCPH_LEN;
+		}
+
+		if (mss < NET_IPV6_MTU) {
+			mss = NET_IPV6_MTU;
+		}
+
+		return mss;
+	}
+#endif /* CONFIG_NET_IPV6 */
+
+	return 0;
+}
+
 static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
@@ -874,6 +967,8 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
+
+		net_pkt_set_gso_size(pkt, net_pkt_gso_size(data));
 	}
 
 	ret = ip_header_add(conn, pkt);
@@ -896,6 +991,11 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 		}
 	}
 
+	if (net_pkt_gso_size(pkt) && is_destination_local(pkt)) {
+		/* Local packets do not go through L2 and are not split */
+		net_pkt_set_gso_size(pkt, 0U);
+	}
+
 	ret = tcp_finalize_pkt(pkt);
 	if (ret < 0) {
 		tcp_pkt_unref(pkt);
@@ -971,6 +1071,50 @@ static bool tcp_window_full(struct tcp *conn)
 	return window_full;
 }
 
+/* Room left in the socket send buffer */
+static size_t tcp_send_buf_space(struct tcp *conn)
+{
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	size_t sndbuf = conn->context->options.sndbuf;
+
+	if (sndbuf) {
+		return sndbuf > conn->send_data_total ?
+			sndbuf - conn->send_data_total : 0;
+	}
+#endif
+
+	return SIZE_MAX;
+}
+
+/* Let the blocked senders go on once data can be queued again */
+static void tcp_tx_sem_update(struct tcp *conn)
+{
+	if (conn->state == TCP_ESTABLISHED &&
+	    (tcp_window_full(conn) || tcp_send_buf_space(conn) == 0)) {
+		/* A reset signals a poll event too, only do it when the
+		 * semaphore is available so that no poller wakes up for
+		 * nothing.
+		 */
+		if (k_sem_count_get(&conn->tx_sem) > 0) {
+			k_sem_reset(&conn->tx_sem);
+		}
+	} else {
+		tcp_tx_sem_wake(conn);
+	}
+}
+
+/* Largest receive window of the connection */
+static uint16_t tcp_recv_buf(struct net_context *context)
+{
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+	if (context->options.rcvbuf) {
+		return MAX(context->options.rcvbuf, NET_IPV6_MTU);
+	}
+#endif
+
+	return tcp_window;
+}
+
 static int tcp_unsent_len(struct tcp *conn)
 {
 	int unsent_len;
@@ -992,13 +1136,14 @@ static int tcp_unsent_len(struct tcp *conn)
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
-	int pos, len;
+	int pos, len, mss;
 	struct net_pkt *pkt;
 
+	mss = conn_mss(conn);
 	pos = conn->unacked_len;
 	len = MIN3(conn->send_data_total - conn->unacked_len,
 		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
+		   mss * GSO_MAX_SEGMENTS);
 	if (len == 0) {
 		NET_DBG("conn: %p no data to send", conn);
 		ret = -ENODATA;
@@ -1019,6 +1164,11 @@ static int tcp_send_data(struct tcp *conn)
 		goto out;
 	}
 
+	if (len > mss) {
+		/* Split into MSS sized segments by net_if just before L2 */
+		net_pkt_set_gso_size(pkt, mss);
+	}
+
 	ret = tcp_out_ext(conn, PSH | ACK, pkt, conn->seq + conn->unacked_len);
 	if (ret == 0) {
 		conn->unacked_len += len;
@@ -1240,6 +1390,7 @@ static struct tcp *tcp_conn_alloc(void)
 	k_mutex_init(&conn->lock);
 	k_fifo_init(&conn->recv_data);
 	k_sem_init(&conn->connect_sem, 0, K_SEM_MAX_LIMIT);
+	k_sem_init(&conn->tx_sem, 1, 1);
 
 	conn->in_connect = false;
 	conn->state = TCP_LISTEN;
@@ -1333,6 +1484,30 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 }
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
+#if defined(CONFIG_NET_TCP_SYN_QUEUE)
+static void tcp_syn_queue_add(struct tcp *listener, struct net_pkt *pkt,
+			      struct tcphdr *th);
+static struct tcp *tcp_syn_queue_complete(struct tcp *listener,
+					  struct net_pkt *pkt,
+					  struct tcphdr *th);
+#endif
+
+/* Link a new connection to the listening connection it was created for */
+static void tcp_conn_accepted(struct tcp *conn, struct tcp *conn_old)
+{
+	net_ipaddr_copy(&conn_old->context->remote, &conn->dst.sa);
+
+	conn->accepted_conn = conn_old;
+
+	/* Accepted connections inherit the socket buffer sizes */
+#if defined(CONFIG_NET_CONTEXT_RCVBUF)
+	conn->context->options.rcvbuf = conn_old->context->options.rcvbuf;
+#endif
+#if defined(CONFIG_NET_CONTEXT_SNDBUF)
+	conn->context->options.sndbuf = conn_old->context->options.sndbuf;
+#endif
+	conn->recv_win = tcp_recv_buf(conn->context);
+}
 
 static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				 struct net_pkt *pkt,
@@ -1340,6 +1515,7 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 				 union net_proto_header *proto,
 				 void *user_data)
 {
+	struct tcp *conn_old = ((struct net_context *)user_data)->tcp;
 	struct tcp *conn;
 	struct tcphdr *th;
 
@@ -1354,18 +1530,25 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	th = th_get(pkt);
 
 	if (th_flags(th) & SYN && !(th_flags(th) & ACK)) {
-		struct tcp *conn_old = ((struct net_context *)user_data)->tcp;
-
+#if defined(CONFIG_NET_TCP_SYN_QUEUE)
+		/* The connection is only created by the final ACK */
+		tcp_syn_queue_add(conn_old, pkt, th);
+#else
 		conn = tcp_conn_new(pkt);
 		if (!conn) {
 			NET_ERR("Cannot allocate a new TCP connection");
 			goto in;
 		}
 
-		net_ipaddr_copy(&conn_old->context->remote, &conn->dst.sa);
-
-		conn->accepted_conn = conn_old;
+		tcp_conn_accepted(conn, conn_old);
+#endif
+	}
+#if defined(CONFIG_NET_TCP_SYN_QUEUE)
+	else if (th_flags(th) & ACK && !(th_flags(th) & (SYN | RST)) &&
+		 conn_old && conn_old->state == TCP_LISTEN) {
+		conn = tcp_syn_queue_complete(conn_old, pkt, th);
 	}
+#endif
  in:
 	if (conn) {
 		tcp_in(conn, pkt);
@@ -1574,6 +1757,479 @@ err:
 	return conn;
 }
 
+#if defined(CONFIG_NET_TCP_SYN_QUEUE)
+/* Half-open connection, waiting for the final ACK of the handshake */
+struct tcp_syn_entry {
+	struct tcp *listener; /* NULL if the entry is free */
+	struct net_if *iface;
+	union tcp_endpoint src;
+	union tcp_endpoint dst;
+	int64_t expiry; /* dropped if not completed by then */
+	int64_t resend; /* next SYN-ACK retransmission */
+	uint32_t rto;
+	uint32_t seq; /* our ISN */
+	uint32_t ack; /* peer ISN + 1 */
+	uint16_t mss; /* peer MSS, 0 if not given */
+};
+
+static void tcp_syn_queue_timeout(struct k_work *work);
+
+static struct tcp_syn_entry syn_queue[CONFIG_NET_TCP_BACKLOG_SIZE];
+static K_MUTEX_DEFINE(syn_queue_lock);
+static K_WORK_DELAYABLE_DEFINE(syn_queue_timer, tcp_syn_queue_timeout);
+
+static struct tcp_syn_entry *syn_entry_find(const union tcp_endpoint *src,
+					    const union tcp_endpoint *dst)
+{
+	size_t len = tcp_endpoint_len(src->sa.sa_family);
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(syn_queue); i++) {
+		struct tcp_syn_entry *entry = &syn_queue[i];
+
+		if (entry->listener && !memcmp(&entry->src, src, len) &&
+		    !memcmp(&entry->dst, dst, len)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static struct tcp_syn_entry *syn_entry_alloc(void)
+{
+	int64_t now = k_uptime_get();
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(syn_queue); i++) {
+		struct tcp_syn_entry *entry = &syn_queue[i];
+
+		if (!entry->listener || entry->expiry <= now) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Make sure the queue is looked at again within the given delay */
+static void syn_queue_timer_update(uint32_t delay_ms)
+{
+	if (!k_work_delayable_is_pending(&syn_queue_timer) ||
+	    k_work_delayable_remaining_get(&syn_queue_timer) >
+	    k_ms_to_ticks_ceil32(delay_ms)) {
+		k_work_reschedule_for_queue(&tcp_work_q, &syn_queue_timer,
+					    K_MSEC(delay_ms));
+	}
+}
+
+static void tcp_syn_queue_purge(struct tcp *listener)
+{
+	int i;
+
+	k_mutex_lock(&syn_queue_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(syn_queue); i++) {
+		if (syn_queue[i].listener == listener) {
+			syn_queue[i].listener = NULL;
+		}
+	}
+
+	k_mutex_unlock(&syn_queue_lock);
+}
+
+#if defined(CONFIG_NET_TCP_SYN_COOKIES)
+/* A SYN cookie is made of a 5 bits time counter, a 3 bits MSS index and
+ * 24 bits of keyed hash of the connection.
+ */
+#define SYN_COOKIE_PERIOD_MS (64 * MSEC_PER_SEC)
+#define SYN_COOKIE_HASH_MASK BIT_MASK(24)
+
+static const uint16_t syn_cookie_mss[] = { 536, 1220, 1440, 1460 };
+static uint8_t syn_cookie_key[16];
+
+static uint32_t syn_cookie_hash(const union tcp_endpoint *src,
+				const union tcp_endpoint *dst,
+				uint32_t peer_isn, uint32_t count,
+				uint32_t mss_idx)
+{
+	struct {
+		uint8_t key[sizeof(syn_cookie_key)];
+		union tcp_endpoint src;
+		union tcp_endpoint dst;
+		uint32_t peer_isn;
+		uint32_t count;
+		uint32_t mss_idx;
+	} buf = {
+		.src = *src,
+		.dst = *dst,
+		.peer_isn = peer_isn,
+		.count = count,
+		.mss_idx = mss_idx,
+	};
+	uint8_t hash[16];
+	static bool once;
+
+	if (!once) {
+		sys_rand_get(syn_cookie_key, sizeof(syn_cookie_key));
+		once = true;
+	}
+
+	memcpy(buf.key, syn_cookie_key, sizeof(buf.key));
+
+	mbedtls_md5((const unsigned char *)&buf, sizeof(buf), hash);
+
+	return UNALIGNED_GET((uint32_t *)&hash[0]) & SYN_COOKIE_HASH_MASK;
+}
+
+static uint32_t syn_cookie_make(const union tcp_endpoint *src,
+				const union tcp_endpoint *dst,
+				uint32_t peer_isn, uint16_t mss)
+{
+	uint32_t count = k_uptime_get() / SYN_COOKIE_PERIOD_MS;
+	uint32_t mss_idx;
+
+	for (mss_idx = ARRAY_SIZE(syn_cookie_mss) - 1; mss_idx > 0;
+	     mss_idx--) {
+		if (mss >= syn_cookie_mss[mss_idx]) {
+			break;
+		}
+	}
+
+	return (count & BIT_MASK(5)) << 27 | mss_idx << 24 |
+		syn_cookie_hash(src, dst, peer_isn, count, mss_idx);
+}
+
+/* Check a cookie of the current or of the previous period */
+static bool syn_cookie_check(const union tcp_endpoint *src,
+			     const union tcp_endpoint *dst,
+			     uint32_t peer_isn, uint32_t cookie,
+			     uint16_t *mss)
+{
+	uint32_t count = k_uptime_get() / SYN_COOKIE_PERIOD_MS;
+	uint32_t mss_idx = (cookie >> 24) & BIT_MASK(3);
+	int i;
+
+	if (mss_idx >= ARRAY_SIZE(syn_cookie_mss)) {
+		return false;
+	}
+
+	for (i = 0; i < 2; i++, count--) {
+		if ((cookie >> 27) != (count & BIT_MASK(5))) {
+			continue;
+		}
+
+		if ((cookie & SYN_COOKIE_HASH_MASK) !=
+		    syn_cookie_hash(src, dst, peer_isn, count, mss_idx)) {
+			return false;
+		}
+
+		*mss = syn_cookie_mss[mss_idx];
+
+		return true;
+	}
+
+	return false;
+}
+#endif /* CONFIG_NET_TCP_SYN_COOKIES */
+
+/* Send a SYN-ACK for a connection that has no struct tcp yet */
+static int tcp_syn_ack_send(struct tcp *listener, struct net_if *iface,
+			    union tcp_endpoint *src, union tcp_endpoint *dst,
+			    uint32_t seq, uint32_t ack)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	sa_family_t family = src->sa.sa_family;
+	struct net_pkt *pkt;
+	struct tcphdr *th;
+	uint32_t mss;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface,
+					sizeof(struct tcphdr) + sizeof(mss),
+					family, IPPROTO_TCP,
+					TCP_PKT_ALLOC_TIMEOUT);
+	if (!pkt) {
+		return -ENOBUFS;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && family == AF_INET) {
+		ret = net_context_create_ipv4_new(listener->context, pkt,
+						  &src->sin.sin_addr,
+						  &dst->sin.sin_addr);
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && family == AF_INET6) {
+		ret = net_context_create_ipv6_new(listener->context, pkt,
+						  &src->sin6.sin6_addr,
+						  &dst->sin6.sin6_addr);
+	} else {
+		ret = -EINVAL;
+	}
+
+	if (ret < 0) {
+		goto fail;
+	}
+
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!th) {
+		ret = -ENOBUFS;
+		goto fail;
+	}
+
+	memset(th, 0, sizeof(struct tcphdr));
+
+	UNALIGNED_PUT(src->sin.sin_port, &th->th_sport);
+	UNALIGNED_PUT(dst->sin.sin_port, &th->th_dport);
+	th->th_off = 6;
+	UNALIGNED_PUT(SYN | ACK, &th->th_flags);
+	UNALIGNED_PUT(htons(tcp_recv_buf(listener->context)), &th->th_win);
+	UNALIGNED_PUT(htonl(seq), &th->th_seq);
+	UNALIGNED_PUT(htonl(ack), &th->th_ack);
+
+	ret = net_pkt_set_data(pkt, &tcp_access);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	mss = htonl(tcp_iface_mss(iface, family) |
+		    (NET_TCP_MSS_OPT << 24) | (NET_TCP_MSS_SIZE << 16));
+
+	ret = net_pkt_write(pkt, &mss, sizeof(mss));
+	if (ret < 0) {
+		goto fail;
+	}
+
+	ret = tcp_finalize_pkt(pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	tcp_send(pkt);
+
+	return 0;
+
+fail:
+	tcp_pkt_unref(pkt);
+
+	return ret;
+}
+
+/* Retransmit the SYN-ACKs that were not answered, and drop the half-open
+ * connections that expired.
+ */
+static void tcp_syn_queue_timeout(struct k_work *work)
+{
+	int64_t now = k_uptime_get();
+	int64_t next = INT64_MAX;
+	int i;
+
+	ARG_UNUSED(work);
+
+	k_mutex_lock(&syn_queue_lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(syn_queue); i++) {
+		struct tcp_syn_entry *entry = &syn_queue[i];
+
+		if (!entry->listener) {
+			continue;
+		}
+
+		if (entry->expiry <= now) {
+			NET_DBG("SYN queue entry %p expired", entry);
+			entry->listener = NULL;
+			continue;
+		}
+
+		if (entry->resend <= now) {
+			(void)tcp_syn_ack_send(entry->listener, entry->iface,
+					       &entry->src, &entry->dst,
+					       entry->seq, entry->ack);
+			entry->rto *= 2U;
+			entry->resend = now + entry->rto;
+		}
+
+		next = MIN(next, MIN(entry->expiry, entry->resend));
+	}
+
+	if (next != INT64_MAX) {
+		k_work_reschedule_for_queue(&tcp_work_q, &syn_queue_timer,
+					    K_MSEC(next - now));
+	}
+
+	k_mutex_unlock(&syn_queue_lock);
+}
+
+/* Answer a SYN received by a listening connection */
+static void tcp_syn_queue_add(struct tcp *listener, struct net_pkt *pkt,
+			      struct tcphdr *th)
+{
+	size_t options_len = (th_off(th) - 5) * 4;
+	struct tcp_options options = { 0 };
+	struct tcp_syn_entry *entry;
+	union tcp_endpoint src;
+	union tcp_endpoint dst;
+	uint32_t seq = 0U;
+	uint16_t mss;
+
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_SRC) < 0) {
+		return;
+	}
+
+	if (options_len && !tcp_options_check(&options, pkt, options_len)) {
+		NET_DBG("DROP: Invalid TCP option list");
+		return;
+	}
+
+	mss = options.mss_found ? options.mss : 0U;
+
+	k_mutex_lock(&syn_queue_lock, K_FOREVER);
+
+	entry = syn_entry_find(&src, &dst);
+	if (!entry || entry->ack != th_seq(th) + 1) {
+		/* Not a retransmission of a known SYN */
+		if (!entry) {
+			entry = syn_entry_alloc();
+		}
+
+		if (entry) {
+			if (!(IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
+			      IS_ENABLED(CONFIG_NET_TEST))) {
+				entry->seq = tcp_init_isn(&src.sa, &dst.sa);
+			} else {
+				entry->seq = 0U;
+			}
+
+			entry->listener = listener;
+			entry->iface = net_pkt_iface(pkt);
+			entry->src = src;
+			entry->dst = dst;
+			entry->ack = th_seq(th) + 1;
+			entry->mss = mss;
+		}
+	}
+
+	if (entry) {
+		int64_t now = k_uptime_get();
+
+		/* A retransmitted SYN restarts the retransmissions */
+		entry->expiry = now + ACK_TIMEOUT_MS;
+		entry->rto = tcp_rto;
+		entry->resend = now + entry->rto;
+		seq = entry->seq;
+
+		syn_queue_timer_update(entry->rto);
+	}
+
+	k_mutex_unlock(&syn_queue_lock);
+
+	if (!entry) {
+#if defined(CONFIG_NET_TCP_SYN_COOKIES)
+		seq = syn_cookie_make(&src, &dst, th_seq(th), mss);
+#else
+		NET_DBG("SYN queue full, dropping connection attempt");
+		net_stats_update_tcp_seg_conndrop(net_pkt_iface(pkt));
+		return;
+#endif
+	}
+
+	if (tcp_syn_ack_send(listener, net_pkt_iface(pkt), &src, &dst, seq,
+			     th_seq(th) + 1) < 0) {
+		NET_DBG("Cannot send SYN-ACK");
+	}
+}
+
+static bool accept_queue_full(struct tcp *listener)
+{
+	return listener->backlog &&
+		atomic_get(&listener->accept_queued) >= listener->backlog;
+}
+
+/* Turn a half-open connection into a full one when its final ACK
+ * is received, and return it in TCP_SYN_RECEIVED state.
+ */
+static struct tcp *tcp_syn_queue_complete(struct tcp *listener,
+					  struct net_pkt *pkt,
+					  struct tcphdr *th)
+{
+	struct tcp_syn_entry *entry;
+	union tcp_endpoint src;
+	union tcp_endpoint dst;
+	uint32_t seq = th_ack(th) - 1;
+	uint16_t mss = 0U;
+	bool found = false;
+	struct tcp *conn;
+
+	if (tcp_endpoint_set(&src, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&dst, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
+
+	k_mutex_lock(&syn_queue_lock, K_FOREVER);
+
+	entry = syn_entry_find(&src, &dst);
+	if (entry && entry->listener == listener && entry->seq == seq &&
+	    entry->ack == th_seq(th)) {
+		mss = entry->mss;
+		found = true;
+
+		if (accept_queue_full(listener)) {
+			/* Keep the half-open connection, the ACK comes
+			 * again when the SYN-ACK is retransmitted.
+			 */
+			entry->expiry = k_uptime_get() + ACK_TIMEOUT_MS;
+		}
+	}
+
+	k_mutex_unlock(&syn_queue_lock);
+
+#if defined(CONFIG_NET_TCP_SYN_COOKIES)
+	if (!found) {
+		found = syn_cookie_check(&src, &dst, th_seq(th) - 1, seq,
+					 &mss);
+	}
+#endif
+
+	if (!found) {
+		return NULL;
+	}
+
+	if (accept_queue_full(listener)) {
+		NET_DBG("conn: %p accept queue full", listener);
+		net_stats_update_tcp_seg_conndrop(net_pkt_iface(pkt));
+		return NULL;
+	}
+
+	conn = tcp_conn_new(pkt);
+	if (!conn) {
+		NET_ERR("Cannot allocate a new TCP connection");
+		return NULL;
+	}
+
+	k_mutex_lock(&syn_queue_lock, K_FOREVER);
+
+	entry = syn_entry_find(&src, &dst);
+	if (entry) {
+		entry->listener = NULL;
+	}
+
+	k_mutex_unlock(&syn_queue_lock);
+
+	tcp_conn_accepted(conn, listener);
+
+	conn->seq = seq + 1;
+	conn->ack = th_seq(th);
+
+	if (mss) {
+		conn->recv_options.mss = mss;
+		conn->recv_options.mss_found = true;
+	}
+
+	conn_state(conn, TCP_SYN_RECEIVED);
+
+	return conn;
+}
+#endif /* CONFIG_NET_TCP_SYN_QUEUE */
+
 static bool tcp_validate_seq(struct tcp *conn, struct tcphdr *hdr)
 {
 	return (net_tcp_seq_cmp(th_seq(hdr), conn->ack) >= 0) &&
@@ -1678,6 +2334,17 @@ static bool tcp_data_received(struct tcp *conn, struct net_pkt *pkt,
 		return false;
 	}
 
+	if (*len > conn->recv_win) {
+		/* The peer does not respect our window, which is the room
+		 * left in the socket receive buffer.
+		 */
+		NET_DBG("conn: %p dropping %zu bytes, window %hu", conn,
+			*len, conn->recv_win);
+		net_stats_update_tcp_seg_drop(conn->iface);
+		tcp_out(conn, ACK);
+		return false;
+	}
+
 	if (tcp_data_get(conn, pkt, len) < 0) {
 		return false;
 	}
@@ -2061,6 +2728,9 @@ next_state:
 	 */
 	if (conn->context) {
 		conn_handler = (struct net_conn *)conn->context->conn_handler;
+
+		/* Acknowledged data or a closed connection wake up senders */
+		tcp_tx_sem_update(conn);
 	}
 
 	recv_user_data = conn->recv_user_data;
@@ -2151,31 +2821,73 @@ int net_tcp_put(struct net_context *context)
 	return 0;
 }
 
-int net_tcp_listen(struct net_context *context)
+int net_tcp_listen(struct net_context *context, int backlog)
 {
+#if defined(CONFIG_NET_TCP_SYN_QUEUE)
+	struct tcp *conn = context->tcp;
+
+	if (conn) {
+		conn->backlog = CLAMP(backlog, 1, UINT16_MAX);
+	}
+#else
+	ARG_UNUSED(backlog);
+#endif
+
 	/* when created, tcp connections are in state TCP_LISTEN */
 	net_context_set_state(context, NET_CONTEXT_LISTENING);
 
 	return 0;
 }
 
+#if defined(CONFIG_NET_TCP_SYN_QUEUE)
+void net_tcp_accept_queue_update(struct net_context *context, int delta)
+{
+	struct tcp *conn = context->tcp;
+
+	if (conn) {
+		atomic_add(&conn->accept_queued, delta);
+	}
+}
+#endif
+
 int net_tcp_update_recv_wnd(struct net_context *context, int32_t delta)
 {
-	int32_t new_win;
+	struct tcp *conn = context->tcp;
+	int ret;
 
-	if (!context->tcp) {
+	if (!conn) {
 		NET_ERR("context->tcp == NULL");
 		return -EPROTOTYPE;
 	}
 
-	new_win = ((struct tcp *)context->tcp)->recv_win + delta;
-	if (new_win < 0 || new_win > UINT16_MAX) {
-		return -EINVAL;
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	ret = tcp_update_recv_wnd(conn, delta);
+	k_mutex_unlock(&conn->lock);
+
+	return ret;
+}
+
+size_t net_tcp_send_buf_space(struct net_context *context)
+{
+	struct tcp *conn = context->tcp;
+	size_t space;
+
+	if (!conn) {
+		return SIZE_MAX;
 	}
 
-	((struct tcp *)context->tcp)->recv_win = new_win;
+	k_mutex_lock(&conn->lock, K_FOREVER);
+	space = tcp_send_buf_space(conn);
+	k_mutex_unlock(&conn->lock);
 
-	return 0;
+	return space;
+}
+
+struct k_sem *net_tcp_tx_sem_get(struct net_context *context)
+{
+	struct tcp *conn = context->tcp;
+
+	return conn ? &conn->tx_sem : NULL;
 }
 
 /* net_context queues the outgoing data for the TCP connection */
@@ -2220,11 +2932,18 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 						&conn->send_data_timer,
 						K_NO_WAIT);
 		ret = -EAGAIN;
+		tcp_tx_sem_update(conn);
 		goto out;
 	}
 
 	len = net_pkt_get_len(pkt);
 
+	if (len > tcp_send_buf_space(conn)) {
+		ret = -EAGAIN;
+		tcp_tx_sem_update(conn);
+		goto out;
+	}
+
 	if (conn->send_data->buffer) {
 		orig_buf = net_buf_frag_last(conn->send_data->buffer);
 	}
@@ -2260,6 +2979,8 @@ int net_tcp_queue_data(struct net_context *context, struct net_pkt *pkt)
 		 */
 		tcp_pkt_unref(pkt);
 	}
+
+	tcp_tx_sem_update(conn);
 out:
 	k_mutex_unlock(&conn->lock);
 
@@ -2371,6 +3092,8 @@ int net_tcp_connect(struct net_context *context,
 		log_strdup(net_sprint_addr(conn->dst.sa.sa_family,
 				(const void *)&conn->dst.sin.sin_addr)));
 
+	conn->recv_win = tcp_recv_buf(context);
+
 	net_context_set_state(context, NET_CONTEXT_CONNECTING);
 
 	ret = net_conn_register(net_context_get_ip_proto(context),
@@ -2517,7 +3240,11 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	tcp_hdr->chksum = 0U;
 
-	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+	/* The checksum of each segment is computed when the packet is
+	 * split before L2.
+	 */
+	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_gso_size(pkt)) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
 	}
 
@@ -2815,45 +3542,110 @@ void net_tcp_foreach(net_tcp_cb_t cb, void *user_data)
 	k_mutex_unlock(&tcp_lock);
 }
 
-uint16_t net_tcp_get_recv_mss(const struct tcp *conn)
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+			void *user_data)
 {
-	sa_family_t family = net_context_get_family(conn->context);
+	NET_PKT_DATA_ACCESS_DEFINE(tcp_access, struct tcphdr);
+	size_t ip_len = net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+	uint16_t mss = net_pkt_gso_size(pkt);
+	size_t hdr_len, data_len, offset, len;
+	struct net_pkt_cursor backup;
+	struct net_pkt *seg;
+	struct tcphdr *th;
+	uint8_t flags;
+	uint32_t seq;
+	bool overwrite;
+	int ret = 0;
 
-	if (family == AF_INET) {
-#if defined(CONFIG_NET_IPV4)
-		struct net_if *iface = net_context_get_iface(conn->context);
+	net_pkt_cursor_backup(pkt, &backup);
+	overwrite = net_pkt_is_being_overwritten(pkt);
 
-		if (iface && net_if_get_mtu(iface) >= NET_IPV4TCPH_LEN) {
-			/* Detect MSS based on interface MTU minus "TCP,IP
-			 * header size"
-			 */
-			return net_if_get_mtu(iface) - NET_IPV4TCPH_LEN;
-		}
-#else
-		return 0;
-#endif /* CONFIG_NET_IPV4 */
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, ip_len)) {
+		ret = -EINVAL;
+		goto out;
 	}
-#if defined(CONFIG_NET_IPV6)
-	else if (family == AF_INET6) {
-		struct net_if *iface = net_context_get_iface(conn->context);
-		int mss = 0;
 
-		if (iface && net_if_get_mtu(iface) >= NET_IPV6TCPH_LEN) {
-			/* Detect MSS based on interface MTU minus "TCP,IP
-			 * header size"
-			 */
-			mss = net_if_get_mtu(iface) - NET_IPV6TCPH_LEN;
+	th = (struct tcphdr *)net_pkt_get_data(pkt, &tcp_access);
+	if (!th) {
+		ret = -ENOBUFS;
+		goto out;
+	}
+
+	hdr_len = ip_len + th_off(th) * 4;
+	seq = th_seq(th);
+	flags = th_flags(th);
+
+	if (net_pkt_get_len(pkt) < hdr_len || mss == 0U) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	data_len = net_pkt_get_len(pkt) - hdr_len;
+
+	for (offset = 0; offset < data_len; offset += len) {
+		len = MIN(mss, data_len - offset);
+
+		seg = net_pkt_clone_slice(pkt, hdr_len, offset, len,
+					  TCP_PKT_ALLOC_TIMEOUT);
+		if (!seg) {
+			ret = -ENOBUFS;
+			break;
 		}
 
-		if (mss < NET_IPV6_MTU) {
-			mss = NET_IPV6_MTU;
+		if (IS_ENABLED(CONFIG_NET_IPV4) &&
+		    net_pkt_family(seg) == AF_INET) {
+			/* Computed again by tcp_finalize_pkt() */
+			NET_IPV4_HDR(seg)->chksum = 0U;
 		}
 
-		return mss;
+		net_pkt_set_overwrite(seg, true);
+		net_pkt_skip(seg, ip_len);
+
+		th = (struct tcphdr *)net_pkt_get_data(seg, &tcp_access);
+		if (!th) {
+			tcp_pkt_unref(seg);
+			ret = -ENOBUFS;
+			break;
+		}
+
+		UNALIGNED_PUT(htonl(seq + offset), &th->th_seq);
+
+		/* Only the last segment carries PSH and FIN */
+		if (offset + len < data_len) {
+			UNALIGNED_PUT(flags & ~(PSH | FIN), &th->th_flags);
+		}
+
+		if (net_pkt_set_data(seg, &tcp_access) < 0 ||
+		    tcp_finalize_pkt(seg) < 0) {
+			tcp_pkt_unref(seg);
+			ret = -ENOBUFS;
+			break;
+		}
+
+		ret = cb(seg, user_data);
+		if (ret < 0) {
+			break;
+		}
 	}
-#endif /* CONFIG_NET_IPV6 */
 
-	return 0;
+	NET_DBG("pkt %p len %zu split into %zu byte segments (%d)", pkt,
+		data_len, (size_t)mss, ret);
+out:
+	net_pkt_cursor_restore(pkt, &backup);
+	net_pkt_set_overwrite(pkt, overwrite);
+
+	return ret;
+}
+#endif /* CONFIG_NET_TCP_GSO */
+
+uint16_t net_tcp_get_recv_mss(const struct tcp *conn)
+{
+	return tcp_iface_mss(net_context_get_iface(conn->context),
+			     net_context_get_family(conn->context));
 }
 
 const char *net_tcp_state_str(enum tcp_state state)
@@ -67,10 +67,11 @@ int net_tcp_unref(struct net_context *context);
  * @brief Listen for an incoming TCP connection
  *
  * @param context Network context
+ * @param backlog Maximum number of connections waiting to be accepted
  *
  * @return 0 if successful, < 0 on error
  */
-int net_tcp_listen(struct net_context *context);
+int net_tcp_listen(struct net_context *context, int backlog);
 
 /**
  * @brief Register an accept callback
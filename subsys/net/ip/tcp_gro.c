@@ -0,0 +1,334 @@
+/** @file
+ * @brief Coalescing of received TCP segments
+ */
+
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/byteorder.h>
+
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_if.h>
+
+#include "net_private.h"
+#include "tcp_internal.h"
+
+/* The segments are merged in the RX traffic class thread, after they
+ * have been captured and processed by the L2 one by one, so the IP
+ * header is at the start of the packet. Only the first fragment of each
+ * packet is looked at, so the IP and TCP headers must both be in it.
+ */
+struct gro_seg {
+	struct net_pkt *pkt;
+	union {
+		struct net_ipv4_hdr *ipv4;
+		struct net_ipv6_hdr *ipv6;
+		uint8_t *ip;
+	};
+	struct net_tcp_hdr *tcp;
+	sa_family_t family;
+	uint8_t ip_len;
+	uint8_t tcp_len;
+	uint16_t data_len;
+};
+
+static uint16_t gro_chksum_add(uint16_t sum, uint16_t val)
+{
+	uint32_t tmp = (uint32_t)sum + val;
+
+	return (uint16_t)((tmp & 0xffff) + (tmp >> 16));
+}
+
+static bool gro_parse(struct net_pkt *pkt, struct gro_seg *seg)
+{
+	struct net_buf *buf = pkt->buffer;
+	size_t tcp_len;
+
+	if (!buf || !buf->len || !net_pkt_iface(pkt)) {
+		return false;
+	}
+
+	seg->pkt = pkt;
+	seg->ip = buf->data;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && (buf->data[0] >> 4) == 4) {
+		struct net_ipv4_hdr *hdr = seg->ipv4;
+
+		/* No IP options and no fragments, DF may be set */
+		if (buf->len < sizeof(struct net_ipv4_hdr) ||
+		    hdr->vhl != 0x45 || hdr->proto != IPPROTO_TCP ||
+		    (hdr->offset[0] & ~(NET_IPV4_DO_NOT_FRAG_MASK >> 8)) ||
+		    hdr->offset[1]) {
+			return false;
+		}
+
+		seg->family = AF_INET;
+		seg->ip_len = sizeof(struct net_ipv4_hdr);
+
+		if (ntohs(hdr->len) < seg->ip_len) {
+			return false;
+		}
+
+		tcp_len = ntohs(hdr->len) - seg->ip_len;
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && (buf->data[0] >> 4) == 6) {
+		struct net_ipv6_hdr *hdr = seg->ipv6;
+
+		/* No extension headers */
+		if (buf->len < sizeof(struct net_ipv6_hdr) ||
+		    hdr->nexthdr != IPPROTO_TCP) {
+			return false;
+		}
+
+		seg->family = AF_INET6;
+		seg->ip_len = sizeof(struct net_ipv6_hdr);
+		tcp_len = ntohs(hdr->len);
+	} else {
+		return false;
+	}
+
+	if (buf->len < seg->ip_len + NET_TCPH_LEN) {
+		return false;
+	}
+
+	seg->tcp = (struct net_tcp_hdr *)(seg->ip + seg->ip_len);
+	seg->tcp_len = (seg->tcp->offset >> 4) * 4U;
+
+	if (seg->tcp_len < NET_TCPH_LEN || tcp_len <= seg->tcp_len ||
+	    buf->len < seg->ip_len + seg->tcp_len) {
+		return false;
+	}
+
+	/* Only plain data segments are merged. Packets with L2 padding
+	 * after the IP packet are left alone.
+	 */
+	if ((seg->tcp->flags & ~PSH) != ACK ||
+	    net_pkt_get_len(pkt) != seg->ip_len + tcp_len) {
+		return false;
+	}
+
+	seg->data_len = tcp_len - seg->tcp_len;
+
+	return true;
+}
+
+static bool gro_match(struct gro_seg *head, uint32_t data_len,
+		      struct gro_seg *seg)
+{
+	if (net_pkt_iface(head->pkt) != net_pkt_iface(seg->pkt) ||
+	    head->family != seg->family || head->tcp_len != seg->tcp_len) {
+		return false;
+	}
+
+	if (net_pkt_vlan_tag(head->pkt) != net_pkt_vlan_tag(seg->pkt)) {
+		return false;
+	}
+
+	/* The IP length fields must not overflow */
+	if (head->tcp_len + data_len + seg->data_len >
+	    UINT16_MAX - head->ip_len) {
+		return false;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && head->family == AF_INET) {
+		if (head->ipv4->tos != seg->ipv4->tos ||
+		    head->ipv4->ttl != seg->ipv4->ttl ||
+		    head->ipv4->offset[0] != seg->ipv4->offset[0] ||
+		    memcmp(head->ipv4->src, seg->ipv4->src,
+			   2 * NET_IPV4_ADDR_SIZE)) {
+			return false;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && head->family == AF_INET6) {
+		if (memcmp(head->ipv6, seg->ipv6,
+			   offsetof(struct net_ipv6_hdr, len)) ||
+		    head->ipv6->hop_limit != seg->ipv6->hop_limit ||
+		    memcmp(head->ipv6->src, seg->ipv6->src,
+			   2 * NET_IPV6_ADDR_SIZE)) {
+			return false;
+		}
+	}
+
+	/* Same connection, same acknowledgment and options, and the
+	 * segment continues the merged data.
+	 */
+	return head->tcp->src_port == seg->tcp->src_port &&
+	       head->tcp->dst_port == seg->tcp->dst_port &&
+	       !memcmp(head->tcp->ack, seg->tcp->ack, sizeof(seg->tcp->ack)) &&
+	       !memcmp(head->tcp->optdata, seg->tcp->optdata,
+		       head->tcp_len - NET_TCPH_LEN) &&
+	       sys_get_be32(head->tcp->seq) + data_len ==
+	       sys_get_be32(seg->tcp->seq);
+}
+
+static bool gro_ip_chksum_ok(struct gro_seg *seg)
+{
+	if (IS_ENABLED(CONFIG_NET_IPV4) && seg->family == AF_INET) {
+		return net_calc_chksum_buf(0U, seg->ip, seg->ip_len) == 0xffff;
+	}
+
+	return true;
+}
+
+static uint16_t gro_pseudo_hdr_sum(struct gro_seg *seg, uint16_t tcp_len)
+{
+	uint16_t sum;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && seg->family == AF_INET) {
+		sum = net_calc_chksum_buf(0U, seg->ipv4->src,
+					  2 * NET_IPV4_ADDR_SIZE);
+	} else {
+		sum = net_calc_chksum_buf(0U, seg->ipv6->src,
+					  2 * NET_IPV6_ADDR_SIZE);
+	}
+
+	sum = gro_chksum_add(sum, IPPROTO_TCP);
+
+	return gro_chksum_add(sum, tcp_len);
+}
+
+/* A valid segment sums up to 0xffff, so the sum of its payload is the
+ * complement of the sum of the pseudo header and the TCP header. This
+ * avoids reading the payload: if the checksum of a segment is wrong,
+ * the checksum of the merged packet is wrong too and it is dropped by
+ * the TCP input.
+ */
+static uint16_t gro_payload_sum(struct gro_seg *seg)
+{
+	uint16_t sum;
+
+	sum = gro_pseudo_hdr_sum(seg, seg->tcp_len + seg->data_len);
+	sum = net_calc_chksum_buf(sum, (uint8_t *)seg->tcp, seg->tcp_len);
+
+	return ~sum;
+}
+
+static void gro_finalize(struct gro_seg *head, uint32_t data_len,
+			 bool chksum, uint16_t payload_sum)
+{
+	uint16_t tcp_len = head->tcp_len + data_len;
+	uint16_t sum;
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && head->family == AF_INET) {
+		head->ipv4->len = htons(head->ip_len + tcp_len);
+
+		if (chksum) {
+			head->ipv4->chksum = 0U;
+
+			sum = net_calc_chksum_buf(0U, head->ip, head->ip_len);
+			sum = (sum == 0U) ? 0xffff : htons(sum);
+			head->ipv4->chksum = ~sum;
+		}
+	} else {
+		head->ipv6->len = htons(tcp_len);
+	}
+
+	if (chksum) {
+		head->tcp->chksum = 0U;
+
+		sum = gro_pseudo_hdr_sum(head, tcp_len);
+		sum = net_calc_chksum_buf(sum, (uint8_t *)head->tcp,
+					  head->tcp_len);
+		sum = gro_chksum_add(sum, payload_sum);
+		sum = (sum == 0U) ? 0xffff : htons(sum);
+		head->tcp->chksum = ~sum;
+	}
+}
+
+struct net_pkt *net_tcp_gro_receive(struct k_fifo *fifo, struct net_pkt *pkt,
+				    struct net_pkt **next)
+{
+	uint16_t payload_sum = 0U;
+	struct gro_seg head, seg;
+	struct net_pkt *tmp;
+	uint32_t data_len;
+	bool chksum;
+	int count = 1;
+
+	*next = NULL;
+
+	if (k_fifo_is_empty(fifo) || !gro_parse(pkt, &head) ||
+	    (head.tcp->flags & PSH)) {
+		return pkt;
+	}
+
+	chksum = net_if_need_calc_rx_checksum(net_pkt_iface(pkt));
+	if (chksum) {
+		if (!gro_ip_chksum_ok(&head)) {
+			return pkt;
+		}
+
+		payload_sum = gro_payload_sum(&head);
+	}
+
+	data_len = head.data_len;
+
+	while (count < CONFIG_NET_TCP_GRO_MAX_SEGMENTS &&
+	       !(head.tcp->flags & PSH)) {
+		uint16_t sum = 0U;
+
+		/* We are the only reader of the queue */
+		tmp = k_fifo_get(fifo, K_NO_WAIT);
+		if (!tmp) {
+			break;
+		}
+
+		/* Consumed by the L2, it does not interrupt the flow */
+		tmp = net_process_rx_l2(tmp);
+		if (!tmp) {
+			continue;
+		}
+
+		/* Everything that can fail is checked before the packets
+		 * are modified: a segment that cannot be merged is handed
+		 * back to be processed right after the merged packet.
+		 */
+		if (!gro_parse(tmp, &seg) || !gro_match(&head, data_len, &seg) ||
+		    (chksum && !gro_ip_chksum_ok(&seg))) {
+			*next = tmp;
+			break;
+		}
+
+		if (chksum) {
+			sum = gro_payload_sum(&seg);
+
+			/* The payload starts at an odd offset of the merged
+			 * payload, so its 16-bit words are byte swapped.
+			 */
+			if (data_len & 1) {
+				sum = __bswap_16(sum);
+			}
+		}
+
+		memcpy(head.tcp->wnd, seg.tcp->wnd, sizeof(head.tcp->wnd));
+		head.tcp->flags |= seg.tcp->flags & PSH;
+
+		/* The headers are in the first fragment, see gro_parse() */
+		net_buf_pull(tmp->buffer, seg.ip_len + seg.tcp_len);
+		net_pkt_trim_buffer(tmp);
+
+		net_pkt_append_buffer(pkt, tmp->buffer);
+		tmp->buffer = NULL;
+		net_pkt_unref(tmp);
+
+		payload_sum = gro_chksum_add(payload_sum, sum);
+		data_len += seg.data_len;
+		count++;
+	}
+
+	if (count > 1) {
+		gro_finalize(&head, data_len, chksum, payload_sum);
+
+		NET_DBG("pkt %p merged %d segments, %u bytes", pkt, count,
+			data_len);
+	}
+
+	return pkt;
+}
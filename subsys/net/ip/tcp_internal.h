@@ -167,21 +167,45 @@ static inline int net_tcp_connect(struct net_context *context,
  * @brief Set TCP socket into listening state
  *
  * @param context Network context
+ * @param backlog Maximum number of connections waiting to be accepted
  *
  * @return 0 if successful, -EOPNOTSUPP if the context was not for TCP,
  *         -EPROTONOSUPPORT if TCP is not supported
  */
 #if defined(CONFIG_NET_NATIVE_TCP)
-int net_tcp_listen(struct net_context *context);
+int net_tcp_listen(struct net_context *context, int backlog);
 #else
-static inline int net_tcp_listen(struct net_context *context)
+static inline int net_tcp_listen(struct net_context *context, int backlog)
 {
 	ARG_UNUSED(context);
+	ARG_UNUSED(backlog);
 
 	return -EPROTONOSUPPORT;
 }
 #endif
 
+/**
+ * @brief Update the number of connections waiting to be accepted
+ *
+ * Used by the socket layer, which queues the new connections of a
+ * listening context until the application accepts them. While the
+ * listen backlog is reached, no new connection is completed.
+ *
+ * @param context Listening network context
+ * @param delta Number of connections queued (positive) or accepted
+ *              (negative)
+ */
+#if defined(CONFIG_NET_NATIVE_TCP) && defined(CONFIG_NET_TCP_SYN_QUEUE)
+void net_tcp_accept_queue_update(struct net_context *context, int delta);
+#else
+static inline void net_tcp_accept_queue_update(struct net_context *context,
+					       int delta)
+{
+	ARG_UNUSED(context);
+	ARG_UNUSED(delta);
+}
+#endif
+
 /**
  * @brief Accept TCP connection
  *
@@ -338,6 +362,47 @@ static inline int net_tcp_update_recv_wnd(struct net_context *context,
 }
 #endif
 
+/**
+ * @brief Get the room left in the send buffer of a TCP connection
+ *
+ * @param context Network context
+ *
+ * @return Number of bytes that can be queued, SIZE_MAX if the socket has
+ *         no send buffer limit
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+size_t net_tcp_send_buf_space(struct net_context *context);
+#else
+static inline size_t net_tcp_send_buf_space(struct net_context *context)
+{
+	ARG_UNUSED(context);
+
+	return SIZE_MAX;
+}
+#endif
+
+/**
+ * @brief Get the semaphore telling if data can be queued for sending
+ *
+ * @details The semaphore is available when neither the receive window of
+ * the peer nor the send buffer of the socket is full, or once the
+ * connection is no longer established. Waiting for it must not take it.
+ *
+ * @param context Network context
+ *
+ * @return Pointer to the semaphore, NULL if there is no TCP connection
+ */
+#if defined(CONFIG_NET_NATIVE_TCP)
+struct k_sem *net_tcp_tx_sem_get(struct net_context *context);
+#else
+static inline struct k_sem *net_tcp_tx_sem_get(struct net_context *context)
+{
+	ARG_UNUSED(context);
+
+	return NULL;
+}
+#endif
+
 /**
  * @brief Queue a TCP FIN packet if needed to close the socket
  *
@@ -359,6 +424,78 @@ static inline int net_tcp_put(struct net_context *context)
 }
 #endif
 
+/**
+ * @typedef net_tcp_gso_cb_t
+ * @brief Callback used to send the segments of a large TCP packet
+ *
+ * @param pkt Segment, the callback takes ownership of it
+ * @param user_data User data given to net_tcp_gso_segment()
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+typedef int (*net_tcp_gso_cb_t)(struct net_pkt *pkt, void *user_data);
+
+/**
+ * @brief Split a TCP packet into segments of net_pkt_gso_size() bytes
+ *
+ * @details The original packet is not modified. The sequence number and
+ * the checksums of every segment are updated, PSH and FIN are only set
+ * in the last one.
+ *
+ * @param pkt TCP packet
+ * @param cb Callback called for each segment
+ * @param user_data User data given to the callback
+ *
+ * @return 0 on success, negative errno otherwise.
+ */
+#if defined(CONFIG_NET_TCP_GSO)
+int net_tcp_gso_segment(struct net_pkt *pkt, net_tcp_gso_cb_t cb,
+			void *user_data);
+#else
+static inline int net_tcp_gso_segment(struct net_pkt *pkt,
+				      net_tcp_gso_cb_t cb, void *user_data)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(cb);
+	ARG_UNUSED(user_data);
+
+	return -ENOTSUP;
+}
+#endif
+
+/**
+ * @brief Merge a received TCP segment with the in-order segments of the
+ *        same connection waiting in an RX queue
+ *
+ * @details The packets following pkt are taken from the queue and go
+ * through net_process_rx_l2() one by one before they are merged. The
+ * queue is never waited on and stays in order: merging stops at the
+ * first packet that cannot be merged, which is returned in next and
+ * must be processed right after the merged packet.
+ *
+ * @param fifo RX queue the packet was taken from
+ * @param pkt Network packet processed by the L2
+ * @param next Set to the packet to process after the returned one, or
+ *        to NULL
+ *
+ * @return The packet to process, pkt itself.
+ */
+#if defined(CONFIG_NET_TCP_GRO)
+struct net_pkt *net_tcp_gro_receive(struct k_fifo *fifo, struct net_pkt *pkt,
+				    struct net_pkt **next);
+#else
+static inline struct net_pkt *net_tcp_gro_receive(struct k_fifo *fifo,
+						  struct net_pkt *pkt,
+						  struct net_pkt **next)
+{
+	ARG_UNUSED(fifo);
+
+	*next = NULL;
+
+	return pkt;
+}
+#endif
+
 #define NET_TCP_MAX_OPT_SIZE  8
 
 #if defined(CONFIG_NET_NATIVE_TCP)
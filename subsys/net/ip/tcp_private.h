@@ -232,8 +232,13 @@ struct tcp { /* TCP connection */
 		net_tcp_accept_cb_t accept_cb;
 		struct tcp *accepted_conn;
 	};
+#if defined(CONFIG_NET_TCP_SYN_QUEUE)
+	atomic_t accept_queued; /* listener: connections not accepted yet */
+	uint16_t backlog; /* listener: accept queue limit */
+#endif
 	struct k_mutex lock;
 	struct k_sem connect_sem; /* semaphore for blocking connect */
+	struct k_sem tx_sem; /* available while data can be queued */
 	struct k_fifo recv_data;  /* temp queue before passing data to app */
 	struct tcp_options recv_options;
 	struct tcp_options send_options;
@@ -487,65 +487,145 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+static inline uint16_t chksum_add(uint16_t sum, uint16_t val)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	sum += val;
+	if (sum < val) {
+		sum++;
+	}
 
-	end = data + len - 1;
+	return sum;
+}
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+/* Fold the 64-bit accumulator of native endian words into a 16-bit
+ * ones' complement sum in network byte order.
+ */
+static inline uint16_t chksum_fold(uint64_t acc)
+{
+	acc = (acc & 0xffffffffU) + (acc >> 32);
+	acc = (acc & 0xffffffffU) + (acc >> 32);
+	acc = (acc & 0xffffU) + (acc >> 16);
+	acc = (acc & 0xffffU) + (acc >> 16);
 
-		data += 2;
+	return sys_be16_to_cpu((uint16_t)acc);
+}
+
+/* Sum the last len (less than 16) bytes of the data */
+static inline uint64_t chksum_tail(uint64_t acc, const uint8_t *data,
+				   size_t len)
+{
+	while (len >= sizeof(uint32_t)) {
+		acc += UNALIGNED_GET((const uint32_t *)data);
+		data += sizeof(uint32_t);
+		len -= sizeof(uint32_t);
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	if (len >= sizeof(uint16_t)) {
+		acc += UNALIGNED_GET((const uint16_t *)data);
+		data += sizeof(uint16_t);
+		len -= sizeof(uint16_t);
 	}
 
-	return sum;
+	if (len) {
+		/* The odd byte is the high byte of the last 16-bit word */
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		acc += (uint16_t)data[0] << 8;
+#else
+		acc += data[0];
+#endif
+	}
+
+	return acc;
 }
 
-static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
+/* The ones' complement sum does not depend on the byte order of the
+ * words it is computed over (RFC 1071), so the data is summed 32 bits
+ * at a time in native byte order into a 64-bit accumulator and only
+ * the folded result is converted. 16 bytes are handled per iteration,
+ * the accumulator cannot overflow for any packet size.
+ */
+static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	uint64_t acc = 0U;
+
+	while (len >= 4 * sizeof(uint32_t)) {
+		acc += (uint64_t)UNALIGNED_GET((const uint32_t *)data) +
+		       UNALIGNED_GET((const uint32_t *)(data + 4)) +
+		       UNALIGNED_GET((const uint32_t *)(data + 8)) +
+		       UNALIGNED_GET((const uint32_t *)(data + 12));
+
+		data += 4 * sizeof(uint32_t);
+		len -= 4 * sizeof(uint32_t);
+	}
+
+	acc = chksum_tail(acc, data, len);
+
+	return chksum_add(sum, chksum_fold(acc));
+}
+
+uint16_t net_calc_chksum_buf(uint16_t sum, const uint8_t *data, size_t len)
+{
+	return calc_chksum(sum, data, len);
+}
+
+uint16_t net_calc_chksum_copy(uint16_t sum, uint8_t *dst, const uint8_t *src,
+			      size_t len)
+{
+	uint64_t acc = 0U;
+
+	while (len >= 4 * sizeof(uint32_t)) {
+		uint32_t w0 = UNALIGNED_GET((const uint32_t *)src);
+		uint32_t w1 = UNALIGNED_GET((const uint32_t *)(src + 4));
+		uint32_t w2 = UNALIGNED_GET((const uint32_t *)(src + 8));
+		uint32_t w3 = UNALIGNED_GET((const uint32_t *)(src + 12));
+
+		UNALIGNED_PUT(w0, (uint32_t *)dst);
+		UNALIGNED_PUT(w1, (uint32_t *)(dst + 4));
+		UNALIGNED_PUT(w2, (uint32_t *)(dst + 8));
+		UNALIGNED_PUT(w3, (uint32_t *)(dst + 12));
+
+		acc += (uint64_t)w0 + w1 + w2 + w3;
+
+		src += 4 * sizeof(uint32_t);
+		dst += 4 * sizeof(uint32_t);
+		len -= 4 * sizeof(uint32_t);
+	}
+
+	memcpy(dst, src, len);
+	acc = chksum_tail(acc, dst, len);
+
+	return chksum_add(sum, chksum_fold(acc));
+}
+
+/* Sum at most len bytes from the cursor position onwards. A fragment
+ * may end on an odd byte, in which case the sum of the next fragment
+ * is computed as if it was aligned and then byte swapped.
+ */
+static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum,
+				       size_t len)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
-	size_t len;
+	bool odd = false;
 
 	if (!cur->buf || !cur->pos) {
 		return sum;
 	}
 
-	len = cur->buf->len - (cur->pos - cur->buf->data);
+	while (cur->buf && len) {
+		size_t chunk = cur->buf->len - (cur->pos - cur->buf->data);
+		uint16_t tmp;
 
-	while (cur->buf) {
-		sum = calc_chksum(sum, cur->pos, len);
+		chunk = MIN(chunk, len);
 
-		cur->buf = cur->buf->frags;
-		if (!cur->buf || !cur->buf->len) {
-			break;
-		}
+		tmp = calc_chksum(0, cur->pos, chunk);
+		sum = chksum_add(sum, odd ? __bswap_16(tmp) : tmp);
 
-		cur->pos = cur->buf->data;
+		odd ^= chunk & 1;
+		len -= chunk;
 
-		if (len % 2) {
-			sum += *cur->pos;
-			if (sum < *cur->pos) {
-				sum++;
-			}
-
-			cur->pos++;
-			len = cur->buf->len - 1;
-		} else {
-			len = cur->buf->len;
+		cur->buf = cur->buf->frags;
+		if (cur->buf) {
+			cur->pos = cur->buf->data;
 		}
 	}
 
@@ -558,6 +638,9 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	uint16_t sum = 0U;
 	struct net_pkt_cursor backup;
 	bool ow;
+#if defined(CONFIG_NET_UDP_CHKSUM_COPY)
+	uint16_t start, part;
+#endif
 
 	if (IS_ENABLED(CONFIG_NET_IPV4) &&
 	    net_pkt_family(pkt) == AF_INET) {
@@ -589,7 +672,22 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+#if defined(CONFIG_NET_UDP_CHKSUM_COPY)
+	/* The payload was summed while it was copied into the packet,
+	 * only the transport header in front of it needs to be read.
+	 */
+	if (net_pkt_chksum_get(pkt, &start, &part) &&
+	    start >= net_pkt_get_current_offset(pkt)) {
+		len = start - net_pkt_get_current_offset(pkt);
+
+		sum = pkt_calc_chksum(pkt, sum, len);
+		sum = chksum_add(sum, (len & 1) ? __bswap_16(part) : part);
+	} else {
+		sum = pkt_calc_chksum(pkt, sum, SIZE_MAX);
+	}
+#else
+	sum = pkt_calc_chksum(pkt, sum, SIZE_MAX);
+#endif
 
 	sum = (sum == 0U) ? 0xffff : htons(sum);
 
@@ -22,79 +22,133 @@ LOG_MODULE_REGISTER(net_arp, CONFIG_NET_ARP_LOG_LEVEL);
 
 #define NET_BUF_TIMEOUT K_MSEC(100)
 #define ARP_REQUEST_TIMEOUT (2 * MSEC_PER_SEC)
+#define ARP_ENTRY_TIMEOUT (CONFIG_NET_ARP_ENTRY_TIMEOUT * MSEC_PER_SEC)
 
 static bool arp_cache_initialized;
 static struct arp_entry arp_entries[CONFIG_NET_ARP_TABLE_SIZE];
 
-static sys_slist_t arp_free_entries;
-static sys_slist_t arp_pending_entries;
-static sys_slist_t arp_table;
+static sys_dlist_t arp_free_entries;
+static sys_dlist_t arp_pending_entries;
+static sys_dlist_t arp_table;
+
+/* Both pending and resolved entries are indexed by interface and address */
+static sys_slist_t arp_hash_table[CONFIG_NET_ARP_HASH_SIZE];
 
 struct k_work_delayable arp_request_timer;
 
+static sys_slist_t *arp_hash_bucket(struct net_if *iface,
+				    struct in_addr *addr)
+{
+	uint32_t hash = addr->s_addr ^
+			(uint32_t)(uintptr_t)iface;
+
+	hash ^= hash >> 16;
+	hash *= 0x7feb352dU;
+	hash ^= hash >> 15;
+	hash *= 0x846ca68bU;
+	hash ^= hash >> 16;
+
+	return &arp_hash_table[hash % CONFIG_NET_ARP_HASH_SIZE];
+}
+
+static void arp_hash_add(struct arp_entry *entry)
+{
+	sys_slist_prepend(arp_hash_bucket(entry->iface, &entry->ip),
+			  &entry->hash_node);
+}
+
+static void arp_hash_remove(struct arp_entry *entry)
+{
+	sys_slist_find_and_remove(arp_hash_bucket(entry->iface, &entry->ip),
+				  &entry->hash_node);
+}
+
 static void arp_entry_cleanup(struct arp_entry *entry, bool pending)
 {
+	int i;
+
 	NET_DBG("%p", entry);
 
 	if (pending) {
-		NET_DBG("Releasing pending pkt %p (ref %ld)",
-			entry->pending,
-			atomic_get(&entry->pending->atomic_ref) - 1);
-		net_pkt_unref(entry->pending);
-		entry->pending = NULL;
+		for (i = 0; i < entry->pending_count; i++) {
+			NET_DBG("Releasing pending pkt %p (ref %ld)",
+				entry->pending[i],
+				atomic_get(&entry->pending[i]->atomic_ref) - 1);
+			net_pkt_unref(entry->pending[i]);
+		}
 	}
 
+	entry->pending_count = 0U;
 	entry->iface = NULL;
 
 	(void)memset(&entry->ip, 0, sizeof(struct in_addr));
 	(void)memset(&entry->eth, 0, sizeof(struct net_eth_addr));
 }
 
-static struct arp_entry *arp_entry_find(sys_slist_t *list,
-					struct net_if *iface,
+static struct arp_entry *arp_entry_find(struct net_if *iface,
 					struct in_addr *dst,
-					sys_snode_t **previous)
+					bool pending)
 {
 	struct arp_entry *entry;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(list, entry, node) {
+	SYS_SLIST_FOR_EACH_CONTAINER(arp_hash_bucket(iface, dst), entry,
+				     hash_node) {
 		NET_DBG("iface %p dst %s",
 			iface, log_strdup(net_sprint_ipv4_addr(&entry->ip)));
 
 		if (entry->iface == iface &&
 		    net_ipv4_addr_cmp(&entry->ip, dst)) {
-			return entry;
-		}
-
-		if (previous) {
-			*previous = &entry->node;
+			/* An address is either pending or resolved */
+			return (entry->pending_count > 0U) == pending ?
+				entry : NULL;
 		}
 	}
 
 	return NULL;
 }
 
+static bool arp_entry_expired(struct arp_entry *entry)
+{
+	if (ARP_ENTRY_TIMEOUT == 0) {
+		return false;
+	}
+
+	return k_uptime_get() - entry->req_start >= ARP_ENTRY_TIMEOUT;
+}
+
 static inline struct arp_entry *arp_entry_find_move_first(struct net_if *iface,
 							  struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_table, iface, dst, &prev);
-	if (entry) {
-		/* Let's assume the target is going to be accessed
-		 * more than once here in a short time frame. So we
-		 * place the entry first in position into the table
-		 * in order to reduce subsequent find.
-		 */
-		if (&entry->node != sys_slist_peek_head(&arp_table)) {
-			sys_slist_remove(&arp_table, prev, &entry->node);
-			sys_slist_prepend(&arp_table, &entry->node);
-		}
+	entry = arp_entry_find(iface, dst, false);
+	if (!entry) {
+		return NULL;
+	}
+
+	sys_dlist_remove(&entry->node);
+
+	if (arp_entry_expired(entry)) {
+		NET_DBG("Entry %p for %s expired", entry,
+			log_strdup(net_sprint_ipv4_addr(dst)));
+
+		/* Resolve the address again */
+		arp_hash_remove(entry);
+		arp_entry_cleanup(entry, false);
+		sys_dlist_prepend(&arp_free_entries, &entry->node);
+
+		return NULL;
 	}
 
+	/* Let's assume the target is going to be accessed
+	 * more than once here in a short time frame. So we
+	 * place the entry first in position into the table
+	 * so that the least recently used one is at the end.
+	 */
+	sys_dlist_prepend(&arp_table, &entry->node);
+
 	return entry;
 }
 
@@ -104,24 +158,25 @@ struct arp_entry *arp_entry_find_pending(struct net_if *iface,
 {
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	return arp_entry_find(&arp_pending_entries, iface, dst, NULL);
+	return arp_entry_find(iface, dst, true);
 }
 
 static struct arp_entry *arp_entry_get_pending(struct net_if *iface,
 					       struct in_addr *dst)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(dst)));
 
-	entry = arp_entry_find(&arp_pending_entries, iface, dst, &prev);
+	entry = arp_entry_find(iface, dst, true);
 	if (entry) {
-		/* We remove the entry from the pending list */
-		sys_slist_remove(&arp_pending_entries, prev, &entry->node);
+		/* We remove the entry from the pending list, it stays
+		 * in the hash table as it is about to be resolved.
+		 */
+		sys_dlist_remove(&entry->node);
 	}
 
-	if (sys_slist_is_empty(&arp_pending_entries)) {
+	if (sys_dlist_is_empty(&arp_pending_entries)) {
 		k_work_cancel_delayable(&arp_request_timer);
 	}
 
@@ -130,35 +185,37 @@ static struct arp_entry *arp_entry_get_pending(struct net_if *iface,
 
 static struct arp_entry *arp_entry_get_free(void)
 {
-	sys_snode_t *node;
+	sys_dnode_t *node;
 
-	node = sys_slist_peek_head(&arp_free_entries);
+	/* We remove the node from the free list */
+	node = sys_dlist_get(&arp_free_entries);
 	if (!node) {
 		return NULL;
 	}
 
-	/* We remove the node from the free list */
-	sys_slist_remove(&arp_free_entries, NULL, node);
-
 	return CONTAINER_OF(node, struct arp_entry, node);
 }
 
 static struct arp_entry *arp_entry_get_last_from_table(void)
 {
-	sys_snode_t *node;
+	struct arp_entry *entry;
+	sys_dnode_t *node;
 
-	/* We assume last entry is the oldest one,
+	/* The last entry is the least recently used one,
 	 * so is the preferred one to be taken out.
 	 */
 
-	node = sys_slist_peek_tail(&arp_table);
+	node = sys_dlist_peek_tail(&arp_table);
 	if (!node) {
 		return NULL;
 	}
 
-	sys_slist_find_and_remove(&arp_table, node);
+	sys_dlist_remove(node);
 
-	return CONTAINER_OF(node, struct arp_entry, node);
+	entry = CONTAINER_OF(node, struct arp_entry, node);
+	arp_hash_remove(entry);
+
+	return entry;
 }
 
 
@@ -166,9 +223,10 @@ static void arp_entry_register_pending(struct arp_entry *entry)
 {
 	NET_DBG("dst %s", log_strdup(net_sprint_ipv4_addr(&entry->ip)));
 
-	sys_slist_append(&arp_pending_entries, &entry->node);
+	sys_dlist_append(&arp_pending_entries, &entry->node);
+	arp_hash_add(entry);
 
-	entry->req_start = k_uptime_get_32();
+	entry->req_start = k_uptime_get();
 
 	/* Let's start the timer if necessary */
 	if (!k_work_delayable_remaining_get(&arp_request_timer)) {
@@ -177,24 +235,45 @@ static void arp_entry_register_pending(struct arp_entry *entry)
 	}
 }
 
+static void arp_entry_queue_pending(struct arp_entry *entry,
+				    struct net_pkt *pkt)
+{
+	int i;
+
+	for (i = 0; i < entry->pending_count; i++) {
+		if (entry->pending[i] == pkt) {
+			return;
+		}
+	}
+
+	if (entry->pending_count == ARRAY_SIZE(entry->pending)) {
+		NET_DBG("Pending queue of %s full, dropping pkt %p",
+			log_strdup(net_sprint_ipv4_addr(&entry->ip)), pkt);
+		return;
+	}
+
+	/* Sent in order once the address is resolved */
+	entry->pending[entry->pending_count++] = net_pkt_ref(pkt);
+}
+
 static void arp_request_timeout(struct k_work *work)
 {
-	uint32_t current = k_uptime_get_32();
+	int64_t current = k_uptime_get();
 	struct arp_entry *entry, *next;
 
 	ARG_UNUSED(work);
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
 					  entry, next, node) {
-		if ((int32_t)(entry->req_start +
-			    ARP_REQUEST_TIMEOUT - current) > 0) {
+		if (entry->req_start + ARP_REQUEST_TIMEOUT - current > 0) {
 			break;
 		}
 
+		arp_hash_remove(entry);
 		arp_entry_cleanup(entry, true);
 
-		sys_slist_remove(&arp_pending_entries, NULL, &entry->node);
-		sys_slist_append(&arp_free_entries, &entry->node);
+		sys_dlist_remove(&entry->node);
+		sys_dlist_append(&arp_free_entries, &entry->node);
 
 		entry = NULL;
 	}
@@ -271,7 +350,8 @@ static inline struct net_pkt *arp_prepare(struct net_if *iface,
 	 * request and we want to send it again.
 	 */
 	if (entry) {
-		entry->pending = net_pkt_ref(pending);
+		entry->pending[0] = net_pkt_ref(pending);
+		entry->pending_count = 1U;
 		entry->iface = net_pkt_iface(pkt);
 
 		net_ipaddr_copy(&entry->ip, next_addr);
@@ -370,6 +450,10 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 			}
 		} else {
 			/* There is a pending already */
+			if (!current_ip) {
+				arp_entry_queue_pending(entry, pkt);
+			}
+
 			entry = NULL;
 		}
 
@@ -379,7 +463,8 @@ struct net_pkt *net_arp_prepare(struct net_pkt *pkt,
 		if (!entry) {
 			/* We cannot send the packet, the ARP cache is full
 			 * or there is already a pending query to this IP
-			 * address, so this packet must be discarded.
+			 * address, so this packet must be discarded unless
+			 * it was queued behind the pending one.
 			 */
 			NET_DBG("Resending ARP %p", req);
 		}
@@ -406,10 +491,9 @@ static void arp_gratuitous(struct net_if *iface,
 			   struct in_addr *src,
 			   struct net_eth_addr *hwaddr)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry;
 
-	entry = arp_entry_find(&arp_table, iface, src, &prev);
+	entry = arp_entry_find(iface, src, false);
 	if (entry) {
 		NET_DBG("Gratuitous ARP hwaddr %s -> %s",
 			log_strdup(net_sprint_ll_addr(
@@ -420,6 +504,7 @@ static void arp_gratuitous(struct net_if *iface,
 					   sizeof(struct net_eth_addr))));
 
 		memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+		entry->req_start = k_uptime_get();
 	}
 }
 
@@ -429,8 +514,10 @@ static void arp_update(struct net_if *iface,
 		       bool gratuitous,
 		       bool force)
 {
+	struct net_pkt *pending[CONFIG_NET_ARP_MAX_PENDING_PKTS];
 	struct arp_entry *entry;
-	struct net_pkt *pkt;
+	uint8_t pending_count;
+	int i;
 
 	NET_DBG("src %s", log_strdup(net_sprint_ipv4_addr(src)));
 
@@ -441,13 +528,13 @@ static void arp_update(struct net_if *iface,
 		}
 
 		if (force) {
-			sys_snode_t *prev = NULL;
 			struct arp_entry *entry;
 
-			entry = arp_entry_find(&arp_table, iface, src, &prev);
+			entry = arp_entry_find(iface, src, false);
 			if (entry) {
 				memcpy(&entry->eth, hwaddr,
 				       sizeof(struct net_eth_addr));
+				entry->req_start = k_uptime_get();
 			} else {
 				/* Add new entry as it was not found and force
 				 * was set.
@@ -459,11 +546,12 @@ static void arp_update(struct net_if *iface,
 				}
 
 				if (entry) {
-					entry->req_start = k_uptime_get_32();
+					entry->req_start = k_uptime_get();
 					entry->iface = iface;
 					net_ipaddr_copy(&entry->ip, src);
 					memcpy(&entry->eth, hwaddr, sizeof(entry->eth));
-					sys_slist_prepend(&arp_table, &entry->node);
+					sys_dlist_prepend(&arp_table, &entry->node);
+					arp_hash_add(entry);
 				}
 			}
 		}
@@ -471,24 +559,31 @@ static void arp_update(struct net_if *iface,
 		return;
 	}
 
-	/* Set the dst in the pending packet */
-	net_pkt_lladdr_dst(entry->pending)->len = sizeof(struct net_eth_addr);
-	net_pkt_lladdr_dst(entry->pending)->addr =
-		(uint8_t *) &NET_ETH_HDR(entry->pending)->dst.addr;
+	/* The pending packets share storage with the hardware address */
+	pending_count = entry->pending_count;
+	memcpy(pending, entry->pending, pending_count * sizeof(pending[0]));
+	entry->pending_count = 0U;
 
-	NET_DBG("dst %s pending %p frag %p",
-		log_strdup(net_sprint_ipv4_addr(&entry->ip)),
-		entry->pending, entry->pending->frags);
+	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+	entry->req_start = k_uptime_get();
 
-	pkt = entry->pending;
-	entry->pending = NULL;
+	/* Inserting entry into the table, it is already hashed */
+	sys_dlist_prepend(&arp_table, &entry->node);
 
-	memcpy(&entry->eth, hwaddr, sizeof(struct net_eth_addr));
+	/* Send the pending packets in the order they were queued */
+	for (i = 0; i < pending_count; i++) {
+		/* Set the dst in the pending packet */
+		net_pkt_lladdr_dst(pending[i])->len =
+			sizeof(struct net_eth_addr);
+		net_pkt_lladdr_dst(pending[i])->addr =
+			(uint8_t *) &NET_ETH_HDR(pending[i])->dst.addr;
 
-	/* Inserting entry into the table */
-	sys_slist_prepend(&arp_table, &entry->node);
+		NET_DBG("dst %s pending %p frag %p",
+			log_strdup(net_sprint_ipv4_addr(&entry->ip)),
+			pending[i], pending[i]->frags);
 
-	net_if_queue_tx(iface, pkt);
+		net_if_queue_tx(iface, pending[i]);
+	}
 }
 
 static inline struct net_pkt *arp_prepare_reply(struct net_if *iface,
@@ -677,41 +772,38 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 
 void net_arp_clear_cache(struct net_if *iface)
 {
-	sys_snode_t *prev = NULL;
 	struct arp_entry *entry, *next;
 
 	NET_DBG("Flushing ARP table");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_table, entry, next, node) {
 		if (iface && iface != entry->iface) {
-			prev = &entry->node;
 			continue;
 		}
 
+		arp_hash_remove(entry);
 		arp_entry_cleanup(entry, false);
 
-		sys_slist_remove(&arp_table, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+		sys_dlist_remove(&entry->node);
+		sys_dlist_prepend(&arp_free_entries, &entry->node);
 	}
 
-	prev = NULL;
-
 	NET_DBG("Flushing ARP pending requests");
 
-	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&arp_pending_entries,
 					  entry, next, node) {
 		if (iface && iface != entry->iface) {
-			prev = &entry->node;
 			continue;
 		}
 
+		arp_hash_remove(entry);
 		arp_entry_cleanup(entry, true);
 
-		sys_slist_remove(&arp_pending_entries, prev, &entry->node);
-		sys_slist_prepend(&arp_free_entries, &entry->node);
+		sys_dlist_remove(&entry->node);
+		sys_dlist_prepend(&arp_free_entries, &entry->node);
 	}
 
-	if (sys_slist_is_empty(&arp_pending_entries)) {
+	if (sys_dlist_is_empty(&arp_pending_entries)) {
 		k_work_cancel_delayable(&arp_request_timer);
 	}
 }
@@ -721,7 +813,7 @@ int net_arp_foreach(net_arp_cb_t cb, void *user_data)
 	int ret = 0;
 	struct arp_entry *entry;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
+	SYS_DLIST_FOR_EACH_CONTAINER(&arp_table, entry, node) {
 		ret++;
 		cb(entry, user_data);
 	}
@@ -737,13 +829,17 @@ void net_arp_init(void)
 		return;
 	}
 
-	sys_slist_init(&arp_free_entries);
-	sys_slist_init(&arp_pending_entries);
-	sys_slist_init(&arp_table);
+	sys_dlist_init(&arp_free_entries);
+	sys_dlist_init(&arp_pending_entries);
+	sys_dlist_init(&arp_table);
+
+	for (i = 0; i < CONFIG_NET_ARP_HASH_SIZE; i++) {
+		sys_slist_init(&arp_hash_table[i]);
+	}
 
 	for (i = 0; i < CONFIG_NET_ARP_TABLE_SIZE; i++) {
 		/* Inserting entry as free */
-		sys_slist_prepend(&arp_free_entries, &arp_entries[i].node);
+		sys_dlist_prepend(&arp_free_entries, &arp_entries[i].node);
 	}
 
 	k_work_init_delayable(&arp_request_timer, arp_request_timeout);
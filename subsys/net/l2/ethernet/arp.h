@@ -10,6 +10,7 @@
 #if defined(CONFIG_NET_ARP) && defined(CONFIG_NET_NATIVE)
 
 #include <sys/slist.h>
+#include <sys/dlist.h>
 #include <net/ethernet.h>
 
 #ifdef __cplusplus
@@ -50,14 +51,18 @@ enum net_verdict net_arp_input(struct net_pkt *pkt,
 			       struct net_eth_hdr *eth_hdr);
 
 struct arp_entry {
-	sys_snode_t node;
-	uint32_t req_start;
+	sys_dnode_t node;
+	sys_snode_t hash_node;
+	/* Request time while pending, then time of the last update */
+	int64_t req_start;
 	struct net_if *iface;
 	struct in_addr ip;
 	union {
-		struct net_pkt *pending;
+		struct net_pkt *pending[CONFIG_NET_ARP_MAX_PENDING_PKTS];
 		struct net_eth_addr eth;
 	};
+	/* Number of packets waiting for the address, 0 once resolved */
+	uint8_t pending_count;
 };
 
 typedef void (*net_arp_cb_t)(struct arp_entry *entry,
@@ -14,6 +14,7 @@ LOG_MODULE_REGISTER(net_eth_bridge, CONFIG_NET_ETHERNET_BRIDGE_LOG_LEVEL);
 #include <net/ethernet_bridge.h>
 
 #include <sys/slist.h>
+#include <string.h>
 
 #include "bridge.h"
 
@@ -50,6 +51,232 @@ struct eth_bridge *eth_bridge_get_by_index(int index)
 	return &_eth_bridge_list_start[index - 1];
 }
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+
+#define FDB_AGEING_TIME_MS \
+	(CONFIG_NET_ETHERNET_BRIDGE_FDB_AGEING_TIME * MSEC_PER_SEC)
+
+static inline uint32_t fdb_hash(const uint8_t *addr)
+{
+	uint32_t hash = 0U;
+	int i;
+
+	for (i = 0; i < sizeof(struct net_eth_addr); i++) {
+		hash = hash * 31U + addr[i];
+	}
+
+	return hash % CONFIG_NET_ETHERNET_BRIDGE_FDB_SIZE;
+}
+
+static inline bool fdb_is_expired(struct eth_bridge_fdb_entry *entry,
+				  int64_t now)
+{
+	return !entry->is_static &&
+	       (now - entry->last_seen) > FDB_AGEING_TIME_MS;
+}
+
+static void fdb_remove(struct eth_bridge *br,
+		       struct eth_bridge_fdb_entry *entry)
+{
+	sys_slist_find_and_remove(&br->fdb_buckets[fdb_hash(entry->addr)],
+				  &entry->node);
+	entry->iface = NULL;
+}
+
+static struct eth_bridge_fdb_entry *fdb_find(struct eth_bridge *br,
+					     const uint8_t *addr)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&br->fdb_buckets[fdb_hash(addr)],
+				     entry, node) {
+		if (memcmp(entry->addr, addr, sizeof(entry->addr)) == 0) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+/* Get an unused entry, or else the least recently seen learned one */
+static struct eth_bridge_fdb_entry *fdb_alloc(struct eth_bridge *br,
+					      const uint8_t *addr)
+{
+	struct eth_bridge_fdb_entry *oldest = NULL;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(br->fdb); i++) {
+		struct eth_bridge_fdb_entry *entry = &br->fdb[i];
+
+		if (entry->iface == NULL) {
+			oldest = entry;
+			break;
+		}
+
+		if (entry->is_static) {
+			continue;
+		}
+
+		if (oldest == NULL || entry->last_seen < oldest->last_seen) {
+			oldest = entry;
+		}
+	}
+
+	if (oldest == NULL) {
+		return NULL;
+	}
+
+	if (oldest->iface != NULL) {
+		fdb_remove(br, oldest);
+	}
+
+	memcpy(oldest->addr, addr, sizeof(oldest->addr));
+	sys_slist_prepend(&br->fdb_buckets[fdb_hash(addr)], &oldest->node);
+
+	return oldest;
+}
+
+static void fdb_learn(struct eth_bridge *br, const uint8_t *addr,
+		      struct net_if *iface)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	entry = fdb_find(br, addr);
+	if (entry == NULL) {
+		entry = fdb_alloc(br, addr);
+		if (entry == NULL) {
+			return;
+		}
+
+		entry->is_static = false;
+	} else if (entry->is_static) {
+		return;
+	}
+
+	entry->iface = iface;
+	entry->last_seen = k_uptime_get();
+}
+
+static struct net_if *fdb_lookup(struct eth_bridge *br, const uint8_t *addr)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	entry = fdb_find(br, addr);
+	if (entry == NULL) {
+		return NULL;
+	}
+
+	if (fdb_is_expired(entry, k_uptime_get())) {
+		fdb_remove(br, entry);
+		return NULL;
+	}
+
+	return entry->iface;
+}
+
+/* Remove the entries of iface, or of all interfaces if iface is NULL */
+static void fdb_flush(struct eth_bridge *br, struct net_if *iface,
+		      bool with_static)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(br->fdb); i++) {
+		struct eth_bridge_fdb_entry *entry = &br->fdb[i];
+
+		if (entry->iface == NULL ||
+		    (iface != NULL && entry->iface != iface) ||
+		    (entry->is_static && !with_static)) {
+			continue;
+		}
+
+		fdb_remove(br, entry);
+	}
+}
+
+int eth_bridge_fdb_add(struct eth_bridge *br, const struct net_eth_addr *addr,
+		       struct net_if *iface)
+{
+	struct ethernet_context *ctx = net_if_l2_data(iface);
+	struct eth_bridge_fdb_entry *entry;
+	int ret = 0;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&br->lock, K_FOREVER);
+
+	if (ctx->bridge.instance != br) {
+		ret = -EINVAL;
+		goto out;
+	}
+
+	entry = fdb_find(br, addr->addr);
+	if (entry == NULL) {
+		entry = fdb_alloc(br, addr->addr);
+		if (entry == NULL) {
+			ret = -ENOMEM;
+			goto out;
+		}
+	}
+
+	entry->iface = iface;
+	entry->is_static = true;
+	entry->last_seen = k_uptime_get();
+
+out:
+	k_mutex_unlock(&br->lock);
+	return ret;
+}
+
+int eth_bridge_fdb_del(struct eth_bridge *br, const struct net_eth_addr *addr)
+{
+	struct eth_bridge_fdb_entry *entry;
+
+	k_mutex_lock(&br->lock, K_FOREVER);
+
+	entry = fdb_find(br, addr->addr);
+	if (entry != NULL) {
+		fdb_remove(br, entry);
+	}
+
+	k_mutex_unlock(&br->lock);
+
+	return entry != NULL ? 0 : -ENOENT;
+}
+
+void eth_bridge_fdb_flush(struct eth_bridge *br)
+{
+	k_mutex_lock(&br->lock, K_FOREVER);
+	fdb_flush(br, NULL, false);
+	k_mutex_unlock(&br->lock);
+}
+
+void eth_bridge_fdb_foreach(struct eth_bridge *br, eth_bridge_fdb_cb_t cb,
+			    void *user_data)
+{
+	int64_t now = k_uptime_get();
+	int i;
+
+	k_mutex_lock(&br->lock, K_FOREVER);
+
+	for (i = 0; i < ARRAY_SIZE(br->fdb); i++) {
+		struct eth_bridge_fdb_entry *entry = &br->fdb[i];
+
+		if (entry->iface == NULL || fdb_is_expired(entry, now)) {
+			continue;
+		}
+
+		cb(br, (const struct net_eth_addr *)entry->addr, entry->iface,
+		   entry->is_static ? 0 : (uint32_t)(now - entry->last_seen),
+		   entry->is_static, user_data);
+	}
+
+	k_mutex_unlock(&br->lock);
+}
+
+#endif /* CONFIG_NET_ETHERNET_BRIDGE_FDB */
+
 int eth_bridge_iface_add(struct eth_bridge *br, struct net_if *iface)
 {
 	struct ethernet_context *ctx = net_if_l2_data(iface);
@@ -102,6 +329,10 @@ int eth_bridge_iface_remove(struct eth_bridge *br, struct net_if *iface)
 	sys_slist_find_and_remove(&br->interfaces, &ctx->bridge.node);
 	ctx->bridge.instance = NULL;
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	fdb_flush(br, iface, true);
+#endif
+
 	k_mutex_unlock(&br->lock);
 
 	NET_DBG("iface %p removed from bridge %p", iface, br);
@@ -137,6 +368,11 @@ int eth_bridge_listener_remove(struct eth_bridge *br, struct eth_bridge_listener
 	return 0;
 }
 
+static inline bool is_group_addr(struct net_eth_addr *addr)
+{
+	return (addr->addr[0] & 0x01) != 0;
+}
+
 static inline bool is_link_local_addr(struct net_eth_addr *addr)
 {
 	if (addr->addr[0] == 0x01 &&
@@ -155,20 +391,35 @@ enum net_verdict net_eth_bridge_input(struct ethernet_context *ctx,
 				      struct net_pkt *pkt)
 {
 	struct eth_bridge *br = ctx->bridge.instance;
+	struct net_eth_addr *src, *dst;
+	struct net_if *dst_iface = NULL;
 	sys_snode_t *node;
 
 	NET_DBG("new pkt %p", pkt);
 
+	src = (struct net_eth_addr *)net_pkt_lladdr_src(pkt)->addr;
+	dst = (struct net_eth_addr *)net_pkt_lladdr_dst(pkt)->addr;
+
 	/* Drop all link-local packets for now. */
-	if (is_link_local_addr((struct net_eth_addr *)net_pkt_lladdr_dst(pkt))) {
+	if (is_link_local_addr(dst)) {
 		return NET_DROP;
 	}
 
 	k_mutex_lock(&br->lock, K_FOREVER);
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	if (!is_group_addr(src)) {
+		fdb_learn(br, src->addr, ctx->iface);
+	}
+
+	if (!is_group_addr(dst)) {
+		dst_iface = fdb_lookup(br, dst->addr);
+	}
+#endif
+
 	/*
-	 * Send packet to all registered interfaces for now.
-	 * Eventually we could get smarter with a MAC address cache.
+	 * Send packet to the interface its destination is known to be on,
+	 * or else to all registered interfaces.
 	 */
 	SYS_SLIST_FOR_EACH_NODE(&br->interfaces, node) {
 		struct ethernet_context *out_ctx;
@@ -181,6 +432,11 @@ enum net_verdict net_eth_bridge_input(struct ethernet_context *ctx,
 			continue;
 		}
 
+		/* Skip it if the destination is known to be elsewhere */
+		if (dst_iface != NULL && dst_iface != out_ctx->iface) {
+			continue;
+		}
+
 		/* Skip it if not allowed to transmit */
 		if (!out_ctx->bridge.allow_tx) {
 			continue;
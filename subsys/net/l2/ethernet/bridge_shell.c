@@ -201,6 +201,158 @@ static int cmd_bridge_show(const struct shell *sh, size_t argc, char *argv[])
 	return 0;
 }
 
+#if defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+static struct eth_bridge *get_bridge(const struct shell *sh, char *index_str)
+{
+	struct eth_bridge *br;
+	int br_idx;
+
+	br_idx = get_idx(sh, index_str);
+	if (br_idx < 0) {
+		return NULL;
+	}
+	br = eth_bridge_get_by_index(br_idx);
+	if (br == NULL) {
+		shell_warn(sh, "Bridge %d not found\n", br_idx);
+	}
+	return br;
+}
+
+static int get_mac(const struct shell *sh, char *mac_str,
+		   struct net_eth_addr *addr)
+{
+	if (net_bytes_from_str(addr->addr, sizeof(addr->addr), mac_str) < 0) {
+		shell_warn(sh, "Invalid MAC address %s\n", mac_str);
+		return -EINVAL;
+	}
+	return 0;
+}
+
+static int cmd_bridge_fdb_add(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct net_eth_addr addr;
+	struct eth_bridge *br;
+	struct net_if *iface;
+	int if_idx;
+
+	br = get_bridge(sh, argv[1]);
+	if (br == NULL) {
+		return -ENOENT;
+	}
+	if (get_mac(sh, argv[2], &addr) < 0) {
+		return -EINVAL;
+	}
+	if_idx = get_idx(sh, argv[3]);
+	if (if_idx < 0) {
+		return if_idx;
+	}
+	iface = net_if_get_by_index(if_idx);
+	if (iface == NULL) {
+		shell_warn(sh, "Interface %d not found\n", if_idx);
+		return -ENOENT;
+	}
+
+	int ret = eth_bridge_fdb_add(br, &addr, iface);
+
+	if (ret < 0) {
+		shell_error(sh, "error: eth_bridge_fdb_add() returned %d\n", ret);
+	}
+	return ret;
+}
+
+static int cmd_bridge_fdb_del(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct net_eth_addr addr;
+	struct eth_bridge *br;
+
+	br = get_bridge(sh, argv[1]);
+	if (br == NULL) {
+		return -ENOENT;
+	}
+	if (get_mac(sh, argv[2], &addr) < 0) {
+		return -EINVAL;
+	}
+
+	int ret = eth_bridge_fdb_del(br, &addr);
+
+	if (ret < 0) {
+		shell_warn(sh, "No entry for %s\n", argv[2]);
+	}
+	return ret;
+}
+
+static int cmd_bridge_fdb_flush(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct eth_bridge *br;
+
+	br = get_bridge(sh, argv[1]);
+	if (br == NULL) {
+		return -ENOENT;
+	}
+
+	eth_bridge_fdb_flush(br);
+	return 0;
+}
+
+static void fdb_entry_show(struct eth_bridge *br,
+			   const struct net_eth_addr *addr,
+			   struct net_if *iface, uint32_t age,
+			   bool is_static, void *data)
+{
+	const struct shell *sh = data;
+
+	shell_fprintf(sh, SHELL_NORMAL,
+		      "%02x:%02x:%02x:%02x:%02x:%02x %-10d",
+		      addr->addr[0], addr->addr[1], addr->addr[2],
+		      addr->addr[3], addr->addr[4], addr->addr[5],
+		      net_if_get_by_iface(iface));
+	if (is_static) {
+		shell_fprintf(sh, SHELL_NORMAL, "static\n");
+	} else {
+		shell_fprintf(sh, SHELL_NORMAL, "%u\n", age / MSEC_PER_SEC);
+	}
+}
+
+static int cmd_bridge_fdb_show(const struct shell *sh, size_t argc, char *argv[])
+{
+	struct eth_bridge *br;
+
+	br = get_bridge(sh, argv[1]);
+	if (br == NULL) {
+		return -ENOENT;
+	}
+
+	shell_fprintf(sh, SHELL_NORMAL, "address           iface     age (s)\n");
+	eth_bridge_fdb_foreach(br, fdb_entry_show, (void *)sh);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(bridge_fdb_commands,
+	SHELL_CMD_ARG(add, NULL,
+		  "Add a static forwarding database entry.\n"
+		  "'bridge fdb add <bridge_index> <mac> <interface_index>'",
+		  cmd_bridge_fdb_add, 4, 0),
+	SHELL_CMD_ARG(del, NULL,
+		  "Delete a forwarding database entry.\n"
+		  "'bridge fdb del <bridge_index> <mac>'",
+		  cmd_bridge_fdb_del, 3, 0),
+	SHELL_CMD_ARG(flush, NULL,
+		  "Delete all learned forwarding database entries.\n"
+		  "'bridge fdb flush <bridge_index>'",
+		  cmd_bridge_fdb_flush, 2, 0),
+	SHELL_CMD_ARG(show, NULL,
+		  "Show the forwarding database.\n"
+		  "'bridge fdb show <bridge_index>'",
+		  cmd_bridge_fdb_show, 2, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+#define BRIDGE_FDB_COMMANDS (&bridge_fdb_commands)
+#else
+#define BRIDGE_FDB_COMMANDS NULL
+#endif /* CONFIG_NET_ETHERNET_BRIDGE_FDB */
+
 SHELL_STATIC_SUBCMD_SET_CREATE(bridge_commands,
 	SHELL_CMD_ARG(addif, NULL,
 		  "Add a network interface to a bridge.\n"
@@ -218,6 +370,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(bridge_commands,
 		  "Show bridge information.\n"
 		  "'bridge show [<bridge_index>]'",
 		  cmd_bridge_show, 1, 1),
+	SHELL_COND_CMD(CONFIG_NET_ETHERNET_BRIDGE_FDB, fdb, BRIDGE_FDB_COMMANDS,
+		  "Forwarding database commands.", NULL),
 	SHELL_SUBCMD_SET_END
 );
 
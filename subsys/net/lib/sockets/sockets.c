@@ -26,6 +26,7 @@ LOG_MODULE_REGISTER(net_sock, CONFIG_NET_SOCKETS_LOG_LEVEL);
 #endif
 
 #include "../../ip/net_stats.h"
+#include "../../ip/tcp_internal.h"
 
 #include "sockets_internal.h"
 
@@ -346,6 +347,7 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 		k_condvar_init(&new_ctx->cond.recv);
 
 		k_fifo_put(&parent->accept_q, new_ctx);
+		net_tcp_accept_queue_update(parent, 1);
 
 		/* TCP context is effectively owned by both application
 		 * and the stack: stack may detect that peer closed/aborted
@@ -568,6 +570,8 @@ int zsock_accept_ctx(struct net_context *parent, struct sockaddr *addr,
 		return -1;
 	}
 
+	net_tcp_accept_queue_update(parent, -1);
+
 	/* Check if the connection is already disconnected */
 	last_pkt = k_fifo_peek_tail(&ctx->recv_q);
 	if (last_pkt) {
@@ -648,12 +652,55 @@ static inline int z_vrfy_zsock_accept(int sock, struct sockaddr *addr,
 #define WAIT_BUFS K_MSEC(100)
 #define MAX_WAIT_BUFS K_SECONDS(10)
 
+/* Blocking stream sockets wait for room in the send buffer and in the
+ * peer window instead of polling for it.
+ */
+static bool sock_tx_can_wait(struct net_context *ctx, k_timeout_t timeout)
+{
+	return IS_ENABLED(CONFIG_NET_NATIVE_TCP) &&
+	       !K_TIMEOUT_EQ(timeout, K_NO_WAIT) &&
+	       net_context_get_type(ctx) == SOCK_STREAM;
+}
+
+/* Wait until data can be queued on a stream socket, or the connection is
+ * closed. The semaphore is looked up again for every wait as it is freed
+ * along with the connection.
+ */
+static int sock_wait_tx(struct net_context *ctx, uint64_t end)
+{
+	struct k_poll_event event;
+	k_timeout_t timeout = K_FOREVER;
+	struct k_sem *tx_sem;
+
+	tx_sem = net_tcp_tx_sem_get(ctx);
+	if (!tx_sem) {
+		return -ENOTCONN;
+	}
+
+	if (end != UINT64_MAX) {
+		int64_t remaining = end - sys_clock_tick_get();
+
+		if (remaining <= 0) {
+			return -EAGAIN;
+		}
+
+		timeout = Z_TIMEOUT_TICKS(remaining);
+	}
+
+	k_poll_event_init(&event, K_POLL_TYPE_SEM_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, tx_sem);
+
+	return k_poll(&event, 1, timeout);
+}
+
 ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 			 int flags,
 			 const struct sockaddr *dest_addr, socklen_t addrlen)
 {
 	k_timeout_t timeout = K_FOREVER;
 	uint64_t buf_timeout = 0;
+	uint64_t tx_timeout;
+	bool tx_wait;
 	int status;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
@@ -663,6 +710,9 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 		buf_timeout = sys_clock_timeout_end_calc(MAX_WAIT_BUFS);
 	}
 
+	tx_wait = sock_tx_can_wait(ctx, timeout);
+	tx_timeout = sys_clock_timeout_end_calc(timeout);
+
 	/* Register the callback before sending in order to receive the response
 	 * from the peer.
 	 */
@@ -684,6 +734,19 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 		}
 
 		if (status < 0) {
+			if (status == -EAGAIN && tx_wait) {
+				/* The send buffer or the peer window is full,
+				 * wait until the peer acknowledges data.
+				 */
+				status = sock_wait_tx(ctx, tx_timeout);
+				if (status < 0) {
+					errno = -status;
+					return -1;
+				}
+
+				continue;
+			}
+
 			if (((status == -ENOBUFS) || (status == -EAGAIN)) &&
 			    K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 				/* If we cannot get any buffers in reasonable
@@ -750,6 +813,8 @@ ssize_t zsock_sendmsg_ctx(struct net_context *ctx, const struct msghdr *msg,
 {
 	k_timeout_t timeout = K_FOREVER;
 	uint64_t buf_timeout = 0;
+	uint64_t tx_timeout;
+	bool tx_wait;
 	int status;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
@@ -759,9 +824,25 @@ ssize_t zsock_sendmsg_ctx(struct net_context *ctx, const struct msghdr *msg,
 		buf_timeout = sys_clock_timeout_end_calc(MAX_WAIT_BUFS);
 	}
 
+	tx_wait = sock_tx_can_wait(ctx, timeout);
+	tx_timeout = sys_clock_timeout_end_calc(timeout);
+
 	while (1) {
 		status = net_context_sendmsg(ctx, msg, flags, NULL, timeout, NULL);
 		if (status < 0) {
+			if (status == -EAGAIN && tx_wait) {
+				/* The send buffer or the peer window is full,
+				 * wait until the peer acknowledges data.
+				 */
+				status = sock_wait_tx(ctx, tx_timeout);
+				if (status < 0) {
+					errno = -status;
+					return -1;
+				}
+
+				continue;
+			}
+
 			if (((status == -ENOBUFS) || (status == -EAGAIN)) &&
 			    K_TIMEOUT_EQ(timeout, K_FOREVER)) {
 				/* If we cannot get any buffers in reasonable
@@ -1397,7 +1478,29 @@ static int zsock_poll_prepare_ctx(struct net_context *ctx,
 	}
 
 	if (pfd->events & ZSOCK_POLLOUT) {
-		return -EALREADY;
+		struct k_sem *tx_sem;
+
+		/* Only stream sockets can run out of send buffer room */
+		if (net_context_get_type(ctx) != SOCK_STREAM) {
+			return -EALREADY;
+		}
+
+		if (*pev == pev_end) {
+			return -ENOMEM;
+		}
+
+		tx_sem = net_tcp_tx_sem_get(ctx);
+
+		(*pev)->obj = tx_sem;
+		(*pev)->type = tx_sem ? K_POLL_TYPE_SEM_AVAILABLE :
+					K_POLL_TYPE_IGNORE;
+		(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+		(*pev)->state = K_POLL_STATE_NOT_READY;
+		(*pev)++;
+
+		if (!tx_sem || k_sem_count_get(tx_sem) > 0) {
+			return -EALREADY;
+		}
 	}
 
 	/* If socket is already in EOF, it can be reported
@@ -1414,12 +1517,7 @@ static int zsock_poll_update_ctx(struct net_context *ctx,
 				 struct zsock_pollfd *pfd,
 				 struct k_poll_event **pev)
 {
-	ARG_UNUSED(ctx);
-
-	/* For now, assume that socket is always writable */
-	if (pfd->events & ZSOCK_POLLOUT) {
-		pfd->revents |= ZSOCK_POLLOUT;
-	}
+	bool retry = false;
 
 	if (pfd->events & ZSOCK_POLLIN) {
 		if ((*pev)->state != K_POLL_STATE_NOT_READY || sock_is_eof(ctx)) {
@@ -1428,10 +1526,39 @@ static int zsock_poll_update_ctx(struct net_context *ctx,
 		(*pev)++;
 	}
 
+	/* Stream sockets are writable while there is room in their send
+	 * buffer, other sockets are assumed to be always writable.
+	 */
+	if (pfd->events & ZSOCK_POLLOUT) {
+		if (net_context_get_type(ctx) != SOCK_STREAM) {
+			pfd->revents |= ZSOCK_POLLOUT;
+		} else {
+			/* Look the semaphore up again, the connection may
+			 * have been freed since the event was prepared.
+			 */
+			struct k_sem *tx_sem = net_tcp_tx_sem_get(ctx);
+
+			if (!tx_sem || k_sem_count_get(tx_sem) > 0) {
+				pfd->revents |= ZSOCK_POLLOUT;
+			} else if ((*pev)->state != K_POLL_STATE_NOT_READY) {
+				/* Another sender took the room before us,
+				 * wait for the next window update.
+				 */
+				(*pev)->state = K_POLL_STATE_NOT_READY;
+				retry = true;
+			}
+			(*pev)++;
+		}
+	}
+
 	if (sock_is_eof(ctx)) {
 		pfd->revents |= ZSOCK_POLLHUP;
 	}
 
+	if (retry && pfd->revents == 0) {
+		return -EAGAIN;
+	}
+
 	return 0;
 }
 
@@ -1448,7 +1575,8 @@ int zsock_poll_internal(struct zsock_pollfd *fds, int nfds, k_timeout_t timeout)
 	int ret = 0;
 	int i;
 	struct zsock_pollfd *pfd;
-	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX];
+	/* A stream socket polled for POLLOUT needs a second event */
+	struct k_poll_event poll_events[CONFIG_NET_SOCKETS_POLL_MAX * 2];
 	struct k_poll_event *pev;
 	struct k_poll_event *pev_end = poll_events + ARRAY_SIZE(poll_events);
 	const struct fd_op_vtable *vtable;
@@ -1748,6 +1876,54 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			return 0;
 		}
+
+		case SO_RCVBUF:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RCVBUF)) {
+				uint16_t size;
+
+				if (*optlen != sizeof(int)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				ret = net_context_get_option(ctx,
+							     NET_OPT_RCVBUF,
+							     &size, NULL);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				*(int *)optval = size;
+
+				return 0;
+			}
+
+			break;
+
+		case SO_SNDBUF:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_SNDBUF)) {
+				uint16_t size;
+
+				if (*optlen != sizeof(int)) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				ret = net_context_get_option(ctx,
+							     NET_OPT_SNDBUF,
+							     &size, NULL);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				*(int *)optval = size;
+
+				return 0;
+			}
+
+			break;
 		}
 
 		break;
@@ -1901,6 +2077,56 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 
 			break;
 
+		case SO_RCVBUF:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_RCVBUF)) {
+				uint16_t size;
+
+				if (optlen != sizeof(int) ||
+				    *(const int *)optval < 0) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				size = MIN(*(const int *)optval, UINT16_MAX);
+
+				ret = net_context_set_option(ctx,
+							     NET_OPT_RCVBUF,
+							     &size, sizeof(size));
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
+		case SO_SNDBUF:
+			if (IS_ENABLED(CONFIG_NET_CONTEXT_SNDBUF)) {
+				uint16_t size;
+
+				if (optlen != sizeof(int) ||
+				    *(const int *)optval < 0) {
+					errno = EINVAL;
+					return -1;
+				}
+
+				size = MIN(*(const int *)optval, UINT16_MAX);
+
+				ret = net_context_set_option(ctx,
+							     NET_OPT_SNDBUF,
+							     &size, sizeof(size));
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
+
 		case SO_SOCKS5:
 			if (IS_ENABLED(CONFIG_SOCKS)) {
 				ret = net_context_set_option(ctx,
@@ -2238,6 +2238,7 @@ static int ztls_poll_update_ctx(struct tls_context *ctx,
 				struct k_poll_event **pev)
 {
 	const struct fd_op_vtable *vtable;
+	struct k_poll_event *pev_in;
 	struct k_mutex *lock;
 	void *obj;
 	int ret;
@@ -2280,6 +2281,11 @@ static int ztls_poll_update_ctx(struct tls_context *ctx,
 		pfd->events &= ~ZSOCK_POLLIN;
 	}
 
+	/* The underlying socket event for ZSOCK_POLLIN comes first, it can
+	 * be followed by one for ZSOCK_POLLOUT.
+	 */
+	pev_in = *pev;
+
 	ret = z_fdtable_call_ioctl(vtable, obj, ZFD_IOCTL_POLL_UPDATE,
 				   pfd, pev);
 	if (ret != 0) {
@@ -2289,7 +2295,7 @@ static int ztls_poll_update_ctx(struct tls_context *ctx,
 	if (pfd->events & ZSOCK_POLLIN) {
 		ret = ztls_poll_update_pollin(pfd->fd, ctx, pfd);
 		if (ret == -EAGAIN && pfd->revents != 0) {
-			(*pev - 1)->state = K_POLL_STATE_NOT_READY;
+			pev_in->state = K_POLL_STATE_NOT_READY;
 			goto exit;
 		}
 	}
@@ -11,6 +11,13 @@ LOG_MODULE_REGISTER(npf_base, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
 #include <net/net_pkt_filter.h>
 #include <spinlock.h>
 
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+#include "compiled.h"
+
+static struct npf_table send_table;
+static struct npf_table recv_table;
+#endif
+
 /*
  * Our actual rule lists for supported test points
  */
@@ -18,11 +25,17 @@ LOG_MODULE_REGISTER(npf_base, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
 struct npf_rule_list npf_send_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&send_rules.rule_head),
 	.lock = { },
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+	.table = &send_table,
+#endif
 };
 
 struct npf_rule_list npf_recv_rules = {
 	.rule_head = SYS_SLIST_STATIC_INIT(&recv_rules.rule_head),
 	.lock = { },
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+	.table = &recv_table,
+#endif
 };
 
 /*
@@ -54,9 +67,13 @@ static bool apply_tests(struct npf_rule *rule, struct net_pkt *pkt)
 /*
  * We return the specified result for the first rule whose tests are all true.
  */
-static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
+static enum net_verdict evaluate(struct npf_rule_list *rules, struct net_pkt *pkt)
 {
+	sys_slist_t *rule_head = &rules->rule_head;
 	struct npf_rule *rule;
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+	enum net_verdict result;
+#endif
 
 	NET_DBG("rule_head %p on pkt %p", rule_head, pkt);
 
@@ -65,8 +82,17 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 		return NET_OK;
 	}
 
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+	if (rules->table && npf_table_evaluate(rules->table, pkt, &result)) {
+		return result;
+	}
+#endif
+
 	SYS_SLIST_FOR_EACH_CONTAINER(rule_head, rule, node) {
 		if (apply_tests(rule, pkt) == true) {
+#if defined(CONFIG_NET_PKT_FILTER_STATS)
+			rule->hits++;
+#endif
 			return rule->result;
 		}
 	}
@@ -78,7 +104,7 @@ static enum net_verdict evaluate(sys_slist_t *rule_head, struct net_pkt *pkt)
 static enum net_verdict lock_evaluate(struct npf_rule_list *rules, struct net_pkt *pkt)
 {
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
-	enum net_verdict result = evaluate(&rules->rule_head, pkt);
+	enum net_verdict result = evaluate(rules, pkt);
 
 	k_spin_unlock(&rules->lock, key);
 	return result;
@@ -102,12 +128,23 @@ bool net_pkt_filter_recv_ok(struct net_pkt *pkt)
  * Rule management
  */
 
+/* Must be called with the rule list lock held */
+static void rules_changed(struct npf_rule_list *rules)
+{
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+	if (rules->table) {
+		npf_table_build(rules->table, &rules->rule_head);
+	}
+#endif
+}
+
 void npf_insert_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 {
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 
 	NET_DBG("inserting rule %p into %p", rule, rules);
 	sys_slist_prepend(&rules->rule_head, &rule->node);
+	rules_changed(rules);
 
 	k_spin_unlock(&rules->lock, key);
 }
@@ -121,6 +158,7 @@ void npf_append_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 
 	NET_DBG("appending rule %p into %p", rule, rules);
 	sys_slist_append(&rules->rule_head, &rule->node);
+	rules_changed(rules);
 
 	k_spin_unlock(&rules->lock, key);
 }
@@ -130,6 +168,10 @@ bool npf_remove_rule(struct npf_rule_list *rules, struct npf_rule *rule)
 	k_spinlock_key_t key = k_spin_lock(&rules->lock);
 	bool result = sys_slist_find_and_remove(&rules->rule_head, &rule->node);
 
+	if (result) {
+		rules_changed(rules);
+	}
+
 	k_spin_unlock(&rules->lock, key);
 	NET_DBG("removing rule %p from %p: %d", rule, rules, result);
 	return result;
@@ -142,6 +184,7 @@ bool npf_remove_all_rules(struct npf_rule_list *rules)
 
 	if (result) {
 		sys_slist_init(&rules->rule_head);
+		rules_changed(rules);
 		NET_DBG("removing all rules from %p", rules);
 	}
 
@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2022 BayLibre SAS
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_DECLARE(npf_base, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
+
+#include <toolchain.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/ethernet.h>
+#include <net/net_pkt_filter.h>
+
+#include "compiled.h"
+
+/*
+ * Table construction
+ */
+
+static void compile_test(struct npf_test *test, struct npf_op *op)
+{
+	op->invert = false;
+
+	if (test->fn == npf_iface_match || test->fn == npf_iface_unmatch) {
+		op->type = NPF_OP_IFACE;
+		op->invert = test->fn == npf_iface_unmatch;
+		op->iface = CONTAINER_OF(test, struct npf_test_iface, test)->iface;
+	} else if (test->fn == npf_orig_iface_match ||
+		   test->fn == npf_orig_iface_unmatch) {
+		op->type = NPF_OP_ORIG_IFACE;
+		op->invert = test->fn == npf_orig_iface_unmatch;
+		op->iface = CONTAINER_OF(test, struct npf_test_iface, test)->iface;
+	} else if (test->fn == npf_size_inbounds) {
+		struct npf_test_size_bounds *bounds =
+			CONTAINER_OF(test, struct npf_test_size_bounds, test);
+
+		op->type = NPF_OP_SIZE;
+		op->size.min = bounds->min;
+		op->size.max = bounds->max;
+	} else if (!IS_ENABLED(CONFIG_NET_L2_ETHERNET) ||
+		   !npf_eth_compile_test(test, op)) {
+		op->type = NPF_OP_CALL;
+		op->test = test;
+	}
+}
+
+/*
+ * Move the first plain interface and Ethernet type matches of a rule
+ * into its entry key, so they can be checked for a whole group of rules
+ * at once.
+ */
+static bool hoist_op(struct npf_entry *entry, const struct npf_op *op)
+{
+	if (op->invert) {
+		return false;
+	}
+
+	if (op->type == NPF_OP_IFACE && !(entry->key & NPF_KEY_IFACE)) {
+		entry->key |= NPF_KEY_IFACE;
+		entry->iface = op->iface;
+		return true;
+	}
+
+	if (op->type == NPF_OP_ETH_TYPE && !(entry->key & NPF_KEY_ETH_TYPE)) {
+		entry->key |= NPF_KEY_ETH_TYPE;
+		entry->eth_type = op->eth_type;
+		return true;
+	}
+
+	return false;
+}
+
+static bool same_key(const struct npf_entry *a, const struct npf_entry *b)
+{
+	if (a->key != b->key) {
+		return false;
+	}
+
+	if ((a->key & NPF_KEY_IFACE) && a->iface != b->iface) {
+		return false;
+	}
+
+	if ((a->key & NPF_KEY_ETH_TYPE) && a->eth_type != b->eth_type) {
+		return false;
+	}
+
+	return true;
+}
+
+void npf_table_build(struct npf_table *table, sys_slist_t *rule_head)
+{
+	struct npf_rule *rule;
+	uint16_t nb_ops = 0U;
+	unsigned int i;
+	int n;
+
+	table->valid = false;
+	table->need_eth = false;
+	table->nb_entries = 0U;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(rule_head, rule, node) {
+		struct npf_entry *entry;
+
+		if (table->nb_entries == ARRAY_SIZE(table->entries) ||
+		    rule->nb_tests > ARRAY_SIZE(table->ops) - nb_ops) {
+			NET_WARN("Rule list %p too large to be compiled",
+				 rule_head);
+			return;
+		}
+
+		entry = &table->entries[table->nb_entries++];
+		entry->rule = rule;
+		entry->key = 0U;
+		entry->first_op = nb_ops;
+
+		for (i = 0; i < rule->nb_tests; i++) {
+			struct npf_op *op = &table->ops[nb_ops];
+
+			compile_test(rule->tests[i], op);
+
+			if (op->type == NPF_OP_ETH_TYPE ||
+			    op->type == NPF_OP_ETH_SRC ||
+			    op->type == NPF_OP_ETH_DST) {
+				table->need_eth = true;
+			}
+
+			if (!hoist_op(entry, op)) {
+				nb_ops++;
+			}
+		}
+
+		entry->nb_ops = nb_ops - entry->first_op;
+	}
+
+	for (n = table->nb_entries - 1; n >= 0; n--) {
+		struct npf_entry *entry = &table->entries[n];
+
+		if (n + 1 < table->nb_entries && same_key(entry, entry + 1)) {
+			entry->next_group = entry[1].next_group;
+		} else {
+			entry->next_group = n + 1;
+		}
+	}
+
+	NET_DBG("compiled %u rules, %u tests from %p", table->nb_entries,
+		nb_ops, rule_head);
+
+	table->valid = true;
+}
+
+/*
+ * Table evaluation
+ */
+
+static const struct net_eth_hdr *pkt_eth_hdr(struct net_pkt *pkt)
+{
+	if (!pkt->buffer || pkt->buffer->len < sizeof(struct net_eth_hdr)) {
+		return NULL;
+	}
+
+	return NET_ETH_HDR(pkt);
+}
+
+static inline bool eth_addr_match(const struct npf_op *op,
+				  const struct net_eth_addr *pkt_addr)
+{
+	const struct net_eth_addr *addr = op->eth_addr.addresses;
+	uint32_t mask_hi = op->eth_addr.mask_hi;
+	uint16_t mask_lo = op->eth_addr.mask_lo;
+	uint32_t hi = UNALIGNED_GET((const uint32_t *)&pkt_addr->addr[0]) & mask_hi;
+	uint16_t lo = UNALIGNED_GET((const uint16_t *)&pkt_addr->addr[4]) & mask_lo;
+	unsigned int i;
+
+	for (i = 0; i < op->eth_addr.nb_addresses; i++, addr++) {
+		if ((UNALIGNED_GET((const uint32_t *)&addr->addr[0]) & mask_hi) == hi &&
+		    (UNALIGNED_GET((const uint16_t *)&addr->addr[4]) & mask_lo) == lo) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static inline bool apply_op(const struct npf_op *op, struct net_pkt *pkt,
+			    const struct net_eth_hdr *eth_hdr)
+{
+	size_t size;
+
+	switch (op->type) {
+	case NPF_OP_IFACE:
+		return op->iface == net_pkt_iface(pkt);
+	case NPF_OP_ORIG_IFACE:
+		return op->iface == net_pkt_orig_iface(pkt);
+	case NPF_OP_SIZE:
+		size = net_pkt_get_len(pkt);
+		return size >= op->size.min && size <= op->size.max;
+	case NPF_OP_ETH_TYPE:
+		return eth_hdr->type == op->eth_type;
+	case NPF_OP_ETH_SRC:
+		return eth_addr_match(op, &eth_hdr->src);
+	case NPF_OP_ETH_DST:
+		return eth_addr_match(op, &eth_hdr->dst);
+	default:
+		return op->test->fn(op->test, pkt);
+	}
+}
+
+static bool apply_ops(const struct npf_op *op, unsigned int nb_ops,
+		      struct net_pkt *pkt, const struct net_eth_hdr *eth_hdr)
+{
+	for (; nb_ops > 0; nb_ops--, op++) {
+		if (!eth_hdr && op->type >= NPF_OP_ETH_TYPE) {
+			/* No Ethernet header: no Ethernet condition holds */
+			return false;
+		}
+
+		if (apply_op(op, pkt, eth_hdr) == op->invert) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static inline bool key_match(const struct npf_entry *entry,
+			     struct net_if *iface,
+			     const struct net_eth_hdr *eth_hdr)
+{
+	if ((entry->key & NPF_KEY_IFACE) && entry->iface != iface) {
+		return false;
+	}
+
+	if (entry->key & NPF_KEY_ETH_TYPE) {
+		return eth_hdr && eth_hdr->type == entry->eth_type;
+	}
+
+	return true;
+}
+
+bool npf_table_evaluate(const struct npf_table *table, struct net_pkt *pkt,
+			enum net_verdict *result)
+{
+	const struct net_eth_hdr *eth_hdr = NULL;
+	struct net_if *iface = net_pkt_iface(pkt);
+	unsigned int i = 0U;
+
+	if (!table->valid) {
+		return false;
+	}
+
+	if (table->need_eth) {
+		eth_hdr = pkt_eth_hdr(pkt);
+	}
+
+	while (i < table->nb_entries) {
+		const struct npf_entry *entry = &table->entries[i];
+
+		if (!key_match(entry, iface, eth_hdr)) {
+			i = entry->next_group;
+			continue;
+		}
+
+		if (apply_ops(&table->ops[entry->first_op], entry->nb_ops,
+			      pkt, eth_hdr)) {
+#if defined(CONFIG_NET_PKT_FILTER_STATS)
+			entry->rule->hits++;
+#endif
+			*result = entry->rule->result;
+			return true;
+		}
+
+		i++;
+	}
+
+	NET_DBG("no matching rules in table %p", table);
+	*result = NET_DROP;
+	return true;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022 BayLibre SAS
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __NPF_COMPILED_H
+#define __NPF_COMPILED_H
+
+#include <sys/util.h>
+#include <net/net_core.h>
+#include <net/net_pkt_filter.h>
+
+/*
+ * A compiled rule list is a flat array of entries, one per rule in list
+ * order, each pointing to a range of a flat array of operations (one per
+ * condition). Built-in conditions are turned into operations that are
+ * evaluated inline, anything else is called through its test function.
+ */
+
+enum npf_op_type {
+	NPF_OP_CALL,
+	NPF_OP_IFACE,
+	NPF_OP_ORIG_IFACE,
+	NPF_OP_SIZE,
+	/* operations below need the Ethernet header */
+	NPF_OP_ETH_TYPE,
+	NPF_OP_ETH_SRC,
+	NPF_OP_ETH_DST,
+};
+
+struct npf_op {
+	uint8_t type;
+	bool invert;
+	union {
+		struct npf_test *test;
+		struct net_if *iface;
+		struct {
+			size_t min;
+			size_t max;
+		} size;
+		uint16_t eth_type;		/* in network order */
+		struct {
+			const struct net_eth_addr *addresses;
+			unsigned int nb_addresses;
+			/* mask split into the first 4 and last 2 bytes */
+			uint32_t mask_hi;
+			uint16_t mask_lo;
+		} eth_addr;
+	};
+};
+
+/* Entry key flags: conditions hoisted out of the operation list */
+#define NPF_KEY_IFACE		BIT(0)
+#define NPF_KEY_ETH_TYPE	BIT(1)
+
+struct npf_entry {
+	struct npf_rule *rule;
+	struct net_if *iface;
+	uint16_t eth_type;		/* in network order */
+	uint8_t key;
+	uint16_t first_op;
+	uint16_t nb_ops;
+	/* first following entry with a different key */
+	uint16_t next_group;
+};
+
+struct npf_table {
+	bool valid;
+	bool need_eth;
+	uint16_t nb_entries;
+	struct npf_entry entries[CONFIG_NET_PKT_FILTER_COMPILED_MAX_RULES];
+	struct npf_op ops[CONFIG_NET_PKT_FILTER_COMPILED_MAX_TESTS];
+};
+
+/**
+ * @brief Compile a rule list into the given table
+ *
+ * Must be called with the rule list lock held. If the rule list does not
+ * fit, the table is marked invalid.
+ */
+void npf_table_build(struct npf_table *table, sys_slist_t *rule_head);
+
+/**
+ * @brief Evaluate a packet against a compiled non-empty rule list
+ *
+ * @return false if the table is invalid, true if @a result was set.
+ */
+bool npf_table_evaluate(const struct npf_table *table, struct net_pkt *pkt,
+			enum net_verdict *result);
+
+/**
+ * @brief Translate an Ethernet condition into a table operation
+ *
+ * @return false if @a test is not an Ethernet condition.
+ */
+bool npf_eth_compile_test(struct npf_test *test, struct npf_op *op);
+
+#endif /* __NPF_COMPILED_H */
@@ -7,9 +7,14 @@
 #include <logging/log.h>
 LOG_MODULE_REGISTER(npf_ethernet, CONFIG_NET_PKT_FILTER_LOG_LEVEL);
 
+#include <toolchain.h>
 #include <net/ethernet.h>
 #include <net/net_pkt_filter.h>
 
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+#include "compiled.h"
+#endif
+
 static bool addr_mask_compare(struct net_eth_addr *addr1,
 			      struct net_eth_addr *addr2,
 			      struct net_eth_addr *mask)
@@ -79,3 +84,42 @@ bool npf_eth_type_unmatch(struct npf_test *test, struct net_pkt *pkt)
 {
 	return !npf_eth_type_match(test, pkt);
 }
+
+#if defined(CONFIG_NET_PKT_FILTER_COMPILED)
+bool npf_eth_compile_test(struct npf_test *test, struct npf_op *op)
+{
+	struct npf_test_eth_addr *test_eth_addr =
+			CONTAINER_OF(test, struct npf_test_eth_addr, test);
+
+	if (test->fn == npf_eth_type_match || test->fn == npf_eth_type_unmatch) {
+		struct npf_test_eth_type *test_eth_type =
+			CONTAINER_OF(test, struct npf_test_eth_type, test);
+
+		op->type = NPF_OP_ETH_TYPE;
+		op->invert = test->fn == npf_eth_type_unmatch;
+		op->eth_type = test_eth_type->type;
+		return true;
+	}
+
+	if (test->fn == npf_eth_src_addr_match ||
+	    test->fn == npf_eth_src_addr_unmatch) {
+		op->type = NPF_OP_ETH_SRC;
+		op->invert = test->fn == npf_eth_src_addr_unmatch;
+	} else if (test->fn == npf_eth_dst_addr_match ||
+		   test->fn == npf_eth_dst_addr_unmatch) {
+		op->type = NPF_OP_ETH_DST;
+		op->invert = test->fn == npf_eth_dst_addr_unmatch;
+	} else {
+		return false;
+	}
+
+	/* The addresses themselves may still change, the mask may not */
+	op->eth_addr.addresses = test_eth_addr->addresses;
+	op->eth_addr.nb_addresses = test_eth_addr->nb_addresses;
+	op->eth_addr.mask_hi =
+		UNALIGNED_GET((uint32_t *)&test_eth_addr->mask.addr[0]);
+	op->eth_addr.mask_lo =
+		UNALIGNED_GET((uint16_t *)&test_eth_addr->mask.addr[4]);
+	return true;
+}
+#endif /* CONFIG_NET_PKT_FILTER_COMPILED */
@@ -16,9 +16,21 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 
 #include <storage/stream_flash.h>
 
+#ifdef CONFIG_STREAM_FLASH_HASH
+#include <tinycrypt/constants.h>
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 #include <settings/settings.h>
 
+/* Stored progress, the digest state is left out when it is not valid */
+struct stream_flash_progress {
+	size_t bytes_written;
+#ifdef CONFIG_STREAM_FLASH_HASH
+	struct tc_sha256_state_struct hash;
+#endif
+};
+
 static int settings_direct_loader(const char *key, size_t len,
 				  settings_read_cb read_cb, void *cb_arg,
 				  void *param)
@@ -27,15 +39,18 @@ static int settings_direct_loader(const char *key, size_t len,
 
 	/* Handle the subtree if it is an exact key match. */
 	if (settings_name_next(key, NULL) == 0) {
-		size_t bytes_written = 0;
-		ssize_t len = read_cb(cb_arg, &bytes_written,
-				      sizeof(bytes_written));
+		struct stream_flash_progress progress = { 0 };
+		size_t bytes_written;
+		ssize_t len = read_cb(cb_arg, &progress, sizeof(progress));
 
-		if (len != sizeof(ctx->bytes_written)) {
+		if (len != sizeof(progress) &&
+		    len != sizeof(progress.bytes_written)) {
 			LOG_ERR("Unable to read bytes_written from storage");
 			return len;
 		}
 
+		bytes_written = progress.bytes_written;
+
 		/* Check that loaded progress is not outdated. */
 		if (bytes_written >= ctx->bytes_written) {
 			ctx->bytes_written = bytes_written;
@@ -45,6 +60,14 @@ static int settings_direct_loader(const char *key, size_t len,
 			return 0;
 		}
 
+#ifdef CONFIG_STREAM_FLASH_HASH
+		ctx->hash = progress.hash;
+		ctx->hash_valid = (len == sizeof(progress));
+		if (!ctx->hash_valid) {
+			LOG_WRN("Loaded progress without digest state");
+		}
+#endif
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 		int rc;
 		struct flash_pages_info page;
@@ -72,6 +95,74 @@ static int settings_direct_loader(const char *key, size_t len,
 
 #endif /* CONFIG_STREAM_FLASH_PROGRESS */
 
+#ifdef CONFIG_STREAM_FLASH_ERASE_AHEAD
+
+static void erase_ahead_done(const struct device *dev,
+			     struct flash_async_op *op, int result)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(op, struct stream_flash_ctx, erase_op);
+
+	ctx->erase_result = result;
+	k_sem_give(&ctx->erase_done);
+}
+
+static int erase_ahead_wait(struct stream_flash_ctx *ctx)
+{
+	if (!ctx->erase_pending) {
+		return 0;
+	}
+
+	k_sem_take(&ctx->erase_done, K_FOREVER);
+	ctx->erase_pending = false;
+
+	if (ctx->erase_result != 0) {
+		LOG_ERR("Error %d while erasing page ahead", ctx->erase_result);
+		return ctx->erase_result;
+	}
+
+	ctx->last_erased_page_start_offset = ctx->erase_op.offset;
+
+	return 0;
+}
+
+/* Start erasing the page the next full buffer will end in */
+static void erase_ahead(struct stream_flash_ctx *ctx)
+{
+	struct flash_pages_info page;
+	size_t next_end = ctx->bytes_written + ctx->buf_len;
+	int rc;
+
+	if (next_end > ctx->available) {
+		next_end = ctx->available;
+	}
+
+	if (next_end <= ctx->bytes_written) {
+		return;
+	}
+
+	rc = flash_get_page_info_by_offs(ctx->fdev,
+					 ctx->offset + next_end - 1, &page);
+	if (rc != 0 || ctx->last_erased_page_start_offset == page.start_offset) {
+		return;
+	}
+
+	ctx->erase_op.type = FLASH_ASYNC_OP_ERASE;
+	ctx->erase_op.offset = page.start_offset;
+	ctx->erase_op.len = page.size;
+	ctx->erase_op.callback = erase_ahead_done;
+
+	LOG_DBG("Erasing page ahead at offset 0x%08lx",
+		(long)page.start_offset);
+
+	rc = flash_async_submit(ctx->fdev, &ctx->erase_op);
+	if (rc == 0) {
+		ctx->erase_pending = true;
+	}
+}
+
+#endif /* CONFIG_STREAM_FLASH_ERASE_AHEAD */
+
 #ifdef CONFIG_STREAM_FLASH_ERASE
 
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
@@ -79,6 +170,13 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 	int rc;
 	struct flash_pages_info page;
 
+#ifdef CONFIG_STREAM_FLASH_ERASE_AHEAD
+	rc = erase_ahead_wait(ctx);
+	if (rc != 0) {
+		return rc;
+	}
+#endif
+
 	rc = flash_get_page_info_by_offs(ctx->fdev, off, &page);
 	if (rc != 0) {
 		LOG_ERR("Error %d while getting page info", rc);
@@ -169,6 +267,10 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		}
 	}
 
+#ifdef CONFIG_STREAM_FLASH_HASH
+	(void)tc_sha256_update(&ctx->hash, ctx->buf, ctx->buf_bytes);
+#endif
+
 	ctx->bytes_written += ctx->buf_bytes;
 	ctx->buf_bytes = 0U;
 
@@ -216,6 +318,16 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		rc = flash_sync(ctx);
 	}
 
+#ifdef CONFIG_STREAM_FLASH_ERASE_AHEAD
+	if (rc == 0) {
+		if (flush) {
+			rc = erase_ahead_wait(ctx);
+		} else if (!ctx->erase_pending) {
+			erase_ahead(ctx);
+		}
+	}
+#endif
+
 	return rc;
 }
 
@@ -224,6 +336,31 @@ size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx)
 	return ctx->bytes_written;
 }
 
+#ifdef CONFIG_STREAM_FLASH_HASH
+
+int stream_flash_hash_get(struct stream_flash_ctx *ctx, uint8_t *hash)
+{
+	struct tc_sha256_state_struct state;
+
+	if (!ctx || !hash) {
+		return -EFAULT;
+	}
+
+	if (!ctx->hash_valid) {
+		return -ENODATA;
+	}
+
+	/* Finalize a copy, so that the stream can be continued */
+	state = ctx->hash;
+	if (tc_sha256_final(hash, &state) != TC_CRYPTO_SUCCESS) {
+		return -EIO;
+	}
+
+	return 0;
+}
+
+#endif /* CONFIG_STREAM_FLASH_HASH */
+
 struct _inspect_flash {
 	size_t buf_len;
 	size_t total_size;
@@ -299,6 +436,14 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	ctx->last_erased_page_start_offset = -1;
 #endif
+#ifdef CONFIG_STREAM_FLASH_ERASE_AHEAD
+	k_sem_init(&ctx->erase_done, 0, 1);
+	ctx->erase_pending = false;
+#endif
+#ifdef CONFIG_STREAM_FLASH_HASH
+	(void)tc_sha256_init(&ctx->hash);
+	ctx->hash_valid = true;
+#endif
 
 	return 0;
 }
@@ -331,9 +476,20 @@ int stream_flash_progress_save(struct stream_flash_ctx *ctx,
 		return -EFAULT;
 	}
 
-	int rc = settings_save_one(settings_key,
-				   &ctx->bytes_written,
-				   sizeof(ctx->bytes_written));
+	struct stream_flash_progress progress = {
+		.bytes_written = ctx->bytes_written,
+	};
+	size_t len = sizeof(progress);
+
+#ifdef CONFIG_STREAM_FLASH_HASH
+	if (ctx->hash_valid) {
+		progress.hash = ctx->hash;
+	} else {
+		len = sizeof(progress.bytes_written);
+	}
+#endif
+
+	int rc = settings_save_one(settings_key, &progress, len);
 
 	if (rc != 0) {
 		LOG_ERR("Error %d while storing progress for \"%s\"",
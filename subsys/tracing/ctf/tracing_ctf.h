@@ -249,6 +249,15 @@ extern "C" {
 #define sys_port_trace_k_msgq_get_enter(msgq, timeout)
 #define sys_port_trace_k_msgq_get_blocking(msgq, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)
+#define sys_port_trace_k_msgq_get_claim_enter(msgq)
+#define sys_port_trace_k_msgq_get_claim_exit(msgq, ret)
+#define sys_port_trace_k_msgq_get_finish(msgq, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret)
 #define sys_port_trace_k_msgq_purge(msgq)
 
@@ -280,6 +289,14 @@ extern "C" {
 #define sys_port_trace_k_pipe_get_enter(pipe, timeout)
 #define sys_port_trace_k_pipe_get_blocking(pipe, timeout)
 #define sys_port_trace_k_pipe_get_exit(pipe, timeout, ret)
+#define sys_port_trace_k_pipe_put_claim_enter(pipe, timeout)
+#define sys_port_trace_k_pipe_put_claim_blocking(pipe, timeout)
+#define sys_port_trace_k_pipe_put_claim_exit(pipe, timeout, ret)
+#define sys_port_trace_k_pipe_put_finish(pipe, ret)
+#define sys_port_trace_k_pipe_get_claim_enter(pipe, timeout)
+#define sys_port_trace_k_pipe_get_claim_blocking(pipe, timeout)
+#define sys_port_trace_k_pipe_get_claim_exit(pipe, timeout, ret)
+#define sys_port_trace_k_pipe_get_finish(pipe, ret)
 #define sys_port_trace_k_pipe_block_put_enter(pipe, sem)
 #define sys_port_trace_k_pipe_block_put_exit(pipe, sem)
 
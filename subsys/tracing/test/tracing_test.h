@@ -315,6 +315,24 @@
 	sys_trace_k_msgq_get_blocking(msgq, data, timeout)
 #define sys_port_trace_k_msgq_get_exit(msgq, timeout, ret)                                         \
 	sys_trace_k_msgq_get_exit(msgq, data, timeout, ret)
+#define sys_port_trace_k_msgq_put_many_enter(msgq, timeout)                                        \
+	sys_trace_k_msgq_put_many_enter(msgq, data, num_msgs, timeout)
+#define sys_port_trace_k_msgq_put_many_blocking(msgq, timeout)                                     \
+	sys_trace_k_msgq_put_many_blocking(msgq, data, num_msgs, timeout)
+#define sys_port_trace_k_msgq_put_many_exit(msgq, timeout, ret)                                    \
+	sys_trace_k_msgq_put_many_exit(msgq, data, num_msgs, timeout, ret)
+#define sys_port_trace_k_msgq_get_many_enter(msgq, timeout)                                        \
+	sys_trace_k_msgq_get_many_enter(msgq, data, num_msgs, timeout)
+#define sys_port_trace_k_msgq_get_many_blocking(msgq, timeout)                                     \
+	sys_trace_k_msgq_get_many_blocking(msgq, data, num_msgs, timeout)
+#define sys_port_trace_k_msgq_get_many_exit(msgq, timeout, ret)                                    \
+	sys_trace_k_msgq_get_many_exit(msgq, data, num_msgs, timeout, ret)
+#define sys_port_trace_k_msgq_get_claim_enter(msgq)                                                \
+	sys_trace_k_msgq_get_claim_enter(msgq, data, max_msgs)
+#define sys_port_trace_k_msgq_get_claim_exit(msgq, ret)                                            \
+	sys_trace_k_msgq_get_claim_exit(msgq, data, max_msgs, ret)
+#define sys_port_trace_k_msgq_get_finish(msgq, ret)                                                \
+	sys_trace_k_msgq_get_finish(msgq, num_msgs, ret)
 #define sys_port_trace_k_msgq_peek(msgq, ret) sys_trace_k_msgq_peek(msgq, data, ret)
 #define sys_port_trace_k_msgq_purge(msgq) sys_trace_k_msgq_purge(msgq)
 
@@ -366,6 +384,20 @@
 	sys_trace_k_pipe_get_blocking(pipe, data, bytes_to_read, bytes_read, min_xfer, timeout)
 #define sys_port_trace_k_pipe_get_exit(pipe, timeout, ret)                                         \
 	sys_trace_k_pipe_get_exit(pipe, data, bytes_to_read, bytes_read, min_xfer, timeout, ret)
+#define sys_port_trace_k_pipe_put_claim_enter(pipe, timeout)                                       \
+	sys_trace_k_pipe_put_claim_enter(pipe, data, bytes_to_write, bytes_claimed, timeout)
+#define sys_port_trace_k_pipe_put_claim_blocking(pipe, timeout)                                    \
+	sys_trace_k_pipe_put_claim_blocking(pipe, data, bytes_to_write, bytes_claimed, timeout)
+#define sys_port_trace_k_pipe_put_claim_exit(pipe, timeout, ret)                                   \
+	sys_trace_k_pipe_put_claim_exit(pipe, data, bytes_to_write, bytes_claimed, timeout, ret)
+#define sys_port_trace_k_pipe_put_finish(pipe, ret) sys_trace_k_pipe_put_finish(pipe, ret)
+#define sys_port_trace_k_pipe_get_claim_enter(pipe, timeout)                                       \
+	sys_trace_k_pipe_get_claim_enter(pipe, data, bytes_to_read, bytes_claimed, timeout)
+#define sys_port_trace_k_pipe_get_claim_blocking(pipe, timeout)                                    \
+	sys_trace_k_pipe_get_claim_blocking(pipe, data, bytes_to_read, bytes_claimed, timeout)
+#define sys_port_trace_k_pipe_get_claim_exit(pipe, timeout, ret)                                   \
+	sys_trace_k_pipe_get_claim_exit(pipe, data, bytes_to_read, bytes_claimed, timeout, ret)
+#define sys_port_trace_k_pipe_get_finish(pipe, ret) sys_trace_k_pipe_get_finish(pipe, ret)
 #define sys_port_trace_k_pipe_block_put_enter(pipe, sem)                                           \
 	sys_trace_k_pipe_block_put_enter(pipe, block, bytes_to_write, sem)
 #define sys_port_trace_k_pipe_block_put_exit(pipe, sem)                                            \
@@ -633,6 +665,20 @@ void sys_trace_k_pipe_get_blocking(struct k_pipe *pipe, void *data, size_t bytes
 				   size_t *bytes_read, size_t min_xfer, k_timeout_t timeout);
 void sys_trace_k_pipe_get_exit(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 			       size_t *bytes_read, size_t min_xfer, k_timeout_t timeout, int ret);
+void sys_trace_k_pipe_put_claim_enter(struct k_pipe *pipe, void **data, size_t bytes_to_write,
+				      size_t *bytes_claimed, k_timeout_t timeout);
+void sys_trace_k_pipe_put_claim_blocking(struct k_pipe *pipe, void **data, size_t bytes_to_write,
+					 size_t *bytes_claimed, k_timeout_t timeout);
+void sys_trace_k_pipe_put_claim_exit(struct k_pipe *pipe, void **data, size_t bytes_to_write,
+				     size_t *bytes_claimed, k_timeout_t timeout, int ret);
+void sys_trace_k_pipe_put_finish(struct k_pipe *pipe, int ret);
+void sys_trace_k_pipe_get_claim_enter(struct k_pipe *pipe, void **data, size_t bytes_to_read,
+				      size_t *bytes_claimed, k_timeout_t timeout);
+void sys_trace_k_pipe_get_claim_blocking(struct k_pipe *pipe, void **data, size_t bytes_to_read,
+					 size_t *bytes_claimed, k_timeout_t timeout);
+void sys_trace_k_pipe_get_claim_exit(struct k_pipe *pipe, void **data, size_t bytes_to_read,
+				     size_t *bytes_claimed, k_timeout_t timeout, int ret);
+void sys_trace_k_pipe_get_finish(struct k_pipe *pipe, int ret);
 void sys_trace_k_pipe_block_put_enter(struct k_pipe *pipe, struct k_mem_block *block, size_t size,
 				      struct k_sem *sem);
 void sys_trace_k_pipe_block_put_exit(struct k_pipe *pipe, struct k_mem_block *block, size_t size,
@@ -650,6 +696,21 @@ void sys_trace_k_msgq_put_exit(struct k_msgq *msgq, const void *data, k_timeout_
 void sys_trace_k_msgq_get_enter(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 void sys_trace_k_msgq_get_blocking(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 void sys_trace_k_msgq_get_exit(struct k_msgq *msgq, const void *data, k_timeout_t timeout, int ret);
+void sys_trace_k_msgq_put_many_enter(struct k_msgq *msgq, const void *data, uint32_t num_msgs,
+				     k_timeout_t timeout);
+void sys_trace_k_msgq_put_many_blocking(struct k_msgq *msgq, const void *data, uint32_t num_msgs,
+					k_timeout_t timeout);
+void sys_trace_k_msgq_put_many_exit(struct k_msgq *msgq, const void *data, uint32_t num_msgs,
+				    k_timeout_t timeout, int ret);
+void sys_trace_k_msgq_get_many_enter(struct k_msgq *msgq, void *data, uint32_t num_msgs,
+				     k_timeout_t timeout);
+void sys_trace_k_msgq_get_many_blocking(struct k_msgq *msgq, void *data, uint32_t num_msgs,
+					k_timeout_t timeout);
+void sys_trace_k_msgq_get_many_exit(struct k_msgq *msgq, void *data, uint32_t num_msgs,
+				    k_timeout_t timeout, int ret);
+void sys_trace_k_msgq_get_claim_enter(struct k_msgq *msgq, void **data, uint32_t max_msgs);
+void sys_trace_k_msgq_get_claim_exit(struct k_msgq *msgq, void **data, uint32_t max_msgs, int ret);
+void sys_trace_k_msgq_get_finish(struct k_msgq *msgq, uint32_t num_msgs, int ret);
 void sys_trace_k_msgq_peek(struct k_msgq *msgq, void *data, int ret);
 void sys_trace_k_msgq_purge(struct k_msgq *msgq);
 
@@ -77,11 +77,34 @@
 	     (uint32_t)(((uint64_t)putsize * 1000000U) / SAFE_DIVISOR(puttime[2])))
 #endif /* FLOAT */
 
+#ifdef FLOAT
+#define PRINT_STREAM_HEADER_UNIT()                                         \
+	PRINT_STRING("|             |                   time/packet (usec)"   \
+		  "                          |\n", output_file)
+
+#define PRINT_STREAM()                                                   \
+	PRINT_F(output_file,                                            \
+	     "|%12u |%14.3f |%14.3f |%14.3f |%14.3f |\n",               \
+	     putsize, puttime[0] / 1000.0, puttime[1] / 1000.0,         \
+	     puttime[2] / 1000.0, puttime[3] / 1000.0)
+#else
+#define PRINT_STREAM_HEADER_UNIT()                                         \
+	PRINT_STRING("|             |                   time/packet (nsec)"   \
+		  "                          |\n", output_file)
+
+#define PRINT_STREAM()                                                   \
+	PRINT_F(output_file,                                            \
+	     "|%12u |%14u |%14u |%14u |%14u |\n",                       \
+	     putsize, puttime[0], puttime[1], puttime[2], puttime[3])
+#endif /* FLOAT */
+
 /*
  * Function prototypes.
  */
 int pipeput(struct k_pipe *pipe, enum pipe_options
 		 option, int size, int count, uint32_t *time);
+int pipeput_stream(struct k_pipe *pipe, bool claim, int size, int count,
+		   uint32_t *time);
 
 /*
  * Function declarations.
@@ -96,7 +119,7 @@ void pipe_test(void)
 {
 	uint32_t	putsize;
 	int         getsize;
-	uint32_t	puttime[3];
+	uint32_t	puttime[4];
 	int		putcount;
 	int		pipe;
 	uint32_t	TaskPrio = UINT32_MAX;
@@ -177,6 +200,30 @@ void pipe_test(void)
 		PRINT_STRING(dashline, output_file);
 		k_thread_priority_set(k_current_get(), TaskPrio);
 	}
+
+	/* buffered operation, copying or claiming the pipe's buffer */
+	PRINT_STRING("|                     "
+			 "streaming with k_pipe_put/get or claims"
+			 "                 |\n", output_file);
+	PRINT_STRING(dashline, output_file);
+	PRINT_STREAM_HEADER_UNIT();
+	PRINT_STRING(dashline, output_file);
+	PRINT_STRING("|   size(B)   | copy small buf| copy big buf  |"
+			 "claim small buf| claim big buf |\n", output_file);
+	PRINT_STRING(dashline, output_file);
+
+	for (putsize = 8U; putsize <= MESSAGE_SIZE_PIPE; putsize <<= 1) {
+		for (pipe = 0; pipe < 4; pipe++) {
+			pipeput_stream(test_pipes[1 + pipe % 2], pipe >= 2,
+				       putsize, NR_OF_PIPE_RUNS,
+				       &puttime[pipe]);
+
+			/* waiting for ack */
+			k_msgq_get(&CH_COMM, &getinfo, K_FOREVER);
+		}
+		PRINT_STREAM();
+	}
+	PRINT_STRING(dashline, output_file);
 }
 
 
@@ -251,4 +298,71 @@ int pipeput(struct k_pipe *pipe,
 	return 0;
 }
 
+
+/**
+ *
+ * @brief Stream data chunks into a buffered pipe and measure time
+ *
+ * With @a claim, each chunk is written in place into the pipe's buffer
+ * through claims instead of being copied by k_pipe_put().
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe     The pipe to be tested.
+ * @param claim    Use k_pipe_put_claim() and k_pipe_put_finish().
+ * @param size     Data chunk size.
+ * @param count    Number of data chunks.
+ * @param time     Total write time.
+ */
+int pipeput_stream(struct k_pipe *pipe, bool claim, int size, int count,
+		   uint32_t *time)
+{
+	int i;
+	unsigned int t;
+	size_t sizexferd;
+	size_t size2xfer;
+	void *ptr;
+
+	/* first sync with the receiver */
+	k_sem_give(&SEM0);
+	t = BENCH_START();
+	for (i = 0; i < count; i++) {
+		if (!claim) {
+			if (k_pipe_put(pipe, data_bench, size, &sizexferd,
+				       size, K_FOREVER) != 0) {
+				return 1;
+			}
+			continue;
+		}
+
+		/* a chunk may wrap around the end of the pipe's buffer */
+		for (size2xfer = size; size2xfer != 0;
+		     size2xfer -= sizexferd) {
+			if (k_pipe_put_claim(pipe, &ptr, size2xfer,
+					     &sizexferd, K_FOREVER) != 0) {
+				return 1;
+			}
+			/* the data is produced in place */
+			if (k_pipe_put_finish(pipe, sizexferd) != 0) {
+				return 1;
+			}
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+	if (bench_test_end() < 0) {
+		if (high_timer_overflow()) {
+			PRINT_STRING("| Timer overflow."
+					"Results are invalid            ",
+						 output_file);
+		} else {
+	PRINT_STRING("| Tick occurred. Results may be inaccurate       ",
+						 output_file);
+		}
+		PRINT_STRING("                             |\n", output_file);
+	}
+	return 0;
+}
+
 #endif /* PIPE_BENCH */
@@ -17,6 +17,8 @@
  */
 int pipeget(struct k_pipe *pipe, enum pipe_options option,
 			int size, int count, unsigned int *time);
+int pipeget_stream(struct k_pipe *pipe, bool claim, int size, int count,
+		   unsigned int *time);
 
 /*
  * Function declarations.
@@ -70,6 +72,19 @@ void piperecvtask(void)
 	}
 	}
 
+	/* buffered streaming, copying or claiming (small and big buffer) */
+	for (getsize = 8; getsize <= MESSAGE_SIZE_PIPE; getsize <<= 1) {
+		for (pipe = 0; pipe < 4; pipe++) {
+			getcount = NR_OF_PIPE_RUNS;
+			pipeget_stream(test_pipes[1 + pipe % 2], pipe >= 2,
+				       getsize, getcount, &gettime);
+			getinfo.time = gettime;
+			getinfo.size = getsize;
+			getinfo.count = getcount;
+			/* acknowledge to master */
+			k_msgq_put(&CH_COMM, &getinfo, K_FOREVER);
+		}
+	}
 }
 
 
@@ -140,4 +155,72 @@ int pipeget(struct k_pipe *pipe, enum pipe_options option, int size, int count,
 	return 0;
 }
 
+
+/**
+ *
+ * @brief Read a data stream from a buffered pipe and measure time
+ *
+ * With @a claim, the data is consumed in place from the pipe's buffer
+ * through claims instead of being copied by k_pipe_get().
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe     Pipe to read data from.
+ * @param claim    Use k_pipe_get_claim() and k_pipe_get_finish().
+ * @param size     Data chunk size.
+ * @param count    Number of data chunks.
+ * @param time     Total read time.
+ */
+int pipeget_stream(struct k_pipe *pipe, bool claim, int size, int count,
+		   unsigned int *time)
+{
+	int i;
+	unsigned int t;
+	size_t sizexferd;
+	size_t size2xfer;
+	void *ptr;
+
+	/* sync with the sender */
+	k_sem_take(&SEM0, K_FOREVER);
+	t = BENCH_START();
+	if (!claim) {
+		for (i = 0; i < count; i++) {
+			if (k_pipe_get(pipe, data_recv, size, &sizexferd,
+				       size, K_FOREVER) != 0) {
+				return 1;
+			}
+		}
+	} else {
+		/* claims return whatever is available, up to the total */
+		for (size2xfer = size * count; size2xfer != 0;
+		     size2xfer -= sizexferd) {
+			if (k_pipe_get_claim(pipe, &ptr, size2xfer,
+					     &sizexferd, K_FOREVER) != 0) {
+				return 1;
+			}
+			/* the data is consumed in place */
+			if (k_pipe_get_finish(pipe, sizexferd) != 0) {
+				return 1;
+			}
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+	if (bench_test_end() < 0) {
+		if (high_timer_overflow()) {
+			PRINT_STRING("| Timer overflow. "
+			"Results are invalid            ",
+						 output_file);
+		} else {
+			PRINT_STRING("| Tick occurred. "
+			"Results may be inaccurate       ",
+						 output_file);
+		}
+		PRINT_STRING("                             |\n",
+					 output_file);
+	}
+	return 0;
+}
+
 #endif /* PIPE_BENCH */
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <sys/printk.h>
+
+/* Simulated duration of the initialization of each slow device */
+#define INIT_MS 50
+
+static int slow_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_msleep(INIT_MS);
+
+	return 0;
+}
+
+#define SLOW_DEVICE_DEFINE(n)						\
+	DEVICE_DEFINE(slow_##n, "slow_" #n, slow_init, NULL, NULL,	\
+		      NULL, POST_KERNEL,				\
+		      CONFIG_KERNEL_INIT_PRIORITY_DEVICE, NULL)
+
+SLOW_DEVICE_DEFINE(0);
+SLOW_DEVICE_DEFINE(1);
+SLOW_DEVICE_DEFINE(2);
+SLOW_DEVICE_DEFINE(3);
+
+#define N_SLOW_DEVICES 4
+
+void main(void)
+{
+	uint32_t cycles = k_cycle_get_32();
+
+	printk("%d devices, %d ms init each\n", N_SLOW_DEVICES, INIT_MS);
+	printk("time to main: %u us\n",
+	       (uint32_t)k_cyc_to_us_floor64(cycles));
+	printk("fin\n");
+}
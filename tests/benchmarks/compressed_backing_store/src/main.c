@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <sys/mem_manage.h>
+#include <mmu.h>
+
+#ifndef CONFIG_BACKING_STORE_COMPRESSED
+#error "Unsupported configuration"
+#endif
+
+/* Pages the backing store holds without compression */
+#define STORE_PAGES	(CONFIG_BACKING_STORE_COMPRESSED_SIZE / \
+			 CONFIG_MMU_PAGE_SIZE)
+#define EXTRA_PAGES	(2 * STORE_PAGES)
+
+static const char *const words[] = {
+	"sensor ", "value ", "temperature ", "0x1234 ", "ok\n", "error ",
+};
+
+static char *arena;
+static size_t arena_pages;
+static size_t free_pages;
+
+static char zero_byte(size_t i)
+{
+	ARG_UNUSED(i);
+
+	return 0;
+}
+
+static char random_byte(size_t i)
+{
+	uint32_t x = i * 2654435761U;
+
+	x ^= x >> 15;
+	x *= 2246822519U;
+	x ^= x >> 13;
+
+	return x;
+}
+
+/* Runs of words picked from a short list, changing every 64 bytes */
+static char text_byte(size_t i)
+{
+	const char *word = words[(i / 64) % ARRAY_SIZE(words)];
+
+	return word[i % strlen(word)];
+}
+
+static void run(const char *name, char (*byte)(size_t i), size_t pages,
+		bool write)
+{
+	size_t size = pages * CONFIG_MMU_PAGE_SIZE;
+	unsigned long faults = z_num_pagefaults_get();
+	uint32_t start = k_cycle_get_32();
+	uint64_t us;
+	size_t i;
+
+	if (write) {
+		for (i = 0; i < size; i++) {
+			arena[i] = byte(i);
+		}
+	}
+
+	for (i = 0; i < size; i++) {
+		if (arena[i] != byte(i)) {
+			printk("%s: bad data at %zu\n", name, i);
+			return;
+		}
+	}
+
+	us = k_cyc_to_us_floor64(k_cycle_get_32() - start);
+	faults = z_num_pagefaults_get() - faults;
+
+	if (write) {
+		size *= 2;
+	}
+
+	printk("%s: %llu KiB/s, %lu faults\n", name,
+	       us ? size * 1000000ULL / 1024U / us : 0ULL, faults);
+}
+
+void main(void)
+{
+	struct k_mem_paging_backing_store_compressed_stats stats;
+	size_t arena_size;
+
+	free_pages = k_mem_free_get() / CONFIG_MMU_PAGE_SIZE;
+	arena_pages = free_pages + EXTRA_PAGES;
+	arena_size = arena_pages * CONFIG_MMU_PAGE_SIZE;
+
+	arena = k_mem_map(arena_size, K_MEM_PERM_RW);
+	if (arena == NULL) {
+		printk("Failed to map %zu bytes\n", arena_size);
+		return;
+	}
+
+	printk("%zu pages mapped, %zu free, backing store of %d pages\n",
+	       arena_pages, free_pages, STORE_PAGES);
+
+	/* Fresh anonymous memory is zeroed */
+	run("zero", zero_byte, arena_pages, false);
+	run("random", random_byte, free_pages + STORE_PAGES / 2, true);
+	run("text", text_byte, arena_pages, true);
+
+	k_mem_paging_backing_store_compressed_stats_get(&stats);
+	printk("%zu pages stored in %zu bytes, %lu page outs, "
+	       "%lu zero, %lu uncompressed\n", stats.pages, stats.bytes,
+	       stats.page_outs, stats.zero_pages, stats.raw_pages);
+	printk("compression ratio: %llu.%02llu\n",
+	       stats.bytes ? stats.pages * CONFIG_MMU_PAGE_SIZE * 1ULL /
+			     stats.bytes : 0ULL,
+	       stats.bytes ? stats.pages * CONFIG_MMU_PAGE_SIZE * 100ULL /
+			     stats.bytes % 100U : 0ULL);
+
+	printk("fin\n");
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <sys/ring_buffer.h>
+#include <sys/spsc_ring.h>
+#include <sys/mpmc_queue.h>
+
+/* Bytes moved through the byte rings, in chunks of CHUNK_SIZE */
+#define TRANSFER_SIZE (256 * 1024)
+#define CHUNK_SIZE 32
+#define RING_SIZE 1024
+
+/* Items moved through the MPMC queue by each producer */
+#define ITEMS_PER_PRODUCER 16384
+#define QUEUE_CAPACITY 64
+#define NUM_PRODUCERS 2
+#define NUM_CONSUMERS 2
+#define NUM_THREADS (NUM_PRODUCERS + NUM_CONSUMERS)
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+
+static uint8_t ring_data[RING_SIZE];
+static struct ring_buf locked_ring;
+static struct k_spinlock ring_lock;
+static struct spsc_ring spsc;
+
+static struct mpmc_queue mpmc;
+static atomic_t mpmc_data[MPMC_QUEUE_BUF_SIZE(sizeof(uint32_t),
+					      QUEUE_CAPACITY) /
+			  sizeof(atomic_t)];
+static atomic_t consumed;
+static atomic_t consumed_sum;
+
+/* Run the given threads, pinned to distinct CPUs when possible, and
+ * return the time until all of them are done.
+ */
+static uint64_t run_threads(k_thread_entry_t *entries, void **args, int num)
+{
+	int prio = k_thread_priority_get(k_current_get());
+	uint32_t start, cycles;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, entries[i],
+				args[i], NULL, NULL, prio, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_mask_clear(&threads[i]);
+		k_thread_cpu_mask_enable(&threads[i], i % CONFIG_MP_NUM_CPUS);
+#endif
+	}
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < num; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (i = 0; i < num; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return k_cyc_to_ns_floor64(cycles) / 1000U;
+}
+
+static void print_rate(const char *name, uint64_t us, uint64_t count,
+		       const char *unit)
+{
+	TC_PRINT("%s: %llu us, %llu %s/s\n", name, us,
+		 us ? count * 1000000ULL / us : 0, unit);
+}
+
+static void locked_producer(void *p1, void *p2, void *p3)
+{
+	uint8_t chunk[CHUNK_SIZE];
+	uint32_t sent = 0, len;
+	k_spinlock_key_t key;
+
+	memset(chunk, 0xa5, sizeof(chunk));
+
+	while (sent < TRANSFER_SIZE) {
+		key = k_spin_lock(&ring_lock);
+		len = ring_buf_put(&locked_ring, chunk, sizeof(chunk));
+		k_spin_unlock(&ring_lock, key);
+
+		if (len == 0) {
+			k_yield();
+		}
+		sent += len;
+	}
+}
+
+static void locked_consumer(void *p1, void *p2, void *p3)
+{
+	uint8_t chunk[CHUNK_SIZE];
+	uint32_t received = 0, len;
+	k_spinlock_key_t key;
+
+	while (received < TRANSFER_SIZE) {
+		key = k_spin_lock(&ring_lock);
+		len = ring_buf_get(&locked_ring, chunk, sizeof(chunk));
+		k_spin_unlock(&ring_lock, key);
+
+		if (len == 0) {
+			k_yield();
+		}
+		received += len;
+	}
+}
+
+static void spsc_producer(void *p1, void *p2, void *p3)
+{
+	uint8_t chunk[CHUNK_SIZE];
+	uint32_t sent = 0, len;
+
+	memset(chunk, 0xa5, sizeof(chunk));
+
+	while (sent < TRANSFER_SIZE) {
+		len = spsc_ring_put(&spsc, chunk, sizeof(chunk));
+		if (len == 0) {
+			k_yield();
+		}
+		sent += len;
+	}
+}
+
+static void spsc_consumer(void *p1, void *p2, void *p3)
+{
+	uint8_t chunk[CHUNK_SIZE];
+	uint32_t received = 0, len;
+
+	while (received < TRANSFER_SIZE) {
+		len = spsc_ring_get(&spsc, chunk, sizeof(chunk));
+		if (len == 0) {
+			k_yield();
+		}
+		received += len;
+	}
+}
+
+static void mpmc_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t val = 1;
+
+	while (val <= ITEMS_PER_PRODUCER) {
+		if (mpmc_queue_put(&mpmc, &val, sizeof(val)) == 0) {
+			val++;
+		} else {
+			k_yield();
+		}
+	}
+}
+
+static void mpmc_consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t val;
+
+	while (atomic_get(&consumed) < NUM_PRODUCERS * ITEMS_PER_PRODUCER) {
+		if (mpmc_queue_get(&mpmc, &val, sizeof(val)) == 0) {
+			atomic_add(&consumed_sum, val);
+			atomic_inc(&consumed);
+		} else {
+			k_yield();
+		}
+	}
+}
+
+/**
+ * @brief Compare a spinlocked ring_buf with the lock-free SPSC ring
+ *
+ * @details One producer and one consumer thread move the same amount of
+ * data in fixed size chunks through each ring, on different CPUs when
+ * the board has several.
+ */
+void test_spsc_ring_perf(void)
+{
+	k_thread_entry_t locked[] = { locked_producer, locked_consumer };
+	k_thread_entry_t lockfree[] = { spsc_producer, spsc_consumer };
+	void *args[] = { NULL, NULL };
+	uint64_t us;
+
+	TC_PRINT("%u bytes in chunks of %u, %u byte ring, %d CPUs\n",
+		 TRANSFER_SIZE, CHUNK_SIZE, RING_SIZE, CONFIG_MP_NUM_CPUS);
+
+	ring_buf_init(&locked_ring, sizeof(ring_data), ring_data);
+	us = run_threads(locked, args, ARRAY_SIZE(locked));
+	print_rate("ring_buf + spinlock", us, TRANSFER_SIZE, "bytes");
+
+	spsc_ring_init(&spsc, sizeof(ring_data), ring_data);
+	us = run_threads(lockfree, args, ARRAY_SIZE(lockfree));
+	print_rate("spsc_ring", us, TRANSFER_SIZE, "bytes");
+}
+
+/**
+ * @brief Measure the MPMC queue with several producers and consumers
+ */
+void test_mpmc_queue_perf(void)
+{
+	k_thread_entry_t entries[NUM_THREADS];
+	void *args[NUM_THREADS] = { NULL };
+	uint32_t expected_sum;
+	uint64_t us;
+	int i;
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		entries[i] = i < NUM_PRODUCERS ? mpmc_producer : mpmc_consumer;
+	}
+
+	zassert_equal(mpmc_queue_init(&mpmc, mpmc_data, sizeof(uint32_t),
+				      QUEUE_CAPACITY), 0, NULL);
+	atomic_set(&consumed, 0);
+	atomic_set(&consumed_sum, 0);
+
+	us = run_threads(entries, args, NUM_THREADS);
+
+	expected_sum = NUM_PRODUCERS *
+		       (ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1U) / 2U);
+	zassert_equal((uint32_t)atomic_get(&consumed_sum), expected_sum,
+		      "items lost or duplicated");
+
+	TC_PRINT("%d producers, %d consumers, %u slots, %d CPUs\n",
+		 NUM_PRODUCERS, NUM_CONSUMERS, QUEUE_CAPACITY,
+		 CONFIG_MP_NUM_CPUS);
+	print_rate("mpmc_queue", us, NUM_PRODUCERS * ITEMS_PER_PRODUCER,
+		   "items");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(ring_perf,
+			 ztest_unit_test(test_spsc_ring_perf),
+			 ztest_unit_test(test_mpmc_queue_perf));
+
+	ztest_run_test_suite(ring_perf);
+}
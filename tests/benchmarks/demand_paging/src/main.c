@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/mem_manage.h>
+#include <mmu.h>
+
+#ifdef CONFIG_BACKING_STORE_RAM_PAGES
+#define EXTRA_PAGES	(CONFIG_BACKING_STORE_RAM_PAGES - 1)
+#else
+#error "Unsupported configuration"
+#endif
+
+#define N_ACCESSES	20000
+/* Share of the random accesses going to the hot pages, in percent */
+#define HOT_PERCENT	80
+#define HOT_PAGES	4
+
+static size_t arena_pages;
+static char *arena;
+static uint32_t seed = 12345;
+
+static uint32_t next_rand(void)
+{
+	seed = seed * 1103515245U + 12345U;
+
+	return seed >> 16;
+}
+
+static size_t sequential_page(unsigned int i)
+{
+	return i % arena_pages;
+}
+
+static size_t random_page(unsigned int i)
+{
+	ARG_UNUSED(i);
+
+	if (next_rand() % 100U < HOT_PERCENT) {
+		return next_rand() % HOT_PAGES;
+	}
+
+	return next_rand() % arena_pages;
+}
+
+static void run(const char *name, size_t (*page)(unsigned int i))
+{
+	uint32_t start, before, cycles, worst = 0U;
+	unsigned long faults = z_num_pagefaults_get();
+	uint64_t us;
+	unsigned int i;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < N_ACCESSES; i++) {
+		volatile char *p = arena + page(i) * CONFIG_MMU_PAGE_SIZE;
+
+		before = k_cycle_get_32();
+		(void)*p;
+		cycles = k_cycle_get_32() - before;
+
+		if (cycles > worst) {
+			worst = cycles;
+		}
+	}
+
+	us = k_cyc_to_us_floor64(k_cycle_get_32() - start);
+	faults = z_num_pagefaults_get() - faults;
+
+	printk("%s access: %lu faults, %llu faults/s, worst access %u us\n",
+	       name, faults, us ? faults * 1000000ULL / us : 0ULL,
+	       (uint32_t)k_cyc_to_us_ceil32(worst));
+}
+
+void main(void)
+{
+	size_t arena_size = k_mem_free_get() +
+			    (EXTRA_PAGES / 2) * CONFIG_MMU_PAGE_SIZE;
+	struct k_mem_paging_stats_t stats;
+
+	arena = k_mem_map(arena_size, K_MEM_PERM_RW);
+	if (arena == NULL) {
+		printk("Failed to map %zu bytes\n", arena_size);
+		return;
+	}
+
+	arena_pages = arena_size / CONFIG_MMU_PAGE_SIZE;
+	printk("%zu pages, %zu page frames\n", arena_pages,
+	       (size_t)Z_NUM_PAGE_FRAMES);
+
+	run("sequential", sequential_page);
+	run("random", random_page);
+
+	k_mem_paging_stats_get(&stats);
+	printk("%lu pages read ahead by %lu page faults\n",
+	       stats.readahead.pages, stats.readahead.cnt);
+
+	printk("fin\n");
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <posix/pthread.h>
+
+/* Workers each lock their own mutex, signal their own condition
+ * variable and unlock the mutex in a loop. Any slowdown as workers are
+ * added comes from state shared between the objects.
+ */
+
+#define N_ITERS 10000
+#define MAX_WORKERS CONFIG_MAX_PTHREAD_COUNT
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct worker {
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, MAX_WORKERS, STACK_SIZE);
+static struct worker workers[MAX_WORKERS];
+
+static void *worker_fn(void *arg)
+{
+	struct worker *w = arg;
+
+	for (int i = 0; i < N_ITERS; i++) {
+		pthread_mutex_lock(&w->mutex);
+		pthread_cond_signal(&w->cond);
+		pthread_mutex_unlock(&w->mutex);
+	}
+
+	return NULL;
+}
+
+/* Return the wall clock cycles per iteration of @a nb parallel workers */
+static uint32_t run(int nb)
+{
+	pthread_attr_t attr;
+	uint32_t start, cycles;
+	int i;
+
+	for (i = 0; i < nb; i++) {
+		pthread_mutex_init(&workers[i].mutex, NULL);
+		pthread_cond_init(&workers[i].cond, NULL);
+	}
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < nb; i++) {
+		pthread_attr_init(&attr);
+		pthread_attr_setstack(&attr, &worker_stacks[i], STACK_SIZE);
+		pthread_create(&workers[i].thread, &attr, worker_fn,
+			       &workers[i]);
+	}
+
+	for (i = 0; i < nb; i++) {
+		pthread_join(workers[i].thread, NULL);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	return cycles / N_ITERS;
+}
+
+void main(void)
+{
+	printk("%d CPUs\n", CONFIG_MP_NUM_CPUS);
+
+	for (int nb = 1; nb <= MAX_WORKERS; nb *= 2) {
+		printk("%d workers: %u cycles/op\n", nb, run(nb));
+	}
+
+	printk("fin\n");
+}
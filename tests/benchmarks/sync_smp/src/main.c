@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Each CPU runs a worker thread looping over its own synchronization
+ * object.  The objects being independent, the cost of an operation
+ * should not depend on how many CPUs run the loop at the same time.
+ */
+
+#define N_ITERS 10000
+#define STACK_SIZE 1024
+
+enum bench_op {
+	BENCH_SEM,
+	BENCH_MUTEX,
+	BENCH_CONDVAR,
+	NUM_BENCH_OPS
+};
+
+static const char *const op_names[NUM_BENCH_OPS] = {
+	[BENCH_SEM] = "sem give/take",
+	[BENCH_MUTEX] = "mutex lock/unlock",
+	[BENCH_CONDVAR] = "condvar signal",
+};
+
+struct worker {
+	struct k_thread thread;
+	struct k_sem sem;
+	struct k_mutex mutex;
+	struct k_condvar condvar;
+	uint32_t cycles;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_MP_NUM_CPUS,
+				   STACK_SIZE);
+static struct worker workers[CONFIG_MP_NUM_CPUS];
+
+static K_SEM_DEFINE(start_sem, 0, CONFIG_MP_NUM_CPUS);
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct worker *w = arg1;
+	enum bench_op op = POINTER_TO_INT(arg2);
+	uint32_t start;
+
+	ARG_UNUSED(arg3);
+
+	k_sem_take(&start_sem, K_FOREVER);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < N_ITERS; i++) {
+		switch (op) {
+		case BENCH_SEM:
+			k_sem_give(&w->sem);
+			k_sem_take(&w->sem, K_NO_WAIT);
+			break;
+		case BENCH_MUTEX:
+			k_mutex_lock(&w->mutex, K_FOREVER);
+			k_mutex_unlock(&w->mutex);
+			break;
+		default:
+			k_condvar_signal(&w->condvar);
+			break;
+		}
+	}
+
+	w->cycles = k_cycle_get_32() - start;
+}
+
+/* Return the average cycles per iteration of @a op run on @a nb_cpus */
+static uint32_t run(enum bench_op op, int nb_cpus)
+{
+	uint64_t tot = 0U;
+	int i;
+
+	for (i = 0; i < nb_cpus; i++) {
+		struct worker *w = &workers[i];
+
+		k_sem_init(&w->sem, 0, 1);
+		k_mutex_init(&w->mutex);
+		k_condvar_init(&w->condvar);
+
+		k_thread_create(&w->thread, worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(worker_stacks[i]),
+				worker_fn, w, INT_TO_POINTER(op), NULL,
+				K_PRIO_COOP(1), 0, K_FOREVER);
+		k_thread_cpu_mask_clear(&w->thread);
+		k_thread_cpu_mask_enable(&w->thread, i);
+		k_thread_start(&w->thread);
+	}
+
+	/* Let them all block on the start semaphore, then release them */
+	k_sleep(K_MSEC(10));
+
+	for (i = 0; i < nb_cpus; i++) {
+		k_sem_give(&start_sem);
+	}
+
+	for (i = 0; i < nb_cpus; i++) {
+		k_thread_join(&workers[i].thread, K_FOREVER);
+		tot += workers[i].cycles;
+	}
+
+	return tot / ((uint64_t)nb_cpus * N_ITERS);
+}
+
+void main(void)
+{
+	for (int op = 0; op < NUM_BENCH_OPS; op++) {
+		uint32_t one = run(op, 1);
+		uint32_t all = run(op, CONFIG_MP_NUM_CPUS);
+
+		printk("%-18s 1 CPU:  %u cycles/op\n", op_names[op], one);
+		printk("%-18s %d CPUs: %u cycles/op\n", op_names[op],
+		       CONFIG_MP_NUM_CPUS, all);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,215 @@
+/* msgq.c */
+
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "syskernel.h"
+
+#define MSGQ_LEN 16
+#define BATCH_SIZE 8
+
+struct k_msgq msgq_1;
+
+static char __aligned(4) msgq_buf[MSGQ_LEN * sizeof(uint32_t)];
+
+/**
+ *
+ * @brief Initialize message queue for the test
+ *
+ */
+void msgq_test_init(void)
+{
+	k_msgq_init(&msgq_1, msgq_buf, sizeof(uint32_t), MSGQ_LEN);
+}
+
+
+/**
+ *
+ * @brief Message queue test thread sending one message at a time
+ *
+ * @param par1   Ignored parameter.
+ * @param par2   Number of test loops.
+ * @param par3	 Unused
+ *
+ */
+void msgq_thread1(void *par1, void *par2, void *par3)
+{
+	int num_loops = POINTER_TO_INT(par2);
+	uint32_t data;
+	int i;
+
+	ARG_UNUSED(par1);
+	ARG_UNUSED(par3);
+
+	for (i = 0; i < num_loops; i++) {
+		data = i;
+		k_msgq_put(&msgq_1, &data, K_FOREVER);
+	}
+}
+
+
+/**
+ *
+ * @brief Message queue test thread sending batches of messages
+ *
+ * @param par1   Ignored parameter.
+ * @param par2   Number of test loops.
+ * @param par3	 Unused
+ *
+ */
+void msgq_thread2(void *par1, void *par2, void *par3)
+{
+	int num_loops = POINTER_TO_INT(par2);
+	uint32_t data[BATCH_SIZE];
+	int i, j, ret;
+
+	ARG_UNUSED(par1);
+	ARG_UNUSED(par3);
+
+	for (i = 0; i < num_loops; i += BATCH_SIZE) {
+		for (j = 0; j < BATCH_SIZE; j++) {
+			data[j] = i + j;
+		}
+
+		j = 0;
+		while (j < MIN(BATCH_SIZE, num_loops - i)) {
+			ret = k_msgq_put_many(&msgq_1, &data[j],
+					      MIN(BATCH_SIZE, num_loops - i) - j,
+					      K_FOREVER);
+			if (ret < 0) {
+				return;
+			}
+			j += ret;
+		}
+	}
+}
+
+
+/**
+ *
+ * @brief The main test entry
+ *
+ * @return 1 if success and 0 on failure
+ *
+ */
+int msgq_test(void)
+{
+	uint32_t data[BATCH_SIZE];
+	uint32_t *msgs;
+	void *claimed;
+	uint32_t t;
+	int i, j, ret;
+	int return_value = 0;
+
+	/* test get wait & put one message at a time */
+	fprintf(output_file, sz_test_case_fmt,
+			"Message queue #1");
+	fprintf(output_file, sz_description,
+			"\n\tk_msgq_init"
+			"\n\tk_msgq_get(K_FOREVER)"
+			"\n\tk_msgq_put(K_FOREVER)");
+	printf(sz_test_start_fmt);
+
+	msgq_test_init();
+
+	t = BENCH_START();
+
+	k_thread_create(&thread_data1, thread_stack1, STACK_SIZE, msgq_thread1,
+			 0, INT_TO_POINTER(number_of_loops), NULL,
+			 K_PRIO_COOP(3), 0, K_NO_WAIT);
+
+	for (i = 0; i < number_of_loops; i++) {
+		k_msgq_get(&msgq_1, data, K_FOREVER);
+		if (data[0] != i) {
+			break;
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
+	/* test get wait & put batches of messages */
+	fprintf(output_file, sz_test_case_fmt,
+			"Message queue #2");
+	fprintf(output_file, sz_description,
+			"\n\tk_msgq_init"
+			"\n\tk_msgq_get_many(K_FOREVER)"
+			"\n\tk_msgq_put_many(K_FOREVER)");
+	printf(sz_test_start_fmt);
+
+	msgq_test_init();
+
+	t = BENCH_START();
+
+	k_thread_create(&thread_data1, thread_stack1, STACK_SIZE, msgq_thread2,
+			 0, INT_TO_POINTER(number_of_loops), NULL,
+			 K_PRIO_COOP(3), 0, K_NO_WAIT);
+
+	i = 0;
+	while (i < number_of_loops) {
+		ret = k_msgq_get_many(&msgq_1, data, BATCH_SIZE, K_FOREVER);
+		for (j = 0; j < ret; j++) {
+			if (data[j] != i) {
+				break;
+			}
+			i++;
+		}
+		if (ret < 0 || j < ret) {
+			break;
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
+	/* test reading batches of messages in place */
+	fprintf(output_file, sz_test_case_fmt,
+			"Message queue #3");
+	fprintf(output_file, sz_description,
+			"\n\tk_msgq_init"
+			"\n\tk_msgq_get_claim"
+			"\n\tk_msgq_get_finish"
+			"\n\tk_msgq_put_many(K_FOREVER)"
+			"\n\tk_yield");
+	printf(sz_test_start_fmt);
+
+	msgq_test_init();
+
+	t = BENCH_START();
+
+	k_thread_create(&thread_data1, thread_stack1, STACK_SIZE, msgq_thread2,
+			 0, INT_TO_POINTER(number_of_loops), NULL,
+			 K_PRIO_COOP(3), 0, K_NO_WAIT);
+
+	i = 0;
+	while (i < number_of_loops) {
+		ret = k_msgq_get_claim(&msgq_1, &claimed, BATCH_SIZE);
+		if (ret == -ENOMSG) {
+			k_yield();
+			continue;
+		}
+
+		msgs = claimed;
+		for (j = 0; j < ret; j++) {
+			if (msgs[j] != i) {
+				break;
+			}
+			i++;
+		}
+		k_msgq_get_finish(&msgq_1, ret);
+		if (ret < 0 || j < ret) {
+			break;
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
+	return return_value;
+}
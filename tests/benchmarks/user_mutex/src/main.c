@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/mutex.h>
+#include <app_memory/app_memdomain.h>
+
+/* A user mode thread locks and unlocks an uncontended mutex in a loop.
+ * The cycle counter can't be read from user mode on every platform, so
+ * the loop is timed from supervisor mode around the thread.
+ */
+
+#define N_ITERS 10000
+#define STACK_SIZE 1024
+
+K_APPMEM_PARTITION_DEFINE(bench_part);
+static K_APP_BMEM(bench_part) SYS_MUTEX_DEFINE(bench_sys_mutex);
+
+static K_MUTEX_DEFINE(bench_k_mutex);
+
+static K_THREAD_STACK_DEFINE(user_stack, STACK_SIZE);
+static struct k_thread user_thread;
+
+static struct k_mem_domain bench_domain;
+
+static void k_mutex_loop(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < N_ITERS; i++) {
+		k_mutex_lock(&bench_k_mutex, K_FOREVER);
+		k_mutex_unlock(&bench_k_mutex);
+	}
+}
+
+static void sys_mutex_loop(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < N_ITERS; i++) {
+		sys_mutex_lock(&bench_sys_mutex, K_FOREVER);
+		sys_mutex_unlock(&bench_sys_mutex);
+	}
+}
+
+/* Return the average cycles per iteration of @a loop run in user mode */
+static uint32_t run(k_thread_entry_t loop)
+{
+	uint32_t start, cycles;
+
+	k_thread_create(&user_thread, user_stack, STACK_SIZE, loop,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(1), K_USER, K_FOREVER);
+	k_mem_domain_add_thread(&bench_domain, &user_thread);
+	k_thread_access_grant(&user_thread, &bench_k_mutex);
+
+	start = k_cycle_get_32();
+
+	k_thread_start(&user_thread);
+	k_thread_join(&user_thread, K_FOREVER);
+
+	cycles = k_cycle_get_32() - start;
+
+	return cycles / N_ITERS;
+}
+
+void main(void)
+{
+	struct k_mem_partition *parts[] = { &bench_part };
+
+	k_mem_domain_init(&bench_domain, ARRAY_SIZE(parts), parts);
+
+	printk("k_mutex lock/unlock:   %u cycles\n", run(k_mutex_loop));
+	printk("sys_mutex lock/unlock: %u cycles (fast path %s)\n",
+	       run(sys_mutex_loop),
+	       IS_ENABLED(CONFIG_SYS_MUTEX_FAST_PATH) ? "on" : "off");
+
+	printk("fin\n");
+}
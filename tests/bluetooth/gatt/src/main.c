@@ -14,6 +14,8 @@
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/gatt.h>
 
+#include "gatt_internal.h"
+
 /* Custom Service Variables */
 static struct bt_uuid_128 test_uuid = BT_UUID_INIT_128(
 	0xf0, 0xde, 0xbc, 0x9a, 0x78, 0x56, 0x34, 0x12,
@@ -265,6 +267,193 @@ void test_gatt_write(void)
 			  "Attribute write value don't match");
 }
 
+static struct bt_gatt_attr group_a_attrs[] = {
+	BT_GATT_PRIMARY_SERVICE(&test_uuid),
+	BT_GATT_DESCRIPTOR(&test_chrc_uuid.uuid, BT_GATT_PERM_READ, read_test,
+			   NULL, test_value),
+	BT_GATT_DESCRIPTOR(&test_chrc_uuid.uuid, BT_GATT_PERM_READ, read_test,
+			   NULL, test_value),
+};
+
+static struct bt_gatt_attr group_b_attrs[] = {
+	BT_GATT_SECONDARY_SERVICE(&test1_uuid),
+	BT_GATT_DESCRIPTOR(&test_chrc_uuid.uuid, BT_GATT_PERM_READ, read_test,
+			   NULL, test_value),
+};
+
+static struct bt_gatt_attr group_c_attrs[] = {
+	BT_GATT_PRIMARY_SERVICE(&test1_uuid),
+};
+
+static struct bt_gatt_service group_svc[] = {
+	BT_GATT_SERVICE(group_a_attrs),
+	BT_GATT_SERVICE(group_b_attrs),
+	BT_GATT_SERVICE(group_c_attrs),
+};
+
+struct group_data {
+	uint16_t count;
+	uint16_t handle[2];
+	uint16_t end_handle[2];
+};
+
+static uint8_t collect_group(const struct bt_gatt_attr *attr, uint16_t handle,
+			     uint16_t end_handle, void *user_data)
+{
+	struct group_data *data = user_data;
+
+	if (data->count == ARRAY_SIZE(data->handle)) {
+		return BT_GATT_ITER_STOP;
+	}
+
+	data->handle[data->count] = handle;
+	data->end_handle[data->count] = end_handle;
+	data->count++;
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+void test_gatt_foreach_group(void)
+{
+	struct group_data data;
+	uint16_t a, b, c;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(group_svc); i++) {
+		zassert_false(bt_gatt_service_register(&group_svc[i]),
+			      "Group service registration failed");
+	}
+
+	a = group_a_attrs[0].handle;
+	b = group_b_attrs[0].handle;
+	c = group_c_attrs[0].handle;
+
+	/* A secondary service ends the preceding primary group */
+	(void)memset(&data, 0, sizeof(data));
+	bt_gatt_foreach_attr_group(a, 0xffff, BT_UUID_GATT_PRIMARY,
+				   collect_group, &data);
+	zassert_equal(data.count, 2, "Number of groups don't match");
+	zassert_equal(data.handle[0], a, "Group start don't match");
+	zassert_equal(data.end_handle[0], group_a_attrs[2].handle,
+		      "Group end don't match");
+	zassert_equal(data.handle[1], c, "Group start don't match");
+	zassert_equal(data.end_handle[1], c, "Group end don't match");
+
+	(void)memset(&data, 0, sizeof(data));
+	bt_gatt_foreach_attr_group(a, 0xffff, BT_UUID_GATT_SECONDARY,
+				   collect_group, &data);
+	zassert_equal(data.count, 1, "Number of groups don't match");
+	zassert_equal(data.handle[0], b, "Group start don't match");
+	zassert_equal(data.end_handle[0], group_b_attrs[1].handle,
+		      "Group end don't match");
+
+	/* Group end is clipped to the end of the range */
+	(void)memset(&data, 0, sizeof(data));
+	bt_gatt_foreach_attr_group(a, group_a_attrs[1].handle,
+				   BT_UUID_GATT_PRIMARY, collect_group, &data);
+	zassert_equal(data.count, 1, "Number of groups don't match");
+	zassert_equal(data.end_handle[0], group_a_attrs[1].handle,
+		      "Group end don't match");
+
+	for (i = 0; i < ARRAY_SIZE(group_svc); i++) {
+		zassert_false(bt_gatt_service_unregister(&group_svc[i]),
+			      "Group service unregister failed");
+	}
+}
+
+#define PERF_SVC_COUNT 200
+#define PERF_ITERATIONS 100
+
+static uint8_t count_group(const struct bt_gatt_attr *attr, uint16_t handle,
+			   uint16_t end_handle, void *user_data)
+{
+	uint16_t *count = user_data;
+
+	(*count)++;
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static struct bt_gatt_attr perf_attrs[PERF_SVC_COUNT][2];
+static struct bt_gatt_service perf_svc[PERF_SVC_COUNT];
+
+void test_gatt_discover_perf(void)
+{
+	uint32_t start, cycles;
+	uint64_t ns;
+	uint16_t num;
+	int i;
+
+	for (i = 0; i < PERF_SVC_COUNT; i++) {
+		perf_attrs[i][0] = (struct bt_gatt_attr)
+			BT_GATT_PRIMARY_SERVICE(&test_uuid);
+		perf_attrs[i][1] = (struct bt_gatt_attr)
+			BT_GATT_DESCRIPTOR(&test_chrc_uuid.uuid,
+					   BT_GATT_PERM_READ, read_test, NULL,
+					   test_value);
+		perf_svc[i] = (struct bt_gatt_service)
+			BT_GATT_SERVICE(perf_attrs[i]);
+
+		zassert_false(bt_gatt_service_register(&perf_svc[i]),
+			      "Perf service registration failed");
+	}
+
+	/* Discover all primary services */
+	num = 0;
+	bt_gatt_foreach_attr_type(0x0001, 0xffff, BT_UUID_GATT_PRIMARY, NULL,
+				  0, count_attr, &num);
+	zassert_true(num >= PERF_SVC_COUNT, "Number of services don't match");
+
+	/* Last service found by handle */
+	num = 0;
+	bt_gatt_foreach_attr_type(perf_attrs[PERF_SVC_COUNT - 1][1].handle,
+				  perf_attrs[PERF_SVC_COUNT - 1][1].handle,
+				  NULL, NULL, 0, count_attr, &num);
+	zassert_equal(num, 1, "Number of attributes don't match");
+
+	start = k_cycle_get_32();
+	for (i = 0; i < PERF_ITERATIONS; i++) {
+		num = 0;
+		bt_gatt_foreach_attr_type(0x0001, 0xffff, BT_UUID_GATT_PRIMARY,
+					  NULL, 0, count_attr, &num);
+	}
+	cycles = k_cycle_get_32() - start;
+	ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("Primary service discovery: %u ns per walk of %u services\n",
+		 (uint32_t)(ns / PERF_ITERATIONS), num);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < PERF_ITERATIONS; i++) {
+		num = 0;
+		bt_gatt_foreach_attr_group(0x0001, 0xffff, BT_UUID_GATT_PRIMARY,
+					   count_group, &num);
+	}
+	cycles = k_cycle_get_32() - start;
+	ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("Primary service groups: %u ns per walk of %u groups\n",
+		 (uint32_t)(ns / PERF_ITERATIONS), num);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < PERF_ITERATIONS; i++) {
+		num = 0;
+		bt_gatt_foreach_attr(perf_attrs[i % PERF_SVC_COUNT][1].handle,
+				     perf_attrs[i % PERF_SVC_COUNT][1].handle,
+				     count_attr, &num);
+	}
+	cycles = k_cycle_get_32() - start;
+	ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("Attribute lookup by handle: %u ns\n",
+		 (uint32_t)(ns / PERF_ITERATIONS));
+
+	for (i = 0; i < PERF_SVC_COUNT; i++) {
+		zassert_false(bt_gatt_service_unregister(&perf_svc[i]),
+			      "Perf service unregister failed");
+	}
+}
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -273,6 +462,8 @@ void test_main(void)
 			 ztest_unit_test(test_gatt_unregister),
 			 ztest_unit_test(test_gatt_foreach),
 			 ztest_unit_test(test_gatt_read),
-			 ztest_unit_test(test_gatt_write));
+			 ztest_unit_test(test_gatt_write),
+			 ztest_unit_test(test_gatt_foreach_group),
+			 ztest_unit_test(test_gatt_discover_perf));
 	ztest_run_test_suite(test_gatt);
 }
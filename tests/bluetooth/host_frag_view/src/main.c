@@ -0,0 +1,381 @@
+/* main.c - Host ACL fragmentation by reference */
+
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+
+#include <errno.h>
+#include <tc_util.h>
+#include <ztest.h>
+
+#include <bluetooth/hci.h>
+#include <bluetooth/buf.h>
+#include <bluetooth/bluetooth.h>
+#include <bluetooth/conn.h>
+#include <drivers/bluetooth/hci_driver.h>
+#include <sys/byteorder.h>
+
+#include "conn_internal.h"
+
+#define ACL_MTU 27
+#define ACL_PKTS 8
+#define PDU_LEN 200
+#define PDU_FRAGS ((PDU_LEN + ACL_MTU - 1) / ACL_MTU)
+#define PERF_PDUS 200
+
+/* Command handler structure for cmd_handle(). */
+struct cmd_handler {
+	uint16_t opcode; /* HCI command opcode */
+	uint8_t len; /* HCI command response length */
+	void (*handler)(struct net_buf *buf, struct net_buf **evt, uint8_t len, uint16_t opcode);
+};
+
+/* Per connection state of the test controller. */
+struct test_link {
+	struct bt_conn *conn;
+	uint8_t rx[PDU_LEN]; /* Reassembled PDU */
+	uint16_t rx_len;
+	bool hold; /* Keep the next fragment instead of releasing it */
+	struct net_buf *held;
+	uint16_t held_offset; /* Offset in the PDU of the held fragment */
+	struct k_sem done; /* Given for every complete PDU */
+};
+
+static struct test_link links[CONFIG_BT_MAX_CONN];
+static uint8_t pdu_data[CONFIG_BT_MAX_CONN][PDU_LEN];
+
+/* Add event to net_buf. */
+static void evt_create(struct net_buf *buf, uint8_t evt, uint8_t len)
+{
+	struct bt_hci_evt_hdr *hdr;
+
+	hdr = net_buf_add(buf, sizeof(*hdr));
+	hdr->evt = evt;
+	hdr->len = len;
+}
+
+/* Create a command complete event. */
+static void *cmd_complete(struct net_buf **buf, uint8_t plen, uint16_t opcode)
+{
+	struct bt_hci_evt_cmd_complete *cc;
+
+	*buf = bt_buf_get_evt(BT_HCI_EVT_CMD_COMPLETE, false, K_FOREVER);
+	evt_create(*buf, BT_HCI_EVT_CMD_COMPLETE, sizeof(*cc) + plen);
+	cc = net_buf_add(*buf, sizeof(*cc));
+	cc->ncmd = 1U;
+	cc->opcode = sys_cpu_to_le16(opcode);
+
+	return net_buf_add(*buf, plen);
+}
+
+/* Generic command complete with success status. */
+static void generic_success(struct net_buf *buf, struct net_buf **evt, uint8_t len, uint16_t opcode)
+{
+	struct bt_hci_evt_cc_status *ccst;
+
+	ccst = cmd_complete(evt, len, opcode);
+
+	/* Fill any event parameters with zero */
+	(void)memset(ccst, 0, len);
+
+	ccst->status = BT_HCI_ERR_SUCCESS;
+}
+
+/* LE only controller, without any optional feature. */
+static void read_local_features(struct net_buf *buf, struct net_buf **evt, uint8_t len,
+				uint16_t opcode)
+{
+	struct bt_hci_rp_read_local_features *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	(void)memset(rp, 0, sizeof(*rp));
+	rp->status = 0x00;
+	/* LE supported, BR/EDR not supported */
+	rp->features[4] = BIT(6) | BIT(5);
+}
+
+static void le_read_buffer_size(struct net_buf *buf, struct net_buf **evt, uint8_t len,
+				uint16_t opcode)
+{
+	struct bt_hci_rp_le_read_buffer_size *rp;
+
+	rp = cmd_complete(evt, sizeof(*rp), opcode);
+	rp->status = 0x00;
+	rp->le_max_len = sys_cpu_to_le16(ACL_MTU);
+	rp->le_max_num = ACL_PKTS;
+}
+
+/* Setup handlers needed for bt_enable to function. */
+static const struct cmd_handler cmds[] = {
+	{ BT_HCI_OP_READ_LOCAL_VERSION_INFO, sizeof(struct bt_hci_rp_read_local_version_info),
+	  generic_success },
+	{ BT_HCI_OP_READ_SUPPORTED_COMMANDS, sizeof(struct bt_hci_rp_read_supported_commands),
+	  generic_success },
+	{ BT_HCI_OP_READ_LOCAL_FEATURES, sizeof(struct bt_hci_rp_read_local_features),
+	  read_local_features },
+	{ BT_HCI_OP_READ_BD_ADDR, sizeof(struct bt_hci_rp_read_bd_addr), generic_success },
+	{ BT_HCI_OP_SET_EVENT_MASK, sizeof(struct bt_hci_evt_cc_status), generic_success },
+	{ BT_HCI_OP_LE_SET_EVENT_MASK, sizeof(struct bt_hci_evt_cc_status), generic_success },
+	{ BT_HCI_OP_LE_READ_LOCAL_FEATURES, sizeof(struct bt_hci_rp_le_read_local_features),
+	  generic_success },
+	{ BT_HCI_OP_LE_READ_BUFFER_SIZE, sizeof(struct bt_hci_rp_le_read_buffer_size),
+	  le_read_buffer_size },
+	{ BT_HCI_OP_LE_RAND, sizeof(struct bt_hci_rp_le_rand), generic_success },
+	{ BT_HCI_OP_LE_SET_RANDOM_ADDRESS, sizeof(struct bt_hci_cp_le_set_random_address),
+	  generic_success },
+	{ BT_HCI_OP_RESET, 0, generic_success },
+};
+
+/* Lookup the command opcode and invoke handler. */
+static int cmd_handle(struct net_buf *cmd)
+{
+	struct net_buf *evt = NULL;
+	struct bt_hci_cmd_hdr *chdr;
+	uint16_t opcode;
+
+	chdr = net_buf_pull_mem(cmd, sizeof(*chdr));
+	opcode = sys_le16_to_cpu(chdr->opcode);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cmds); i++) {
+		if (cmds[i].opcode == opcode) {
+			cmds[i].handler(cmd, &evt, cmds[i].len, opcode);
+			bt_recv_prio(evt);
+
+			return 0;
+		}
+	}
+
+	zassert_unreachable("opcode %X failed", opcode);
+
+	return -EINVAL;
+}
+
+/* Return the controller buffer of a fragment to the host. */
+static void num_completed_packets(uint16_t handle)
+{
+	struct bt_hci_evt_num_completed_packets *ev;
+	struct bt_hci_handle_count *hc;
+	struct net_buf *buf;
+
+	buf = bt_buf_get_evt(BT_HCI_EVT_NUM_COMPLETED_PACKETS, false, K_FOREVER);
+	evt_create(buf, BT_HCI_EVT_NUM_COMPLETED_PACKETS, sizeof(*ev) + sizeof(*hc));
+	ev = net_buf_add(buf, sizeof(*ev));
+	ev->num_handles = 1U;
+	hc = net_buf_add(buf, sizeof(*hc));
+	hc->handle = sys_cpu_to_le16(handle);
+	hc->count = sys_cpu_to_le16(1);
+
+	bt_recv_prio(buf);
+}
+
+/* Reassemble the ACL fragments sent on each connection. */
+static void acl_handle(struct net_buf *buf)
+{
+	struct bt_hci_acl_hdr *hdr;
+	struct test_link *link;
+	uint16_t handle, len;
+	uint8_t flags;
+
+	hdr = (void *)buf->data;
+	handle = bt_acl_handle(sys_le16_to_cpu(hdr->handle));
+	flags = bt_acl_flags(sys_le16_to_cpu(hdr->handle));
+	len = sys_le16_to_cpu(hdr->len);
+
+	zassert_true(handle < ARRAY_SIZE(links), "Unknown handle %u", handle);
+	zassert_true(len <= ACL_MTU, "Fragment exceeds the ACL MTU");
+	zassert_equal(buf->len, sizeof(*hdr) + len, "Length mismatch");
+
+	link = &links[handle];
+
+	if (flags == BT_ACL_START_NO_FLUSH) {
+		zassert_equal(link->rx_len, 0, "Start in the middle of a PDU");
+	} else {
+		zassert_equal(flags, BT_ACL_CONT, "Unexpected flags 0x%02x", flags);
+		zassert_not_equal(link->rx_len, 0, "Continuation without start");
+	}
+
+	zassert_true(link->rx_len + len <= PDU_LEN, "PDU too long");
+	memcpy(&link->rx[link->rx_len], &buf->data[sizeof(*hdr)], len);
+
+	if (link->hold && !link->held) {
+		link->held = net_buf_ref(buf);
+		link->held_offset = link->rx_len;
+	}
+
+	link->rx_len += len;
+	if (link->rx_len == PDU_LEN) {
+		link->rx_len = 0U;
+		k_sem_give(&link->done);
+	}
+
+	num_completed_packets(handle);
+}
+
+/* HCI driver open. */
+static int driver_open(void)
+{
+	return 0;
+}
+
+/* HCI driver send. */
+static int driver_send(struct net_buf *buf)
+{
+	switch (bt_buf_get_type(buf)) {
+	case BT_BUF_CMD:
+		zassert_true(cmd_handle(buf) == 0, "Unknown HCI command");
+		break;
+	case BT_BUF_ACL_OUT:
+		acl_handle(buf);
+		break;
+	default:
+		zassert_unreachable("Unexpected buffer type");
+		break;
+	}
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+
+/* HCI driver structure. */
+static const struct bt_hci_driver drv = {
+	.name = "test",
+	.bus = BT_HCI_DRIVER_BUS_VIRTUAL,
+	.open = driver_open,
+	.send = driver_send,
+	.quirks = 0,
+};
+
+static void send_pdu(struct test_link *link, const uint8_t *data)
+{
+	struct net_buf *buf;
+
+	buf = bt_conn_create_pdu(NULL, 0);
+	zassert_not_null(buf, "No PDU buffer");
+	net_buf_add_mem(buf, data, PDU_LEN);
+
+	zassert_equal(bt_conn_send(link->conn, buf), 0, "Send failed");
+}
+
+static void test_host_frag_view_setup(void)
+{
+	bt_addr_le_t addr;
+
+	/* Register the test HCI driver */
+	bt_hci_driver_register(&drv);
+
+	/* Go! Wait until Bluetooth initialization is done  */
+	zassert_true((bt_enable(NULL) == 0), "bt_enable failed");
+
+	for (uint16_t i = 0; i < ARRAY_SIZE(links); i++) {
+		struct test_link *link = &links[i];
+
+		k_sem_init(&link->done, 0, 1);
+
+		bt_addr_le_create_static(&addr);
+		link->conn = bt_conn_add_le(BT_ID_DEFAULT, &addr);
+		zassert_not_null(link->conn, "Connection alloc failed");
+
+		link->conn->handle = i;
+		link->conn->role = BT_HCI_ROLE_CENTRAL;
+		bt_conn_set_state(link->conn, BT_CONN_CONNECTED);
+
+		for (uint16_t j = 0; j < PDU_LEN; j++) {
+			pdu_data[i][j] = (uint8_t)(j * 7U + i);
+		}
+	}
+}
+
+static void test_host_frag_view_integrity(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(links); i++) {
+		struct test_link *link = &links[i];
+
+		/* Back to back PDUs reuse the fragment view of the link */
+		send_pdu(link, pdu_data[i]);
+		send_pdu(link, pdu_data[i]);
+
+		for (int j = 0; j < 2; j++) {
+			zassert_equal(k_sem_take(&link->done, K_SECONDS(1)), 0,
+				      "PDU not sent");
+			zassert_mem_equal(link->rx, pdu_data[i], PDU_LEN,
+					  "PDU data corrupted");
+		}
+	}
+}
+
+static void test_host_frag_view_stall(void)
+{
+	struct test_link *stalled = &links[0];
+	struct test_link *other = &links[1];
+	struct net_buf *held;
+
+	if (!IS_ENABLED(CONFIG_BT_L2CAP_TX_FRAG_VIEW)) {
+		ztest_test_skip();
+	}
+
+	/* The driver keeps the first fragment view of the stalled link */
+	stalled->hold = true;
+	send_pdu(stalled, pdu_data[0]);
+	send_pdu(other, pdu_data[1]);
+
+	/* The other link is not held up by the stalled one */
+	zassert_equal(k_sem_take(&other->done, K_SECONDS(1)), 0,
+		      "PDU stuck behind the stalled link");
+	zassert_mem_equal(other->rx, pdu_data[1], PDU_LEN, "PDU data corrupted");
+
+	zassert_not_null(stalled->held, "No fragment held");
+	zassert_equal(stalled->rx_len, ACL_MTU, "Stalled link kept sending");
+	zassert_not_equal(k_sem_take(&stalled->done, K_MSEC(100)), 0,
+			  "Stalled PDU completed");
+
+	/* Nothing has been written over the held fragment */
+	held = stalled->held;
+	zassert_mem_equal(&held->data[sizeof(struct bt_hci_acl_hdr)],
+			  &pdu_data[0][stalled->held_offset], ACL_MTU,
+			  "Held fragment overwritten");
+
+	stalled->hold = false;
+	stalled->held = NULL;
+	net_buf_unref(held);
+
+	zassert_equal(k_sem_take(&stalled->done, K_SECONDS(1)), 0,
+		      "Stalled PDU not resumed");
+	zassert_mem_equal(stalled->rx, pdu_data[0], PDU_LEN, "PDU data corrupted");
+}
+
+static void test_host_frag_view_perf(void)
+{
+	struct test_link *link = &links[0];
+	uint32_t start, cycles;
+	uint64_t ns;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < PERF_PDUS; i++) {
+		send_pdu(link, pdu_data[0]);
+		zassert_equal(k_sem_take(&link->done, K_SECONDS(1)), 0,
+			      "PDU not sent");
+	}
+	cycles = k_cycle_get_32() - start;
+	ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%s ACL fragmentation: %u ns per %u byte PDU (%u fragments)\n",
+		 IS_ENABLED(CONFIG_BT_L2CAP_TX_FRAG_VIEW) ? "View" : "Copy",
+		 (uint32_t)(ns / PERF_PDUS), PDU_LEN, PDU_FRAGS);
+}
+
+/* test case main entry */
+void test_main(void)
+{
+	ztest_test_suite(test_host_frag_view,
+			 ztest_unit_test(test_host_frag_view_setup),
+			 ztest_unit_test(test_host_frag_view_integrity),
+			 ztest_unit_test(test_host_frag_view_stall),
+			 ztest_unit_test(test_host_frag_view_perf));
+
+	ztest_run_test_suite(test_host_frag_view);
+}
@@ -299,6 +299,86 @@ static void test_get_mock(void)
 #endif
 }
 
+#ifdef CONFIG_FLASH_ASYNC
+static K_SEM_DEFINE(async_done, 0, 1);
+static int async_result;
+
+static void async_cb(const struct device *dev, struct flash_async_op *op,
+		     int result)
+{
+	async_result = result;
+	k_sem_give(&async_done);
+}
+
+static int async_run(struct flash_async_op *op)
+{
+	int rc;
+
+	op->callback = async_cb;
+	rc = flash_async_submit(flash_dev, op);
+	if (rc != 0) {
+		return rc;
+	}
+
+	zassert_equal(0, k_sem_take(&async_done, K_SECONDS(1)),
+		      "async operation did not complete");
+
+	return async_result;
+}
+#endif /* CONFIG_FLASH_ASYNC */
+
+static void test_async(void)
+{
+#ifndef CONFIG_FLASH_ASYNC
+	ztest_test_skip();
+#else
+	static uint8_t head[FLASH_SIMULATOR_PROG_UNIT * 2];
+	static uint8_t tail[FLASH_SIMULATOR_PROG_UNIT * 2];
+	const struct flash_async_buf bufs[] = {
+		{ .data = head, .len = sizeof(head) },
+		{ .data = tail, .len = sizeof(tail) },
+	};
+	struct flash_async_op op = {
+		.type = FLASH_ASYNC_OP_ERASE,
+		.offset = FLASH_SIMULATOR_BASE_OFFSET,
+		.len = FLASH_SIMULATOR_ERASE_UNIT,
+	};
+	off_t i;
+	int rc;
+
+	rc = async_run(&op);
+	zassert_equal(0, rc, "async erase should succeed");
+
+	for (i = 0; i < sizeof(head); i++) {
+		head[i] = i;
+		tail[i] = ~i;
+	}
+
+	op.type = FLASH_ASYNC_OP_WRITE;
+	op.bufs = bufs;
+	op.buf_count = ARRAY_SIZE(bufs);
+	rc = async_run(&op);
+	zassert_equal(0, rc, "async write should succeed");
+
+	op.type = FLASH_ASYNC_OP_READ;
+	op.data = test_read_buf;
+	op.len = sizeof(head) + sizeof(tail);
+	rc = async_run(&op);
+	zassert_equal(0, rc, "async read should succeed");
+
+	zassert_mem_equal(test_read_buf, head, sizeof(head),
+			  "first buffer not written");
+	zassert_mem_equal(test_read_buf + sizeof(head), tail, sizeof(tail),
+			  "second buffer not written");
+
+	op.type = FLASH_ASYNC_OP_ERASE;
+	op.offset = FLASH_SIMULATOR_BASE_OFFSET - FLASH_SIMULATOR_ERASE_UNIT;
+	op.len = FLASH_SIMULATOR_ERASE_UNIT;
+	rc = async_run(&op);
+	zassert_equal(-EINVAL, rc, "out of bounds async erase should fail");
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(flash_sim_api,
@@ -310,7 +390,8 @@ void test_main(void)
 			 ztest_unit_test(test_align),
 			 ztest_unit_test(test_get_erase_value),
 			 ztest_unit_test(test_double_write),
-			 ztest_unit_test(test_get_mock));
+			 ztest_unit_test(test_get_mock),
+			 ztest_unit_test(test_async));
 
 	ztest_run_test_suite(flash_sim_api);
 }
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <device.h>
+
+#define DT_DRV_COMPAT test_init_order
+
+/* Time each init takes, so that inits of independent devices overlap */
+#define INIT_MS 10
+
+struct init_order_data {
+	/* Sequence numbers of the start and the end of the init */
+	atomic_val_t started;
+	atomic_val_t done;
+};
+
+static atomic_t init_seq;
+static atomic_t running;
+static atomic_t max_running;
+
+static int init_order_init(const struct device *dev)
+{
+	struct init_order_data *data = dev->data;
+	atomic_val_t now, max;
+
+	data->started = atomic_inc(&init_seq) + 1;
+
+	now = atomic_inc(&running) + 1;
+	do {
+		max = atomic_get(&max_running);
+	} while ((now > max) && !atomic_cas(&max_running, max, now));
+
+	k_msleep(INIT_MS);
+
+	atomic_dec(&running);
+	data->done = atomic_inc(&init_seq) + 1;
+
+	return 0;
+}
+
+/* No other device is initialized at the APPLICATION level, which keeps
+ * these in a single parallel batch.
+ */
+#define INIT_ORDER_DEVICE_DEFINE(inst)					\
+	static struct init_order_data init_order_data_##inst;		\
+									\
+	DEVICE_DT_INST_DEFINE(inst, init_order_init, NULL,		\
+			      &init_order_data_##inst, NULL,		\
+			      APPLICATION,				\
+			      CONFIG_APPLICATION_INIT_PRIORITY, NULL);
+
+DT_INST_FOREACH_STATUS_OKAY(INIT_ORDER_DEVICE_DEFINE)
+
+static void check_required(const struct device *dev,
+			   const struct device *rdev)
+{
+	const struct init_order_data *data = dev->data;
+	const struct init_order_data *rdata = rdev->data;
+
+	zassert_true(rdata->done < data->started,
+		     "%s initialized before its requirement %s",
+		     dev->name, rdev->name);
+}
+
+static void check_device(const struct device *dev)
+{
+	const struct init_order_data *data = dev->data;
+
+	zassert_true(device_is_ready(dev), "%s not ready", dev->name);
+	zassert_not_equal(data->done, 0, "%s not initialized", dev->name);
+}
+
+#define CHECK_REQUIRED(node_id, prop, idx)				\
+	check_required(DEVICE_DT_GET(node_id),				\
+		       DEVICE_DT_GET(DT_PHANDLE_BY_IDX(node_id, prop, idx)));
+
+#define CHECK_DEVICE(inst)						\
+	check_device(DEVICE_DT_INST_GET(inst));				\
+	COND_CODE_1(DT_INST_NODE_HAS_PROP(inst, requires),		\
+		    (DT_INST_FOREACH_PROP_ELEM(inst, requires,		\
+					       CHECK_REQUIRED)), ())
+
+/**
+ * @brief Test the init order of devices initialized in parallel
+ *
+ * @details Devices of the same init level, depending on each other
+ * through devicetree, are initialized by the parallel init threads.
+ * Check that each init only started once all the inits of the devices
+ * it requires were done, and that independent devices were initialized
+ * concurrently.
+ *
+ * @ingroup kernel_device_tests
+ */
+void test_init_order(void)
+{
+	DT_INST_FOREACH_STATUS_OKAY(CHECK_DEVICE)
+
+	zassert_true(atomic_get(&max_running) > 1,
+		     "devices were not initialized in parallel");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(device_init_parallel,
+			 ztest_unit_test(test_init_order));
+	ztest_run_test_suite(device_init_parallel);
+}
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 4
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * BATCH_LEN];
+static ZTEST_DMEM uint32_t send_buf[BATCH_LEN * 2];
+static ZTEST_DMEM uint32_t rec_buf[BATCH_LEN * 2];
+
+static void check_received(uint32_t first, int num)
+{
+	for (int i = 0; i < num; i++) {
+		zassert_equal(rec_buf[i], first + i, "got %u, expected %u",
+			      rec_buf[i], first + i);
+	}
+}
+
+static void put_get_many(struct k_msgq *q)
+{
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(send_buf); i++) {
+		send_buf[i] = i;
+	}
+
+	/**TESTPOINT: get from an empty queue without waiting */
+	ret = k_msgq_get_many(q, rec_buf, BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+
+	/**TESTPOINT: put more than fits */
+	ret = k_msgq_put_many(q, send_buf, 3, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	ret = k_msgq_put_many(q, &send_buf[3], 3, K_NO_WAIT);
+	zassert_equal(ret, 1, NULL);
+	zassert_equal(k_msgq_num_used_get(q), BATCH_LEN, NULL);
+
+	/**TESTPOINT: put to a full queue without waiting */
+	ret = k_msgq_put_many(q, &send_buf[4], 1, K_NO_WAIT);
+	zassert_equal(ret, -ENOMSG, NULL);
+
+	ret = k_msgq_get_many(q, rec_buf, 2, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	check_received(0, 2);
+
+	/**TESTPOINT: put and get across the end of the ring buffer */
+	ret = k_msgq_put_many(q, &send_buf[4], 2, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+
+	ret = k_msgq_get_many(q, rec_buf, ARRAY_SIZE(rec_buf), K_NO_WAIT);
+	zassert_equal(ret, BATCH_LEN, NULL);
+	check_received(2, BATCH_LEN);
+
+	/**TESTPOINT: mix with single message calls */
+	ret = k_msgq_put(q, &send_buf[0], K_NO_WAIT);
+	zassert_equal(ret, 0, NULL);
+	ret = k_msgq_put_many(q, &send_buf[1], 2, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	ret = k_msgq_get(q, rec_buf, K_NO_WAIT);
+	zassert_equal(ret, 0, NULL);
+	ret = k_msgq_get_many(q, &rec_buf[1], BATCH_LEN, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	check_received(0, 3);
+
+	zassert_equal(k_msgq_put_many(q, send_buf, 0, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_get_many(q, rec_buf, 0, K_NO_WAIT), 0, NULL);
+}
+
+static void pend_put_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_put_many((struct k_msgq *)p1, &send_buf[5],
+				  BATCH_LEN, TIMEOUT);
+
+	zassert_equal(ret, 1, NULL);
+}
+
+static void pend_get_entry(void *p1, void *p2, void *p3)
+{
+	int ret = k_msgq_get_many((struct k_msgq *)p1, rec_buf, BATCH_LEN,
+				  TIMEOUT);
+
+	zassert_equal(ret, 1, NULL);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test sending and receiving several messages at once
+ *
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_put_get_many(void)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+
+	put_get_many(&msgq);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test sending and receiving several messages at once
+ *
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_user_put_get_many(void)
+{
+	struct k_msgq *q;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, BATCH_LEN), NULL);
+
+	put_get_many(q);
+}
+#endif
+
+/**
+ * @brief Test waking up waiting threads with batch calls
+ *
+ * @details A receiver waiting on an empty queue gets the first message of
+ * a batch, and a sender waiting on a full queue gets its message in when
+ * a batch is received.
+ *
+ * @see k_msgq_put_many(), k_msgq_get_many()
+ */
+void test_msgq_many_pend_thread(void)
+{
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(send_buf); i++) {
+		send_buf[i] = i;
+	}
+
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, pend_get_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_msgq_put_many(&msgq, send_buf, 3, K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	check_received(0, 1);
+	zassert_equal(k_msgq_num_used_get(&msgq), 2, NULL);
+
+	ret = k_msgq_put_many(&msgq, &send_buf[3], 2, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, pend_put_entry, &msgq,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_msleep(TIMEOUT_MS >> 1);
+
+	ret = k_msgq_get_many(&msgq, rec_buf, 2, K_NO_WAIT);
+	zassert_equal(ret, 2, NULL);
+	check_received(1, 2);
+	k_thread_join(&tdata, K_FOREVER);
+
+	/* the waiting sender's message follows the queued ones */
+	ret = k_msgq_get_many(&msgq, rec_buf, ARRAY_SIZE(rec_buf), K_NO_WAIT);
+	zassert_equal(ret, 3, NULL);
+	check_received(3, 3);
+}
+
+/**
+ * @brief Test reading messages in place
+ *
+ * @see k_msgq_get_claim(), k_msgq_get_finish()
+ */
+void test_msgq_get_claim(void)
+{
+	uint32_t *msgs;
+	void *claimed;
+	int ret;
+
+	for (int i = 0; i < ARRAY_SIZE(send_buf); i++) {
+		send_buf[i] = i;
+	}
+
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+
+	zassert_equal(k_msgq_get_claim(&msgq, &claimed, BATCH_LEN), -ENOMSG,
+		      NULL);
+	zassert_equal(k_msgq_get_finish(&msgq, 0), -EINVAL, NULL);
+
+	/* leave the read position in the middle of the ring buffer */
+	zassert_equal(k_msgq_put_many(&msgq, send_buf, 3, K_NO_WAIT), 3, NULL);
+	zassert_equal(k_msgq_get_many(&msgq, rec_buf, 3, K_NO_WAIT), 3, NULL);
+	zassert_equal(k_msgq_put_many(&msgq, send_buf, BATCH_LEN, K_NO_WAIT),
+		      BATCH_LEN, NULL);
+
+	/**TESTPOINT: claims stop at the end of the ring buffer */
+	ret = k_msgq_get_claim(&msgq, &claimed, BATCH_LEN);
+	zassert_equal(ret, 1, NULL);
+	zassert_equal(*(uint32_t *)claimed, 0, NULL);
+
+	/**TESTPOINT: the queue can't be read otherwise during a claim */
+	zassert_equal(k_msgq_get_claim(&msgq, &claimed, 1), -EBUSY, NULL);
+	zassert_equal(k_msgq_get(&msgq, rec_buf, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_get_many(&msgq, rec_buf, 1, K_NO_WAIT), -EBUSY,
+		      NULL);
+	zassert_equal(k_msgq_peek(&msgq, rec_buf), -EBUSY, NULL);
+	zassert_equal(k_msgq_get_finish(&msgq, 2), -EINVAL, NULL);
+
+	zassert_equal(k_msgq_get_finish(&msgq, 1), 0, NULL);
+
+	ret = k_msgq_get_claim(&msgq, &claimed, BATCH_LEN);
+	zassert_equal(ret, 3, NULL);
+	msgs = claimed;
+	for (int i = 0; i < ret; i++) {
+		zassert_equal(msgs[i], i + 1, NULL);
+	}
+
+	/**TESTPOINT: messages not released stay in the queue */
+	zassert_equal(k_msgq_get_finish(&msgq, 1), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 2, NULL);
+	zassert_equal(k_msgq_get_many(&msgq, rec_buf, BATCH_LEN, K_NO_WAIT), 2,
+		      NULL);
+	check_received(2, 2);
+
+	/**TESTPOINT: purge ends a claim */
+	zassert_equal(k_msgq_put(&msgq, send_buf, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_get_claim(&msgq, &claimed, 1), 1, NULL);
+	k_msgq_purge(&msgq);
+	zassert_equal(k_msgq_get_finish(&msgq, 1), -EINVAL, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+}
+
+/**
+ * @}
+ */
@@ -62,7 +62,7 @@ ZTEST_BMEM SYS_MUTEX_DEFINE(mutex_2);
 ZTEST_BMEM SYS_MUTEX_DEFINE(mutex_3);
 ZTEST_BMEM SYS_MUTEX_DEFINE(mutex_4);
 
-#ifdef CONFIG_USERSPACE
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST_PATH)
 static SYS_MUTEX_DEFINE(no_access_mutex);
 #endif
 static ZTEST_BMEM SYS_MUTEX_DEFINE(not_my_mutex);
@@ -359,8 +359,10 @@ void test_supervisor_access(void)
 {
 	int rv;
 
-#ifdef CONFIG_USERSPACE
-	/* coverage for get_k_mutex checks */
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST_PATH)
+	/* coverage for get_k_mutex checks, the fast path would dereference
+	 * these pointers
+	 */
 	rv = sys_mutex_lock((struct sys_mutex *)NULL, K_NO_WAIT);
 	zassert_true(rv == -EINVAL, "accepted bad mutex pointer");
 	rv = sys_mutex_lock((struct sys_mutex *)k_current_get(), K_NO_WAIT);
@@ -379,7 +381,8 @@ void test_supervisor_access(void)
 
 void test_user_access(void)
 {
-#ifdef CONFIG_USERSPACE
+	/* The fast path faults on memory outside of the domain */
+#if defined(CONFIG_USERSPACE) && !defined(CONFIG_SYS_MUTEX_FAST_PATH)
 	int rv;
 
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
@@ -27,6 +27,8 @@ extern void test_pipe_alloc(void);
 extern void test_pipe_reader_wait(void);
 extern void test_pipe_block_writer_wait(void);
 extern void test_pipe_cleanup(void);
+extern void test_pipe_claim_put_get(void);
+extern void test_pipe_claim_wait(void);
 #ifdef CONFIG_USERSPACE
 extern void test_pipe_user_thread2thread(void);
 extern void test_pipe_user_put_fail(void);
@@ -114,6 +116,8 @@ void test_main(void)
 			 ztest_unit_test(test_pipe_avail_w_lt_r),
 			 ztest_unit_test(test_pipe_avail_r_eq_w_full),
 			 ztest_unit_test(test_pipe_avail_r_eq_w_empty),
-			 ztest_unit_test(test_pipe_avail_no_buffer));
+			 ztest_unit_test(test_pipe_avail_no_buffer),
+			 ztest_unit_test(test_pipe_claim_put_get),
+			 ztest_1cpu_unit_test(test_pipe_claim_wait));
 	ztest_run_test_suite(pipe_api);
 }
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for writing and reading a pipe in place
+ * @ingroup kernel_pipe_tests
+ * @{
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define CLAIM_PIPE_LEN	16
+
+static unsigned char __aligned(4) claim_buf[CLAIM_PIPE_LEN];
+static struct k_pipe claim_pipe;
+static struct k_pipe claim_bufferless;
+
+static const unsigned char data[] = "0123456789abcdef";
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+
+/**
+ * @brief Test claiming space and data of a pipe's buffer
+ *
+ * Claims must return contiguous regions of the buffer, and be mixed with
+ * copying reads and writes as the data stays in order.
+ */
+void test_pipe_claim_put_get(void)
+{
+	unsigned char rx[CLAIM_PIPE_LEN];
+	size_t claimed, xferd;
+	void *ptr;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+	k_pipe_init(&claim_bufferless, NULL, 0);
+
+	/* move both indexes to the middle of the buffer */
+	zassert_ok(k_pipe_put(&claim_pipe, (void *)data, 10, &xferd, 10,
+			      K_NO_WAIT), NULL);
+	zassert_ok(k_pipe_get(&claim_pipe, rx, 10, &xferd, 10, K_NO_WAIT),
+		   NULL);
+
+	/**TESTPOINT: claims stop at the end of the buffer */
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &ptr, CLAIM_PIPE_LEN,
+				    &claimed, K_NO_WAIT), NULL);
+	zassert_equal(claimed, CLAIM_PIPE_LEN - 10, NULL);
+	zassert_equal(ptr, &claim_buf[10], NULL);
+	memcpy(ptr, data, claimed);
+
+	/**TESTPOINT: a single write claim at a time */
+	zassert_equal(k_pipe_put_claim(&claim_pipe, &ptr, 1, &claimed,
+				       K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_pipe_put(&claim_pipe, (void *)data, 1, &xferd, 1,
+				 K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 7), -EINVAL, NULL);
+
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 6), NULL);
+	zassert_equal(k_pipe_put_finish(&claim_pipe, 0), -EINVAL, NULL);
+
+	/**TESTPOINT: only the bytes committed are added */
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &ptr, CLAIM_PIPE_LEN,
+				    &claimed, K_NO_WAIT), NULL);
+	zassert_equal(claimed, 10, NULL);
+	zassert_equal(ptr, &claim_buf[0], NULL);
+	memcpy(ptr, &data[6], 4);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, 4), NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 10, NULL);
+
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &ptr, CLAIM_PIPE_LEN,
+				    &claimed, K_NO_WAIT), NULL);
+	zassert_equal(claimed, 6, NULL);
+	zassert_mem_equal(ptr, data, claimed, NULL);
+
+	/**TESTPOINT: a single read claim at a time */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &ptr, 1, &claimed,
+				       K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_pipe_get(&claim_pipe, rx, 1, &xferd, 1, K_NO_WAIT),
+		      -EBUSY, NULL);
+
+	/**TESTPOINT: writing is not affected by a read claim */
+	zassert_ok(k_pipe_put(&claim_pipe, (void *)&data[10], 2, &xferd, 2,
+			      K_NO_WAIT), NULL);
+
+	/**TESTPOINT: bytes not released stay at the head of the pipe */
+	zassert_ok(k_pipe_get_finish(&claim_pipe, 2), NULL);
+	zassert_ok(k_pipe_get(&claim_pipe, rx, sizeof(rx), &xferd, 10,
+			      K_NO_WAIT), NULL);
+	zassert_mem_equal(rx, &data[2], 10, NULL);
+
+	/**TESTPOINT: nothing to claim */
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &ptr, 1, &claimed,
+				       K_NO_WAIT), -EIO, NULL);
+	zassert_equal(k_pipe_get_claim(&claim_pipe, &ptr, 1, &claimed,
+				       K_MSEC(10)), -EAGAIN, NULL);
+	zassert_equal(k_pipe_put_claim(&claim_bufferless, &ptr, 1, &claimed,
+				       K_FOREVER), -EIO, NULL);
+
+	/**TESTPOINT: flushing ends a read claim */
+	zassert_ok(k_pipe_put(&claim_pipe, (void *)data, 4, &xferd, 4,
+			      K_NO_WAIT), NULL);
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &ptr, 4, &claimed,
+				    K_NO_WAIT), NULL);
+	k_pipe_flush(&claim_pipe);
+	zassert_equal(k_pipe_get_finish(&claim_pipe, claimed), -EINVAL, NULL);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+}
+
+static void thread_get_claim(void *p1, void *p2, void *p3)
+{
+	size_t claimed;
+	void *ptr;
+
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &ptr, CLAIM_PIPE_LEN,
+				    &claimed, K_FOREVER), NULL);
+	zassert_equal(claimed, 4, NULL);
+	zassert_mem_equal(ptr, data, claimed, NULL);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, claimed), NULL);
+}
+
+static void thread_get(void *p1, void *p2, void *p3)
+{
+	unsigned char rx[8];
+	size_t xferd;
+
+	zassert_ok(k_pipe_get(&claim_pipe, rx, sizeof(rx), &xferd, sizeof(rx),
+			      K_FOREVER), NULL);
+	zassert_mem_equal(rx, data, sizeof(rx), NULL);
+}
+
+static void thread_put(void *p1, void *p2, void *p3)
+{
+	size_t xferd;
+
+	zassert_ok(k_pipe_put(&claim_pipe, (void *)data, 8, &xferd, 8,
+			      K_FOREVER), NULL);
+}
+
+static void run_waiter(k_thread_entry_t entry)
+{
+	k_thread_create(&tdata, tstack, STACK_SIZE, entry, NULL, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	k_sleep(K_MSEC(50));
+}
+
+/**
+ * @brief Test waking up threads waiting on a pipe with claims
+ *
+ * A claim waits for the other side of the pipe, and committing or
+ * releasing a claim completes the requests of waiting threads.
+ */
+void test_pipe_claim_wait(void)
+{
+	size_t claimed, xferd;
+	void *ptr;
+
+	k_pipe_init(&claim_pipe, claim_buf, sizeof(claim_buf));
+
+	/**TESTPOINT: a waiting read claim is woken up by a write */
+	run_waiter(thread_get_claim);
+	zassert_ok(k_pipe_put(&claim_pipe, (void *)data, 4, &xferd, 4,
+			      K_NO_WAIT), NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+
+	/**TESTPOINT: committing completes a waiting reader */
+	run_waiter(thread_get);
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &ptr, 4, &claimed,
+				    K_NO_WAIT), NULL);
+	zassert_equal(claimed, 4, NULL);
+	memcpy(ptr, data, claimed);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, claimed), NULL);
+	zassert_ok(k_pipe_put_claim(&claim_pipe, &ptr, 4, &claimed,
+				    K_NO_WAIT), NULL);
+	zassert_equal(claimed, 4, NULL);
+	memcpy(ptr, &data[4], claimed);
+	zassert_ok(k_pipe_put_finish(&claim_pipe, claimed), NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), 0, NULL);
+
+	/**TESTPOINT: releasing makes room for a waiting writer */
+	zassert_ok(k_pipe_put(&claim_pipe, (void *)data, CLAIM_PIPE_LEN,
+			      &xferd, CLAIM_PIPE_LEN, K_NO_WAIT), NULL);
+	run_waiter(thread_put);
+	/* the data wraps around: the first claim stops at the end */
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &ptr, 8, &claimed,
+				    K_NO_WAIT), NULL);
+	zassert_equal(claimed, 4, NULL);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, claimed), NULL);
+	zassert_ok(k_pipe_get_claim(&claim_pipe, &ptr, 4, &claimed,
+				    K_NO_WAIT), NULL);
+	zassert_equal(claimed, 4, NULL);
+	zassert_ok(k_pipe_get_finish(&claim_pipe, claimed), NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(&claim_pipe), CLAIM_PIPE_LEN, NULL);
+	k_pipe_flush(&claim_pipe);
+}
+
+/**
+ * @}
+ */
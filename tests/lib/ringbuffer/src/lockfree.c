@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <ztest.h>
+#include <ztress.h>
+#include <sys/spsc_ring.h>
+#include <sys/mpmc_queue.h>
+
+#define QUEUE_CAPACITY 8
+
+static struct spsc_ring spsc;
+static uint8_t spsc_data[32];
+
+static struct mpmc_queue mpmc;
+static atomic_t mpmc_data[MPMC_QUEUE_BUF_SIZE(sizeof(uint32_t),
+					      QUEUE_CAPACITY) /
+			  sizeof(atomic_t)];
+
+SPSC_RING_DEFINE(spsc_defined, 64);
+
+void test_spsc_ring_put_get(void)
+{
+	uint8_t in[24], out[24];
+	uint8_t *data;
+	uint32_t len;
+
+	spsc_ring_init(&spsc, sizeof(spsc_data), spsc_data);
+	zassert_equal(spsc_ring_capacity_get(&spsc), sizeof(spsc_data), NULL);
+	zassert_equal(spsc_ring_capacity_get(&spsc_defined), 64, NULL);
+
+	for (int i = 0; i < sizeof(in); i++) {
+		in[i] = i;
+	}
+
+	/* Go around the ring a few times to exercise the wrap */
+	for (int i = 0; i < 4; i++) {
+		zassert_equal(spsc_ring_put(&spsc, in, sizeof(in)), sizeof(in),
+			      NULL);
+		zassert_equal(spsc_ring_size_get(&spsc), sizeof(in), NULL);
+		zassert_equal(spsc_ring_put(&spsc, in, sizeof(in)),
+			      sizeof(spsc_data) - sizeof(in), NULL);
+		zassert_equal(spsc_ring_space_get(&spsc), 0, NULL);
+
+		zassert_equal(spsc_ring_get(&spsc, out, sizeof(out)),
+			      sizeof(out), NULL);
+		zassert_equal(memcmp(in, out, sizeof(out)), 0, NULL);
+
+		len = spsc_ring_get_claim(&spsc, &data, sizeof(spsc_data));
+		zassert_true(len > 0, NULL);
+		spsc_ring_get_finish(&spsc, len);
+		len = spsc_ring_get(&spsc, out, sizeof(out));
+		zassert_equal(spsc_ring_size_get(&spsc), 0, NULL);
+	}
+
+	/* Claims are contiguous */
+	len = spsc_ring_put_claim(&spsc, &data, sizeof(spsc_data));
+	zassert_true(data + len <= spsc_data + sizeof(spsc_data), NULL);
+	spsc_ring_put_finish(&spsc, 0);
+}
+
+void test_mpmc_queue_put_get(void)
+{
+	uint32_t val;
+	void *item;
+	int i;
+
+	zassert_equal(mpmc_queue_init(&mpmc, mpmc_data, sizeof(val), 3),
+		      -EINVAL, "capacity not a power of two accepted");
+	zassert_equal(mpmc_queue_init(&mpmc, mpmc_data, sizeof(val),
+				      QUEUE_CAPACITY), 0, NULL);
+
+	zassert_equal(mpmc_queue_get(&mpmc, &val, sizeof(val)), -EAGAIN, NULL);
+
+	for (i = 0; i < QUEUE_CAPACITY; i++) {
+		val = i;
+		zassert_equal(mpmc_queue_put(&mpmc, &val, sizeof(val)), 0,
+			      NULL);
+	}
+	zassert_equal(mpmc_queue_put(&mpmc, &val, sizeof(val)), -ENOMEM,
+		      NULL);
+
+	/* A claimed item keeps its slot until finished */
+	zassert_equal(mpmc_queue_get_claim(&mpmc, &item), 0, NULL);
+	zassert_equal(*(uint32_t *)item, 0, NULL);
+	zassert_equal(mpmc_queue_put(&mpmc, &val, sizeof(val)), -ENOMEM,
+		      NULL);
+	mpmc_queue_get_finish(&mpmc, item);
+
+	zassert_equal(mpmc_queue_put_claim(&mpmc, &item), 0, NULL);
+	*(uint32_t *)item = QUEUE_CAPACITY;
+	mpmc_queue_put_finish(&mpmc, item);
+
+	for (i = 1; i <= QUEUE_CAPACITY; i++) {
+		zassert_equal(mpmc_queue_get(&mpmc, &val, sizeof(val)), 0,
+			      NULL);
+		zassert_equal(val, i, NULL);
+	}
+	zassert_equal(mpmc_queue_get(&mpmc, &val, sizeof(val)), -EAGAIN, NULL);
+}
+
+static uint32_t spsc_put_cnt;
+static uint32_t spsc_get_cnt;
+
+static bool spsc_produce(void *user_data, uint32_t iter_cnt, bool last,
+			 int prio)
+{
+	uint8_t *data;
+	uint32_t len;
+
+	len = spsc_ring_put_claim(&spsc, &data, 7);
+	for (uint32_t i = 0; i < len; i++) {
+		data[i] = spsc_put_cnt++;
+	}
+	spsc_ring_put_finish(&spsc, len);
+
+	return true;
+}
+
+static bool spsc_consume(void *user_data, uint32_t iter_cnt, bool last,
+			 int prio)
+{
+	uint8_t data[5];
+	uint32_t len;
+
+	len = spsc_ring_get(&spsc, data, sizeof(data));
+	for (uint32_t i = 0; i < len; i++) {
+		zassert_equal(data[i], (uint8_t)spsc_get_cnt,
+			      "Got %02x, exp: %02x", data[i],
+			      (uint8_t)spsc_get_cnt);
+		spsc_get_cnt++;
+	}
+
+	return true;
+}
+
+static uint32_t mpmc_put_cnt[2];
+static atomic_t mpmc_put_sum;
+static atomic_t mpmc_get_sum;
+
+/* Consumers can be preempted between taking an item and checking it, so
+ * the order of the items is not checked; the sums of the values put and
+ * got must match once the queue is drained.
+ */
+static bool mpmc_produce(void *user_data, uint32_t iter_cnt, bool last,
+			 int prio)
+{
+	uint32_t id = POINTER_TO_UINT(user_data);
+	uint32_t val = mpmc_put_cnt[id] + 1;
+
+	if (mpmc_queue_put(&mpmc, &val, sizeof(val)) == 0) {
+		mpmc_put_cnt[id]++;
+		atomic_add(&mpmc_put_sum, val);
+	}
+
+	return true;
+}
+
+static bool mpmc_consume(void *user_data, uint32_t iter_cnt, bool last,
+			 int prio)
+{
+	void *item;
+
+	if (mpmc_queue_get_claim(&mpmc, &item) == 0) {
+		atomic_add(&mpmc_get_sum, *(uint32_t *)item);
+		mpmc_queue_get_finish(&mpmc, item);
+	}
+
+	return true;
+}
+
+static void lockfree_ztress(ztress_handler high, ztress_handler low,
+			    void *high_data, void *low_data)
+{
+	k_timeout_t timeout;
+
+	timeout = (CONFIG_SYS_CLOCK_TICKS_PER_SEC < 10000) ? K_MSEC(1000) :
+							     K_MSEC(10000);
+
+	ztress_set_timeout(timeout);
+	ZTRESS_EXECUTE(ZTRESS_THREAD(high, high_data, 0, 0, Z_TIMEOUT_TICKS(20)),
+		       ZTRESS_THREAD(low, low_data, 0, 2000, Z_TIMEOUT_TICKS(20)));
+}
+
+/* Single producer, single consumer from different priorities */
+void test_spsc_ring_stress(void)
+{
+	spsc_ring_init(&spsc, sizeof(spsc_data), spsc_data);
+	spsc_put_cnt = 0;
+	spsc_get_cnt = 0;
+	lockfree_ztress(spsc_produce, spsc_consume, NULL, NULL);
+
+	spsc_ring_init(&spsc, sizeof(spsc_data), spsc_data);
+	spsc_put_cnt = 0;
+	spsc_get_cnt = 0;
+	lockfree_ztress(spsc_consume, spsc_produce, NULL, NULL);
+}
+
+/* Producers from different priorities, consumers from the same contexts */
+static bool mpmc_produce_consume(void *user_data, uint32_t iter_cnt,
+				 bool last, int prio)
+{
+	mpmc_produce(user_data, iter_cnt, last, prio);
+
+	return mpmc_consume(user_data, iter_cnt, last, prio);
+}
+
+void test_mpmc_queue_stress(void)
+{
+	uint32_t val;
+
+	zassert_equal(mpmc_queue_init(&mpmc, mpmc_data, sizeof(uint32_t),
+				      QUEUE_CAPACITY), 0, NULL);
+	memset(mpmc_put_cnt, 0, sizeof(mpmc_put_cnt));
+	atomic_set(&mpmc_put_sum, 0);
+	atomic_set(&mpmc_get_sum, 0);
+
+	lockfree_ztress(mpmc_produce_consume, mpmc_produce_consume,
+			UINT_TO_POINTER(0), UINT_TO_POINTER(1));
+
+	while (mpmc_queue_get(&mpmc, &val, sizeof(val)) == 0) {
+		atomic_add(&mpmc_get_sum, val);
+	}
+
+	zassert_equal(atomic_get(&mpmc_get_sum), atomic_get(&mpmc_put_sum),
+		      "items lost or duplicated");
+}
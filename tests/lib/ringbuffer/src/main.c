@@ -42,6 +42,10 @@ extern void test_ringbuffer_concurrent(void);
 extern void test_ringbuffer_zerocpy_stress(void);
 extern void test_ringbuffer_cpy_stress(void);
 extern void test_ringbuffer_item_stress(void);
+extern void test_spsc_ring_put_get(void);
+extern void test_spsc_ring_stress(void);
+extern void test_mpmc_queue_put_get(void);
+extern void test_mpmc_queue_stress(void);
 /**
  * @brief Test APIs of ring buffer
  *
@@ -1031,7 +1035,11 @@ void test_main(void)
 		       ztest_unit_test(test_ringbuffer_concurrent),
 		       ztest_unit_test(test_ringbuffer_zerocpy_stress),
 		       ztest_unit_test(test_ringbuffer_cpy_stress),
-		       ztest_unit_test(test_ringbuffer_item_stress)
+		       ztest_unit_test(test_ringbuffer_item_stress),
+		       ztest_unit_test(test_spsc_ring_put_get),
+		       ztest_unit_test(test_spsc_ring_stress),
+		       ztest_unit_test(test_mpmc_queue_put_get),
+		       ztest_unit_test(test_mpmc_queue_stress)
 		);
 	ztest_run_test_suite(test_ringbuffer_api);
 }
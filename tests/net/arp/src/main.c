@@ -45,6 +45,14 @@ static struct net_eth_addr hwaddr = { { 0x42, 0x11, 0x69, 0xde, 0xfa, 0xec } };
 
 static int send_status = -EINVAL;
 
+/* IPv4 packets sent by the interface, in order */
+#define MAX_SENT_PKTS 16
+static struct net_pkt *sent_pkts[MAX_SENT_PKTS];
+static int nb_sent_pkts;
+
+#define NB_HOSTS CONFIG_NET_ARP_TABLE_SIZE
+#define BENCH_ROUNDS 100
+
 struct net_arp_context {
 	uint8_t mac_addr[sizeof(struct net_eth_addr)];
 	struct net_linkaddr ll_addr;
@@ -142,6 +150,9 @@ static int tester_send(const struct device *dev, struct net_pkt *pkt)
 				return send_status;
 			}
 		}
+	} else if (ntohs(hdr->type) == NET_ETH_PTYPE_IP &&
+		   nb_sent_pkts < MAX_SENT_PKTS) {
+		sent_pkts[nb_sent_pkts++] = pkt;
 	}
 
 	send_status = 0;
@@ -647,9 +658,265 @@ void test_arp(void)
 	}
 }
 
+static struct net_pkt *prepare_ipv4_pkt(struct net_if *iface,
+					struct in_addr *dst)
+{
+	struct net_pkt *pkt;
+	struct net_ipv4_hdr *ipv4;
+	int len = strlen(app_data);
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_ipv4_hdr) +
+					len, AF_INET, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem");
+
+	ipv4 = (struct net_ipv4_hdr *)net_buf_add(pkt->buffer,
+						  sizeof(struct net_ipv4_hdr));
+	net_ipv4_addr_copy_raw(ipv4->src, (uint8_t *)if_get_addr(iface));
+	net_ipv4_addr_copy_raw(ipv4->dst, (uint8_t *)dst);
+
+	memcpy(net_buf_add(pkt->buffer, len), app_data, len);
+
+	return pkt;
+}
+
+/* Feed an ARP packet from a host to us */
+static void feed_arp(struct net_if *iface, uint16_t opcode,
+		     struct in_addr *host, struct net_eth_addr *host_hwaddr)
+{
+	struct net_eth_hdr *eth_hdr;
+	struct net_arp_hdr *arp_hdr;
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(struct net_eth_hdr) +
+					sizeof(struct net_arp_hdr),
+					AF_UNSPEC, 0, K_SECONDS(1));
+	zassert_not_null(pkt, "out of mem request");
+
+	setup_eth_header(iface, pkt, net_eth_broadcast_addr(),
+			 NET_ETH_PTYPE_ARP);
+
+	eth_hdr = (struct net_eth_hdr *)net_pkt_data(pkt);
+	memcpy(&eth_hdr->src, host_hwaddr, sizeof(struct net_eth_addr));
+
+	net_buf_add(pkt->buffer, sizeof(struct net_eth_hdr));
+	net_buf_pull(pkt->buffer, sizeof(struct net_eth_hdr));
+	arp_hdr = NET_ARP_HDR(pkt);
+
+	arp_hdr->hwtype = htons(NET_ARP_HTYPE_ETH);
+	arp_hdr->protocol = htons(NET_ETH_PTYPE_IP);
+	arp_hdr->hwlen = sizeof(struct net_eth_addr);
+	arp_hdr->protolen = sizeof(struct in_addr);
+	arp_hdr->opcode = htons(opcode);
+	memcpy(&arp_hdr->src_hwaddr, host_hwaddr, sizeof(struct net_eth_addr));
+	net_ipv4_addr_copy_raw(arp_hdr->src_ipaddr, (uint8_t *)host);
+	net_ipv4_addr_copy_raw(arp_hdr->dst_ipaddr,
+			       (uint8_t *)if_get_addr(iface));
+
+	if (opcode == NET_ARP_REPLY) {
+		memcpy(&arp_hdr->dst_hwaddr, net_if_get_link_addr(iface)->addr,
+		       sizeof(struct net_eth_addr));
+	} else {
+		(void)memset(&arp_hdr->dst_hwaddr, 0,
+			     sizeof(struct net_eth_addr));
+	}
+
+	net_buf_add(pkt->buffer, sizeof(struct net_arp_hdr));
+
+	zassert_equal(net_arp_input(pkt, eth_hdr), NET_OK,
+		      "ARP packet dropped");
+
+	/* Yielding so that network interface TX thread can proceed. */
+	k_yield();
+}
+
+static void host_addr(int i, struct in_addr *addr,
+		      struct net_eth_addr *host_hwaddr)
+{
+	struct in_addr base = { { { 192, 168, 0, 100 } } };
+	struct net_eth_addr base_hwaddr = {
+		{ 0x02, 0x00, 0x5E, 0x00, 0x53, 0x00 }
+	};
+
+	net_ipaddr_copy(addr, &base);
+	addr->s4_addr[3] += i;
+
+	if (host_hwaddr) {
+		memcpy(host_hwaddr, &base_hwaddr, sizeof(base_hwaddr));
+		host_hwaddr->addr[5] += i;
+	}
+}
+
+void test_arp_pending_queue(void)
+{
+	struct net_pkt *pkts[CONFIG_NET_ARP_MAX_PENDING_PKTS + 1];
+	struct net_eth_addr host_hwaddr;
+	struct net_if *iface;
+	struct net_pkt *req;
+	struct in_addr host;
+	int i;
+
+	if (CONFIG_NET_ARP_MAX_PENDING_PKTS < 2) {
+		ztest_test_skip();
+		return;
+	}
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_arp_test));
+	req_test = true;
+
+	net_arp_clear_cache(NULL);
+	host_addr(0, &host, &host_hwaddr);
+
+	/* One more packet than there is room for */
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = prepare_ipv4_pkt(iface, &host);
+
+		req = net_arp_prepare(pkts[i], &host, NULL);
+		zassert_not_null(req, "No ARP request");
+		zassert_not_equal(req, pkts[i], "Address is not resolved");
+		net_pkt_unref(req);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		zassert_equal(atomic_get(&pkts[i]->atomic_ref),
+			      i < CONFIG_NET_ARP_MAX_PENDING_PKTS ? 2 : 1,
+			      "Wrong ref count of packet %d", i);
+	}
+
+	nb_sent_pkts = 0;
+
+	feed_arp(iface, NET_ARP_REPLY, &host, &host_hwaddr);
+
+	zassert_equal(nb_sent_pkts, CONFIG_NET_ARP_MAX_PENDING_PKTS,
+		      "Pending packets not sent");
+
+	for (i = 0; i < ARRAY_SIZE(pkts); i++) {
+		if (i < CONFIG_NET_ARP_MAX_PENDING_PKTS) {
+			zassert_equal(sent_pkts[i], pkts[i],
+				      "Packet %d sent out of order", i);
+		}
+
+		zassert_equal(atomic_get(&pkts[i]->atomic_ref), 1,
+			      "ARP cache still owns packet %d", i);
+		net_pkt_unref(pkts[i]);
+	}
+}
+
+void test_arp_ageing(void)
+{
+	struct net_eth_addr host_hwaddr;
+	struct net_if *iface;
+	struct net_pkt *pkt, *req;
+	struct in_addr host;
+
+	if (CONFIG_NET_ARP_ENTRY_TIMEOUT == 0 ||
+	    CONFIG_NET_ARP_ENTRY_TIMEOUT > 2) {
+		ztest_test_skip();
+		return;
+	}
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_arp_test));
+	req_test = true;
+
+	net_arp_clear_cache(NULL);
+	host_addr(1, &host, &host_hwaddr);
+
+	/* An ARP request from the host adds it to the cache */
+	feed_arp(iface, NET_ARP_REQUEST, &host, &host_hwaddr);
+
+	pkt = prepare_ipv4_pkt(iface, &host);
+
+	zassert_equal(net_arp_prepare(pkt, &host, NULL), pkt,
+		      "Host not in ARP cache");
+
+	k_msleep(CONFIG_NET_ARP_ENTRY_TIMEOUT * MSEC_PER_SEC + 100);
+
+	req = net_arp_prepare(pkt, &host, NULL);
+	zassert_not_null(req, "No ARP request");
+	zassert_not_equal(req, pkt, "Entry did not expire");
+	net_pkt_unref(req);
+
+	net_arp_clear_cache(NULL);
+
+	zassert_equal(atomic_get(&pkt->atomic_ref), 1,
+		      "ARP cache still owns the packet");
+	net_pkt_unref(pkt);
+}
+
+static void count_cb(struct arp_entry *entry, void *user_data)
+{
+	int *count = user_data;
+
+	(*count)++;
+}
+
+void test_arp_many_hosts(void)
+{
+	struct net_eth_addr host_hwaddr;
+	struct net_if *iface;
+	struct net_pkt *pkt;
+	struct in_addr host;
+	uint32_t start, cycles;
+	int misses = 0;
+	int count = 0;
+	int i, round;
+
+	iface = net_if_lookup_by_dev(DEVICE_GET(net_arp_test));
+	req_test = true;
+
+	net_arp_clear_cache(NULL);
+
+	/* Fill the whole cache from ARP requests of the hosts */
+	for (i = 0; i < NB_HOSTS; i++) {
+		host_addr(i, &host, &host_hwaddr);
+		feed_arp(iface, NET_ARP_REQUEST, &host, &host_hwaddr);
+	}
+
+	net_arp_foreach(count_cb, &count);
+	zassert_equal(count, NB_HOSTS, "Hosts missing from ARP cache");
+
+	pkt = prepare_ipv4_pkt(iface, &host);
+
+	for (i = 0; i < NB_HOSTS; i++) {
+		host_addr(i, &host, &host_hwaddr);
+
+		zassert_equal(net_arp_prepare(pkt, &host, NULL), pkt,
+			      "Host %d not in ARP cache", i);
+		zassert_mem_equal(net_pkt_lladdr_dst(pkt)->addr, &host_hwaddr,
+				  sizeof(host_hwaddr),
+				  "Wrong hwaddr for host %d", i);
+	}
+
+	start = k_cycle_get_32();
+
+	for (round = 0; round < BENCH_ROUNDS; round++) {
+		for (i = 0; i < NB_HOSTS; i++) {
+			host_addr(i, &host, NULL);
+
+			if (net_arp_prepare(pkt, &host, NULL) != pkt) {
+				misses++;
+			}
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(misses, 0, "ARP cache misses");
+
+	TC_PRINT("%d hosts, %d hash buckets: %u cycles, %llu ns per lookup\n",
+		 NB_HOSTS, CONFIG_NET_ARP_HASH_SIZE,
+		 cycles / (NB_HOSTS * BENCH_ROUNDS),
+		 k_cyc_to_ns_floor64(cycles) / (NB_HOSTS * BENCH_ROUNDS));
+
+	net_pkt_unref(pkt);
+	net_arp_clear_cache(NULL);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_arp_fn,
-		ztest_unit_test(test_arp));
+		ztest_unit_test(test_arp),
+		ztest_unit_test(test_arp_pending_queue),
+		ztest_unit_test(test_arp_ageing),
+		ztest_unit_test(test_arp_many_hosts));
 	ztest_run_test_suite(test_arp_fn);
 }
@@ -31,10 +31,14 @@ LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
 struct eth_fake_context {
 	struct net_if *iface;
 	struct net_pkt *sent_pkt;
+	int sent_count;
 	uint8_t mac_address[6];
 	bool promisc_mode;
 };
 
+/* Only count sent packets instead of keeping them */
+static bool fake_count_only;
+
 static void eth_fake_iface_init(struct net_if *iface)
 {
 	const struct device *dev = net_if_get_device(iface);
@@ -71,6 +75,11 @@ static int eth_fake_send(const struct device *dev,
 		return 0;
 	}
 
+	ctx->sent_count++;
+	if (fake_count_only) {
+		return 0;
+	}
+
 	if (ctx->sent_pkt != NULL) {
 		DBG("Fake send found pkt %p while sending %p\n",
 		    ctx->sent_pkt, pkt);
@@ -217,10 +226,37 @@ static void test_iface_setup(void)
 	get_free_packet_count();
 }
 
+/*
+ * The source and destination MAC addresses are completely arbitrary
+ * except for the U/L and I/G bits. However, the index of the faked
+ * incoming interface is mixed in as well to create some variation,
+ * and to help with validation on the transmit side.
+ */
+static void make_src_addr(struct net_if *iface, struct net_eth_addr *addr)
+{
+	addr->addr[0] = 0xa2;
+	addr->addr[1] = 0x11;
+	addr->addr[2] = 0x22;
+	addr->addr[3] = net_if_get_by_iface(iface);
+	addr->addr[4] = 0x77;
+	addr->addr[5] = 0x88;
+}
+
+static void make_dst_addr(struct net_if *iface, struct net_eth_addr *addr)
+{
+	addr->addr[0] = 0xb2;
+	addr->addr[1] = 0x11;
+	addr->addr[2] = 0x22;
+	addr->addr[3] = 0x33;
+	addr->addr[4] = net_if_get_by_iface(iface);
+	addr->addr[5] = 0x55;
+}
+
 /*
  * Simulate a packet reception from the outside world
  */
-static void _recv_data(struct net_if *iface)
+static void _recv_data_addr(struct net_if *iface, struct net_eth_addr *src,
+			    struct net_eth_addr *dst)
 {
 	struct net_pkt *pkt;
 	struct net_eth_hdr eth_hdr;
@@ -231,27 +267,8 @@ static void _recv_data(struct net_if *iface)
 					   AF_UNSPEC, 0, K_FOREVER);
 	zassert_not_null(pkt, "");
 
-	/*
-	 * The source and destination MAC addresses are completely arbitrary
-	 * except for the U/L and I/G bits. However, the index of the faked
-	 * incoming interface is mixed in as well to create some variation,
-	 * and to help with validation on the transmit side.
-	 */
-
-	eth_hdr.dst.addr[0] = 0xb2;
-	eth_hdr.dst.addr[1] = 0x11;
-	eth_hdr.dst.addr[2] = 0x22;
-	eth_hdr.dst.addr[3] = 0x33;
-	eth_hdr.dst.addr[4] = net_if_get_by_iface(iface);
-	eth_hdr.dst.addr[5] = 0x55;
-
-	eth_hdr.src.addr[0] = 0xa2;
-	eth_hdr.src.addr[1] = 0x11;
-	eth_hdr.src.addr[2] = 0x22;
-	eth_hdr.src.addr[3] = net_if_get_by_iface(iface);
-	eth_hdr.src.addr[4] = 0x77;
-	eth_hdr.src.addr[5] = 0x88;
-
+	eth_hdr.src = *src;
+	eth_hdr.dst = *dst;
 	eth_hdr.type = htons(NET_ETH_PTYPE_ALL);
 
 	ret = net_pkt_write(pkt, &eth_hdr, sizeof(eth_hdr));
@@ -265,6 +282,16 @@ static void _recv_data(struct net_if *iface)
 	zassert_equal(ret, 0, "");
 }
 
+static void _recv_data(struct net_if *iface)
+{
+	struct net_eth_addr src, dst;
+
+	make_src_addr(iface, &src);
+	make_dst_addr(iface, &dst);
+
+	_recv_data_addr(iface, &src, &dst);
+}
+
 static void test_recv_before_bridging(void)
 {
 	/* fake some packet reception */
@@ -352,6 +379,150 @@ static void test_recv_with_bridge(void)
 	check_free_packet_count();
 }
 
+static void release_sent_pkts(void)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(eth_fake_data); i++) {
+		if (eth_fake_data[i].sent_pkt != NULL) {
+			net_pkt_unref(eth_fake_data[i].sent_pkt);
+			eth_fake_data[i].sent_pkt = NULL;
+		}
+	}
+}
+
+static void test_fdb(void)
+{
+#if !defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	ztest_test_skip();
+#else
+	struct net_eth_addr src, dst, addr, unknown;
+	int ret;
+
+	/*
+	 * The source addresses of test_recv_with_bridge() have been
+	 * learned. A packet to an address on fake_iface[1], which may not
+	 * transmit, must not be flooded to fake_iface[2].
+	 */
+	make_src_addr(fake_iface[0], &src);
+	make_src_addr(fake_iface[1], &dst);
+	_recv_data_addr(fake_iface[0], &src, &dst);
+	k_sleep(K_MSEC(100));
+	zassert_is_null(eth_fake_data[2].sent_pkt, "");
+
+	/* A packet to an unknown address is flooded, its source learned */
+	make_src_addr(fake_iface[2], &addr);
+	addr.addr[5]++;
+	make_dst_addr(fake_iface[2], &unknown);
+	_recv_data_addr(fake_iface[2], &addr, &unknown);
+	k_sleep(K_MSEC(100));
+	zassert_not_null(eth_fake_data[0].sent_pkt, "");
+	release_sent_pkts();
+
+	/* A packet to an address on its own segment is not forwarded */
+	make_src_addr(fake_iface[2], &src);
+	_recv_data_addr(fake_iface[2], &src, &addr);
+	k_sleep(K_MSEC(100));
+	zassert_is_null(eth_fake_data[0].sent_pkt, "");
+
+	/* A static entry overrides learning */
+	ret = eth_bridge_fdb_add(&test_bridge, &addr, fake_iface[0]);
+	zassert_equal(ret, 0, "");
+
+	_recv_data_addr(fake_iface[2], &addr, &unknown);
+	k_sleep(K_MSEC(100));
+	release_sent_pkts();
+
+	_recv_data_addr(fake_iface[2], &src, &addr);
+	k_sleep(K_MSEC(100));
+	zassert_not_null(eth_fake_data[0].sent_pkt, "");
+	release_sent_pkts();
+
+	ret = eth_bridge_fdb_del(&test_bridge, &addr);
+	zassert_equal(ret, 0, "");
+	ret = eth_bridge_fdb_del(&test_bridge, &addr);
+	zassert_equal(ret, -ENOENT, "");
+
+	/* With learned entries flushed, packets are flooded again */
+	eth_bridge_fdb_flush(&test_bridge);
+
+	make_src_addr(fake_iface[0], &src);
+	_recv_data_addr(fake_iface[0], &src, &dst);
+	k_sleep(K_MSEC(100));
+	zassert_not_null(eth_fake_data[2].sent_pkt, "");
+	release_sent_pkts();
+
+	check_free_packet_count();
+#endif
+}
+
+#define TX_LOAD_PKT_COUNT 32
+
+static int count_sent_pkts(void)
+{
+	int i, count = 0;
+
+	for (i = 0; i < ARRAY_SIZE(eth_fake_data); i++) {
+		count += eth_fake_data[i].sent_count;
+		eth_fake_data[i].sent_count = 0;
+	}
+
+	return count;
+}
+
+static int send_tx_load_pkts(struct net_eth_addr *src,
+			     struct net_eth_addr *dst)
+{
+	int i;
+
+	(void)count_sent_pkts();
+
+	for (i = 0; i < TX_LOAD_PKT_COUNT; i++) {
+		_recv_data_addr(fake_iface[0], src, dst);
+		k_sleep(K_MSEC(10));
+	}
+
+	return count_sent_pkts();
+}
+
+static void test_fdb_tx_load(void)
+{
+#if !defined(CONFIG_NET_ETHERNET_BRIDGE_FDB)
+	ztest_test_skip();
+#else
+	struct net_eth_addr src, dst;
+	int flooded, forwarded;
+
+	fake_count_only = true;
+	eth_bridge_iface_allow_tx(fake_iface[1], true);
+	eth_bridge_fdb_flush(&test_bridge);
+
+	make_src_addr(fake_iface[0], &src);
+	make_src_addr(fake_iface[2], &dst);
+
+	/* Destination not known yet */
+	flooded = send_tx_load_pkts(&src, &dst);
+
+	/* Let the bridge learn the destination */
+	_recv_data_addr(fake_iface[2], &dst, &src);
+	k_sleep(K_MSEC(10));
+
+	forwarded = send_tx_load_pkts(&src, &dst);
+
+	TC_PRINT("%d packets to one of %zu ports: %d sent when flooded, "
+		 "%d sent when learned\n", TX_LOAD_PKT_COUNT,
+		 ARRAY_SIZE(fake_iface), flooded, forwarded);
+
+	zassert_equal(flooded, TX_LOAD_PKT_COUNT * 2, "");
+	zassert_equal(forwarded, TX_LOAD_PKT_COUNT, "");
+
+	eth_bridge_iface_allow_tx(fake_iface[1], false);
+	fake_count_only = false;
+
+	check_free_packet_count();
+#endif
+}
+
 static void test_recv_after_bridging(void)
 {
 	int ret;
@@ -375,6 +546,8 @@ void test_main(void)
 			 ztest_unit_test(test_recv_before_bridging),
 			 ztest_unit_test(test_setup_bridge),
 			 ztest_unit_test(test_recv_with_bridge),
+			 ztest_unit_test(test_fdb),
+			 ztest_unit_test(test_fdb_tx_load),
 			 ztest_unit_test(test_recv_after_bridging));
 
 	ztest_run_test_suite(net_eth_bridge_test);
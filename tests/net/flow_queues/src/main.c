@@ -0,0 +1,374 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TC_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+#include <linker/sections.h>
+
+#include <tc_util.h>
+#include <ztest.h>
+
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+#define TEST_PORT 4242
+#define FLOW_PORT_BASE 30000
+
+#define NUM_FLOWS 16
+#define PKTS_PER_FLOW 8
+
+#define PERF_PKTS_PER_FLOW 25
+/* Simulated processing time of each packet */
+#define PERF_WORK_US 50
+
+#define WAIT_TIME K_SECONDS(5)
+#define ALLOC_TIMEOUT K_MSEC(500)
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+struct flow_data {
+	uint16_t flow;
+	uint16_t seq;
+};
+
+struct flow_state {
+	k_tid_t thread;
+	uint16_t next_seq;
+};
+
+static struct net_if *iface1;
+static struct k_sem wait_data;
+
+static struct flow_state flows[NUM_FLOWS];
+static bool order_failed;
+static bool thread_failed;
+static int work_us;
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+/* Check that all the packets of a flow are handled in order by one thread */
+static void check_flow(struct flow_data *data)
+{
+	struct flow_state *state;
+
+	if (data->flow >= NUM_FLOWS) {
+		order_failed = true;
+		return;
+	}
+
+	state = &flows[data->flow];
+
+	if (data->seq != state->next_seq) {
+		order_failed = true;
+	}
+
+	state->next_seq = data->seq + 1;
+
+	if (state->thread == NULL) {
+		state->thread = k_current_get();
+	} else if (state->thread != k_current_get()) {
+		thread_failed = true;
+	}
+
+	if (work_us) {
+		k_busy_wait(work_us);
+	}
+
+	k_sem_give(&wait_data);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	NET_PKT_DATA_ACCESS_DEFINE(data_access, struct flow_data);
+	struct flow_data *data;
+
+	if (!pkt->buffer) {
+		return -ENODATA;
+	}
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (net_pkt_skip(pkt, NET_IPV4UDPH_LEN)) {
+		return -EINVAL;
+	}
+
+	data = (struct flow_data *)net_pkt_get_data(pkt, &data_access);
+	if (!data) {
+		return -EINVAL;
+	}
+
+	check_flow(data);
+
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_flow_queues_test, "flow_queues_test",
+		net_iface_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&net_iface_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), NET_IPV4_MTU);
+
+static enum net_verdict udp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	struct flow_data data;
+
+	if (net_pkt_read(pkt, &data, sizeof(data))) {
+		order_failed = true;
+	} else {
+		check_flow(&data);
+	}
+
+	net_pkt_unref(pkt);
+
+	return NET_OK;
+}
+
+static void test_setup(void)
+{
+	struct sockaddr local_addr = { 0 };
+	struct net_conn_handle *handle;
+	struct net_if_addr *ifaddr;
+	int ret;
+
+	k_sem_init(&wait_data, 0, UINT_MAX);
+
+	iface1 = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface1, "Interface");
+
+	ifaddr = net_if_ipv4_addr_add(iface1, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	net_if_up(iface1);
+
+	net_ipaddr_copy(&net_sin(&local_addr)->sin_addr, &my_addr);
+	local_addr.sa_family = AF_INET;
+
+	ret = net_udp_register(AF_INET, NULL, &local_addr, 0, TEST_PORT,
+			       NULL, udp_data_received, NULL, &handle);
+	zassert_equal(ret, 0, "Cannot register UDP handler");
+}
+
+static void reset_flows(void)
+{
+	memset(flows, 0, sizeof(flows));
+	order_failed = false;
+	thread_failed = false;
+}
+
+static struct net_pkt *create_pkt(bool rx, int flow, int seq)
+{
+	struct flow_data data = { .flow = flow, .seq = seq };
+	uint16_t port = FLOW_PORT_BASE + flow;
+	struct net_pkt *pkt;
+
+	if (rx) {
+		pkt = net_pkt_rx_alloc_with_buffer(iface1, sizeof(data),
+						   AF_INET, IPPROTO_UDP,
+						   ALLOC_TIMEOUT);
+	} else {
+		pkt = net_pkt_alloc_with_buffer(iface1, sizeof(data),
+						AF_INET, IPPROTO_UDP,
+						ALLOC_TIMEOUT);
+	}
+
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	if (rx) {
+		zassert_equal(net_ipv4_create(pkt, &peer_addr, &my_addr), 0,
+			      "Cannot create IPv4 header");
+		zassert_equal(net_udp_create(pkt, htons(port),
+					     htons(TEST_PORT)), 0,
+			      "Cannot create UDP header");
+	} else {
+		zassert_equal(net_ipv4_create(pkt, &my_addr, &peer_addr), 0,
+			      "Cannot create IPv4 header");
+		zassert_equal(net_udp_create(pkt, htons(TEST_PORT),
+					     htons(port)), 0,
+			      "Cannot create UDP header");
+	}
+
+	zassert_equal(net_pkt_write(pkt, &data, sizeof(data)), 0,
+		      "Cannot write payload");
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	return pkt;
+}
+
+/* Send the packets of all the flows interleaved, and return the number
+ * of threads that handled them.
+ */
+static int run_flows(bool rx, int pkts_per_flow)
+{
+	struct net_pkt *pkt;
+	k_tid_t threads[NUM_FLOWS];
+	int nb_threads = 0;
+	int flow, seq, i;
+
+	reset_flows();
+
+	for (seq = 0; seq < pkts_per_flow; seq++) {
+		for (flow = 0; flow < NUM_FLOWS; flow++) {
+			pkt = create_pkt(rx, flow, seq);
+
+			if (rx) {
+				zassert_equal(net_recv_data(iface1, pkt), 0,
+					      "Cannot receive packet");
+			} else {
+				zassert_equal(net_send_data(pkt), 0,
+					      "Cannot send packet");
+			}
+		}
+	}
+
+	for (i = 0; i < NUM_FLOWS * pkts_per_flow; i++) {
+		zassert_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+			      "Packet %d not handled", i);
+	}
+
+	zassert_false(order_failed, "Packets of a flow reordered");
+	zassert_false(thread_failed, "Flow handled by several threads");
+
+	for (flow = 0; flow < NUM_FLOWS; flow++) {
+		for (i = 0; i < nb_threads; i++) {
+			if (threads[i] == flows[flow].thread) {
+				break;
+			}
+		}
+
+		if (i == nb_threads) {
+			threads[nb_threads++] = flows[flow].thread;
+		}
+	}
+
+	return nb_threads;
+}
+
+static void test_rx_single_queue(void)
+{
+	net_if_flag_clear(iface1, NET_IF_FLOW_HASH);
+
+	zassert_equal(run_flows(true, PKTS_PER_FLOW), 1,
+		      "Flows spread without NET_IF_FLOW_HASH");
+}
+
+static void test_rx_flow_queues(void)
+{
+	net_if_flag_set(iface1, NET_IF_FLOW_HASH);
+
+	/* The chances that 16 flows hash to the same queue are tiny */
+	zassert_true(run_flows(true, PKTS_PER_FLOW) > 1,
+		     "Flows not spread over the queues");
+}
+
+static void test_tx_single_queue(void)
+{
+	net_if_flag_clear(iface1, NET_IF_FLOW_HASH);
+
+	zassert_equal(run_flows(false, PKTS_PER_FLOW), 1,
+		      "Flows spread without NET_IF_FLOW_HASH");
+}
+
+static void test_tx_flow_queues(void)
+{
+	net_if_flag_set(iface1, NET_IF_FLOW_HASH);
+
+	zassert_true(run_flows(false, PKTS_PER_FLOW) > 1,
+		     "Flows not spread over the queues");
+}
+
+static uint64_t measure_rx(bool flow_hash, int *nb_threads)
+{
+	uint32_t start, cycles;
+
+	if (flow_hash) {
+		net_if_flag_set(iface1, NET_IF_FLOW_HASH);
+	} else {
+		net_if_flag_clear(iface1, NET_IF_FLOW_HASH);
+	}
+
+	work_us = PERF_WORK_US;
+	start = k_cycle_get_32();
+
+	*nb_threads = run_flows(true, PERF_PKTS_PER_FLOW);
+
+	cycles = k_cycle_get_32() - start;
+	work_us = 0;
+
+	return k_cyc_to_ns_floor64(cycles) / 1000U;
+}
+
+static void test_rx_perf(void)
+{
+	uint64_t us_single, us_flows;
+	int pkts = NUM_FLOWS * PERF_PKTS_PER_FLOW;
+	int threads_single, threads_flows;
+
+	us_single = measure_rx(false, &threads_single);
+	us_flows = measure_rx(true, &threads_flows);
+
+	TC_PRINT("%d packets of %d flows, %d us of work each, %d CPUs\n",
+		 pkts, NUM_FLOWS, PERF_WORK_US, CONFIG_MP_NUM_CPUS);
+	TC_PRINT("%d queue: %llu us, %llu pkts/s\n", threads_single,
+		 us_single, us_single ? pkts * 1000000ULL / us_single : 0);
+	TC_PRINT("%d queues: %llu us, %llu pkts/s\n", threads_flows,
+		 us_flows, us_flows ? pkts * 1000000ULL / us_flows : 0);
+	TC_PRINT("Speedup x%llu.%02llu\n",
+		 us_flows ? us_single / us_flows : 0,
+		 us_flows ? (us_single * 100U / us_flows) % 100U : 0);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_flow_queues_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_rx_single_queue),
+			 ztest_unit_test(test_rx_flow_queues),
+			 ztest_unit_test(test_tx_single_queue),
+			 ztest_unit_test(test_tx_flow_queues),
+			 ztest_unit_test(test_rx_perf));
+
+	ztest_run_test_suite(net_flow_queues_test);
+}
@@ -0,0 +1,369 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_IPV4_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+#include <linker/sections.h>
+
+#include <tc_util.h>
+#include <ztest.h>
+
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "udp_internal.h"
+
+/* The MTU of the test interface, this is also the minimum MTU that
+ * every IPv4 host must be able to receive (RFC 791).
+ */
+#define TEST_MTU 576
+
+#define TEST_SRC_PORT 4352
+#define TEST_DST_PORT 25348
+
+#define WAIT_TIME K_SECONDS(1)
+#define ALLOC_TIMEOUT K_MSEC(500)
+
+#define PERF_ROUNDS 50
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+enum fragment_order {
+	IN_ORDER,
+	REVERSE_ORDER,
+	DROP_SECOND,
+};
+
+static struct net_if *iface1;
+static struct k_sem wait_data;
+
+static enum fragment_order order;
+static struct net_pkt *held[CONFIG_NET_IPV4_FRAGMENT_MAX_PKT];
+static int held_count;
+static int frag_count;
+static bool frag_failed;
+
+static uint8_t payload[1400];
+static size_t payload_len;
+static bool payload_ok;
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static void loop_back(struct net_pkt *pkt)
+{
+	if (net_recv_data(net_pkt_iface(pkt), pkt) < 0) {
+		net_pkt_unref(pkt);
+	}
+}
+
+/* Act as a link to a peer that reflects every packet back to us: the
+ * addresses are swapped as in the loopback driver, which does not
+ * change any checksum.
+ */
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	struct net_ipv4_hdr *hdr = NET_IPV4_HDR(pkt);
+	struct net_pkt *cloned;
+	struct in_addr addr;
+	uint16_t flags;
+	int i;
+
+	if (!pkt->buffer) {
+		return -ENODATA;
+	}
+
+	if (hdr->proto != IPPROTO_UDP) {
+		/* ICMP errors and such are not looped back */
+		return 0;
+	}
+
+	if (net_pkt_get_len(pkt) > TEST_MTU) {
+		frag_failed = true;
+	}
+
+	flags = net_ipv4_hdr_frag_flags(hdr);
+
+	if (flags & (NET_IPV4_MORE_FRAG_MASK | NET_IPV4_FRAGH_OFFSET_MASK)) {
+		frag_count++;
+
+		if ((flags & NET_IPV4_MORE_FRAG_MASK) &&
+		    (ntohs(hdr->len) - NET_IPV4H_LEN) % 8) {
+			frag_failed = true;
+		}
+	}
+
+	net_ipv4_addr_copy_raw((uint8_t *)&addr, hdr->src);
+	net_ipv4_addr_copy_raw(hdr->src, hdr->dst);
+	net_ipv4_addr_copy_raw(hdr->dst, (uint8_t *)&addr);
+
+	cloned = net_pkt_clone(pkt, K_NO_WAIT);
+	if (!cloned) {
+		return -ENOMEM;
+	}
+
+	switch (order) {
+	case IN_ORDER:
+		loop_back(cloned);
+		break;
+	case DROP_SECOND:
+		if (frag_count == 2) {
+			net_pkt_unref(cloned);
+		} else {
+			loop_back(cloned);
+		}
+		break;
+	case REVERSE_ORDER:
+		held[held_count++] = cloned;
+
+		if (!(flags & NET_IPV4_MORE_FRAG_MASK) ||
+		    held_count == ARRAY_SIZE(held)) {
+			for (i = held_count - 1; i >= 0; i--) {
+				loop_back(held[i]);
+			}
+
+			held_count = 0;
+		}
+		break;
+	}
+
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_ipv4_frag_test, "ipv4_frag_test",
+		net_iface_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&net_iface_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), TEST_MTU);
+
+static enum net_verdict udp_data_received(struct net_conn *conn,
+					  struct net_pkt *pkt,
+					  union net_ip_header *ip_hdr,
+					  union net_proto_header *proto_hdr,
+					  void *user_data)
+{
+	static uint8_t data[sizeof(payload)];
+	size_t len = net_pkt_remaining_data(pkt);
+
+	payload_ok = len == payload_len &&
+		     net_pkt_read(pkt, data, len) == 0 &&
+		     memcmp(data, payload, len) == 0;
+
+	net_pkt_unref(pkt);
+
+	k_sem_give(&wait_data);
+
+	return NET_OK;
+}
+
+static void test_setup(void)
+{
+	struct sockaddr remote_addr = { 0 };
+	struct sockaddr local_addr = { 0 };
+	struct net_conn_handle *handle;
+	struct net_if_addr *ifaddr;
+	size_t i;
+	int ret;
+
+	k_sem_init(&wait_data, 0, UINT_MAX);
+
+	iface1 = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface1, "Interface");
+
+	ifaddr = net_if_ipv4_addr_add(iface1, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv4 address");
+
+	net_if_up(iface1);
+
+	/* The addresses are swapped by the interface */
+	net_ipaddr_copy(&net_sin(&local_addr)->sin_addr, &my_addr);
+	local_addr.sa_family = AF_INET;
+
+	net_ipaddr_copy(&net_sin(&remote_addr)->sin_addr, &peer_addr);
+	remote_addr.sa_family = AF_INET;
+
+	ret = net_udp_register(AF_INET, &remote_addr, &local_addr,
+			       TEST_SRC_PORT, TEST_DST_PORT, NULL,
+			       udp_data_received, NULL, &handle);
+	zassert_equal(ret, 0, "Cannot register UDP handler");
+
+	for (i = 0; i < sizeof(payload); i++) {
+		payload[i] = i;
+	}
+}
+
+static int send_udp(size_t len, uint8_t flags)
+{
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, len, AF_INET, IPPROTO_UDP,
+					ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	zassert_equal(net_ipv4_create_full(pkt, &my_addr, &peer_addr, 0U, 0U,
+					   flags, 0U, 0U), 0,
+		      "Cannot create IPv4 header");
+	zassert_equal(net_udp_create(pkt, htons(TEST_SRC_PORT),
+				     htons(TEST_DST_PORT)), 0,
+		      "Cannot create UDP header");
+	zassert_equal(net_pkt_write(pkt, payload, len), 0,
+		      "Cannot write payload");
+
+	net_pkt_cursor_init(pkt);
+	net_ipv4_finalize(pkt, IPPROTO_UDP);
+
+	payload_len = len;
+	payload_ok = false;
+	frag_count = 0;
+	frag_failed = false;
+
+	ret = net_send_data(pkt);
+	if (ret < 0) {
+		net_pkt_unref(pkt);
+	}
+
+	return ret;
+}
+
+static void send_and_verify(size_t len, int expected_frags)
+{
+	zassert_equal(send_udp(len, 0U), 0, "Cannot send packet");
+
+	zassert_equal(k_sem_take(&wait_data, WAIT_TIME), 0,
+		      "Packet of %zu bytes not received", len);
+	zassert_true(payload_ok, "Received data mismatch");
+	zassert_false(frag_failed, "Invalid fragment sent");
+	zassert_equal(frag_count, expected_frags,
+		      "Sent %d fragments, expected %d", frag_count,
+		      expected_frags);
+}
+
+static void test_no_fragment(void)
+{
+	order = IN_ORDER;
+
+	send_and_verify(TEST_MTU - NET_IPV4UDPH_LEN, 0);
+}
+
+static void test_fragment(void)
+{
+	order = IN_ORDER;
+
+	/* The fragments carry 552 bytes of payload each */
+	send_and_verify(TEST_MTU, 2);
+	send_and_verify(sizeof(payload), 3);
+}
+
+static void test_fragment_reverse_order(void)
+{
+	order = REVERSE_ORDER;
+
+	send_and_verify(sizeof(payload), 3);
+}
+
+static int pending_reassembly;
+
+static void reassembly_cb(struct net_ipv4_reassembly *reass, void *user_data)
+{
+	pending_reassembly++;
+}
+
+static void test_fragment_missing(void)
+{
+	order = DROP_SECOND;
+
+	zassert_equal(send_udp(sizeof(payload), 0U), 0, "Cannot send packet");
+	zassert_not_equal(k_sem_take(&wait_data, K_MSEC(100)), 0,
+			  "Incomplete packet received");
+
+	pending_reassembly = 0;
+	net_ipv4_frag_foreach(reassembly_cb, NULL);
+	zassert_equal(pending_reassembly, 1, "Reassembly not pending");
+
+	k_sleep(K_SECONDS(CONFIG_NET_IPV4_FRAGMENT_TIMEOUT) + WAIT_TIME);
+
+	pending_reassembly = 0;
+	net_ipv4_frag_foreach(reassembly_cb, NULL);
+	zassert_equal(pending_reassembly, 0, "Reassembly not timed out");
+}
+
+static void test_dont_fragment(void)
+{
+	order = IN_ORDER;
+
+	zassert_not_equal(send_udp(sizeof(payload), NET_IPV4_DF), 0,
+			  "Packet with DF flag sent");
+	zassert_equal(frag_count, 0, "Packet with DF flag fragmented");
+}
+
+static void test_fragment_perf(void)
+{
+	uint32_t start, cycles;
+	uint64_t us;
+	int i;
+
+	order = IN_ORDER;
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < PERF_ROUNDS; i++) {
+		send_and_verify(sizeof(payload), 3);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	us = k_cyc_to_ns_floor64(cycles) / 1000U;
+
+	TC_PRINT("%d datagrams of %zu bytes over MTU %d in %llu us\n",
+		 PERF_ROUNDS, sizeof(payload), TEST_MTU, us);
+	TC_PRINT("Latency %llu us per datagram, throughput %llu kB/s\n",
+		 us / PERF_ROUNDS,
+		 us ? (uint64_t)PERF_ROUNDS * sizeof(payload) * 1000U / us : 0);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_ipv4_fragment_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_no_fragment),
+			 ztest_unit_test(test_fragment),
+			 ztest_unit_test(test_fragment_reverse_order),
+			 ztest_unit_test(test_fragment_missing),
+			 ztest_unit_test(test_dont_fragment),
+			 ztest_unit_test(test_fragment_perf));
+
+	ztest_run_test_suite(net_ipv4_fragment_test);
+}
@@ -306,6 +306,158 @@ static void test_npf_eth_mac_addr_mask(void)
 	zassert_true(npf_remove_all_recv_rules(), "");
 }
 
+/*
+ * Custom conditions and rule ordering
+ */
+
+static bool custom_called;
+
+static bool npf_test_len_150(struct npf_test *test, struct net_pkt *pkt)
+{
+	custom_called = true;
+	return net_pkt_get_len(pkt) == 150;
+}
+
+static struct {
+	struct npf_test test;
+} len_150 = {
+	.test.fn = npf_test_len_150,
+};
+
+static NPF_IFACE_MATCH(match_iface_b, &dummy_iface_b);
+static NPF_ETH_TYPE_MATCH(arp_packet, NET_ETH_PTYPE_ARP);
+
+static NPF_RULE(accept_small_ip_a, NET_OK, match_iface_a, ip_packet, maxsize_200);
+static NPF_RULE(drop_ip_a, NET_DROP, ip_packet, match_iface_a);
+static NPF_RULE(accept_custom_a, NET_OK, match_iface_a, len_150);
+static NPF_RULE(accept_arp, NET_OK, arp_packet);
+static NPF_RULE(accept_non_ip_b, NET_OK, match_iface_b, not_ip_packet);
+
+static bool recv_ok(int type, int size, struct net_if *iface)
+{
+	struct net_pkt *pkt = build_test_pkt(type, size, iface);
+	bool result = net_pkt_filter_recv_ok(pkt);
+
+	net_pkt_unref(pkt);
+	return result;
+}
+
+static void test_npf_rule_order(void)
+{
+#if defined(CONFIG_NET_PKT_FILTER_STATS)
+	npf_default_drop.hits = 0;
+#endif
+
+	npf_append_recv_rule(&accept_small_ip_a);
+	npf_append_recv_rule(&drop_ip_a);
+	npf_append_recv_rule(&accept_custom_a);
+	npf_append_recv_rule(&accept_arp);
+	npf_append_recv_rule(&accept_non_ip_b);
+	npf_append_recv_rule(&npf_default_drop);
+
+	zassert_true(recv_ok(NET_ETH_PTYPE_IP, 100, &dummy_iface_a), "");
+	zassert_false(recv_ok(NET_ETH_PTYPE_IP, 300, &dummy_iface_a), "");
+	zassert_false(custom_called, "custom condition should not be reached");
+
+	zassert_true(recv_ok(NET_ETH_PTYPE_ARP, 150, &dummy_iface_a), "");
+	zassert_true(custom_called, "custom condition not evaluated");
+
+	zassert_true(recv_ok(NET_ETH_PTYPE_ARP, 300, &dummy_iface_a), "");
+	zassert_true(recv_ok(NET_ETH_PTYPE_ARP, 300, &dummy_iface_b), "");
+	zassert_true(recv_ok(NET_ETH_PTYPE_IPV6, 300, &dummy_iface_b), "");
+	zassert_false(recv_ok(NET_ETH_PTYPE_IP, 100, &dummy_iface_b), "");
+	zassert_false(recv_ok(NET_ETH_PTYPE_IPV6, 100, NULL), "");
+
+	/* rule changes are taken into account */
+	zassert_true(npf_remove_recv_rule(&drop_ip_a), "");
+	zassert_true(recv_ok(NET_ETH_PTYPE_ARP, 300, &dummy_iface_b), "");
+	zassert_false(recv_ok(NET_ETH_PTYPE_IP, 300, &dummy_iface_a), "");
+
+#if defined(CONFIG_NET_PKT_FILTER_STATS)
+	zassert_equal(accept_small_ip_a.hits, 1, "");
+	zassert_equal(drop_ip_a.hits, 1, "");
+	zassert_equal(accept_custom_a.hits, 1, "");
+	zassert_equal(accept_arp.hits, 3, "");
+	zassert_equal(accept_non_ip_b.hits, 1, "");
+	zassert_equal(npf_default_drop.hits, 3, "");
+#endif
+
+	zassert_true(npf_remove_all_recv_rules(), "");
+}
+
+/*
+ * Evaluation cost with a few dozen rules in front of the matching one
+ */
+
+#define PERF_RULES 24
+#define PERF_ROUNDS 1000
+
+static struct net_eth_addr perf_addresses[] = {
+	{ { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x01 } },
+	{ { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x02 } },
+	{ { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x03 } },
+	{ { 0x02, 0x00, 0x5e, 0x00, 0x53, 0x04 } },
+};
+
+static NPF_SIZE_MAX(maxsize_1500, 1500);
+
+/* Six rules per Ethernet type, none of them matching the test packet */
+#define PERF_RULE(i, _) \
+	static NPF_ETH_TYPE_MATCH(perf_type_##i, 0x88b5 + (i) / 6); \
+	static NPF_ETH_SRC_ADDR_MASK_MATCH(perf_src_##i, perf_addresses, \
+					   0xff, 0xff, 0xff, 0xff, 0xff, i); \
+	static NPF_RULE(perf_rule_##i, NET_DROP, maxsize_1500, \
+			perf_type_##i, perf_src_##i)
+
+#define PERF_RULE_ADDR(i, _) &perf_rule_##i
+
+LISTIFY(PERF_RULES, PERF_RULE, (;));
+
+static struct npf_rule *perf_rules[] = {
+	LISTIFY(PERF_RULES, PERF_RULE_ADDR, (,))
+};
+
+static void test_npf_perf(void)
+{
+	struct net_pkt *pkt = build_test_pkt(NET_ETH_PTYPE_IP, 100, NULL);
+	uint32_t start, cycles;
+	bool ok = true;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(perf_rules); i++) {
+		npf_append_recv_rule(perf_rules[i]);
+	}
+
+	npf_append_recv_rule(&small_ip_pkt);
+	npf_append_recv_rule(&npf_default_drop);
+
+#if defined(CONFIG_NET_PKT_FILTER_STATS)
+	small_ip_pkt.hits = 0;
+#endif
+
+	start = k_cycle_get_32();
+
+	for (i = 0; i < PERF_ROUNDS; i++) {
+		ok &= net_pkt_filter_recv_ok(pkt);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	zassert_true(ok, "packet not accepted");
+
+	TC_PRINT("%d rules: %u cycles per packet (%s evaluation)\n",
+		 PERF_RULES + 2, cycles / PERF_ROUNDS,
+		 IS_ENABLED(CONFIG_NET_PKT_FILTER_COMPILED) ?
+		 "compiled" : "list");
+
+#if defined(CONFIG_NET_PKT_FILTER_STATS)
+	zassert_equal(small_ip_pkt.hits, PERF_ROUNDS, "");
+#endif
+
+	zassert_true(npf_remove_all_recv_rules(), "");
+	net_pkt_unref(pkt);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_pkt_filter_test,
@@ -313,7 +465,9 @@ void test_main(void)
 			 ztest_unit_test(test_npf_example1),
 			 ztest_unit_test(test_npf_example2),
 			 ztest_unit_test(test_npf_eth_mac_address),
-			 ztest_unit_test(test_npf_eth_mac_addr_mask));
+			 ztest_unit_test(test_npf_eth_mac_addr_mask),
+			 ztest_unit_test(test_npf_rule_order),
+			 ztest_unit_test(test_npf_perf));
 
 	ztest_run_test_suite(net_pkt_filter_test);
 }
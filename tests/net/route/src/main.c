@@ -492,6 +492,45 @@ static void test_route_del_many(void)
 	}
 }
 
+#define LOOKUP_COUNT 1000
+
+static void test_route_lookup_perf(void)
+{
+	struct net_route_entry *found;
+	uint32_t start, cycles;
+	int count, i, j;
+
+	for (count = 1; count <= max_routes; count *= 2) {
+		for (i = 0; i < count; i++) {
+			test_routes[i] = net_route_add(my_iface,
+						       &dest_addresses[i], 128,
+						       &peer_addr,
+						       NET_IPV6_ND_INFINITE_LIFETIME,
+						       NET_ROUTE_PREFERENCE_LOW);
+			zassert_not_null(test_routes[i], "Route add failed");
+		}
+
+		start = k_cycle_get_32();
+
+		for (j = 0; j < LOOKUP_COUNT; j++) {
+			found = net_route_lookup(my_iface,
+						 &dest_addresses[j % count]);
+			zassert_equal_ptr(found, test_routes[j % count],
+					  "Wrong route found");
+		}
+
+		cycles = k_cycle_get_32() - start;
+
+		TC_PRINT("%d routes: %u ns per lookup\n", count,
+			 (uint32_t)(k_cyc_to_ns_floor64(cycles) / LOOKUP_COUNT));
+
+		for (i = 0; i < count; i++) {
+			zassert_false(net_route_del(test_routes[i]),
+				      "Route del failed");
+		}
+	}
+}
+
 static void test_route_lifetime(void)
 {
 	entry = net_route_add(my_iface,
@@ -565,6 +604,7 @@ void test_main(void)
 			ztest_unit_test(test_populate_nbr_cache),
 			ztest_unit_test(test_route_add_many),
 			ztest_unit_test(test_route_del_many),
+			ztest_unit_test(test_route_lookup_perf),
 			ztest_unit_test(test_route_lifetime),
 			ztest_unit_test(test_route_preference));
 	ztest_run_test_suite(test_route);
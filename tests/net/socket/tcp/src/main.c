@@ -981,6 +981,500 @@ void test_v6_msg_waitall(void)
 	test_close(c_sock);
 }
 
+void test_so_sndbuf_rcvbuf(void)
+{
+	struct sockaddr_in bind_addr4;
+	int sock, rv;
+	int optval;
+	socklen_t optlen = sizeof(optval);
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &sock, &bind_addr4);
+
+	optval = 2000;
+	rv = setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &optval, sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	optval = 3000;
+	rv = setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &optval, sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	rv = getsockopt(sock, SOL_SOCKET, SO_SNDBUF, &optval, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optval, 2000, "getsockopt got invalid send buffer");
+	zassert_equal(optlen, sizeof(optval), "getsockopt got invalid size");
+
+	rv = getsockopt(sock, SOL_SOCKET, SO_RCVBUF, &optval, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optval, 3000, "getsockopt got invalid receive buffer");
+	zassert_equal(optlen, sizeof(optval), "getsockopt got invalid size");
+
+	optval = -1;
+	rv = setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &optval, sizeof(optval));
+	zassert_equal(rv, -1, "setsockopt accepted a negative size");
+	zassert_equal(errno, EINVAL, "Unexpected errno value: %d", errno);
+
+	test_close(sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+#define SNDBUF_SIZE 1000
+#define RCVBUF_SIZE 1280
+
+void test_v4_so_sndbuf_poll(void)
+{
+	static uint8_t buf[SNDBUF_SIZE + 500];
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct pollfd pfd;
+	size_t total = 0;
+	ssize_t ret;
+	int optval;
+	int rv, i;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	/* Accepted sockets inherit the receive buffer of the listener */
+	optval = RCVBUF_SIZE;
+	rv = setsockopt(s_sock, SOL_SOCKET, SO_RCVBUF, &optval,
+			sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	optval = SNDBUF_SIZE;
+	rv = setsockopt(c_sock, SOL_SOCKET, SO_SNDBUF, &optval,
+			sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+	zassert_equal(addrlen, sizeof(struct sockaddr_in), "wrong addrlen");
+
+	/* Without reading on the peer, the sender can only queue as much
+	 * as the peer window plus its own send buffer.
+	 */
+	for (i = 0; i < 10; i++) {
+		ret = send(c_sock, buf, sizeof(buf), MSG_DONTWAIT);
+		if (ret < 0) {
+			break;
+		}
+
+		zassert_true(ret <= SNDBUF_SIZE, "send buffer overrun");
+		total += ret;
+
+		k_msleep(THREAD_SLEEP);
+	}
+
+	zassert_equal(ret, -1, "send buffer never filled up");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+	zassert_true(total <= RCVBUF_SIZE + SNDBUF_SIZE,
+		     "Queued %zu bytes", total);
+
+	pfd.fd = c_sock;
+	pfd.events = POLLOUT;
+	rv = poll(&pfd, 1, 0);
+	zassert_equal(rv, 0, "socket writable with a full send buffer");
+
+	/* Reading reopens the window, the queued data gets acknowledged
+	 * and the socket becomes writable again.
+	 */
+	while (total > 0) {
+		ret = recv(new_sock, buf, sizeof(buf), 0);
+		zassert_true(ret > 0, "recv failed (%d)", errno);
+		total -= ret;
+	}
+
+	rv = poll(&pfd, 1, 1000);
+	zassert_equal(rv, 1, "socket not writable after the peer read");
+	zassert_equal(pfd.revents, POLLOUT, "Unexpected revents 0x%x",
+		      pfd.revents);
+
+	test_close(c_sock);
+	test_eof(new_sock);
+
+	test_close(new_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+#define FLOWS 3
+#define FLOW_CHUNK 256
+#define FLOW_TIME_MS 2000
+#define FLOW_STACK_SZ (2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+K_THREAD_STACK_ARRAY_DEFINE(flow_stacks, FLOWS, FLOW_STACK_SZ);
+static struct k_thread flow_threads[FLOWS];
+static volatile bool flows_stop;
+static int flow_failures;
+
+static void flow_sender(void *p1, void *p2, void *p3)
+{
+	static const uint8_t chunk[FLOW_CHUNK];
+	int sock = POINTER_TO_INT(p1);
+
+	while (!flows_stop) {
+		if (send(sock, chunk, sizeof(chunk), 0) < 0) {
+			flow_failures++;
+			k_msleep(1);
+		}
+	}
+}
+
+/* Run several bulk TCP flows over the loopback interface for a while,
+ * and return Jain's fairness index of their throughput, in thousandths.
+ */
+static unsigned int run_flows(int sndbuf)
+{
+	static uint8_t buf[FLOW_CHUNK];
+	int c_socks[FLOWS], new_socks[FLOWS];
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	struct pollfd pfds[FLOWS];
+	uint64_t bytes[FLOWS] = { 0 };
+	uint64_t sum = 0, sum_sq = 0;
+	uint32_t start;
+	int s_sock;
+	ssize_t ret;
+	int i, rv;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	for (i = 0; i < FLOWS; i++) {
+		prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+				    &c_socks[i], &c_saddr);
+
+		if (sndbuf) {
+			rv = setsockopt(c_socks[i], SOL_SOCKET, SO_SNDBUF,
+					&sndbuf, sizeof(sndbuf));
+			zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+		}
+
+		test_connect(c_socks[i], (struct sockaddr *)&s_saddr,
+			     sizeof(s_saddr));
+
+		addrlen = sizeof(addr);
+		test_accept(s_sock, &new_socks[i], &addr, &addrlen);
+
+		pfds[i].fd = new_socks[i];
+		pfds[i].events = POLLIN;
+	}
+
+	flows_stop = false;
+	flow_failures = 0;
+
+	for (i = 0; i < FLOWS; i++) {
+		k_thread_create(&flow_threads[i], flow_stacks[i],
+				K_THREAD_STACK_SIZEOF(flow_stacks[i]),
+				flow_sender, INT_TO_POINTER(c_socks[i]),
+				NULL, NULL, K_PRIO_PREEMPT(8), 0, K_NO_WAIT);
+	}
+
+	start = k_uptime_get_32();
+
+	while (k_uptime_get_32() - start < FLOW_TIME_MS) {
+		rv = poll(pfds, FLOWS, 100);
+		zassert_true(rv >= 0, "poll failed (%d)", errno);
+
+		for (i = 0; i < FLOWS; i++) {
+			if (!(pfds[i].revents & POLLIN)) {
+				continue;
+			}
+
+			ret = recv(new_socks[i], buf, sizeof(buf),
+				   MSG_DONTWAIT);
+			if (ret > 0) {
+				bytes[i] += ret;
+			}
+		}
+	}
+
+	/* Keep draining until all the senders noticed the end of the run */
+	flows_stop = true;
+
+	for (i = 0; i < FLOWS; i++) {
+		while (k_thread_join(&flow_threads[i], K_MSEC(10)) != 0) {
+			int j;
+
+			for (j = 0; j < FLOWS; j++) {
+				(void)recv(new_socks[j], buf, sizeof(buf),
+					   MSG_DONTWAIT);
+			}
+		}
+	}
+
+	for (i = 0; i < FLOWS; i++) {
+		TC_PRINT("flow %d: %llu bytes\n", i, bytes[i]);
+		zassert_true(bytes[i] > 0, "flow %d starved", i);
+
+		sum += bytes[i];
+		sum_sq += bytes[i] * bytes[i];
+
+		test_close(c_socks[i]);
+		test_close(new_socks[i]);
+	}
+
+	test_close(s_sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+
+	TC_PRINT("%d flows, send buffer %d: %llu bytes/s, %d send failures\n",
+		 FLOWS, sndbuf, sum * 1000U / FLOW_TIME_MS, flow_failures);
+
+	return sum_sq ? (unsigned int)(sum * sum * 1000U / (FLOWS * sum_sq)) :
+			0U;
+}
+
+void test_v4_sndbuf_fairness(void)
+{
+	unsigned int fairness;
+
+	fairness = run_flows(0);
+	TC_PRINT("Unlimited send buffers: fairness %u.%03u\n",
+		 fairness / 1000U, fairness % 1000U);
+
+	fairness = run_flows(2 * FLOW_CHUNK);
+	TC_PRINT("Send buffers of %d bytes: fairness %u.%03u\n",
+		 2 * FLOW_CHUNK, fairness / 1000U, fairness % 1000U);
+
+	zassert_equal(flow_failures, 0, "sends failed with a send buffer");
+}
+
+#define BLOCKED_SENDERS 2
+
+static ssize_t blocked_send_ret[BLOCKED_SENDERS];
+static int blocked_send_errno[BLOCKED_SENDERS];
+
+static void blocked_sender(void *p1, void *p2, void *p3)
+{
+	static const uint8_t chunk[FLOW_CHUNK];
+	int sock = POINTER_TO_INT(p1);
+	int idx = POINTER_TO_INT(p2);
+
+	blocked_send_ret[idx] = send(sock, chunk, sizeof(chunk), 0);
+	blocked_send_errno[idx] = errno;
+}
+
+void test_v4_sndbuf_peer_close(void)
+{
+	static uint8_t buf[SNDBUF_SIZE];
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	ssize_t ret;
+	int optval;
+	int i, rv;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	optval = RCVBUF_SIZE;
+	rv = setsockopt(s_sock, SOL_SOCKET, SO_RCVBUF, &optval,
+			sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	optval = SNDBUF_SIZE;
+	rv = setsockopt(c_sock, SOL_SOCKET, SO_SNDBUF, &optval,
+			sizeof(optval));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	test_connect(c_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+	/* Fill the peer window and the send buffer */
+	for (i = 0; i < 10; i++) {
+		ret = send(c_sock, buf, sizeof(buf), MSG_DONTWAIT);
+		if (ret < 0) {
+			break;
+		}
+
+		k_msleep(THREAD_SLEEP);
+	}
+
+	zassert_equal(ret, -1, "send buffer never filled up");
+	zassert_equal(errno, EAGAIN, "Unexpected errno value: %d", errno);
+
+	/* Every blocked sender has to wake up, not only the first one */
+	for (i = 0; i < BLOCKED_SENDERS; i++) {
+		k_thread_create(&flow_threads[i], flow_stacks[i],
+				K_THREAD_STACK_SIZEOF(flow_stacks[i]),
+				blocked_sender, INT_TO_POINTER(c_sock),
+				INT_TO_POINTER(i), NULL, K_PRIO_PREEMPT(8), 0,
+				K_NO_WAIT);
+	}
+
+	k_msleep(THREAD_SLEEP);
+
+	for (i = 0; i < BLOCKED_SENDERS; i++) {
+		zassert_equal(k_thread_join(&flow_threads[i], K_NO_WAIT),
+			      -EBUSY, "sender %d did not block", i);
+	}
+
+	/* The peer goes away without reading, which ends and frees the
+	 * connection under the blocked senders.
+	 */
+	test_close(new_sock);
+
+	for (i = 0; i < BLOCKED_SENDERS; i++) {
+		zassert_equal(k_thread_join(&flow_threads[i], K_SECONDS(2)), 0,
+			      "sender %d not woken up", i);
+		zassert_equal(blocked_send_ret[i], -1,
+			      "send succeeded on a closed connection");
+		zassert_not_equal(blocked_send_errno[i], EAGAIN,
+				  "send timed out instead of failing");
+	}
+
+	test_close(c_sock);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+void test_v4_syn_queue_backlog(void)
+{
+	int c_sock1, c_sock2;
+	int s_sock;
+	int new_sock1, new_sock2;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen = sizeof(addr);
+	struct pollfd pfd;
+	int count_before = 0, count_after = 0;
+	int rv;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_SYN_QUEUE)) {
+		ztest_test_skip();
+	}
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock1, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+			    &c_sock2, &c_saddr);
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	zassert_equal(listen(s_sock, 1), 0, "listen failed");
+
+	net_context_foreach(calc_net_context, &count_before);
+
+	test_connect(c_sock1, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_connect(c_sock2, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	k_msleep(THREAD_SLEEP);
+
+	/* With a backlog of 1, the second connection is kept half-open
+	 * and does not use a context until the first one is accepted.
+	 */
+	net_context_foreach(calc_net_context, &count_after);
+	zassert_equal(count_before + 1, count_after,
+		      "Unexpected number of contexts (before %d vs after %d)",
+		      count_before, count_after);
+
+	test_accept(s_sock, &new_sock1, &addr, &addrlen);
+
+	/* The SYN-ACK retransmission completes the second connection */
+	pfd.fd = s_sock;
+	pfd.events = POLLIN;
+	rv = poll(&pfd, 1, 3000);
+	zassert_equal(rv, 1, "second connection not completed");
+
+	addrlen = sizeof(addr);
+	test_accept(s_sock, &new_sock2, &addr, &addrlen);
+
+	test_send(c_sock2, TEST_STR_SMALL, strlen(TEST_STR_SMALL), 0);
+	test_recv(new_sock2, 0);
+
+	test_close(c_sock1);
+	test_close(c_sock2);
+	test_eof(new_sock1);
+	test_eof(new_sock2);
+
+	test_close(new_sock1);
+	test_close(new_sock2);
+	test_close(s_sock);
+
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+}
+
+#define CONNECT_RUNS 10
+/* Longer than the TIME_WAIT delay, so that the contexts are released */
+#define CONNECT_PAUSE K_MSEC(CONFIG_NET_TCP_TIME_WAIT_DELAY + 100)
+
+void test_v4_connect_rate(void)
+{
+	int c_sock;
+	int s_sock;
+	int new_sock;
+	struct sockaddr_in c_saddr;
+	struct sockaddr_in s_saddr;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	uint32_t start, cycles = 0U;
+	uint64_t us;
+	int i;
+
+	prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &s_sock, &s_saddr);
+	test_bind(s_sock, (struct sockaddr *)&s_saddr, sizeof(s_saddr));
+	test_listen(s_sock);
+
+	for (i = 0; i < CONNECT_RUNS; i++) {
+		prepare_sock_tcp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, ANY_PORT,
+				    &c_sock, &c_saddr);
+
+		start = k_cycle_get_32();
+
+		zassert_equal(connect(c_sock, (struct sockaddr *)&s_saddr,
+				      sizeof(s_saddr)),
+			      0, "connect failed");
+
+		addrlen = sizeof(addr);
+		test_accept(s_sock, &new_sock, &addr, &addrlen);
+
+		cycles += k_cycle_get_32() - start;
+
+		test_close(c_sock);
+		test_close(new_sock);
+
+		k_sleep(CONNECT_PAUSE);
+	}
+
+	test_close(s_sock);
+	k_sleep(TCP_TEARDOWN_TIMEOUT);
+
+	us = k_cyc_to_ns_floor64(cycles) / 1000U;
+
+	TC_PRINT("%d connections, SYN queue %s: %llu us each, %llu conn/s\n",
+		 CONNECT_RUNS,
+		 IS_ENABLED(CONFIG_NET_TCP_SYN_QUEUE) ? "on" : "off",
+		 us / CONNECT_RUNS, us ? CONNECT_RUNS * 1000000ULL / us : 0);
+}
+
 #ifdef CONFIG_USERSPACE
 #define CHILD_STACK_SZ		(2048 + CONFIG_TEST_EXTRA_STACK_SIZE)
 struct k_thread child_thread;
@@ -1075,6 +1569,12 @@ void test_main(void)
 		ztest_unit_test(test_v6_so_rcvtimeo),
 		ztest_unit_test(test_v4_msg_waitall),
 		ztest_unit_test(test_v6_msg_waitall),
+		ztest_unit_test(test_so_sndbuf_rcvbuf),
+		ztest_unit_test(test_v4_so_sndbuf_poll),
+		ztest_unit_test(test_v4_sndbuf_fairness),
+		ztest_unit_test(test_v4_sndbuf_peer_close),
+		ztest_unit_test(test_v4_syn_queue_backlog),
+		ztest_unit_test(test_v4_connect_rate),
 		ztest_user_unit_test(test_socket_permission)
 		);
 
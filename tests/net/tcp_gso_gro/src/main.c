@@ -0,0 +1,492 @@
+/* main.c - Application main entry point */
+
+/*
+ * Copyright (c) 2022 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, CONFIG_NET_TCP_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/printk.h>
+#include <sys/byteorder.h>
+
+#include <tc_util.h>
+#include <ztest.h>
+
+#include <net/dummy.h>
+#include <net/buf.h>
+#include <net/net_ip.h>
+#include <net/net_if.h>
+
+#define NET_LOG_ENABLED 1
+#include "net_private.h"
+
+#include "ipv4.h"
+#include "ipv6.h"
+#include "tcp_internal.h"
+
+#define TEST_MTU 576
+#define TEST_MSS (TEST_MTU - NET_IPV4TCPH_LEN)
+
+#define TEST_SRC_PORT 4242
+#define TEST_DST_PORT 80
+#define TEST_SEQ 0xfffffe00U
+#define TEST_ACK 1000U
+
+#define ALLOC_TIMEOUT K_MSEC(500)
+
+#define PERF_ROUNDS 100
+
+static struct in_addr my_addr4 = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr4 = { { { 192, 0, 2, 2 } } };
+static struct in6_addr my_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr6 = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					  0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static struct net_if *iface1;
+
+static uint8_t payload[CONFIG_NET_TCP_GSO_MAX_SEGMENTS * TEST_MSS];
+
+static struct net_pkt *segs[CONFIG_NET_TCP_GRO_MAX_SEGMENTS + 2];
+static int seg_count;
+
+static int net_iface_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void net_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_DUMMY);
+}
+
+static int sender_iface(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api net_iface_api = {
+	.iface_api.init = net_iface_init,
+	.send = sender_iface,
+};
+
+NET_DEVICE_INIT(net_tcp_gso_gro_test, "tcp_gso_gro_test",
+		net_iface_dev_init, NULL, NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT,
+		&net_iface_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), TEST_MTU);
+
+/* Build a TCP packet as it would be received from a dummy interface */
+static struct net_pkt *create_tcp_pkt(sa_family_t family, uint32_t seq,
+				      uint8_t flags, const uint8_t *data,
+				      size_t len)
+{
+	struct net_tcp_hdr hdr = { 0 };
+	struct net_pkt *pkt;
+	int ret;
+
+	pkt = net_pkt_alloc_with_buffer(iface1, sizeof(hdr) + len, family,
+					IPPROTO_TCP, ALLOC_TIMEOUT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	if (family == AF_INET) {
+		ret = net_ipv4_create(pkt, &peer_addr4, &my_addr4);
+	} else {
+		ret = net_ipv6_create(pkt, &peer_addr6, &my_addr6);
+	}
+
+	zassert_equal(ret, 0, "Cannot create IP header");
+
+	hdr.src_port = htons(TEST_SRC_PORT);
+	hdr.dst_port = htons(TEST_DST_PORT);
+	sys_put_be32(seq, hdr.seq);
+	sys_put_be32(TEST_ACK, hdr.ack);
+	hdr.offset = (sizeof(hdr) / 4U) << 4;
+	hdr.flags = flags;
+	sys_put_be16(8192, hdr.wnd);
+
+	zassert_equal(net_pkt_write(pkt, &hdr, sizeof(hdr)), 0,
+		      "Cannot write TCP header");
+	zassert_equal(net_pkt_write(pkt, data, len), 0,
+		      "Cannot write payload");
+
+	net_pkt_cursor_init(pkt);
+
+	if (family == AF_INET) {
+		ret = net_ipv4_finalize(pkt, IPPROTO_TCP);
+	} else {
+		ret = net_ipv6_finalize(pkt, IPPROTO_TCP);
+	}
+
+	zassert_equal(ret, 0, "Cannot finalize pkt");
+
+	return pkt;
+}
+
+static struct net_tcp_hdr *get_tcp_hdr(struct net_pkt *pkt)
+{
+	return (struct net_tcp_hdr *)(pkt->buffer->data +
+				      net_pkt_ip_hdr_len(pkt));
+}
+
+static void check_payload(struct net_pkt *pkt, const uint8_t *data,
+			  size_t len)
+{
+	static uint8_t buf[sizeof(payload)];
+
+	zassert_true(len <= sizeof(buf), "Too much data");
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_skip(pkt, net_pkt_ip_hdr_len(pkt) + NET_TCPH_LEN);
+
+	zassert_equal(net_pkt_remaining_data(pkt), len, "Wrong data length");
+	zassert_equal(net_pkt_read(pkt, buf, len), 0, "Cannot read data");
+	zassert_mem_equal(buf, data, len, "Data mismatch");
+}
+
+static void check_chksums(struct net_pkt *pkt)
+{
+	if (net_pkt_family(pkt) == AF_INET) {
+		zassert_equal(net_calc_chksum_ipv4(pkt), 0,
+			      "Invalid IPv4 header checksum");
+	}
+
+	zassert_equal(net_calc_chksum_tcp(pkt), 0, "Invalid TCP checksum");
+}
+
+static void flush_segs(void)
+{
+	while (seg_count) {
+		net_pkt_unref(segs[--seg_count]);
+	}
+}
+
+static void test_setup(void)
+{
+	size_t i;
+
+	iface1 = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	zassert_not_null(iface1, "Interface");
+
+	for (i = 0; i < sizeof(payload); i++) {
+		payload[i] = i ^ (i >> 8);
+	}
+}
+
+static int gso_segment_cb(struct net_pkt *pkt, void *user_data)
+{
+	if (seg_count == ARRAY_SIZE(segs)) {
+		net_pkt_unref(pkt);
+		return -ENOMEM;
+	}
+
+	segs[seg_count++] = pkt;
+
+	return 0;
+}
+
+static void gso_test(sa_family_t family, size_t len)
+{
+	uint16_t mss = family == AF_INET ? TEST_MSS :
+				TEST_MTU - NET_IPV6TCPH_LEN;
+	size_t hdr_len = family == AF_INET ? NET_IPV4TCPH_LEN :
+				NET_IPV6TCPH_LEN;
+	struct net_pkt *pkt;
+	size_t offset = 0;
+	int i;
+
+	pkt = create_tcp_pkt(family, TEST_SEQ, ACK | PSH | FIN, payload, len);
+	net_pkt_set_gso_size(pkt, mss);
+
+	zassert_equal(net_tcp_gso_segment(pkt, gso_segment_cb, NULL), 0,
+		      "Cannot segment pkt");
+	zassert_equal(seg_count, DIV_ROUND_UP(len, mss),
+		      "Wrong number of segments");
+
+	for (i = 0; i < seg_count; i++) {
+		struct net_pkt *seg = segs[i];
+		size_t seg_len = MIN(mss, len - offset);
+		struct net_tcp_hdr *tcp = get_tcp_hdr(seg);
+		uint8_t flags = i == seg_count - 1 ? ACK | PSH | FIN : ACK;
+
+		zassert_equal(net_pkt_gso_size(seg), 0, "Segment with GSO");
+		zassert_equal(net_pkt_get_len(seg), hdr_len + seg_len,
+			      "Wrong segment length");
+		zassert_true(net_pkt_get_len(seg) <= TEST_MTU,
+			     "Segment larger than MTU");
+		zassert_equal(sys_get_be32(tcp->seq),
+			      (uint32_t)(TEST_SEQ + offset),
+			      "Wrong sequence number");
+		zassert_equal(tcp->flags, flags, "Wrong flags");
+
+		check_chksums(seg);
+		check_payload(seg, payload + offset, seg_len);
+
+		offset += seg_len;
+	}
+
+	flush_segs();
+	net_pkt_unref(pkt);
+}
+
+static void test_gso_ipv4(void)
+{
+	gso_test(AF_INET, TEST_MSS + 1);
+	gso_test(AF_INET, sizeof(payload));
+}
+
+static void test_gso_ipv6(void)
+{
+	gso_test(AF_INET6, sizeof(payload));
+}
+
+/* Queue count segments of len bytes behind a first one and merge them */
+static struct net_pkt *gro_test(sa_family_t family, struct k_fifo *fifo,
+				int count, size_t len)
+{
+	struct net_pkt *pkt, *next;
+	int i;
+
+	k_fifo_init(fifo);
+
+	for (i = 0; i < count; i++) {
+		segs[i] = create_tcp_pkt(family, TEST_SEQ + i * len, ACK,
+					 payload + i * len, len);
+		if (i > 0) {
+			k_fifo_put(fifo, segs[i]);
+		}
+	}
+
+	pkt = net_tcp_gro_receive(fifo, segs[0], &next);
+	zassert_equal(pkt, segs[0], "Wrong packet returned");
+	zassert_is_null(next, "Segment not merged");
+
+	return pkt;
+}
+
+static void check_merged(struct net_pkt *pkt, size_t len)
+{
+	struct net_tcp_hdr *tcp = get_tcp_hdr(pkt);
+	size_t hdr_len = net_pkt_ip_hdr_len(pkt) + NET_TCPH_LEN;
+
+	zassert_equal(net_pkt_get_len(pkt), hdr_len + len, "Wrong length");
+	zassert_equal(sys_get_be32(tcp->seq), TEST_SEQ, "Wrong sequence");
+
+	check_chksums(pkt);
+	check_payload(pkt, payload, len);
+}
+
+static void test_gro_ipv4(void)
+{
+	struct k_fifo fifo;
+	struct net_pkt *pkt;
+
+	/* An odd length exercises the byte swapped checksums */
+	pkt = gro_test(AF_INET, &fifo, 4, 333);
+
+	zassert_true(k_fifo_is_empty(&fifo), "Segments left in the queue");
+	check_merged(pkt, 4 * 333);
+
+	net_pkt_unref(pkt);
+}
+
+static void test_gro_ipv6(void)
+{
+	struct k_fifo fifo;
+	struct net_pkt *pkt;
+
+	pkt = gro_test(AF_INET6, &fifo, 3, 500);
+
+	zassert_true(k_fifo_is_empty(&fifo), "Segments left in the queue");
+	check_merged(pkt, 3 * 500);
+
+	net_pkt_unref(pkt);
+}
+
+static void test_gro_max_segments(void)
+{
+	int count = CONFIG_NET_TCP_GRO_MAX_SEGMENTS + 1;
+	struct k_fifo fifo;
+	struct net_pkt *pkt;
+
+	pkt = gro_test(AF_INET, &fifo, count, 100);
+
+	check_merged(pkt, CONFIG_NET_TCP_GRO_MAX_SEGMENTS * 100);
+	zassert_equal(k_fifo_get(&fifo, K_NO_WAIT), segs[count - 1],
+		      "Last segment not left in the queue");
+
+	net_pkt_unref(segs[count - 1]);
+	net_pkt_unref(pkt);
+}
+
+static void test_gro_out_of_order(void)
+{
+	struct net_pkt *pkt, *other, *next;
+	struct k_fifo fifo;
+
+	k_fifo_init(&fifo);
+
+	/* The third segment is missing, the fourth is not merged */
+	segs[0] = create_tcp_pkt(AF_INET, TEST_SEQ, ACK, payload, 100);
+	segs[1] = create_tcp_pkt(AF_INET, TEST_SEQ + 100, ACK,
+				 payload + 100, 100);
+	other = create_tcp_pkt(AF_INET, TEST_SEQ + 300, ACK,
+			       payload + 300, 100);
+
+	k_fifo_put(&fifo, segs[1]);
+	k_fifo_put(&fifo, other);
+
+	pkt = net_tcp_gro_receive(&fifo, segs[0], &next);
+
+	check_merged(pkt, 200);
+	zassert_equal(next, other, "Out of order segment not handed back");
+	zassert_true(k_fifo_is_empty(&fifo), "Segments left in the queue");
+	check_chksums(other);
+
+	net_pkt_unref(other);
+	net_pkt_unref(pkt);
+}
+
+static void test_gro_push(void)
+{
+	struct net_pkt *pkt, *other, *next;
+	struct k_fifo fifo;
+
+	k_fifo_init(&fifo);
+
+	/* PSH ends the merged packet */
+	segs[0] = create_tcp_pkt(AF_INET, TEST_SEQ, ACK, payload, 100);
+	segs[1] = create_tcp_pkt(AF_INET, TEST_SEQ + 100, ACK | PSH,
+				 payload + 100, 100);
+	other = create_tcp_pkt(AF_INET, TEST_SEQ + 200, ACK,
+			       payload + 200, 100);
+
+	k_fifo_put(&fifo, segs[1]);
+	k_fifo_put(&fifo, other);
+
+	pkt = net_tcp_gro_receive(&fifo, segs[0], &next);
+
+	check_merged(pkt, 200);
+	zassert_is_null(next, "Segment after PSH taken from the queue");
+	zassert_equal(get_tcp_hdr(pkt)->flags, ACK | PSH, "PSH not set");
+	zassert_equal(k_fifo_get(&fifo, K_NO_WAIT), other,
+		      "Segment after PSH not left in the queue");
+
+	net_pkt_unref(other);
+	net_pkt_unref(pkt);
+}
+
+static void test_gro_bad_chksum(void)
+{
+	struct net_pkt *pkt, *next;
+	struct k_fifo fifo;
+
+	k_fifo_init(&fifo);
+
+	segs[0] = create_tcp_pkt(AF_INET, TEST_SEQ, ACK, payload, 100);
+	segs[1] = create_tcp_pkt(AF_INET, TEST_SEQ + 100, ACK,
+				 payload + 100, 100);
+
+	/* Corrupt the payload of the second segment */
+	segs[1]->buffer->data[NET_IPV4TCPH_LEN] ^= 0x5a;
+
+	k_fifo_put(&fifo, segs[1]);
+
+	pkt = net_tcp_gro_receive(&fifo, segs[0], &next);
+
+	zassert_true(k_fifo_is_empty(&fifo), "Segment not merged");
+	zassert_not_equal(net_calc_chksum_tcp(pkt), 0,
+			  "Corrupted data not detected");
+
+	net_pkt_unref(pkt);
+}
+
+static void test_gso_gro_perf(void)
+{
+	uint32_t start, gso_cycles = 0U, gro_cycles = 0U;
+	struct net_pkt *pkt, *next;
+	struct k_fifo fifo;
+	uint64_t bytes;
+	int i;
+
+	for (i = 0; i < PERF_ROUNDS; i++) {
+		pkt = create_tcp_pkt(AF_INET, TEST_SEQ, ACK, payload,
+				     sizeof(payload));
+		net_pkt_set_gso_size(pkt, TEST_MSS);
+
+		start = k_cycle_get_32();
+		net_tcp_gso_segment(pkt, gso_segment_cb, NULL);
+		gso_cycles += k_cycle_get_32() - start;
+
+		zassert_equal(seg_count, CONFIG_NET_TCP_GSO_MAX_SEGMENTS,
+			      "Wrong number of segments");
+
+		flush_segs();
+		net_pkt_unref(pkt);
+	}
+
+	bytes = (uint64_t)PERF_ROUNDS * sizeof(payload);
+
+	TC_PRINT("GSO: %llu bytes in %u cycles, %llu cycles/kB, "
+		 "%llu kB/s\n", bytes, gso_cycles,
+		 (uint64_t)gso_cycles * 1024U / bytes,
+		 gso_cycles ? bytes * sys_clock_hw_cycles_per_sec() /
+			      gso_cycles / 1024U : 0);
+
+	for (i = 0; i < PERF_ROUNDS; i++) {
+		k_fifo_init(&fifo);
+
+		for (seg_count = 0; seg_count < CONFIG_NET_TCP_GSO_MAX_SEGMENTS;
+		     seg_count++) {
+			segs[seg_count] = create_tcp_pkt(
+				AF_INET, TEST_SEQ + seg_count * TEST_MSS, ACK,
+				payload + seg_count * TEST_MSS, TEST_MSS);
+			if (seg_count > 0) {
+				k_fifo_put(&fifo, segs[seg_count]);
+			}
+		}
+
+		start = k_cycle_get_32();
+		pkt = net_tcp_gro_receive(&fifo, segs[0], &next);
+		gro_cycles += k_cycle_get_32() - start;
+
+		zassert_true(k_fifo_is_empty(&fifo), "Segments not merged");
+
+		seg_count = 0;
+		net_pkt_unref(pkt);
+	}
+
+	TC_PRINT("GRO: %llu bytes in %u cycles, %llu cycles/kB, "
+		 "%llu kB/s\n", bytes, gro_cycles,
+		 (uint64_t)gro_cycles * 1024U / bytes,
+		 gro_cycles ? bytes * sys_clock_hw_cycles_per_sec() /
+			      gro_cycles / 1024U : 0);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_tcp_gso_gro_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_gso_ipv4),
+			 ztest_unit_test(test_gso_ipv6),
+			 ztest_unit_test(test_gro_ipv4),
+			 ztest_unit_test(test_gro_ipv6),
+			 ztest_unit_test(test_gro_max_segments),
+			 ztest_unit_test(test_gro_out_of_order),
+			 ztest_unit_test(test_gro_push),
+			 ztest_unit_test(test_gro_bad_chksum),
+			 ztest_unit_test(test_gso_gro_perf));
+
+	ztest_run_test_suite(net_tcp_gso_gro_test);
+}
@@ -29,6 +29,8 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_UTILS_LOG_LEVEL);
 
 #define NET_LOG_ENABLED 1
 #include "net_private.h"
+#include "ipv4.h"
+#include "udp_internal.h"
 
 struct net_addr_test_data {
 	sa_family_t family;
@@ -848,11 +850,240 @@ void test_addr_parse(void)
 #endif
 }
 
+/* The original 16 bits at a time implementation, used as reference */
+static uint16_t chksum_ref(uint16_t sum, const uint8_t *data, size_t len)
+{
+	const uint8_t *end = data + len - 1;
+	uint16_t tmp;
+
+	while (data < end) {
+		tmp = (data[0] << 8) + data[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		data += 2;
+	}
+
+	if (data == end) {
+		tmp = data[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+#define CHKSUM_DATA_LEN 1280
+#define CHKSUM_PERF_ROUNDS 200
+
+static uint8_t chksum_src[CHKSUM_DATA_LEN + 4];
+static uint8_t chksum_dst[CHKSUM_DATA_LEN + 4];
+
+static void chksum_fill(uint8_t *data, size_t len, uint32_t seed)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		seed = seed * 1103515245U + 12345U;
+		data[i] = seed >> 16;
+	}
+}
+
+void test_chksum(void)
+{
+	static const uint8_t patterns[] = { 0x00, 0xff };
+	size_t len, off, i;
+	uint16_t ref;
+
+	chksum_fill(chksum_src, sizeof(chksum_src), 1);
+
+	for (off = 0; off < 4; off++) {
+		for (len = 0; len <= 300; len++) {
+			ref = chksum_ref(0x1234, chksum_src + off, len);
+
+			zassert_equal(net_calc_chksum_buf(0x1234,
+							  chksum_src + off,
+							  len),
+				      ref, "Checksum mismatch, len %zu", len);
+
+			memset(chksum_dst, 0, sizeof(chksum_dst));
+
+			zassert_equal(net_calc_chksum_copy(0x1234,
+							   chksum_dst + 3 - off,
+							   chksum_src + off,
+							   len),
+				      ref, "Copy checksum mismatch, len %zu",
+				      len);
+			zassert_mem_equal(chksum_dst + 3 - off,
+					  chksum_src + off, len,
+					  "Copy mismatch, len %zu", len);
+		}
+	}
+
+	for (i = 0; i < ARRAY_SIZE(patterns); i++) {
+		memset(chksum_dst, patterns[i], CHKSUM_DATA_LEN);
+
+		zassert_equal(net_calc_chksum_buf(0, chksum_dst,
+						  CHKSUM_DATA_LEN),
+			      chksum_ref(0, chksum_dst, CHKSUM_DATA_LEN),
+			      "Checksum mismatch, pattern 0x%02x",
+			      patterns[i]);
+	}
+}
+
+void test_chksum_perf(void)
+{
+	uint32_t start, ref_cyc, buf_cyc, copy_sum_cyc, copy_cyc;
+	volatile uint16_t sum = 0U;
+	int i;
+
+	chksum_fill(chksum_src, CHKSUM_DATA_LEN, 2);
+
+	start = k_cycle_get_32();
+	for (i = 0; i < CHKSUM_PERF_ROUNDS; i++) {
+		sum = chksum_ref(sum, chksum_src, CHKSUM_DATA_LEN);
+	}
+	ref_cyc = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (i = 0; i < CHKSUM_PERF_ROUNDS; i++) {
+		sum = net_calc_chksum_buf(sum, chksum_src, CHKSUM_DATA_LEN);
+	}
+	buf_cyc = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (i = 0; i < CHKSUM_PERF_ROUNDS; i++) {
+		memcpy(chksum_dst, chksum_src, CHKSUM_DATA_LEN);
+		sum = net_calc_chksum_buf(sum, chksum_dst, CHKSUM_DATA_LEN);
+	}
+	copy_sum_cyc = k_cycle_get_32() - start;
+
+	start = k_cycle_get_32();
+	for (i = 0; i < CHKSUM_PERF_ROUNDS; i++) {
+		sum = net_calc_chksum_copy(sum, chksum_dst, chksum_src,
+					   CHKSUM_DATA_LEN);
+	}
+	copy_cyc = k_cycle_get_32() - start;
+
+	TC_PRINT("Checksum of %d bytes, %d rounds:\n", CHKSUM_DATA_LEN,
+		 CHKSUM_PERF_ROUNDS);
+	TC_PRINT("  16-bit reference     %u us\n", k_cyc_to_us_floor32(ref_cyc));
+	TC_PRINT("  wide word            %u us\n", k_cyc_to_us_floor32(buf_cyc));
+	TC_PRINT("  memcpy + wide word   %u us\n",
+		 k_cyc_to_us_floor32(copy_sum_cyc));
+	TC_PRINT("  copy and checksum    %u us\n", k_cyc_to_us_floor32(copy_cyc));
+}
+
+#if defined(CONFIG_NET_UDP_CHKSUM_COPY)
+static struct net_pkt *chksum_udp_pkt(size_t len)
+{
+	struct in_addr src = { { { 192, 0, 2, 1 } } };
+	struct in_addr dst = { { { 192, 0, 2, 2 } } };
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(NULL, len, AF_INET, IPPROTO_UDP,
+					K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	/* There is no interface to take the TTL from */
+	net_pkt_set_ipv4_ttl(pkt, 64);
+
+	zassert_equal(net_ipv4_create(pkt, &src, &dst), 0,
+		      "Cannot create IPv4 header");
+	zassert_equal(net_udp_create(pkt, htons(4242), htons(4243)), 0,
+		      "Cannot create UDP header");
+
+	return pkt;
+}
+
+static void chksum_udp_write(struct net_pkt *pkt, size_t len)
+{
+	/* Odd sized writes, so that the payload is summed from odd offsets */
+	static const size_t chunks[] = { 1, 7, 33, 2, 101 };
+	size_t pos = 0, chunk;
+	int i = 0;
+
+	net_pkt_chksum_track(pkt);
+
+	while (pos < len) {
+		chunk = MIN(chunks[i++ % ARRAY_SIZE(chunks)], len - pos);
+
+		zassert_equal(net_pkt_write(pkt, chksum_src + pos, chunk), 0,
+			      "Cannot write payload");
+		pos += chunk;
+	}
+}
+
+static uint16_t chksum_udp_full(struct net_pkt *pkt)
+{
+	uint16_t start, sum;
+
+	/* Drop the tracked sum, if any, to walk the whole packet */
+	(void)net_pkt_chksum_get(pkt, &start, &sum);
+
+	net_pkt_cursor_init(pkt);
+
+	return net_calc_chksum_udp(pkt);
+}
+
+void test_chksum_udp_copy(void)
+{
+	const size_t len = 555;
+	struct net_pkt *pkt;
+	uint16_t sum;
+	uint8_t byte;
+
+	chksum_fill(chksum_src, len, 3);
+
+	pkt = chksum_udp_pkt(len);
+	chksum_udp_write(pkt, len);
+
+	net_pkt_cursor_init(pkt);
+	sum = net_calc_chksum_udp(pkt);
+
+	zassert_equal(sum, chksum_udp_full(pkt), "Tracked checksum mismatch");
+
+	net_pkt_unref(pkt);
+
+	/* Overwriting the payload after it was summed must not use the
+	 * tracked sum.
+	 */
+	pkt = chksum_udp_pkt(len);
+	chksum_udp_write(pkt, len);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	byte = chksum_src[100] ^ 0x5a;
+	net_pkt_skip(pkt, NET_IPV4UDPH_LEN + 100);
+	net_pkt_write_u8(pkt, byte);
+	net_pkt_set_overwrite(pkt, false);
+
+	net_pkt_cursor_init(pkt);
+	sum = net_calc_chksum_udp(pkt);
+
+	zassert_equal(sum, chksum_udp_full(pkt), "Stale tracked checksum");
+
+	net_pkt_unref(pkt);
+}
+#else
+void test_chksum_udp_copy(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_NET_UDP_CHKSUM_COPY */
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum),
+			 ztest_unit_test(test_chksum_perf),
+			 ztest_unit_test(test_chksum_udp_copy));
 
 	ztest_run_test_suite(test_utils_fn);
 }
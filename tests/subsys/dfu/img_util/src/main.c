@@ -158,12 +158,80 @@ void test_check_flash(void)
 	flash_area_close(ctx.flash_area);
 }
 
+#define PERF_IMAGE_SIZE (64 * 1024)
+
+void test_check_flash_perf(void)
+{
+#ifndef CONFIG_IMG_STREAM_HASH
+	ztest_test_skip();
+#else
+	static uint8_t chunk[CONFIG_IMG_BLOCK_BUF_SIZE];
+	struct flash_img_check fic;
+	struct flash_area_check fac;
+	struct flash_img_context ctx;
+	const struct flash_area *fa;
+	uint8_t hash[TC_SHA256_DIGEST_SIZE];
+	uint32_t start, streamed, reread;
+	size_t i;
+	int ret;
+
+	for (i = 0; i < sizeof(chunk); i++) {
+		chunk[i] = i;
+	}
+
+	ret = flash_img_init_id(&ctx, FLASH_AREA_ID(image_1));
+	zassert_true(ret == 0, "Flash img init");
+	ret = flash_area_erase(ctx.flash_area, 0, ctx.flash_area->fa_size);
+	zassert_true(ret == 0, "Flash erase failure (%d)", ret);
+
+	for (i = 0; i < PERF_IMAGE_SIZE; i += sizeof(chunk)) {
+		ret = flash_img_buffered_write(&ctx, chunk, sizeof(chunk),
+					       i + sizeof(chunk) >=
+					       PERF_IMAGE_SIZE);
+		zassert_true(ret == 0, "Flash img buffered write (%d)", ret);
+	}
+
+	ret = stream_flash_hash_get(&ctx.stream, hash);
+	zassert_true(ret == 0, "Stream hash get (%d)", ret);
+
+	fic.match = hash;
+	fic.clen = PERF_IMAGE_SIZE;
+
+	start = k_cycle_get_32();
+	ret = flash_img_check(&ctx, &fic, FLASH_AREA_ID(image_1));
+	streamed = k_cycle_get_32() - start;
+	zassert_true(ret == 0, "Flash img check (%d)", ret);
+
+	/* Same check by reading the image back from flash */
+	ret = flash_area_open(FLASH_AREA_ID(image_1), &fa);
+	zassert_true(ret == 0, "Flash area open (%d)", ret);
+
+	fac.match = hash;
+	fac.clen = PERF_IMAGE_SIZE;
+	fac.off = 0;
+	fac.rbuf = ctx.buf;
+	fac.rblen = sizeof(ctx.buf);
+
+	start = k_cycle_get_32();
+	ret = flash_area_check_int_sha256(fa, &fac);
+	reread = k_cycle_get_32() - start;
+	zassert_true(ret == 0, "Flash area check (%d)", ret);
+
+	flash_area_close(fa);
+
+	TC_PRINT("Check of %u byte image: %u us streamed, %u us read back\n",
+		 PERF_IMAGE_SIZE, k_cyc_to_us_floor32(streamed),
+		 k_cyc_to_us_floor32(reread));
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_util,
 			ztest_unit_test(test_collecting),
 			ztest_unit_test(test_init_id),
-			ztest_unit_test(test_check_flash)
+			ztest_unit_test(test_check_flash),
+			ztest_unit_test(test_check_flash_perf)
 			);
 	ztest_run_test_suite(test_util);
 }
@@ -93,7 +93,8 @@ void test_main(void)
 			 ztest_unit_test(test_unmount),
 			 ztest_unit_test_setup_teardown(test_mount_flags,
 							dummy_setup,
-							fs_teardown)
+							fs_teardown),
+			 ztest_unit_test(test_fs_path_resolve)
 			 );
 	ztest_run_test_suite(fat_fs_basic_test);
 }
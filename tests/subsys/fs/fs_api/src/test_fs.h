@@ -56,4 +56,5 @@ void test_file_stat(void);
 void test_file_unlink(void);
 void test_unmount(void);
 void test_mount_flags(void);
+void test_fs_path_resolve(void);
 #endif
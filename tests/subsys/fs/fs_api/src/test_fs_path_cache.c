@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2022 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include "test_fs.h"
+
+/* Number of mount points and distinct paths used for timing */
+#define RES_MNT_COUNT	6
+#define RES_PATH_COUNT	64
+#define RES_ITERATIONS	16
+
+/* File system whose operations do nothing but record the mount point
+ * a path was resolved to, so that fs_stat() timing is dominated by the
+ * path to mount point resolution in the file system core.
+ */
+static struct fs_mount_t *resolved_mp;
+
+static int res_stat(struct fs_mount_t *mountp, const char *path,
+		    struct fs_dirent *entry)
+{
+	resolved_mp = mountp;
+	return 0;
+}
+
+static int res_mount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static int res_unmount(struct fs_mount_t *mountp)
+{
+	return 0;
+}
+
+static struct fs_file_system_t res_fs = {
+	.stat = res_stat,
+	.mount = res_mount,
+	.unmount = res_unmount,
+};
+
+static struct fs_mount_t res_mnt[RES_MNT_COUNT] = {
+	{ .type = TEST_FS_2, .mnt_point = "/RES0:" },
+	{ .type = TEST_FS_2, .mnt_point = "/RES1:" },
+	{ .type = TEST_FS_2, .mnt_point = "/RES2:" },
+	{ .type = TEST_FS_2, .mnt_point = "/RES3:" },
+	{ .type = TEST_FS_2, .mnt_point = "/RES4:" },
+	{ .type = TEST_FS_2, .mnt_point = "/RES5:" },
+};
+
+static struct fs_mount_t res_nested_mnt = {
+	.type = TEST_FS_2,
+	.mnt_point = "/RES5:/sub",
+};
+
+static char res_paths[RES_PATH_COUNT][32];
+
+static struct fs_mount_t *resolve(const char *path)
+{
+	struct fs_dirent entry;
+	int ret;
+
+	resolved_mp = NULL;
+	ret = fs_stat(path, &entry);
+	if (ret < 0) {
+		return NULL;
+	}
+
+	return resolved_mp;
+}
+
+/**
+ * @brief Test path to mount point resolution and time it
+ *
+ * @details Resolve paths against several mount points, including one
+ * nested beneath another, before and after mounting and unmounting,
+ * then time resolution of many distinct paths below one mount point.
+ * Comparing the reported time with and without
+ * CONFIG_FILE_SYSTEM_PATH_CACHE gives the cost of the cache against
+ * the uncached mount list scan.
+ *
+ * @ingroup filesystem_api
+ */
+void test_fs_path_resolve(void)
+{
+	struct fs_mount_t *last = &res_mnt[RES_MNT_COUNT - 1];
+	uint32_t start, cycles;
+	int ret;
+
+	ret = fs_register(TEST_FS_2, &res_fs);
+	zassert_equal(ret, 0, "Failed to register fs (%d)", ret);
+
+	for (int i = 0; i < RES_MNT_COUNT; ++i) {
+		ret = fs_mount(&res_mnt[i]);
+		zassert_equal(ret, 0, "Failed to mount %s (%d)",
+			      res_mnt[i].mnt_point, ret);
+	}
+
+	zassert_equal(resolve("/RES1:/file"), &res_mnt[1], "Wrong mount");
+	zassert_equal(resolve("/RES1:/file"), &res_mnt[1], "Wrong mount");
+	zassert_equal(resolve("/RES1:"), &res_mnt[1], "Wrong mount");
+	zassert_is_null(resolve("/RES1:file"), "Resolved bad separator");
+	zassert_is_null(resolve("/RES"), "Resolved a partial name");
+	zassert_equal(resolve("/RES5:/sub/file"), last, "Wrong mount");
+
+	/* A mount nested beneath a cached one takes over its subtree */
+	ret = fs_mount(&res_nested_mnt);
+	zassert_equal(ret, 0, "Failed to mount nested fs (%d)", ret);
+	zassert_equal(resolve("/RES5:/sub/file"), &res_nested_mnt,
+		      "Nested mount not resolved");
+	zassert_equal(resolve("/RES5:/sub/file"), &res_nested_mnt,
+		      "Nested mount not resolved");
+	zassert_equal(resolve("/RES5:/subfile"), last, "Wrong mount");
+	zassert_equal(resolve("/RES5:/file"), last, "Wrong mount");
+
+	ret = fs_unmount(&res_nested_mnt);
+	zassert_equal(ret, 0, "Failed to unmount nested fs (%d)", ret);
+	zassert_equal(resolve("/RES5:/sub/file"), last, "Wrong mount");
+
+	ret = fs_unmount(&res_mnt[1]);
+	zassert_equal(ret, 0, "Failed to unmount (%d)", ret);
+	zassert_is_null(resolve("/RES1:/file"), "Resolved unmounted fs");
+
+	/* Many distinct files below the last mounted file system, like a
+	 * logger rotating through files.
+	 */
+	for (int i = 0; i < RES_PATH_COUNT; ++i) {
+		snprintf(res_paths[i], sizeof(res_paths[i]),
+			 "/RES5:/logs/log%04d.txt", i);
+	}
+
+	start = k_cycle_get_32();
+	for (int n = 0; n < RES_ITERATIONS; ++n) {
+		for (int i = 0; i < RES_PATH_COUNT; ++i) {
+			zassert_equal(resolve(res_paths[i]), last,
+				      "Wrong mount");
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("path cache %s: %u resolutions, %llu ns each\n",
+		 IS_ENABLED(CONFIG_FILE_SYSTEM_PATH_CACHE) ? "on" : "off",
+		 RES_ITERATIONS * RES_PATH_COUNT,
+		 (unsigned long long)k_cyc_to_ns_floor64(cycles) /
+		 (RES_ITERATIONS * RES_PATH_COUNT));
+
+	for (int i = 0; i < RES_MNT_COUNT; ++i) {
+		if (i != 1) {
+			(void)fs_unmount(&res_mnt[i]);
+		}
+	}
+
+	fs_unregister(TEST_FS_2, &res_fs);
+}
@@ -6,6 +6,7 @@
 
 /* littlefs performance testing */
 
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <kernel.h>
@@ -223,6 +224,74 @@ static int small_8_1K_cust(void)
 	return custom_write_test("small 8x1K bigfile", &testfs_small_mnt, &cfg, 1024, 8);
 }
 
+static int open_close(const char *tag,
+		      struct fs_mount_t *mp,
+		      size_t nfiles,
+		      size_t nopen)
+{
+	struct testfs_path path;
+	struct fs_file_t file;
+	char name[8];
+	uint32_t t0;
+	uint32_t t1;
+	int rc;
+	int rv = TC_FAIL;
+
+	fs_file_t_init(&file);
+	TC_PRINT("clearing %s for %s open test\n",
+		 mp->mnt_point, tag);
+	if (testfs_lfs_wipe_partition(mp) != TC_PASS) {
+		return TC_FAIL;
+	}
+
+	rc = fs_mount(mp);
+	if (rc != 0) {
+		TC_PRINT("Mount %s failed: %d\n", mp->mnt_point, rc);
+		return TC_FAIL;
+	}
+
+	for (size_t i = 0; i < nfiles; ++i) {
+		snprintf(name, sizeof(name), "f%zu", i);
+		testfs_path_init(&path, mp, name, TESTFS_PATH_END);
+
+		rc = fs_open(&file, path.path, FS_O_CREATE | FS_O_WRITE);
+		if (rc != 0) {
+			TC_PRINT("Failed to create %s: %d\n", path.path, rc);
+			goto out_mnt;
+		}
+		(void)fs_close(&file);
+	}
+
+	t0 = k_uptime_get_32();
+	for (size_t i = 0; i < nopen; ++i) {
+		snprintf(name, sizeof(name), "f%zu", i % nfiles);
+		testfs_path_init(&path, mp, name, TESTFS_PATH_END);
+
+		rc = fs_open(&file, path.path, FS_O_READ);
+		if (rc != 0) {
+			TC_PRINT("Failed to open %s: %d\n", path.path, rc);
+			goto out_mnt;
+		}
+		(void)fs_close(&file);
+	}
+	t1 = k_uptime_get_32();
+
+	if (t1 == t0) {
+		t1++;
+	}
+
+	TC_PRINT("%s open/close %zu files %zu times in %u ms: %u opens/s\n",
+		 tag, nfiles, nopen, (t1 - t0),
+		 (uint32_t)(nopen * 1000U / (t1 - t0)));
+
+	rv = TC_PASS;
+
+out_mnt:
+	(void)fs_unmount(mp);
+
+	return rv;
+}
+
 void test_lfs_perf(void)
 {
 	k_sleep(K_MSEC(100));   /* flush log messages */
@@ -232,6 +301,15 @@ void test_lfs_perf(void)
 		      TC_PASS,
 		      "failed");
 
+	k_sleep(K_MSEC(100));   /* flush log messages */
+	zassert_equal(open_close(IS_ENABLED(CONFIG_FILE_SYSTEM_PATH_CACHE) ?
+				 "small 64 files cached" :
+				 "small 64 files uncached",
+				 &testfs_small_mnt,
+				 64, 1024),
+		      TC_PASS,
+		      "failed");
+
 	if (IS_ENABLED(CONFIG_APP_TEST_CUSTOM)) {
 		k_sleep(K_MSEC(100));   /* flush log messages */
 		zassert_equal(small_8_1K_cust(), TC_PASS,
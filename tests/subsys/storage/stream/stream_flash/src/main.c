@@ -13,6 +13,11 @@
 
 #include <storage/stream_flash.h>
 
+#ifdef CONFIG_STREAM_FLASH_HASH
+#include <tinycrypt/constants.h>
+#include <tinycrypt/sha256.h>
+#endif
+
 #define BUF_LEN 512
 #define MAX_PAGE_SIZE 0x1000 /* Max supported page size to run test on */
 #define MAX_NUM_PAGES 4      /* Max number of pages used in these tests */
@@ -78,20 +83,32 @@ static void erase_flash(void)
 }
 
 
+static void wait_erase_ahead(void)
+{
+#ifdef CONFIG_STREAM_FLASH_ERASE_AHEAD
+	/* The context is about to be reset: a flush waits for the page
+	 * being erased ahead, if any.
+	 */
+	(void)stream_flash_buffered_write(&ctx, write_buf, 0, true);
+#endif
+}
+
 static void init_target(void)
 {
 	int rc;
 
-	/* Ensure that target is clean */
-	memset(&ctx, 0, sizeof(ctx));
-	memset(buf, 0, BUF_LEN);
-
 	/* Disable callback tests */
 	cb_len = 0;
 	cb_offset = 0;
 	cb_buf = NULL;
 	cb_ret = 0;
 
+	wait_erase_ahead();
+
+	/* Ensure that target is clean */
+	memset(&ctx, 0, sizeof(ctx));
+	memset(buf, 0, BUF_LEN);
+
 	erase_flash();
 
 	rc = stream_flash_init(&ctx, fdev, buf, BUF_LEN, FLASH_BASE, 0,
@@ -394,6 +411,7 @@ static void test_stream_flash_buffered_write_whole_page(void)
 	VERIFY_WRITTEN(page_size, page_size);
 
 	/* Reset stream_flash context */
+	wait_erase_ahead();
 	memset(&ctx, 0, sizeof(ctx));
 	memset(buf, 0, BUF_LEN);
 	rc = stream_flash_init(&ctx, fdev, buf, BUF_LEN, FLASH_BASE, 0,
@@ -464,6 +482,74 @@ static void test_stream_flash_buffered_write_whole_page(void)
 }
 #endif
 
+static void test_stream_flash_erase_ahead(void)
+{
+#ifndef CONFIG_STREAM_FLASH_ERASE_AHEAD
+	ztest_test_skip();
+#else
+	int rc;
+
+	init_target();
+
+	/* Dirty the second page, as a previous image would */
+	rc = flash_write(fdev, FLASH_BASE + page_size, write_buf, BUF_LEN);
+	zassert_equal(rc, 0, "should succeed");
+
+	/* Fill the first page */
+	rc = stream_flash_buffered_write(&ctx, write_buf, page_size, false);
+	zassert_equal(rc, 0, "expected success");
+
+	/* The next buffer ends in the second page, which is erased ahead.
+	 * Flushing the empty buffer waits for the erase to complete.
+	 */
+	rc = stream_flash_buffered_write(&ctx, write_buf, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	VERIFY_ERASED(page_size, BUF_LEN);
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, true);
+	zassert_equal(rc, 0, "expected success");
+
+	VERIFY_WRITTEN(0, page_size + BUF_LEN);
+#endif
+}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE_AHEAD
+static K_SEM_DEFINE(sysworkq_done, 0, 1);
+static int sysworkq_rc;
+
+static void erase_ahead_work_handler(struct k_work *work)
+{
+	sysworkq_rc = stream_flash_buffered_write(&ctx, write_buf, page_size,
+						  false);
+	if (sysworkq_rc == 0) {
+		/* Waits for the erase started ahead of this write */
+		sysworkq_rc = stream_flash_buffered_write(&ctx, write_buf,
+							  BUF_LEN, true);
+	}
+	k_sem_give(&sysworkq_done);
+}
+#endif
+
+static void test_stream_flash_erase_ahead_sysworkq(void)
+{
+#ifndef CONFIG_STREAM_FLASH_ERASE_AHEAD
+	ztest_test_skip();
+#else
+	static K_WORK_DEFINE(erase_ahead_work, erase_ahead_work_handler);
+	int rc;
+
+	init_target();
+
+	/* Asynchronous erases must not need the system work queue */
+	k_work_submit(&erase_ahead_work);
+	zassert_equal(k_sem_take(&sysworkq_done, K_SECONDS(5)), 0,
+		      "write from the system work queue deadlocked");
+	zassert_equal(sysworkq_rc, 0, "expected success");
+
+	VERIFY_WRITTEN(0, page_size + BUF_LEN);
+#endif
+}
+
 static size_t write_and_save_progress(size_t bytes, const char *save_key)
 {
 	int rc;
@@ -644,6 +730,71 @@ static void test_stream_flash_progress_clear(void)
 #endif
 }
 
+static void test_stream_flash_progress_hash(void)
+{
+#ifndef CONFIG_STREAM_FLASH_HASH
+	ztest_test_skip();
+#else
+	/* Data that depends on its offset, so that a chunk hashed twice,
+	 * skipped or hashed out of order changes the digest
+	 */
+	static uint8_t data[BUF_LEN * 3];
+	struct tc_sha256_state_struct sha;
+	uint8_t expected[TC_SHA256_DIGEST_SIZE];
+	uint8_t hash[TC_SHA256_DIGEST_SIZE];
+	int rc;
+
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = i + (i >> 8);
+	}
+
+	(void)tc_sha256_init(&sha);
+	(void)tc_sha256_update(&sha, data, sizeof(data));
+	(void)tc_sha256_final(expected, &sha);
+
+	clear_all_progress();
+	init_target();
+
+	rc = stream_flash_hash_get(NULL, hash);
+	zassert_true(rc < 0, "expected error since ctx is NULL");
+
+	/* Write some data and save the progress along with the digest */
+	rc = stream_flash_buffered_write(&ctx, data, BUF_LEN * 2, true);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_progress_save(&ctx, progress_key);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Data which is only buffered is not part of the digest */
+	rc = stream_flash_buffered_write(&ctx, &data[BUF_LEN * 2],
+					 BUF_LEN / 2, false);
+	zassert_equal(rc, 0, "expected success");
+
+	init_target();
+
+	/* Resume and write the rest */
+	(void) load_progress(progress_key);
+
+	rc = stream_flash_buffered_write(&ctx, &data[BUF_LEN * 2], BUF_LEN,
+					 true);
+	zassert_equal(rc, 0, "expected success");
+
+	/* init_target() erased the flash, only the rest is there */
+	VERIFY_BUF(BUF_LEN * 2, BUF_LEN, &data[BUF_LEN * 2]);
+
+	rc = stream_flash_hash_get(&ctx, hash);
+	zassert_equal(rc, 0, "expected success");
+	zassert_mem_equal(hash, expected, sizeof(hash),
+			  "digest of resumed stream is wrong");
+
+	/* Getting the digest does not end the stream */
+	rc = stream_flash_hash_get(&ctx, hash);
+	zassert_equal(rc, 0, "expected success");
+	zassert_mem_equal(hash, expected, sizeof(hash),
+			  "digest changed between calls");
+#endif
+}
+
 void test_main(void)
 {
 	fdev = device_get_binding(FLASH_NAME);
@@ -663,11 +814,14 @@ void test_main(void)
 	     ztest_unit_test(test_stream_flash_buffered_write_callback),
 	     ztest_unit_test(test_stream_flash_flush),
 	     ztest_unit_test(test_stream_flash_buffered_write_whole_page),
+	     ztest_unit_test(test_stream_flash_erase_ahead),
+	     ztest_unit_test(test_stream_flash_erase_ahead_sysworkq),
 	     ztest_unit_test(test_stream_flash_erase_page),
 	     ztest_unit_test(test_stream_flash_bytes_written),
 	     ztest_unit_test(test_stream_flash_progress_api),
 	     ztest_unit_test(test_stream_flash_progress_resume),
-	     ztest_unit_test(test_stream_flash_progress_clear)
+	     ztest_unit_test(test_stream_flash_progress_clear),
+	     ztest_unit_test(test_stream_flash_progress_hash)
 	 );
 
 	ztest_run_test_suite(lib_stream_flash_test);
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2022 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define CONFIG_MMU_PAGE_SIZE 4096
+
+#include "../../../subsys/demand_paging/backing_store/compressed_codec.c"
+
+#define PAGE_SIZE	CONFIG_MMU_PAGE_SIZE
+#define GUARD		0xee
+
+static uint8_t page[PAGE_SIZE];
+/* Compressed data, followed by guard bytes */
+static uint8_t packed[2 * PAGE_SIZE];
+static uint8_t unpacked[PAGE_SIZE];
+
+static uint32_t rand_state;
+
+static uint8_t rand_byte(void)
+{
+	/* xorshift32 */
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state >> 24;
+}
+
+static void fill_random(uint8_t *buf, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		buf[i] = rand_byte();
+	}
+}
+
+/* Compress page, check it decompresses to the same data, return the
+ * compressed size
+ */
+static size_t round_trip(void)
+{
+	size_t size;
+
+	memset(packed, GUARD, sizeof(packed));
+
+	size = compress_page(page, packed, PAGE_SIZE);
+	zassert_not_equal(size, 0, "page not compressed");
+	zassert_true(size <= PAGE_SIZE, "compressed size %zu too large",
+		     size);
+	zassert_equal(packed[size], GUARD, "wrote past the compressed data");
+
+	memset(unpacked, 0, sizeof(unpacked));
+	zassert_true(decompress_page(packed, size, unpacked),
+		     "decompression failed");
+	zassert_mem_equal(unpacked, page, PAGE_SIZE, "page mismatch");
+
+	return size;
+}
+
+void test_zero_page(void)
+{
+	memset(page, 0, sizeof(page));
+
+	zassert_true(round_trip() < 32, "zero page not compressed well");
+}
+
+void test_runs(void)
+{
+	size_t pos = 0, len;
+
+	/* Runs of 1 to 60 identical bytes */
+	for (unsigned int k = 0; pos < PAGE_SIZE; k++) {
+		len = MIN((k % 60) + 1, PAGE_SIZE - pos);
+		memset(&page[pos], k, len);
+		pos += len;
+	}
+
+	zassert_true(round_trip() < PAGE_SIZE / 2,
+		     "runs not compressed well");
+}
+
+void test_overlapping_matches(void)
+{
+	/* Periods shorter than MIN_MATCH give matches overlapping their
+	 * own output
+	 */
+	for (size_t period = 1; period <= 7; period++) {
+		for (size_t i = 0; i < PAGE_SIZE; i++) {
+			page[i] = 'a' + i % period;
+		}
+
+		zassert_true(round_trip() < 64,
+			     "period %zu not compressed well", period);
+	}
+}
+
+void test_overlapping_match_decode(void)
+{
+	uint8_t stream[] = {
+		/* One literal, match length continued */
+		(1 << 4) | 15, 'x',
+		/* Offset 1 */
+		0x01, 0x00,
+		/* PAGE_SIZE - 1 - MIN_MATCH - 15 = 15 * 255 + 251 */
+		255, 255, 255, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 255, 255, 255, 251,
+	};
+
+	zassert_true(decompress_page(stream, sizeof(stream), unpacked),
+		     "decompression failed");
+
+	for (size_t i = 0; i < PAGE_SIZE; i++) {
+		zassert_equal(unpacked[i], 'x', "wrong byte at %zu", i);
+	}
+}
+
+void test_long_lengths(void)
+{
+	/* Literal runs around the length extension boundaries, followed
+	 * by a long match
+	 */
+	static const size_t lit_lens[] = {
+		0, 1, 14, 15, 16, 269, 270, 271, 524, 525, 526, 1000,
+	};
+
+	rand_state = 0x12345678;
+
+	for (size_t i = 0; i < ARRAY_SIZE(lit_lens); i++) {
+		memset(page, 0, sizeof(page));
+		fill_random(page, lit_lens[i]);
+
+		zassert_true(round_trip() < lit_lens[i] + 64,
+			     "%zu literals not compressed well", lit_lens[i]);
+	}
+}
+
+void test_long_length_decode(void)
+{
+	static uint8_t stream[3 + 270 + 2 + 15];
+	uint8_t *p = stream;
+	size_t i;
+
+	rand_state = 0xcafe;
+
+	/* 270 literals: 15 + 255 + 0 */
+	*p++ = (15 << 4) | 15;
+	*p++ = 255;
+	*p++ = 0;
+	fill_random(p, 270);
+	p += 270;
+
+	/* Offset 270, PAGE_SIZE - 270 - MIN_MATCH - 15 = 14 * 255 + 237 */
+	sys_put_le16(270, p);
+	p += 2;
+	for (i = 0; i < 14; i++) {
+		*p++ = 255;
+	}
+	*p++ = 237;
+
+	zassert_equal(p - stream, sizeof(stream), "bad test stream");
+	zassert_true(decompress_page(stream, sizeof(stream), unpacked),
+		     "decompression failed");
+
+	for (i = 270; i < PAGE_SIZE; i++) {
+		zassert_equal(unpacked[i], unpacked[i - 270],
+			      "wrong byte at %zu", i);
+	}
+	zassert_mem_equal(unpacked, &stream[3], 270, "wrong literals");
+}
+
+void test_incompressible(void)
+{
+	size_t limit = PAGE_SIZE / 2;
+
+	rand_state = 0xdeadbeef;
+	fill_random(page, sizeof(page));
+
+	memset(packed, GUARD, sizeof(packed));
+	zassert_equal(compress_page(page, packed, PAGE_SIZE - 1), 0,
+		      "random page compressed");
+	zassert_equal(compress_page(page, packed, limit), 0,
+		      "random page compressed");
+
+	for (size_t i = limit; i < sizeof(packed); i++) {
+		zassert_equal(packed[i], GUARD, "wrote past the limit at %zu",
+			      i);
+	}
+
+	/* Compressible data after random data still has to fit */
+	memset(&page[PAGE_SIZE / 2], 0, PAGE_SIZE / 2);
+	zassert_equal(compress_page(page, packed, limit), 0,
+		      "half random page fits in half a page");
+	zassert_true(round_trip() < limit + 64,
+		     "half random page not compressed");
+}
+
+void test_text(void)
+{
+	static const char *const words[] = {
+		"the ", "page ", "is ", "compressed ", "and ", "stored ",
+		"in ", "chunks ", "of ", "memory ", "\n",
+	};
+	size_t pos = 0, len;
+
+	rand_state = 42;
+
+	while (pos < PAGE_SIZE) {
+		const char *word = words[rand_byte() % ARRAY_SIZE(words)];
+
+		len = MIN(strlen(word), PAGE_SIZE - pos);
+		memcpy(&page[pos], word, len);
+		pos += len;
+	}
+
+	zassert_true(round_trip() < PAGE_SIZE / 2,
+		     "text not compressed well");
+}
+
+void test_corrupted(void)
+{
+	static const uint8_t zero_offset[] = { (1 << 4) | 15, 'x', 0, 0 };
+	static const uint8_t far_offset[] = { (1 << 4) | 15, 'x', 2, 0 };
+	static const uint8_t short_page[] = { 3 << 4, 'a', 'b', 'c' };
+	static const uint8_t no_offset[] = { (1 << 4) | 1, 'x', 1 };
+	static const uint8_t no_literals[] = { 15 << 4, 255 };
+	size_t size;
+
+	zassert_false(decompress_page(zero_offset, sizeof(zero_offset),
+				      unpacked), "zero offset accepted");
+	zassert_false(decompress_page(far_offset, sizeof(far_offset),
+				      unpacked), "offset before the page accepted");
+	zassert_false(decompress_page(short_page, sizeof(short_page),
+				      unpacked), "short page accepted");
+	zassert_false(decompress_page(no_offset, sizeof(no_offset),
+				      unpacked), "truncated offset accepted");
+	zassert_false(decompress_page(no_literals, sizeof(no_literals),
+				      unpacked), "truncated literals accepted");
+
+	/* A truncated page, and a page with trailing data */
+	rand_state = 7;
+	memset(page, 0, sizeof(page));
+	fill_random(page, 100);
+	fill_random(&page[PAGE_SIZE - 10], 10);
+	size = round_trip();
+
+	zassert_false(decompress_page(packed, size - 1, unpacked),
+		      "truncated page accepted");
+	packed[size] = 0x10;
+	zassert_false(decompress_page(packed, size + 1, unpacked),
+		      "trailing data accepted");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(compressed_backing_store,
+			 ztest_unit_test(test_zero_page),
+			 ztest_unit_test(test_runs),
+			 ztest_unit_test(test_overlapping_matches),
+			 ztest_unit_test(test_overlapping_match_decode),
+			 ztest_unit_test(test_long_lengths),
+			 ztest_unit_test(test_long_length_decode),
+			 ztest_unit_test(test_incompressible),
+			 ztest_unit_test(test_text),
+			 ztest_unit_test(test_corrupted));
+	ztest_run_test_suite(compressed_backing_store);
+}